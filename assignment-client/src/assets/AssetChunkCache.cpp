@@ -0,0 +1,182 @@
+//
+//  AssetChunkCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "AssetServerLogging.h"
+
+const qint64 AssetChunkCache::CHUNK_SIZE = 256 * 1024;
+
+// remember a few times more missed chunks than fit in the cache
+static const size_t GHOSTS_PER_CHUNK = 4;
+
+AssetChunkCache::AssetChunkCache(qint64 capacity) :
+    _capacity(capacity),
+    _maxGhosts(std::max((size_t)1, (size_t)(capacity / CHUNK_SIZE) * GHOSTS_PER_CHUNK))
+{
+}
+
+bool AssetChunkCache::find(const QString& file, qint64 chunkIndex, QByteArray& chunk) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _index.find({ file, chunkIndex });
+    if (it == _index.end()) {
+        ++_numMisses;
+        return false;
+    }
+
+    // move to the front
+    _entries.splice(_entries.begin(), _entries, it->second);
+    chunk = it->second->chunk;
+    ++_numHits;
+    _bytesServed += chunk.size();
+    return true;
+}
+
+void AssetChunkCache::insert(const QString& file, qint64 chunkIndex, const QByteArray& chunk) {
+    if (chunk.size() > _capacity) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Key key { file, chunkIndex };
+    if (_index.find(key) != _index.end()) {
+        // another task loaded it at the same time
+        return;
+    }
+
+    auto ghost = _ghostIndex.find(key);
+    if (ghost == _ghostIndex.end()) {
+        // first time around, only remember that it was asked for
+        _ghosts.push_front(key);
+        _ghostIndex[key] = _ghosts.begin();
+        if (_ghosts.size() > _maxGhosts) {
+            _ghostIndex.erase(_ghosts.back());
+            _ghosts.pop_back();
+        }
+        return;
+    }
+
+    _ghosts.erase(ghost->second);
+    _ghostIndex.erase(ghost);
+
+    _entries.push_front({ key, chunk });
+    _index[key] = _entries.begin();
+    _size += chunk.size();
+    ++_numAdmissions;
+
+    evict();
+}
+
+void AssetChunkCache::remove(const QString& file) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->key.file == file) {
+            _size -= it->chunk.size();
+            _index.erase(it->key);
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AssetChunkCache::evict() {
+    while (_size > _capacity && !_entries.empty()) {
+        auto& entry = _entries.back();
+        _size -= entry.chunk.size();
+        _index.erase(entry.key);
+        _entries.pop_back();
+        ++_numEvictions;
+    }
+}
+
+QJsonObject AssetChunkCache::getStats() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    quint64 numLookups = _numHits + _numMisses;
+
+    QJsonObject stats;
+    stats["1. Capacity (MB)"] = (double)_capacity / (1024.0 * 1024.0);
+    stats["2. Size (MB)"] = (double)_size / (1024.0 * 1024.0);
+    stats["3. Chunks"] = (double)_entries.size();
+    stats["4. Hits"] = (double)_numHits;
+    stats["5. Misses"] = (double)_numMisses;
+    stats["6. Hit Ratio"] = numLookups > 0 ? (double)_numHits / (double)numLookups : 0.0;
+    stats["7. Served From Cache (MB)"] = (double)_bytesServed / (1024.0 * 1024.0);
+    stats["8. Admissions"] = (double)_numAdmissions;
+    stats["9. Evictions"] = (double)_numEvictions;
+    return stats;
+}
+
+CachedAssetReader::CachedAssetReader(std::shared_ptr<AssetChunkCache> cache, const QString& filePath,
+                                     const QString& cacheName, qint64 offset, qint64 size) :
+    _cache(cache),
+    _filePath(filePath),
+    _cacheName(cacheName),
+    _position(offset),
+    _end(offset + size)
+{
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+bool CachedAssetReader::loadChunk(qint64 chunkIndex) {
+    _chunkIndex = chunkIndex;
+    if (_cache && _cache->find(_cacheName, chunkIndex, _chunk)) {
+        return true;
+    }
+
+    // always read the whole chunk, so that it can be cached for whatever range is asked for next
+    if (!_file.isOpen()) {
+        _file.setFileName(_filePath);
+        _file.open(QIODevice::ReadOnly);
+    }
+    if (!_file.isOpen() || !_file.seek(chunkIndex * AssetChunkCache::CHUNK_SIZE)) {
+        qCWarning(asset_server) << "Failed to read" << _filePath << "-" << _file.errorString();
+        _chunk.clear();
+        return false;
+    }
+    _chunk = _file.read(AssetChunkCache::CHUNK_SIZE);
+
+    if (_cache) {
+        _cache->insert(_cacheName, chunkIndex, _chunk);
+    }
+    return true;
+}
+
+qint64 CachedAssetReader::readData(char* data, qint64 maxSize) {
+    qint64 numRead = 0;
+
+    while (numRead < maxSize && _position < _end) {
+        qint64 chunkIndex = _position / AssetChunkCache::CHUNK_SIZE;
+        if (chunkIndex != _chunkIndex && !loadChunk(chunkIndex)) {
+            break;
+        }
+
+        qint64 offsetInChunk = _position - chunkIndex * AssetChunkCache::CHUNK_SIZE;
+        qint64 numBytes = std::min({ maxSize - numRead, _end - _position, (qint64)_chunk.size() - offsetInChunk });
+        if (numBytes <= 0) {
+            // the file is shorter than it was when the range was checked
+            break;
+        }
+
+        memcpy(data + numRead, _chunk.constData() + offsetInChunk, numBytes);
+        numRead += numBytes;
+        _position += numBytes;
+    }
+
+    return numRead > 0 || _position >= _end ? numRead : -1;
+}
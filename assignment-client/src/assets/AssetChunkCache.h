@@ -0,0 +1,113 @@
+//
+//  AssetChunkCache.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkCache_h
+#define hifi_AssetChunkCache_h
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+/// In-memory LRU cache of fixed size chunks of asset files, shared by every send task.
+///
+/// A chunk is only admitted the second time it is asked for within a while, so that a one-off download of a large
+/// asset streams past the cache instead of evicting everything that is actually popular.
+class AssetChunkCache {
+public:
+    static const qint64 CHUNK_SIZE;
+
+    AssetChunkCache(qint64 capacity);
+
+    /// \param file asset file name (hash, plus a suffix for variants)
+    /// \return whether the chunk was found
+    bool find(const QString& file, qint64 chunkIndex, QByteArray& chunk);
+    void insert(const QString& file, qint64 chunkIndex, const QByteArray& chunk);
+
+    /// drops every chunk of file, e.g. once it was deleted
+    void remove(const QString& file);
+
+    QJsonObject getStats();
+
+private:
+    struct Key {
+        QString file;
+        qint64 chunkIndex;
+        bool operator==(const Key& other) const { return chunkIndex == other.chunkIndex && file == other.file; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const { return qHash(key.file) ^ std::hash<qint64>()(key.chunkIndex); }
+    };
+    struct Entry {
+        Key key;
+        QByteArray chunk;
+    };
+    using Entries = std::list<Entry>;
+    using Keys = std::list<Key>;
+
+    void evict(); // requires _mutex
+
+    const qint64 _capacity;
+    const size_t _maxGhosts;
+
+    std::mutex _mutex;
+    Entries _entries; // most recently used first
+    std::unordered_map<Key, Entries::iterator, KeyHash> _index;
+    Keys _ghosts; // chunks that missed recently, most recent first
+    std::unordered_map<Key, Keys::iterator, KeyHash> _ghostIndex;
+    qint64 _size { 0 };
+
+    // stats, guarded by _mutex
+    quint64 _numHits { 0 };
+    quint64 _numMisses { 0 };
+    quint64 _numAdmissions { 0 };
+    quint64 _numEvictions { 0 };
+    quint64 _bytesServed { 0 };
+};
+
+/// Reads a byte range of an asset file through an AssetChunkCache, one chunk at a time.
+/// Used as the stream source of asset replies, so the reads happen as the packets are sent.
+class CachedAssetReader : public QIODevice {
+    Q_OBJECT
+public:
+    CachedAssetReader(std::shared_ptr<AssetChunkCache> cache, const QString& filePath, const QString& cacheName,
+                      qint64 offset, qint64 size);
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return _end - _position + QIODevice::bytesAvailable(); }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override;
+    qint64 writeData(const char* data, qint64 maxSize) override { return -1; }
+
+private:
+    bool loadChunk(qint64 chunkIndex);
+
+    std::shared_ptr<AssetChunkCache> _cache;
+    QString _filePath;
+    QFile _file; // only opened on a cache miss
+    QString _cacheName;
+    qint64 _position;
+    qint64 _end;
+
+    qint64 _chunkIndex { -1 };
+    QByteArray _chunk;
+};
+
+#endif // hifi_AssetChunkCache_h
@@ -0,0 +1,293 @@
+//
+//  AssetMappingStore.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMappingStore.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+
+const qint64 AssetMappingStore::MIN_COMPACTION_JOURNAL_SIZE = 1024 * 1024;
+
+// each journal record is the payload size, the MD5 of the payload, then the payload:
+// the number of operations followed by a path and hash for each (an empty hash removes the path)
+static const int RECORD_CHECKSUM_SIZE = 16;
+static const int RECORD_HEADER_SIZE = sizeof(quint32) + RECORD_CHECKSUM_SIZE;
+
+AssetMappingStore::~AssetMappingStore() {
+    if (_journal.isOpen()) {
+        _journal.close();
+    }
+}
+
+bool AssetMappingStore::load(const QString& snapshotPath, const QString& journalPath) {
+    _snapshotPath = snapshotPath;
+    _journalPath = journalPath;
+    _mappings.clear();
+    _hashReferences.clear();
+
+    if (!readSnapshot()) {
+        return false;
+    }
+
+    replayJournal();
+
+    if (!openJournal()) {
+        qCCritical(asset_server) << "Failed to open mapping journal at" << _journalPath;
+        return false;
+    }
+
+    qCInfo(asset_server) << "Loaded" << _mappings.size() << "mappings from" << _snapshotPath << "and" << _journalPath;
+
+    maybeCompact();
+    return true;
+}
+
+bool AssetMappingStore::readSnapshot() {
+    QFile mapFile { _snapshotPath };
+    if (!mapFile.exists()) {
+        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << _snapshotPath;
+        _snapshotSize = 0;
+        return true;
+    }
+
+    if (mapFile.open(QIODevice::ReadOnly)) {
+        QJsonParseError error;
+
+        auto data = mapFile.readAll();
+        auto jsonDocument = QJsonDocument::fromJson(data, &error);
+
+        if (error.error == QJsonParseError::NoError) {
+            if (!jsonDocument.isObject()) {
+                qCWarning(asset_server) << "Failed to read mapping file, root value in" << _snapshotPath << "is not an object";
+                return false;
+            }
+
+            auto root = jsonDocument.object();
+            for (auto it = root.begin(); it != root.end(); ++it) {
+                auto key = it.key();
+                auto value = it.value();
+
+                if (!value.isString()) {
+                    qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
+                    continue;
+                }
+
+                if (!isValidFilePath(key)) {
+                    qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
+                    continue;
+                }
+
+                if (!isValidHash(value.toString())) {
+                    qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
+                    continue;
+                }
+
+                apply({ key, value.toString() });
+            }
+
+            _snapshotSize = data.size();
+            return true;
+        }
+    }
+
+    qCCritical(asset_server) << "Failed to read mapping file at" << _snapshotPath;
+    return false;
+}
+
+void AssetMappingStore::replayJournal() {
+    QFile journal { _journalPath };
+    if (!journal.exists() || !journal.open(QIODevice::ReadWrite)) {
+        return;
+    }
+
+    QDataStream stream(&journal);
+    qint64 validSize = 0;
+    int numRecords = 0;
+
+    while (journal.bytesAvailable() >= RECORD_HEADER_SIZE) {
+        quint32 payloadSize;
+        stream >> payloadSize;
+        QByteArray checksum = journal.read(RECORD_CHECKSUM_SIZE);
+        QByteArray payload = journal.read(payloadSize);
+
+        if (payload.size() != (int)payloadSize || QCryptographicHash::hash(payload, QCryptographicHash::Md5) != checksum) {
+            break;
+        }
+
+        QDataStream payloadStream(payload);
+        quint32 numOperations;
+        payloadStream >> numOperations;
+        Transaction transaction;
+        for (quint32 i = 0; i < numOperations && payloadStream.status() == QDataStream::Ok; ++i) {
+            Transaction::Operation operation;
+            payloadStream >> operation.path >> operation.hash;
+            transaction._operations.push_back(operation);
+        }
+        if (payloadStream.status() != QDataStream::Ok) {
+            break;
+        }
+
+        for (const auto& operation : transaction._operations) {
+            apply(operation);
+        }
+        validSize = journal.pos();
+        ++numRecords;
+    }
+
+    if (validSize < journal.size()) {
+        // the tail was torn by a crash in the middle of a commit, which was never acknowledged
+        qCWarning(asset_server) << "Dropping" << journal.size() - validSize << "bytes of incomplete mapping journal at"
+            << _journalPath;
+        journal.resize(validSize);
+    }
+
+    if (numRecords > 0) {
+        qCDebug(asset_server) << "Replayed" << numRecords << "mapping transactions from" << _journalPath;
+    }
+}
+
+bool AssetMappingStore::openJournal() {
+    _journal.setFileName(_journalPath);
+    if (!_journal.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+    _journalSize = _journal.size();
+    return true;
+}
+
+bool AssetMappingStore::appendToJournal(const QByteArray& record) {
+    if (!_journal.isOpen()) {
+        return false;
+    }
+
+    if (_journal.write(record) != record.size() || !_journal.flush()) {
+        // don't leave a partial record behind for the next commit to follow
+        _journal.resize(_journalSize);
+        return false;
+    }
+
+    _journalSize += record.size();
+    return true;
+}
+
+bool AssetMappingStore::commit(const Transaction& transaction) {
+    if (transaction.isEmpty()) {
+        return true;
+    }
+
+    QByteArray payload;
+    QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+    payloadStream << (quint32)transaction._operations.size();
+    for (const auto& operation : transaction._operations) {
+        payloadStream << operation.path << operation.hash;
+    }
+
+    QByteArray record;
+    QDataStream recordStream(&record, QIODevice::WriteOnly);
+    recordStream << (quint32)payload.size();
+    record.append(QCryptographicHash::hash(payload, QCryptographicHash::Md5));
+    record.append(payload);
+
+    if (!appendToJournal(record)) {
+        qCWarning(asset_server) << "Failed to append" << transaction.size() << "mapping operations to" << _journalPath;
+        return false;
+    }
+
+    for (const auto& operation : transaction._operations) {
+        apply(operation);
+    }
+
+    maybeCompact();
+    return true;
+}
+
+void AssetMappingStore::apply(const Transaction::Operation& operation) {
+    auto it = _mappings.find(operation.path);
+    if (it != _mappings.end()) {
+        auto reference = _hashReferences.find(it->second);
+        if (reference != _hashReferences.end() && --reference.value() == 0) {
+            _hashReferences.erase(reference);
+        }
+
+        if (operation.hash.isEmpty()) {
+            _mappings.erase(it);
+            return;
+        }
+        it->second = operation.hash;
+    } else if (operation.hash.isEmpty()) {
+        return;
+    } else {
+        _mappings.emplace(operation.path, operation.hash);
+    }
+    ++_hashReferences[operation.hash];
+}
+
+std::pair<AssetMappingStore::const_iterator, AssetMappingStore::const_iterator>
+AssetMappingStore::getPrefixRange(const AssetPath& prefix) const {
+    if (prefix.isEmpty()) {
+        return { _mappings.cbegin(), _mappings.cend() };
+    }
+
+    auto first = _mappings.lower_bound(prefix);
+
+    // every path with the prefix sorts before the prefix with its last character bumped
+    auto lastCharacter = prefix.at(prefix.size() - 1).unicode();
+    if (lastCharacter == std::numeric_limits<ushort>::max()) {
+        auto last = first;
+        while (last != _mappings.cend() && last->first.startsWith(prefix)) {
+            ++last;
+        }
+        return { first, last };
+    }
+
+    AssetPath bound = prefix;
+    bound[prefix.size() - 1] = QChar(lastCharacter + 1);
+    return { first, _mappings.lower_bound(bound) };
+}
+
+void AssetMappingStore::maybeCompact() {
+    if (_journalSize < std::max(MIN_COMPACTION_JOURNAL_SIZE, _snapshotSize)) {
+        return;
+    }
+
+    // the snapshot is replaced atomically, and a crash before the journal is cleared
+    // only means replaying changes that the new snapshot already has
+    if (writeSnapshot() && _journal.resize(0)) {
+        _journalSize = 0;
+        ++_numCompactions;
+        qCDebug(asset_server) << "Compacted" << _mappings.size() << "mappings into" << _snapshotPath;
+    } else {
+        qCWarning(asset_server) << "Failed to compact mappings into" << _snapshotPath;
+    }
+}
+
+bool AssetMappingStore::writeSnapshot() {
+    QJsonObject root;
+    for (const auto& mapping : _mappings) {
+        root[mapping.first] = mapping.second;
+    }
+    auto data = QJsonDocument(root).toJson();
+
+    QSaveFile mapFile { _snapshotPath };
+    if (mapFile.open(QIODevice::WriteOnly) && mapFile.write(data) == data.size() && mapFile.commit()) {
+        _snapshotSize = data.size();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,101 @@
+//
+//  AssetMappingStore.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMappingStore_h
+#define hifi_AssetMappingStore_h
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+
+#include "AssetUtils.h"
+
+/// Path => hash mappings of the asset server, persisted as a JSON snapshot plus an append-only journal.
+///
+/// Changes are batched in a Transaction and committed atomically: the transaction is appended to the journal as a
+/// single checksummed record before it is applied in memory, so a commit costs the size of the change rather
+/// than the size of the table. A record torn by a crash fails its checksum and is dropped on the next load.
+/// Once the journal outgrows the snapshot, both are folded into a new snapshot.
+///
+/// Must only be used from the asset server's main thread.
+class AssetMappingStore {
+public:
+    using Mappings = std::map<AssetPath, AssetHash>;
+    using const_iterator = Mappings::const_iterator;
+
+    class Transaction {
+    public:
+        void set(const AssetPath& path, const AssetHash& hash) { _operations.push_back({ path, hash }); }
+        void remove(const AssetPath& path) { _operations.push_back({ path, AssetHash() }); }
+
+        bool isEmpty() const { return _operations.empty(); }
+        size_t size() const { return _operations.size(); }
+
+    private:
+        friend class AssetMappingStore;
+
+        struct Operation {
+            AssetPath path;
+            AssetHash hash; // empty for a removal
+        };
+        std::vector<Operation> _operations;
+    };
+
+    static const qint64 MIN_COMPACTION_JOURNAL_SIZE;
+
+    ~AssetMappingStore();
+
+    /// Loads the snapshot and replays the journal over it. Returns false if the snapshot can't be read.
+    bool load(const QString& snapshotPath, const QString& journalPath);
+
+    /// Applies every operation of transaction, or none of them if it could not be persisted
+    bool commit(const Transaction& transaction);
+
+    const_iterator begin() const { return _mappings.cbegin(); }
+    const_iterator end() const { return _mappings.cend(); }
+    const_iterator find(const AssetPath& path) const { return _mappings.find(path); }
+    size_t size() const { return _mappings.size(); }
+
+    /// The first mapping whose path sorts after path
+    const_iterator upperBound(const AssetPath& path) const { return _mappings.upper_bound(path); }
+
+    /// The mappings whose path starts with prefix, in path order
+    std::pair<const_iterator, const_iterator> getPrefixRange(const AssetPath& prefix) const;
+
+    /// Whether any path is mapped to hash
+    bool isMapped(const AssetHash& hash) const { return _hashReferences.contains(hash); }
+
+    qint64 getJournalSize() const { return _journalSize; }
+    int getNumCompactions() const { return _numCompactions; }
+
+private:
+    void apply(const Transaction::Operation& operation);
+    bool readSnapshot();
+    void replayJournal();
+    bool openJournal();
+    bool appendToJournal(const QByteArray& record);
+    void maybeCompact();
+    bool writeSnapshot();
+
+    Mappings _mappings;
+    QHash<AssetHash, int> _hashReferences;
+
+    QString _snapshotPath;
+    QString _journalPath;
+    QFile _journal;
+    qint64 _journalSize { 0 };
+    qint64 _snapshotSize { 0 };
+    int _numCompactions { 0 };
+};
+
+#endif // hifi_AssetMappingStore_h
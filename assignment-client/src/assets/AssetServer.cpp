@@ -14,6 +14,7 @@
 
 #include <thread>
 #include <memory>
+#include <limits>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCryptographicHash>
@@ -36,6 +37,7 @@
 
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
+#include "CompressAssetTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
 
@@ -54,6 +56,9 @@ static QStringList BAKEABLE_TEXTURE_EXTENSIONS;
 static const QString BAKED_MODEL_SIMPLE_NAME = "asset.fbx";
 static const QString BAKED_TEXTURE_SIMPLE_NAME = "texture.ktx";
 
+// text based formats that are worth sending compressed
+static const QStringList COMPRESSIBLE_EXTENSIONS = { "fbx", "obj", "fst", "json", "js" };
+
 void AssetServer::bakeAsset(const AssetHash& assetHash, const AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
@@ -125,14 +130,41 @@ std::pair<BakingStatus, QString> AssetServer::getAssetStatus(const AssetPath& pa
 }
 
 void AssetServer::bakeAssets() {
-    auto it = _fileMappings.cbegin();
-    for (; it != _fileMappings.cend(); ++it) {
+    auto it = _fileMappings.begin();
+    for (; it != _fileMappings.end(); ++it) {
         auto path = it->first;
         auto hash = it->second;
+        maybeCompress(path, hash);
         maybeBake(path, hash);
     }
 }
 
+void AssetServer::maybeCompress(const AssetPath& path, const AssetHash& hash) {
+    auto extension = path.mid(path.lastIndexOf('.') + 1).toLower();
+    if (!COMPRESSIBLE_EXTENSIONS.contains(extension) || _queuedCompressions.contains(hash)) {
+        return;
+    }
+
+    // decided by this run or an earlier one
+    if (_compressedAssets.getDecision(hash) != CompressedAssetStore::Decision::Unknown) {
+        return;
+    }
+
+    _queuedCompressions.insert(hash);
+    _compressionTaskPool.start(new CompressAssetTask(_compressedAssets, hash, getPathToAssetHash(hash)));
+}
+
+void AssetServer::removeDerivedCopies(const AssetHash& hash) {
+    // the compressed copy may be left from a previous run, before this run's assets were compressed
+    _queuedCompressions.remove(hash);
+    _compressedAssets.remove(hash);
+
+    if (_chunkCache) {
+        _chunkCache->remove(hash);
+        _chunkCache->remove(hash + COMPRESSED_ASSET_SUFFIX);
+    }
+}
+
 void AssetServer::maybeBake(const AssetPath& path, const AssetHash& hash) {
     if (needsToBeBaked(path, hash)) {
         qDebug() << "Queuing bake of: " << path;
@@ -228,6 +260,7 @@ void updateConsumedCores() {
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
+    _compressionTaskPool(this),
     _bakingTaskPool(this)
 {
     // store the current state of image compression so we can reset it when this assignment is complete
@@ -250,6 +283,7 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
     _bakingTaskPool.setMaxThreadCount(1);
+    _compressionTaskPool.setMaxThreadCount(1);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListener(PacketType::AssetGet, this, "handleAssetGet");
@@ -315,6 +349,9 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_COMPRESSED_FILES_SUBDIR = "compressed";
+static const QString MAP_FILE_NAME = "map.json";
+static const QString MAP_JOURNAL_FILE_NAME = "map.journal";
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -366,6 +403,13 @@ void AssetServer::completeSetup() {
 
     _resourcesDirectory = QDir(absoluteFilePath);
 
+    static const QString CHUNK_CACHE_SIZE_OPTION = "chunk_cache_size";
+    static const int DEFAULT_CHUNK_CACHE_SIZE_MB = 256;
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto chunkCacheSize = assetServerObject[CHUNK_CACHE_SIZE_OPTION].toInt(DEFAULT_CHUNK_CACHE_SIZE_MB);
+    _chunkCache = std::make_shared<AssetChunkCache>(std::max(chunkCacheSize, 0) * BYTES_PER_MEGABYTE);
+    qCInfo(asset_server) << "Caching up to" << chunkCacheSize << "MB of hot asset data in memory.";
+
     qCDebug(asset_server) << "Creating resources directory";
     _resourcesDirectory.mkpath(".");
     _filesDirectory = _resourcesDirectory;
@@ -376,8 +420,18 @@ void AssetServer::completeSetup() {
         return;
     }
 
-    // load whatever mappings we currently have from the local file
-    if (loadMappingsFromFile()) {
+    QDir compressedDirectory = _resourcesDirectory;
+    if (!_resourcesDirectory.mkpath(ASSET_COMPRESSED_FILES_SUBDIR) || !compressedDirectory.cd(ASSET_COMPRESSED_FILES_SUBDIR)) {
+        qCCritical(asset_server) << "Unable to create compressed file directory for asset-server files. Stopping assignment.";
+        setFinished(true);
+        return;
+    }
+    _compressedAssets = CompressedAssetStore(compressedDirectory);
+
+    // load whatever mappings we currently have from the local files
+    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
+    auto mapJournalPath = _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME);
+    if (_fileMappings.load(mapFilePath, mapJournalPath)) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
 
         // Check the asset directory to output some information about what we have
@@ -411,20 +465,14 @@ void AssetServer::cleanupUnmappedFiles() {
     for (const auto& fileInfo : files) {
         auto filename = fileInfo.fileName();
         if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
+            if (!_fileMappings.isMapped(filename)) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
+                    removeDerivedCopies(filename);
                     removeBakedPathsForDeletedAsset(filename);
                 } else {
                     qCDebug(asset_server) << "\tAttempt to delete unmapped file" << filename << "failed";
@@ -432,6 +480,9 @@ void AssetServer::cleanupUnmappedFiles() {
             }
         }
     }
+
+    // compressed copies whose asset is already gone, e.g. removed while a previous run was still compressing it
+    _compressedAssets.removeOrphans(_filesDirectory);
 }
 
 void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -547,13 +598,39 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, SharedNode
 }
 
 void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket) {
-    replyPacket.writePrimitive(AssetServerError::NoError);
+    auto first = _fileMappings.begin();
+    auto last = _fileMappings.end();
+    uint32_t maxCount = std::numeric_limits<uint32_t>::max();
+
+    // clients that page through the mappings send the folder to list, where to resume and how many to send
+    bool isPaged = message.getBytesLeftToRead() > 0;
+    if (isPaged) {
+        AssetPath prefix = message.readString();
+        AssetPath startAfter = message.readString();
+        message.readPrimitive(&maxCount);
+
+        std::tie(first, last) = _fileMappings.getPrefixRange(prefix);
+        if (first != last && !startAfter.isEmpty() && startAfter >= first->first) {
+            first = _fileMappings.upperBound(startAfter);
+            if (first != last && !first->first.startsWith(prefix)) {
+                // resuming past the end of the folder
+                first = last;
+            }
+        }
+    }
 
-    uint32_t count = (uint32_t)_fileMappings.size();
+    uint32_t count = 0;
+    auto pageEnd = first;
+    while (pageEnd != last && count < maxCount) {
+        ++pageEnd;
+        ++count;
+    }
+
+    replyPacket.writePrimitive(AssetServerError::NoError);
 
     replyPacket.writePrimitive(count);
 
-    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
+    for (auto it = first; it != pageEnd; ++it) {
         auto mapping = it->first;
         auto hash = it->second;
         replyPacket.writeString(mapping);
@@ -567,6 +644,11 @@ void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, SharedN
             replyPacket.writeString(lastBakeErrors);
         }
     }
+
+    if (isPaged) {
+        // where the next page starts, or nothing if this was the last one
+        replyPacket.writeString(pageEnd != last && count > 0 ? std::prev(pageEnd)->first : AssetPath());
+    }
 }
 
 void AssetServer::handleSetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket) {
@@ -712,7 +794,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _compressedAssets.getDirectory(), _chunkCache);
     _transferTaskPool.start(task);
 }
 
@@ -808,93 +890,12 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
-    // send off the stats packets
-    ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
-}
-
-static const QString MAP_FILE_NAME = "map.json";
-
-bool AssetServer::loadMappingsFromFile() {
-
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.exists()) {
-        if (mapFile.open(QIODevice::ReadOnly)) {
-            QJsonParseError error;
-
-            auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
-
-            if (error.error == QJsonParseError::NoError) {
-                if (!jsonDocument.isObject()) {
-                    qCWarning(asset_server) << "Failed to read mapping file, root value in" << mapFilePath << "is not an object";
-                    return false;
-                }
-
-                //_fileMappings = jsonDocument.object().toVariantHash();
-                auto root = jsonDocument.object();
-                for (auto it = root.begin(); it != root.end(); ++it) {
-                    auto key = it.key();
-                    auto value = it.value();
-
-                    if (!value.isString()) {
-                        qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
-                        continue;
-                    }
-
-                    if (!isValidFilePath(key)) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
-                        continue;
-                    }
-
-                    if (!isValidHash(value.toString())) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
-                        continue;
-                    }
-
-
-                    qDebug() << "Added " << key << value.toString();
-                    _fileMappings[key] = value.toString();
-                }
-
-                qCInfo(asset_server) << "Loaded" << _fileMappings.size() << "mappings from map file at" << mapFilePath;
-                return true;
-            }
-        }
-
-        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
-        return false;
-    } else {
-        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
+    if (_chunkCache) {
+        serverStats["Chunk Cache"] = _chunkCache->getStats();
     }
 
-    return true;
-}
-
-bool AssetServer::writeMappingsToFile() {
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.open(QIODevice::WriteOnly)) {
-        QJsonObject root;
-
-        for (auto it : _fileMappings) {
-            root[it.first] = it.second;
-        }
-
-        QJsonDocument jsonDocument { root };
-
-        if (mapFile.write(jsonDocument.toJson()) != -1) {
-            qCDebug(asset_server) << "Wrote JSON mappings to file at" << mapFilePath;
-            return true;
-        } else {
-            qCWarning(asset_server) << "Failed to write JSON mappings to file at" << mapFilePath;
-        }
-    } else {
-        qCWarning(asset_server) << "Failed to open map file at" << mapFilePath;
-    }
-
-    return false;
+    // send off the stats packets
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
 
 bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
@@ -910,27 +911,17 @@ bool AssetServer::setMapping(AssetPath path, AssetHash hash) {
         return false;
     }
 
-    // remember what the old mapping was in case persistence fails
-    auto it = _fileMappings.find(path);
-    auto oldMapping = it != _fileMappings.end() ? it->second : "";
-
-    // update the in memory QHash
-    _fileMappings[path] = hash;
+    AssetMappingStore::Transaction transaction;
+    transaction.set(path, hash);
 
-    // attempt to write to file
-    if (writeMappingsToFile()) {
+    // attempt to persist the mapping, it is only applied in memory if that succeeds
+    if (_fileMappings.commit(transaction)) {
         // persistence succeeded, we are good to go
         qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
+        maybeCompress(path, hash);
         maybeBake(path, hash);
         return true;
     } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.erase(_fileMappings.find(path));
-        } else {
-            _fileMappings[path] = oldMapping;
-        }
-
         qCWarning(asset_server) << "Failed to persist mapping:" << path << "=>" << hash;
 
         return false;
@@ -954,35 +945,30 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetHash hash) {
 }
 
 bool AssetServer::deleteMappings(const AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
+    AssetMappingStore::Transaction transaction;
 
     QSet<QString> hashesToCheckForDeletion;
 
-    // enumerate the paths to delete and remove them all
+    // enumerate the paths to delete and remove them all in one transaction
     for (const auto& rawPath : paths) {
         auto path = rawPath.trimmed();
 
         // figure out if this path will delete a file or folder
         if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
-            auto sizeBefore = _fileMappings.size();
+            // remove everything below the folder
+            auto range = _fileMappings.getPrefixRange(path);
+            auto sizeBefore = transaction.size();
 
-            while (it != _fileMappings.end()) {
-                if (it->first.startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it->second;
+            for (auto it = range.first; it != range.second; ++it) {
+                // add this hash to the list we need to check for asset removal from the server
+                hashesToCheckForDeletion << it->second;
 
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
+                transaction.remove(it->first);
             }
 
-            auto sizeNow = _fileMappings.size();
-            if (sizeBefore != sizeNow) {
-                qCDebug(asset_server) << "Deleted" << sizeBefore - sizeNow << "mappings in folder: " << path;
+            auto numDeleted = transaction.size() - sizeBefore;
+            if (numDeleted > 0) {
+                qCDebug(asset_server) << "Deleting" << numDeleted << "mappings in folder: " << path;
             } else {
                 qCDebug(asset_server) << "Did not find any mappings to delete in folder:" << path;
             }
@@ -993,35 +979,32 @@ bool AssetServer::deleteMappings(const AssetPathList& paths) {
                 // add this hash to the list we need to check for asset removal from server
                 hashesToCheckForDeletion << it->second;
 
-                qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << it->second;
-                
-                _fileMappings.erase(it);
+                qCDebug(asset_server) << "Deleting a mapping:" << path << "=>" << it->second;
+
+                transaction.remove(path);
             } else {
                 qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
             }
         }
     }
 
-    // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
+    // attempt to persist the deletes, they are only applied in memory if that succeeds
+    if (_fileMappings.commit(transaction)) {
         // persistence succeeded we are good to go
 
-        // TODO iterate through hashesToCheckForDeletion instead
-        for (auto& pair : _fileMappings) {
-            auto it = hashesToCheckForDeletion.find(pair.second);
-            if (it != hashesToCheckForDeletion.end()) {
-                hashesToCheckForDeletion.erase(it);
+        // we now have a set of hashes that may be unmapped - we will delete those asset files
+        for (auto& hash : hashesToCheckForDeletion) {
+            if (_fileMappings.isMapped(hash)) {
+                continue;
             }
-        }
 
-        // we now have a set of hashes that are unmapped - we will delete those asset files
-        for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
+                removeDerivedCopies(hash);
                 removeBakedPathsForDeletedAsset(hash);
             } else {
                 qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
@@ -1030,10 +1013,7 @@ bool AssetServer::deleteMappings(const AssetPathList& paths) {
 
         return true;
     } else {
-        qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
-
-        // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
+        qCWarning(asset_server) << "Failed to persist deleted mappings";
 
         return false;
     }
@@ -1059,35 +1039,26 @@ bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
             return false;
         }
 
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
-
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
+        AssetMappingStore::Transaction transaction;
 
-        while (it != oldMappings.end()) {
-            auto& oldKey = it->first;
-            if (oldKey.startsWith(oldPath)) {
-                auto newKey = oldKey;
-                newKey.replace(0, oldPath.size(), newPath);
-
-                // remove the old version from the in memory file mappings
-                _fileMappings.erase(_fileMappings.find(oldKey));
-                _fileMappings[newKey] = it->second;
-            }
-
-            ++it;
+        // move every mapping below the renamed folder - removing all of the old paths first,
+        // since some of them may also be new paths when one folder is nested in the other
+        auto range = _fileMappings.getPrefixRange(oldPath);
+        for (auto it = range.first; it != range.second; ++it) {
+            transaction.remove(it->first);
+        }
+        for (auto it = range.first; it != range.second; ++it) {
+            auto newKey = it->first;
+            newKey.replace(0, oldPath.size(), newPath);
+            transaction.set(newKey, it->second);
         }
 
-        if (writeMappingsToFile()) {
+        if (_fileMappings.commit(transaction)) {
             // persisted the changed mappings, return success
             qCDebug(asset_server) << "Renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return true;
         } else {
-            // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
-
             qCWarning(asset_server) << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return false;
@@ -1100,40 +1071,24 @@ bool AssetServer::renameMapping(AssetPath oldPath, AssetPath newPath) {
             return false;
         }
 
-        // take the old hash to remove the old mapping
         auto it = _fileMappings.find(oldPath);
-        auto oldSourceMapping = it->second;
-        _fileMappings.erase(it);
-
-        // in case we're overwriting, keep the current destination mapping for potential rollback
-        auto oldDestinationIt = _fileMappings.find(newPath);
+        if (it == _fileMappings.end()) {
+            // failed to find a mapping that was to be renamed, return failure
+            return false;
+        }
 
-        if (!oldSourceMapping.isEmpty()) {
-            _fileMappings[newPath] = oldSourceMapping;
+        AssetMappingStore::Transaction transaction;
+        transaction.remove(oldPath);
+        transaction.set(newPath, it->second);
 
-            if (writeMappingsToFile()) {
-                // persisted the renamed mapping, return success
-                qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
+        if (_fileMappings.commit(transaction)) {
+            // persisted the renamed mapping, return success
+            qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
 
-                return true;
-            } else {
-                // we couldn't persist the renamed mapping, rollback and return failure
-                _fileMappings[oldPath] = oldSourceMapping;
-
-                if (oldDestinationIt != _fileMappings.end()) {
-                    // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationIt->second;
-                } else {
-                    // clear the new mapping
-                    _fileMappings.erase(_fileMappings.find(newPath));
-                }
-
-                qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
-
-                return false;
-            }
+            return true;
         } else {
-            // failed to find a mapping that was to be renamed, return failure
+            qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
+
             return false;
         }
     }
@@ -18,7 +18,10 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetChunkCache.h"
+#include "AssetMappingStore.h"
 #include "AssetUtils.h"
+#include "CompressedAssetStore.h"
 #include "ReceivedMessage.h"
 
 
@@ -61,8 +64,6 @@ private slots:
     void sendStatsPacket() override;
 
 private:
-    using Mappings = std::unordered_map<QString, QString>;
-
     void handleGetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
     void handleGetAllMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
@@ -70,10 +71,6 @@ private:
     void handleRenameMappingOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
     void handleSetBakingEnabledOperation(ReceivedMessage& message, SharedNodePointer senderNode, NLPacketList& replyPacket);
 
-    // Mapping file operations must be called from main assignment thread only
-    bool loadMappingsFromFile();
-    bool writeMappingsToFile();
-
     /// Set the mapping for path to hash
     bool setMapping(AssetPath path, AssetHash hash);
 
@@ -88,6 +85,11 @@ private:
     /// Delete any unmapped files from the local asset directory
     void cleanupUnmappedFiles();
 
+    /// Queue writing a compressed variant of the asset if it is of a type that compresses well
+    void maybeCompress(const AssetPath& path, const AssetHash& hash);
+    /// Remove the compressed variant, compression decision and cached chunks of an asset file that was deleted
+    void removeDerivedCopies(const AssetHash& hash);
+
     QString getPathToAssetHash(const AssetHash& assetHash);
 
     std::pair<BakingStatus, QString> getAssetStatus(const AssetPath& path, const AssetHash& hash);
@@ -111,7 +113,8 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetHash originalAssetHash);
 
-    Mappings _fileMappings;
+    // Mapping operations must be called from main assignment thread only
+    AssetMappingStore _fileMappings;
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
@@ -119,6 +122,13 @@ private:
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    /// Hot chunks of asset files, shared by the download tasks
+    std::shared_ptr<AssetChunkCache> _chunkCache;
+
+    CompressedAssetStore _compressedAssets;
+    QSet<AssetHash> _queuedCompressions;
+    QThreadPool _compressionTaskPool;
+
     QHash<AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
@@ -0,0 +1,39 @@
+//
+//  CompressAssetTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CompressAssetTask.h"
+
+#include <QtCore/QFileInfo>
+
+#include "AssetServerLogging.h"
+
+CompressAssetTask::CompressAssetTask(const CompressedAssetStore& store, const AssetHash& hash, const QString& filePath) :
+    _store(store),
+    _hash(hash),
+    _filePath(filePath)
+{
+}
+
+void CompressAssetTask::run() {
+    auto size = QFileInfo(_filePath).size();
+    switch (_store.compress(_hash, _filePath)) {
+        case CompressedAssetStore::Decision::Compressed:
+            qCDebug(asset_server) << "Compressed" << _filePath << "-" << size << "=>"
+                << QFileInfo(_store.getCompressedFilePath(_hash)).size() << "bytes";
+            break;
+        case CompressedAssetStore::Decision::NotWorthIt:
+            qCDebug(asset_server) << "Not keeping compressed variant of" << _filePath << "-" << size << "bytes";
+            break;
+        default:
+            qCWarning(asset_server) << "Failed to write compressed variant of" << _filePath;
+            break;
+    }
+}
@@ -0,0 +1,34 @@
+//
+//  CompressAssetTask.h
+//  assignment-client/src/assets
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompressAssetTask_h
+#define hifi_CompressAssetTask_h
+
+#include <QtCore/QRunnable>
+#include <QtCore/QString>
+
+#include <CompressedAssetStore.h>
+
+/// Writes the zlib compressed variant of an asset file, which is served to clients that accept it.
+/// Only a record of the decision is written if compression wouldn't save much.
+class CompressAssetTask : public QRunnable {
+public:
+    CompressAssetTask(const CompressedAssetStore& store, const AssetHash& hash, const QString& filePath);
+
+    void run() override;
+
+private:
+    CompressedAssetStore _store;
+    AssetHash _hash;
+    QString _filePath;
+};
+
+#endif // hifi_CompressAssetTask_h
@@ -12,8 +12,10 @@
 #include "SendAssetTask.h"
 
 #include <cmath>
+#include <memory>
 
 #include <QFile>
+#include <QFileInfo>
 
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
@@ -22,15 +24,19 @@
 #include <NodeList.h>
 #include <udt/Packet.h>
 
+#include "AssetChunkCache.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             const QDir& compressedDir, std::shared_ptr<AssetChunkCache> cache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _compressedDir(compressedDir),
+    _cache(cache)
 {
     
 }
@@ -47,6 +53,9 @@ void SendAssetTask::run() {
     // starting at index 1.
     _message->readPrimitive(&byteRange.fromInclusive);
     _message->readPrimitive(&byteRange.toExclusive);
+
+    uint8_t acceptedEncodings = 1 << (uint8_t)AssetEncoding::Identity;
+    _message->readPrimitive(&acceptedEncodings);
     
     QString hexHash = assetHash.toHex();
     
@@ -64,17 +73,39 @@ void SendAssetTask::run() {
         replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        QString cacheName = hexHash;
+        AssetEncoding encoding = AssetEncoding::Identity;
+
+        QFileInfo fileInfo { filePath };
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (fileInfo.isFile() && fileInfo.isReadable()) {
+            auto fileSize = fileInfo.size();
+
+            // a range that starts in the file but runs past its end is cut short, so that a client can ask for the
+            // first part of an asset without knowing its size; a reply shorter than asked for holds the whole asset
+            if ((byteRange.fromInclusive < fileSize || byteRange.fromInclusive == 0) && byteRange.toExclusive > fileSize) {
+                byteRange.toExclusive = fileSize;
+            }
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
+
+            // whole files are sent compressed to the clients that accept it, if that was worth it for this asset
+            bool acceptsZlib = acceptedEncodings & (1 << (uint8_t)AssetEncoding::Zlib);
+            if (acceptsZlib && byteRange.fromInclusive == 0 && byteRange.toExclusive == fileSize) {
+                QFileInfo compressedFileInfo { _compressedDir.filePath(QString(hexHash)) };
+                if (compressedFileInfo.isFile() && compressedFileInfo.isReadable()) {
+                    filePath = compressedFileInfo.filePath();
+                    cacheName = hexHash + COMPRESSED_ASSET_SUFFIX;
+                    encoding = AssetEncoding::Zlib;
+                    fileSize = compressedFileInfo.size();
+                    byteRange.toExclusive = fileSize;
+                }
+            }
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +113,20 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
+                // a positive range starts that far into the file, a negative one that far back from its end
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
 
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                replyPacketList->writePrimitive(AssetServerError::NoError);
+                replyPacketList->writePrimitive(encoding);
+                replyPacketList->writePrimitive(size);
 
-                    replyPacketList->writePrimitive(AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+                // stream the range into the reply packets as the connection is ready for them, through the chunk
+                // cache, rather than holding all of it in memory
+                std::unique_ptr<QIODevice> reader { new CachedAssetReader(_cache, filePath, cacheName, offset, size) };
+                replyPacketList->setStreamSource(std::move(reader), size);
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetServerError::AssetNotFound);
@@ -12,6 +12,8 @@
 #ifndef hifi_SendAssetTask_h
 #define hifi_SendAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QByteArray>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QString>
@@ -21,11 +23,16 @@
 #include "AssetServer.h"
 #include "Node.h"
 
+class AssetChunkCache;
 class NLPacket;
 
+/// file name suffix of compressed asset variants in the asset chunk cache
+const QString COMPRESSED_ASSET_SUFFIX = ".z";
+
 class SendAssetTask : public QRunnable {
 public:
-    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir);
+    SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                  const QDir& compressedDir, std::shared_ptr<AssetChunkCache> cache);
 
     void run() override;
 
@@ -33,6 +40,8 @@ private:
     QSharedPointer<ReceivedMessage> _message;
     SharedNodePointer _senderNode;
     QDir _resourcesDir;
+    QDir _compressedDir;
+    std::shared_ptr<AssetChunkCache> _cache;
 };
 
 #endif
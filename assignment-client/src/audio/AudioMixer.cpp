@@ -17,14 +17,19 @@
 #include <QtCore/QJsonValue>
 
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <Profile.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
+#include <SoundCache.h>
 #include <StDev.h>
 #include <UUID.h>
 #include <CPUDetect.h>
@@ -53,6 +58,7 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
 QVector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 QVector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+QVector<AudioMixer::BroadcastSettings> AudioMixer::_zoneBroadcastSettings;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -93,6 +99,12 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     packetReceiver.registerListener(PacketType::NodeMuteRequest, this, "handleNodeMuteRequestPacket");
     packetReceiver.registerListener(PacketType::KillAvatar, this, "handleKillAvatarPacket");
 
+    // hosted injectors load their sounds through the SoundCache, on the main thread
+    packetReceiver.registerListenerForTypes({
+        PacketType::HostedAudioInjector,
+        PacketType::StopHostedAudioInjector },
+        this, "handleHostedAudioInjectorPacket");
+
     packetReceiver.registerListenerForTypes({
         PacketType::ReplicatedMicrophoneAudioNoEcho,
         PacketType::ReplicatedMicrophoneAudioWithEcho,
@@ -230,6 +242,15 @@ void AudioMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet,
     }
 }
 
+void AudioMixer::handleHostedAudioInjectorPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
+    auto clientData = getOrCreateClientData(sendingNode.data());
+    if (packet->getType() == PacketType::HostedAudioInjector) {
+        clientData->parseHostedAudioInjector(*packet);
+    } else {
+        clientData->parseStopHostedAudioInjector(*packet);
+    }
+}
+
 void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
     auto injectorClientData = qobject_cast<AudioMixerClientData*>(sender());
     if (injectorClientData) {
@@ -272,6 +293,9 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    statsObject["avg_listeners_(late)_per_frame"] = (float)_stats.sumListenersLate / (float)_numStatFrames;
+    statsObject["avg_listeners_(broadcast)_per_frame"] = (float)_stats.sumListenersBroadcast / (float)_numStatFrames;
+    statsObject["avg_broadcast_encodes_per_frame"] = (float)_stats.sumBroadcastEncodes / (float)_numStatFrames;
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
@@ -314,6 +338,20 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["mix_stats"] = mixStats;
 
+    // when listeners' mixes went out, relative to the start of the frame
+    QJsonObject mixLatencyStats;
+    int numMixLatencies = 0;
+    for (int count : _stats.mixLatency) {
+        numMixLatencies += count;
+    }
+    for (int i = 0; i < AudioMixerStats::NUM_MIX_LATENCY_BUCKETS; ++i) {
+        bool isLastBucket = i == AudioMixerStats::NUM_MIX_LATENCY_BUCKETS - 1;
+        QString bucketName = isLastBucket ? QString("%_%1ms+").arg(i, 2, 10, QChar('0'))
+            : QString("%_%1-%2ms").arg(i, 2, 10, QChar('0')).arg(i + 1, 2, 10, QChar('0'));
+        mixLatencyStats[bucketName] = numMixLatencies > 0 ? (100.0f * _stats.mixLatency[i]) / numMixLatencies : 0.0f;
+    }
+    statsObject["mix_latency"] = mixLatencyStats;
+
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
 
@@ -367,13 +405,29 @@ AudioMixerClientData* AudioMixer::getOrCreateClientData(Node* node) {
     return clientData;
 }
 
+void AudioMixer::aboutToFinish() {
+    if (auto resourceManager = DependencyManager::get<ResourceManager>()) {
+        resourceManager->cleanup();
+    }
+
+    DependencyManager::destroy<SoundCache>();
+    DependencyManager::destroy<ResourceCacheSharedItems>();
+}
+
 void AudioMixer::start() {
     auto nodeList = DependencyManager::get<NodeList>();
 
+    // sounds hosted for clients are loaded (and shared) through a SoundCache, created here so that it lives
+    // on this thread, and so only finishes loading sounds in between mixes
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<SoundCache>();
+
     // prepare the NodeList
     nodeList->addSetOfNodeTypesToNodeInterestSet({
         NodeType::Agent, NodeType::EntityScriptServer,
-        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer
+        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer,
+        NodeType::AssetServer
     });
     nodeList->linkedDataCreateCallback = [&](Node* node) { getOrCreateClientData(node); };
 
@@ -388,6 +442,13 @@ void AudioMixer::start() {
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
 
+    static const MetricCounter framesMetric { "audio_mixer.frames" };
+    static const MetricHistogram frameUsecsMetric { "audio_mixer.frame_usecs" };
+    static const MetricHistogram mixUsecsMetric { "audio_mixer.mix_usecs" };
+
+    // a frame this late is audible to every listener, so trace what led up to it
+    static const quint64 STALLED_FRAME_USECS = 5 * AudioConstants::NETWORK_FRAME_USECS;
+
     while (!_isFinished) {
         auto ticTimer = _ticTiming.timer();
 
@@ -398,20 +459,31 @@ void AudioMixer::start() {
         }
 
         auto frameTimer = _frameTiming.timer();
+        auto frameStart = p_high_resolution_clock::now();
 
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // prepare frames; pop off any new audio from their streams
             {
+                PROFILE_RANGE(app, "AudioMixer::prepareFrames");
                 auto prepareTimer = _prepareTiming.timer();
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     _stats.sumStreams += prepareFrame(node, frame);
                 });
+
+                // mix and encode once for each broadcast audience, before the slaves send it out
+                for (auto& broadcast : _broadcasts) {
+                    _stats.sumBroadcastEncodes += broadcast->prepare(cbegin, cend);
+                }
             }
 
             // mix across slave threads
             {
+                PROFILE_RANGE(app, "AudioMixer::mix");
                 auto mixTimer = _mixTiming.timer();
-                _slavePool.mix(cbegin, cend, frame, _throttlingRatio);
+                auto mixStart = p_high_resolution_clock::now();
+                _slavePool.mix(cbegin, cend, frame, _throttlingRatio, frameTimestamp, &_broadcasts);
+                mixUsecsMetric.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                    p_high_resolution_clock::now() - mixStart).count());
             }
         });
 
@@ -426,6 +498,7 @@ void AudioMixer::start() {
 
         // process queued events (networking, global audio packets, &c.)
         {
+            PROFILE_RANGE(app, "AudioMixer::processEvents");
             auto eventsTimer = _eventsTiming.timer();
 
             // since we're a while loop we need to yield to qt's event processing
@@ -440,6 +513,14 @@ void AudioMixer::start() {
             }
         }
 
+        quint64 frameUsecs = std::chrono::duration_cast<std::chrono::microseconds>(
+            p_high_resolution_clock::now() - frameStart).count();
+        framesMetric.add();
+        frameUsecsMetric.record(frameUsecs);
+        if (frameUsecs > STALLED_FRAME_USECS) {
+            tracing::TraceRing::getInstance().reportStall("Audio mixer frame", frameUsecs);
+        }
+
         if (_isFinished) {
             // alert qt eventing that this is finished
             QCoreApplication::sendPostedEvents(this, QEvent::DeferredDelete);
@@ -531,6 +612,8 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _zoneBroadcastSettings.clear();
+    _broadcasts.clear();
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -750,6 +833,29 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                 }
             }
         }
+
+        const QString BROADCAST_ZONES = "broadcast_zones";
+        if (audioEnvGroupObject[BROADCAST_ZONES].isArray()) {
+            const QJsonArray& broadcastZones = audioEnvGroupObject[BROADCAST_ZONES].toArray();
+
+            const QString SOURCE = "source";
+            const QString LISTENER = "listener";
+            for (int i = 0; i < broadcastZones.count(); ++i) {
+                QJsonObject broadcastObject = broadcastZones[i].toObject();
+
+                BroadcastSettings settings;
+                settings.source = broadcastObject.value(SOURCE).toString();
+                settings.listener = broadcastObject.value(LISTENER).toString();
+
+                if (_audioZones.contains(settings.source) && _audioZones.contains(settings.listener)) {
+                    _zoneBroadcastSettings.push_back(settings);
+                    _broadcasts.emplace_back(new AudioMixerBroadcast(_audioZones[settings.source],
+                                                                     _audioZones[settings.listener]));
+
+                    qDebug() << "Added Broadcast:" << settings.source << settings.listener;
+                }
+            }
+        }
     }
 }
 
@@ -42,6 +42,10 @@ public:
         float reverbTime;
         float wetLevel;
     };
+    struct BroadcastSettings {
+        QString source;
+        QString listener;
+    };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
@@ -49,6 +53,7 @@ public:
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static const QVector<BroadcastSettings>& getBroadcastSettings() { return _zoneBroadcastSettings; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -59,6 +64,7 @@ public:
 public slots:
     void run() override;
     void sendStatsPacket() override;
+    void aboutToFinish() override;
 
 private slots:
     // packet handlers
@@ -66,6 +72,7 @@ private slots:
     void handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleHostedAudioInjectorPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
 
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
@@ -97,6 +104,8 @@ private:
 
     AudioMixerSlavePool _slavePool;
 
+    AudioMixerBroadcasts _broadcasts;
+
     class Timer {
     public:
         class Timing{
@@ -134,6 +143,7 @@ private:
     static QHash<QString, AABox> _audioZones;
     static QVector<ZoneSettings> _zoneSettings;
     static QVector<ReverbSettings> _zoneReverbSettings;
+    static QVector<BroadcastSettings> _zoneBroadcastSettings;
 
 };
 
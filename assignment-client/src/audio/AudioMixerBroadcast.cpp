@@ -0,0 +1,224 @@
+//
+//  AudioMixerBroadcast.cpp
+//  assignment-client/src/audio
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerBroadcast.h"
+
+#include <algorithm>
+
+#include <AudioBitrateController.h>
+
+#include "AudioMixerClientData.h"
+#include "AvatarAudioStream.h"
+#include "HostedAudioInjector.h"
+#include "InjectedAudioStream.h"
+
+AudioMixerBroadcast::AudioMixerBroadcast(const AABox& sourceZone, const AABox& listenerZone) :
+    _sourceZone(sourceZone),
+    _listenerZone(listenerZone),
+    _limiter(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO)
+{
+}
+
+AudioMixerBroadcast::~AudioMixerBroadcast() {
+    for (auto& encoderPair : _encoders) {
+        releaseEncoder(encoderPair.second);
+    }
+}
+
+void AudioMixerBroadcast::releaseEncoder(SharedEncoder& sharedEncoder) {
+    if (sharedEncoder.codec && sharedEncoder.encoder) {
+        sharedEncoder.codec->releaseEncoder(sharedEncoder.encoder);
+    }
+    sharedEncoder.encoder = nullptr;
+}
+
+int AudioMixerBroadcast::prepare(ConstIter begin, ConstIter end) {
+    bool hasAudio = mix(begin, end);
+
+    // find the codecs and bitrate levels of the audience
+    struct EncoderSettings {
+        CodecPluginPointer codec;
+        float expectedPacketLoss { 0.0f };
+    };
+    std::map<EncoderKey, EncoderSettings> settings;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+        if (data && node->getType() == NodeType::Agent) {
+            auto avatarStream = data->getAvatarAudioStream();
+            if (avatarStream && _listenerZone.contains(avatarStream->getPosition())) {
+                auto& setting = settings[EncoderKey(data->getCodecName(), data->getBitrateLevel())];
+                setting.codec = data->getCodec();
+                // the listener at this level with the worst link sizes the forward error correction for all
+                setting.expectedPacketLoss = std::max(setting.expectedPacketLoss, data->getExpectedPacketLoss());
+            }
+        }
+    });
+
+    // and encode once for each of them
+    int numEncodes = 0;
+    for (auto& settingPair : settings) {
+        auto& sharedEncoder = _encoders[settingPair.first];
+        auto& setting = settingPair.second;
+        if (sharedEncoder.codec != setting.codec) {
+            releaseEncoder(sharedEncoder);
+            sharedEncoder.codec = setting.codec;
+            if (sharedEncoder.codec) {
+                sharedEncoder.encoder = sharedEncoder.codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+            }
+        }
+
+        int bitrateLevel = settingPair.first.second;
+        if (sharedEncoder.encoder && sharedEncoder.encoder->supportsBitrateAdaptation() && bitrateLevel >= 0) {
+            sharedEncoder.encoder->setBitrate(AudioBitrateController::BITRATE_LEVELS[bitrateLevel]);
+            sharedEncoder.encoder->setExpectedPacketLoss(setting.expectedPacketLoss);
+        }
+
+        sharedEncoder.hasFrame = hasAudio || sharedEncoder.shouldFlush;
+        if (!sharedEncoder.hasFrame) {
+            continue;
+        }
+
+        // once the stage goes quiet, one frame of zeros flushes the encoder, as for a listener's own mix
+        static const QByteArray ZEROS(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+        const QByteArray decodedFrame = hasAudio ?
+            QByteArray(reinterpret_cast<const char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO) :
+            ZEROS;
+        if (sharedEncoder.encoder) {
+            sharedEncoder.encoder->encode(decodedFrame, sharedEncoder.encodedFrame);
+        } else {
+            sharedEncoder.encodedFrame = decodedFrame;
+        }
+        sharedEncoder.shouldFlush = hasAudio;
+        ++numEncodes;
+    }
+
+    // codecs and levels that nobody here uses this frame go without
+    for (auto& encoderPair : _encoders) {
+        if (settings.find(encoderPair.first) == settings.end()) {
+            encoderPair.second.hasFrame = false;
+        }
+    }
+
+    return numEncodes;
+}
+
+bool AudioMixerBroadcast::mix(ConstIter begin, ConstIter end) {
+    memset(_mixSamples, 0, sizeof(_mixSamples));
+    _sourceNodes.clear();
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+        if (!data) {
+            return;
+        }
+
+        bool isSource = false;
+
+        for (auto& streamPair : data->getAudioStreams()) {
+            auto& stream = streamPair.second;
+            if (!_sourceZone.contains(stream->getPosition())) {
+                continue;
+            }
+            isSource = true;
+
+            if (!stream->lastPopSucceeded()) {
+                continue;
+            }
+
+            float gain = 1.0f;
+            if (stream->getType() == PositionalAudioStream::Injector) {
+                gain = static_cast<const InjectedAudioStream*>(stream.get())->getAttenuationRatio();
+            }
+
+            // nothing is spatialized, mono sources are heard in the middle
+            AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+            if (stream->isStereo()) {
+                for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+                    _mixSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+                }
+            } else {
+                for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
+                    auto monoSample = float(streamPopOutput[i / 2] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+                    _mixSamples[i] += monoSample;
+                    _mixSamples[i + 1] += monoSample;
+                }
+            }
+        }
+
+        for (auto& injectorPair : data->getHostedInjectors()) {
+            auto& injector = injectorPair.second;
+            if (!_sourceZone.contains(injector->getPosition())) {
+                continue;
+            }
+            isSource = true;
+
+            if (!injector->hasFrame()) {
+                continue;
+            }
+
+            float gain = injector->getVolume();
+            injector->readFrame(_bufferSamples);
+            if (injector->isStereo()) {
+                for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+                    _mixSamples[i] += float(_bufferSamples[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+                }
+            } else {
+                for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
+                    auto monoSample = float(_bufferSamples[i / 2] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+                    _mixSamples[i] += monoSample;
+                    _mixSamples[i + 1] += monoSample;
+                }
+            }
+        }
+
+        if (isSource) {
+            _sourceNodes.push_back(node);
+        }
+    });
+
+    // check for silent audio before limiting, as in AudioMixerSlave::prepareMix
+    bool hasAudio = false;
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+        if (_mixSamples[i] != 0.0f) {
+            hasAudio = true;
+            break;
+        }
+    }
+
+    _limiter.render(_mixSamples, _bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    return hasAudio;
+}
+
+bool AudioMixerBroadcast::canShareWith(const SharedNodePointer& listener, AudioMixerClientData& listenerData,
+        unsigned int frame) const {
+    for (auto& source : _sourceNodes) {
+        if (*source == *listener || listenerData.shouldIgnore(listener, source, frame)) {
+            return false;
+        }
+
+        // a per-avatar gain set by the listener
+        if (listenerData.hrtfForStream(source->getUUID(), QUuid()).getGainAdjustment() != 1.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const QByteArray* AudioMixerBroadcast::getEncodedFrame(const QString& codecName, int bitrateLevel,
+        const void*& encoderStream) const {
+    auto it = _encoders.find(EncoderKey(codecName, bitrateLevel));
+    if (it == _encoders.end() || !it->second.hasFrame) {
+        return nullptr;
+    }
+    encoderStream = &it->second;
+    return &it->second.encodedFrame;
+}
@@ -0,0 +1,85 @@
+//
+//  AudioMixerBroadcast.h
+//  assignment-client/src/audio
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerBroadcast_h
+#define hifi_AudioMixerBroadcast_h
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <AABox.h>
+#include <AudioConstants.h>
+#include <AudioLimiter.h>
+#include <NodeList.h>
+#include <plugins/CodecPlugin.h>
+
+class AudioMixerClientData;
+
+// A broadcast zone: everything heard from its source zone (a stage) is mixed once per frame, without HRTF or distance
+// attenuation, and encoded once per codec and bitrate level. Listeners in its listener zone (an audience) are sent that shared payload
+// instead of a mix of their own, so a mass audience costs a packet per listener rather than a mix and an encode.
+// Listeners only share an encoder if their links run at the same bitrate level, as their own encoder would.
+//
+// A listener that would not hear exactly the shared mix (it is one of the sources, ignores one, or has changed the
+// gain of one) gets its own mix as usual.
+class AudioMixerBroadcast {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    AudioMixerBroadcast(const AABox& sourceZone, const AABox& listenerZone);
+    ~AudioMixerBroadcast();
+
+    AudioMixerBroadcast(const AudioMixerBroadcast&) = delete;
+    AudioMixerBroadcast& operator=(const AudioMixerBroadcast&) = delete;
+
+    // mixes and encodes the frame, on the mixer thread before the slaves run (after prepareFrame popped the streams)
+    // returns the number of frames encoded
+    int prepare(ConstIter begin, ConstIter end);
+
+    bool containsListener(const glm::vec3& position) const { return _listenerZone.contains(position); }
+
+    // whether the listener hears exactly the shared mix, checked by the slave mixing the listener
+    bool canShareWith(const SharedNodePointer& listener, AudioMixerClientData& listenerData, unsigned int frame) const;
+
+    // the frame encoded for listeners with the codec and bitrate level, or nullptr if a silent frame should be sent instead
+    // encoderStream is set to the shared encoder it came from, which the listener's decoder has to follow
+    const QByteArray* getEncodedFrame(const QString& codecName, int bitrateLevel, const void*& encoderStream) const;
+
+private:
+    using EncoderKey = std::pair<QString, int>;   // codec name, "" for none, and bitrate level, -1 if it does not adapt
+
+    struct SharedEncoder {
+        CodecPluginPointer codec;
+        Encoder* encoder { nullptr };
+        QByteArray encodedFrame;
+        bool hasFrame { false };
+        bool shouldFlush { false };
+    };
+
+    bool mix(ConstIter begin, ConstIter end);
+    void releaseEncoder(SharedEncoder& sharedEncoder);
+
+    AABox _sourceZone;
+    AABox _listenerZone;
+
+    std::vector<SharedNodePointer> _sourceNodes;
+    std::map<EncoderKey, SharedEncoder> _encoders;
+
+    AudioLimiter _limiter;
+    float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+};
+
+using AudioMixerBroadcasts = std::vector<std::unique_ptr<AudioMixerBroadcast>>;
+
+#endif // hifi_AudioMixerBroadcast_h
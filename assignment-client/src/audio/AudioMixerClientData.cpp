@@ -9,11 +9,17 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <chrono>
+#include <cmath>
 #include <random>
 
 #include <QtCore/QDebug>
 #include <QtCore/QJsonArray>
 
+#include <AudioInjector.h>
+#include <AudioLogging.h>
+#include <LogHandler.h>
+#include <SoundCache.h>
 #include <udt/PacketHeaders.h>
 #include <UUID.h>
 
@@ -82,8 +88,11 @@ void AudioMixerClientData::processPackets() {
             }
             case PacketType::AudioStreamStats: {
                 QMutexLocker lock(&getMutex());
+                PacketStreamStats previousStats = _downstreamAudioStreamStats._packetStreamStats;
                 parseData(*packet);
 
+                adaptDownstreamBitrate(previousStats, node->getPingMs());
+
                 break;
             }
             case PacketType::NegotiateAudioFormat:
@@ -201,6 +210,73 @@ void AudioMixerClientData::parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessa
     node->parseIgnoreRadiusRequestMessage(message);
 }
 
+// like the AudioInjectorManager's limit on the injectors a client streams at once
+static const size_t MAX_HOSTED_INJECTORS_PER_NODE = 40;
+
+void AudioMixerClientData::parseHostedAudioInjector(ReceivedMessage& message) {
+    QUuid injectorID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    QUrl url { message.readString() };
+
+    const int OPTIONS_BYTES = sizeof(glm::vec3) + sizeof(glm::quat) + sizeof(float) + sizeof(uchar) + sizeof(float);
+    if (injectorID.isNull() || message.getBytesLeftToRead() < OPTIONS_BYTES) {
+        return;
+    }
+
+    glm::vec3 position;
+    glm::quat orientation;
+    float volume;
+    uchar loop;
+    float playbackSeconds;
+    message.readPrimitive(&position);
+    message.readPrimitive(&orientation);
+    message.readPrimitive(&volume);
+    message.readPrimitive(&loop);
+    message.readPrimitive(&playbackSeconds);
+
+    auto it = _hostedInjectors.find(injectorID);
+    if (it == _hostedInjectors.end()) {
+        if (!AudioInjector::isMixerHostableURL(url)) {
+            qDebug() << "Refusing to host a sound from" << url << "for" << uuidStringWithoutCurlyBraces(getNodeID());
+            return;
+        }
+        if (_hostedInjectors.size() >= MAX_HOSTED_INJECTORS_PER_NODE) {
+            qDebug() << "Refusing to host another sound for" << uuidStringWithoutCurlyBraces(getNodeID())
+                << "- at max of" << MAX_HOSTED_INJECTORS_PER_NODE << "hosted injectors";
+            return;
+        }
+
+        // the SoundCache shares one decoded copy of the sound between all of its injectors
+        // (it is only set once the mixer has started)
+        if (!DependencyManager::isSet<SoundCache>()) {
+            return;
+        }
+        auto sound = DependencyManager::get<SoundCache>()->getSound(url);
+        if (!sound) {
+            return;
+        }
+        auto injector = std::make_shared<HostedAudioInjector>(injectorID, sound, playbackSeconds);
+        it = _hostedInjectors.emplace(injectorID, injector).first;
+    } else {
+        it->second->setPlaybackSeconds(playbackSeconds);
+        it->second->refresh();
+    }
+
+    auto& injector = *it->second;
+    injector.setPosition(position);
+    injector.setOrientation(orientation);
+    injector.setVolume(std::isfinite(volume) ? glm::clamp(volume, 0.0f, 1.0f) : 0.0f);
+    injector.setLoop(loop != 0);
+}
+
+void AudioMixerClientData::parseStopHostedAudioInjector(ReceivedMessage& message) {
+    QUuid injectorID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+    if (_hostedInjectors.erase(injectorID) > 0) {
+        // so that the HRTF objects for this source can be cleaned up
+        emit injectorStreamFinished(injectorID);
+    }
+}
+
 AvatarAudioStream* AudioMixerClientData::getAvatarAudioStream() {
     QReadLocker readLocker { &_streamsLock };
 
@@ -334,9 +410,17 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
         // seek to the beginning of the packet so that the next reader is in the right spot
         message.seek(0);
 
+        // packets wait for the next frame to be processed, so the jitter buffer is told when the socket read them
+        quint64 arrivalUsecs = usecTimestampNow();
+        auto queuedTime = p_high_resolution_clock::now() - message.getFirstPacketReceiveTime();
+        auto queuedUsecs = std::chrono::duration_cast<std::chrono::microseconds>(queuedTime).count();
+        if (queuedUsecs > 0 && (quint64)queuedUsecs < USECS_PER_SECOND) {
+            arrivalUsecs -= queuedUsecs;
+        }
+
         // check the overflow count before we parse data
         auto overflowBefore = matchingStream->getOverflowCount();
-        auto parseResult = matchingStream->parseData(message);
+        auto parseResult = matchingStream->parseData(message, arrivalUsecs);
 
         if (matchingStream->getOverflowCount() > overflowBefore) {
             qDebug() << "Just overflowed on stream from" << message.getSourceID() << "at" << message.getSenderSockAddr();
@@ -377,7 +461,21 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
         }
     }
 
-    return (int)_audioStreams.size();
+    auto now = usecTimestampNow();
+    auto injectorIt = _hostedInjectors.begin();
+    while (injectorIt != _hostedInjectors.end()) {
+        auto& injector = injectorIt->second;
+
+        if (!injector->advanceFrame() || injector->isExpired(now)) {
+            // the sound played out, failed to load, or its client is gone
+            emit injectorStreamFinished(injectorIt->first);
+            injectorIt = _hostedInjectors.erase(injectorIt);
+        } else {
+            ++injectorIt;
+        }
+    }
+
+    return (int)(_audioStreams.size() + _hostedInjectors.size());
 }
 
 bool AudioMixerClientData::shouldSendStats(int frameNumber) {
@@ -438,6 +536,18 @@ void AudioMixerClientData::sendAudioStreamStatsPackets(const SharedNodePointer&
     }
 }
 
+static void addJitterBufferStats(QJsonObject& stats, const InboundAudioStream& stream) {
+    stats["concealed"] = stream.getConcealedFrames();
+    stats["accelerated"] = stream.getAcceleratedFrames();
+    stats["expanded"] = stream.getExpandedFrames();
+
+    QJsonArray delayHistogram;
+    for (int count : stream.getDelayHistogram()) {
+        delayHistogram.push_back(count);
+    }
+    stats["delay_frames_histogram"] = delayHistogram;
+}
+
 QJsonObject AudioMixerClientData::getAudioStreamStats() {
     QJsonObject result;
 
@@ -458,6 +568,9 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
     downstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
     downstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
     downstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
+    if (_encoder && _encoder->supportsBitrateAdaptation()) {
+        downstreamStats["bitrate"] = _encoder->getBitrate();
+    }
 
     result["downstream"] = downstreamStats;
 
@@ -476,6 +589,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
         upstreamStats["overflows"] = (double) streamStats._overflowCount;
         upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
+        addJitterBufferStats(upstreamStats, *avatarAudioStream);
         upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
         upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
         upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
@@ -506,6 +620,7 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
             upstreamStats["not_mixed"] = (double) streamStats._consecutiveNotMixedCount;
             upstreamStats["overflows"] = (double) streamStats._overflowCount;
             upstreamStats["silents_dropped"] = (double) streamStats._framesDropped;
+            addJitterBufferStats(upstreamStats, *injectorPair.second);
             upstreamStats["lost%"] = streamStats._packetStreamStats.getLostRate() * 100.0f;
             upstreamStats["lost%_30s"] = streamStats._packetStreamWindowStats.getLostRate() * 100.0f;
             upstreamStats["min_gap"] = formatUsecTime(streamStats._timeGapMin);
@@ -535,6 +650,52 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
+void AudioMixerClientData::adaptDownstreamBitrate(const PacketStreamStats& previousStats, int pingMs) {
+    if (!_encoder || !_encoder->supportsBitrateAdaptation()) {
+        return;
+    }
+
+    // the totals start over if the client restarts its stream, skip the report that would look like a wrap
+    const PacketStreamStats& stats = _downstreamAudioStreamStats._packetStreamStats;
+    if (stats._expectedReceived < previousStats._expectedReceived || stats._lost < previousStats._lost) {
+        return;
+    }
+
+    // loss is what the listener reported for the mix since its last report, and the delay is our ping to it
+    float lossRate = (stats - previousStats).getLostRate();
+    if (_bitrateController.update(lossRate, pingMs)) {
+        // with many listeners on changing links this would flood the log, so repeats are collapsed into a count
+        static QString repeatedMessage = LogHandler::getInstance().addRepeatedMessageRegex(
+            "^Downstream audio for .* now encoded at .*");
+        qCDebug(audio) << "Downstream audio for" << getNodeID() << "now encoded at" << _bitrateController.getBitrate()
+            << "bps, loss" << lossRate << "ping" << pingMs << "ms";
+    }
+
+    _encoder->setBitrate(_bitrateController.getBitrate());
+    _encoder->setExpectedPacketLoss(_bitrateController.getExpectedPacketLoss());
+}
+
+int AudioMixerClientData::getBitrateLevel() const {
+    if (!_encoder || !_encoder->supportsBitrateAdaptation()) {
+        return -1;
+    }
+    return _bitrateController.getLevel();
+}
+
+void AudioMixerClientData::setDownstreamEncoder(const SharedNodePointer& node, const void* encoderStream) {
+    if (encoderStream == _downstreamEncoder) {
+        return;
+    }
+    _downstreamEncoder = encoderStream;
+
+    if (_codec) {
+        // a fresh encoder of our own, and a fresh decoder at the listener, whose encoder restarts along with it
+        // (so does our decoder of its mic stream)
+        setupCodec(_codec, _selectedCodecName);
+        sendSelectAudioFormat(node, _selectedCodecName);
+    }
+}
+
 void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
     if (_shouldFlushEncoder) {
@@ -553,6 +714,11 @@ void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& c
     _selectedCodecName = codecName;
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+        if (_encoder && _encoder->supportsBitrateAdaptation()) {
+            // continue from what the link could carry for the previous codec
+            _encoder->setBitrate(_bitrateController.getBitrate());
+            _encoder->setExpectedPacketLoss(_bitrateController.getExpectedPacketLoss());
+        }
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
     }
 
@@ -17,6 +17,7 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioBitrateController.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -25,6 +26,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "HostedAudioInjector.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -34,6 +36,8 @@ public:
 
     using SharedStreamPointer = std::shared_ptr<PositionalAudioStream>;
     using AudioStreamMap = std::unordered_map<QUuid, SharedStreamPointer>;
+    using SharedHostedInjectorPointer = std::shared_ptr<HostedAudioInjector>;
+    using HostedInjectorMap = std::unordered_map<QUuid, SharedHostedInjectorPointer>;
 
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
     void processPackets();
@@ -42,6 +46,9 @@ public:
     AudioStreamMap getAudioStreams() { QReadLocker readLock { &_streamsLock }; return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
 
+    // hosted injectors are only changed on the AudioMixer assignment thread, between mixes, so they are not locked
+    const HostedInjectorMap& getHostedInjectors() const { return _hostedInjectors; }
+
     // returns whether self (this data's node) should ignore node, memoized by frame
     // precondition: frame is increasing after first call (including overflow wrap)
     bool shouldIgnore(SharedNodePointer self, SharedNodePointer node, unsigned int frame);
@@ -68,7 +75,12 @@ public:
     void parseNodeIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
     void parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node);
 
-    // attempt to pop a frame from each audio stream, and return the number of streams from this client
+    // these load sounds through the SoundCache, so they are parsed on the AudioMixer assignment thread
+    void parseHostedAudioInjector(ReceivedMessage& message);
+    void parseStopHostedAudioInjector(ReceivedMessage& message);
+
+    // attempt to pop a frame from each audio stream and advance each hosted injector,
+    // and return the number of streams from this client
     int checkBuffersBeforeFrameSend();
 
     void removeDeadInjectedStreams();
@@ -100,6 +112,15 @@ public:
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
     QString getCodecName() { return _selectedCodecName; }
+    CodecPluginPointer getCodec() const { return _codec; }
+
+    // the bitrate level of the listener's link, or -1 if its codec does not adapt, and the loss expected on it
+    int getBitrateLevel() const;
+    float getExpectedPacketLoss() const { return _bitrateController.getExpectedPacketLoss(); }
+
+    // Called before sending a frame encoded by encoderStream, nullptr for the listener's own encoder. The listener's
+    // decoder only follows the encoder it started with, so switching to another one restarts the codec at both ends.
+    void setDownstreamEncoder(const SharedNodePointer& node, const void* encoderStream);
 
     bool shouldMuteClient() { return _shouldMuteClient; }
     void setShouldMuteClient(bool shouldMuteClient) { _shouldMuteClient = shouldMuteClient; }
@@ -125,8 +146,13 @@ private:
     QReadWriteLock _streamsLock;
     AudioStreamMap _audioStreams; // microphone stream from avatar is stored under key of null UUID
 
+    HostedInjectorMap _hostedInjectors;
+
     void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
 
+    // retunes a codec with a variable bitrate to the link, from the listener's latest downstream stats
+    void adaptDownstreamBitrate(const PacketStreamStats& previousStats, int pingMs);
+
     using IgnoreZone = AABox;
     class IgnoreZoneMemo {
     public:
@@ -179,8 +205,10 @@ private:
     QString _selectedCodecName;
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
     Decoder* _decoder{ nullptr }; // for mic stream
+    AudioBitrateController _bitrateController; // for outbound mixed stream, if the codec can adapt
 
     bool _shouldFlushEncoder { false };
+    const void* _downstreamEncoder { nullptr }; // a broadcast's shared encoder the listener is following, if any
 
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
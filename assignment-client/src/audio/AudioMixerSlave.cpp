@@ -16,6 +16,7 @@
 #include <glm/gtx/vector_angle.hpp>
 
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
@@ -31,6 +32,7 @@
 #include "AudioMixer.h"
 #include "AudioMixerClientData.h"
 #include "AvatarAudioStream.h"
+#include "HostedAudioInjector.h"
 #include "InjectedAudioStream.h"
 #include "AudioHelpers.h"
 
@@ -38,9 +40,13 @@
 
 using AudioStreamMap = AudioMixerClientData::AudioStreamMap;
 
+// leave the rest of the frame for processing packets, so that the next frame starts on time
+const std::chrono::microseconds AudioMixerSlave::MIX_DEADLINE { AudioConstants::NETWORK_FRAME_USECS * 3 / 4 };
+const int AudioMixerSlave::FALLBACK_MIXED_NODES = 2;
+
 // packet helpers
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, const QByteArray& buffer);
 void sendSilentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
@@ -50,8 +56,10 @@ inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const
         const glm::vec3& relativePosition);
 inline float computeGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition, bool isEcho);
-inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
+inline float computeDistanceGain(const AvatarAudioStream& listeningNodeStream, const glm::vec3& sourcePosition,
         const glm::vec3& relativePosition);
+// the azimuth only depends on where the source is relative to the listener, so it works for any kind of source
+inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const glm::vec3& relativePosition);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
@@ -60,11 +68,14 @@ void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     }
 }
 
-void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        p_high_resolution_clock::time_point frameStart, const AudioMixerBroadcasts* broadcasts) {
     _begin = begin;
     _end = end;
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _frameStart = frameStart;
+    _broadcasts = broadcasts;
 }
 
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
@@ -93,11 +104,31 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     if (node->getType() == NodeType::Agent && node->getActiveSocket()) {
         ++stats.sumListeners;
 
-        // mix the audio
-        bool mixHasAudio = prepareMix(node);
+        // listeners are queued by priority, so the ones still waiting past the deadline matter the least
+        bool isLate = p_high_resolution_clock::now() - _frameStart > MIX_DEADLINE;
+        if (isLate) {
+            ++stats.sumListenersLate;
+        }
+
+        // an audience member is sent the frame that was mixed and encoded once for all of them
+        auto broadcast = findBroadcast(node, *data, *avatarStream);
+        bool mixHasAudio = !broadcast && prepareMix(node, isLate);
 
         // send audio packet
-        if (mixHasAudio || data->shouldFlushEncoder()) {
+        if (broadcast) {
+            ++stats.sumListenersBroadcast;
+            const void* encoderStream = nullptr;
+            auto encodedBuffer = broadcast->getEncodedFrame(data->getCodecName(), data->getBitrateLevel(), encoderStream);
+            if (encodedBuffer) {
+                data->setDownstreamEncoder(node, encoderStream);
+                sendMixPacket(node, *data, *encodedBuffer);
+            } else {
+                ++stats.sumListenersSilent;
+                sendSilentPacket(node, *data);
+            }
+        } else if (mixHasAudio || data->shouldFlushEncoder()) {
+            data->setDownstreamEncoder(node, nullptr);
+
             QByteArray encodedBuffer;
             if (mixHasAudio) {
                 // encode the audio
@@ -114,6 +145,12 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             sendSilentPacket(node, *data);
         }
 
+        static const MetricHistogram mixLatencyMetric { "audio_mixer.listener_mix_latency_usecs" };
+        auto mixLatency = std::chrono::duration_cast<std::chrono::microseconds>(
+            p_high_resolution_clock::now() - _frameStart).count();
+        stats.recordMixLatency(mixLatency);
+        mixLatencyMetric.record(mixLatency);
+
         // send environment packet
         sendEnvironmentPacket(node, *data);
 
@@ -125,23 +162,39 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
     }
 }
 
-bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
+const AudioMixerBroadcast* AudioMixerSlave::findBroadcast(const SharedNodePointer& listener,
+        AudioMixerClientData& listenerData, const AvatarAudioStream& listenerStream) {
+    if (!_broadcasts) {
+        return nullptr;
+    }
+
+    for (auto& broadcast : *_broadcasts) {
+        if (broadcast->containsListener(listenerStream.getPosition())) {
+            // otherwise the listener is mixed as if there were no broadcast
+            return broadcast->canShareWith(listener, listenerData, _frame) ? broadcast.get() : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener, bool isLate) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
 
-    bool isThrottling = _throttlingRatio > 0.0f;
+    bool isThrottling = isLate || _throttlingRatio > 0.0f;
     std::vector<std::pair<float, SharedNodePointer>> throttledNodes;
 
-    typedef void (AudioMixerSlave::*MixFunctor)(
-            AudioMixerClientData&, const QUuid&, const AvatarAudioStream&, const PositionalAudioStream&);
-    auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, MixFunctor mixFunctor) {
+    auto forAllStreams = [&](const SharedNodePointer& node, AudioMixerClientData* nodeData, bool throttle) {
         auto nodeID = node->getUUID();
         for (auto& streamPair : nodeData->getAudioStreams()) {
             auto nodeStream = streamPair.second;
-            (this->*mixFunctor)(*listenerData, nodeID, *listenerAudioStream, *nodeStream);
+            addStream(*listenerData, nodeID, *listenerAudioStream, *nodeStream, throttle);
+        }
+        for (auto& injectorPair : nodeData->getHostedInjectors()) {
+            addHostedInjector(*listenerData, nodeID, *listenerAudioStream, *injectorPair.second, throttle);
         }
     };
 
@@ -165,12 +218,12 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             }
         } else if (!listenerData->shouldIgnore(listener, node, _frame)) {
             if (!isThrottling) {
-                forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+                forAllStreams(node, nodeData, false);
             } else {
                 auto nodeID = node->getUUID();
 
                 // compute the node's max relative volume
-                float nodeVolume;
+                float nodeVolume = 0.0f;
                 for (auto& streamPair : nodeData->getAudioStreams()) {
                     auto nodeStream = streamPair.second;
 
@@ -186,6 +239,20 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                     nodeVolume = std::max(streamVolume, nodeVolume);
                 }
 
+                for (auto& injectorPair : nodeData->getHostedInjectors()) {
+                    auto& injector = injectorPair.second;
+
+                    // approximate the gain, as for an injected stream
+                    glm::vec3 relativePosition = injector->getPosition() - listenerAudioStream->getPosition();
+                    float distance = glm::max(glm::length(relativePosition), EPSILON);
+                    float gain = injector->getVolume() / distance;
+
+                    auto& hrtf = listenerData->hrtfForStream(nodeID, injector->getID());
+                    gain *= hrtf.getGainAdjustment();
+
+                    nodeVolume = std::max(injector->getLoudness() * gain, nodeVolume);
+                }
+
                 // max-heapify the nodes by relative volume
                 throttledNodes.push_back(std::make_pair(nodeVolume, node));
                 if (!throttledNodes.empty()) {
@@ -198,6 +265,9 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     if (isThrottling) {
         // pop the loudest nodes off the heap and mix their streams
         int numToRetain = (int)(std::distance(_begin, _end) * (1 - _throttlingRatio));
+        if (isLate) {
+            numToRetain = std::min(numToRetain, FALLBACK_MIXED_NODES);
+        }
         for (int i = 0; i < numToRetain; i++) {
             if (throttledNodes.empty()) {
                 break;
@@ -207,7 +277,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
             auto& node = throttledNodes.back().second;
             AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-            forAllStreams(node, nodeData, &AudioMixerSlave::mixStream);
+            forAllStreams(node, nodeData, false);
 
             throttledNodes.pop_back();
         }
@@ -216,7 +286,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         for (const std::pair<float, SharedNodePointer>& nodePair : throttledNodes) {
             auto& node = nodePair.second;
             AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-            forAllStreams(node, nodeData, &AudioMixerSlave::throttleStream);
+            forAllStreams(node, nodeData, true);
         }
     }
 
@@ -242,11 +312,6 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     return hasAudio;
 }
 
-void AudioMixerSlave::throttleStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
-        const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
-    addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, true);
-}
-
 void AudioMixerSlave::mixStream(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
         const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd) {
     addStream(listenerNodeData, sourceNodeID, listeningNodeStream, streamToAdd, false);
@@ -267,7 +332,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
     float gain = computeGain(listeningNodeStream, streamToAdd, relativePosition, isEcho);
-    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
+    float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, relativePosition);
     const int HRTF_DATASET_INDEX = 1;
 
     if (!streamToAdd.lastPopSucceeded()) {
@@ -361,6 +426,63 @@ void AudioMixerSlave::addStream(AudioMixerClientData& listenerNodeData, const QU
     ++stats.hrtfRenders;
 }
 
+void AudioMixerSlave::addHostedInjector(AudioMixerClientData& listenerNodeData, const QUuid& sourceNodeID,
+        const AvatarAudioStream& listeningNodeStream, const HostedAudioInjector& injector,
+        bool throttle) {
+    // the sound is still loading
+    if (!injector.hasFrame()) {
+        return;
+    }
+
+    ++stats.totalMixes;
+
+    glm::vec3 relativePosition = injector.getPosition() - listeningNodeStream.getPosition();
+
+    float distance = glm::max(glm::length(relativePosition), EPSILON);
+    float gain = injector.getVolume() * computeDistanceGain(listeningNodeStream, injector.getPosition(), relativePosition);
+    float azimuth = computeAzimuth(listeningNodeStream, relativePosition);
+    const int HRTF_DATASET_INDEX = 1;
+
+    // read straight out of the shared sound
+    injector.readFrame(_bufferSamples);
+
+    // stereo sources are not passed through HRTF
+    if (injector.isStereo()) {
+        for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+            _mixSamples[i] += float(_bufferSamples[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
+        }
+
+        ++stats.manualStereoMixes;
+        return;
+    }
+
+    // get the existing listener-source HRTF object, or create a new one
+    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, injector.getID());
+
+    if (injector.getLoudness() == 0.0f) {
+        // call renderSilent to reduce artifacts
+        hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        ++stats.hrtfSilentRenders;
+        return;
+    }
+
+    if (throttle) {
+        // call renderSilent with actual frame data and a gain of 0.0f to reduce artifacts
+        hrtf.renderSilent(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, 0.0f,
+                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        ++stats.hrtfThrottleRenders;
+        return;
+    }
+
+    hrtf.render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    ++stats.hrtfRenders;
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
@@ -368,7 +490,7 @@ std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 s
     return audioPacket;
 }
 
-void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer) {
+void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, const QByteArray& buffer) {
     const int MIX_PACKET_SIZE =
         sizeof(quint16) + AudioConstants::MAX_CODEC_NAME_LENGTH_ON_WIRE + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
     quint16 sequence = data.getOutgoingSequenceNumber();
@@ -509,13 +631,20 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
         gain *= offAxisCoefficient;
     }
 
+    return gain * computeDistanceGain(listeningNodeStream, streamToAdd.getPosition(), relativePosition);
+}
+
+float computeDistanceGain(const AvatarAudioStream& listeningNodeStream, const glm::vec3& sourcePosition,
+        const glm::vec3& relativePosition) {
+    float gain = 1.0f;
+
     auto& audioZones = AudioMixer::getAudioZones();
     auto& zoneSettings = AudioMixer::getZoneSettings();
 
     // find distance attenuation coefficient
     float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
     for (int i = 0; i < zoneSettings.length(); ++i) {
-        if (audioZones[zoneSettings[i].source].contains(streamToAdd.getPosition()) &&
+        if (audioZones[zoneSettings[i].source].contains(sourcePosition) &&
             audioZones[zoneSettings[i].listener].contains(listeningNodeStream.getPosition())) {
             attenuationPerDoublingInDistance = zoneSettings[i].coefficient;
             break;
@@ -542,8 +671,7 @@ float computeGain(const AvatarAudioStream& listeningNodeStream, const Positional
     return gain;
 }
 
-float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
-        const glm::vec3& relativePosition) {
+float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const glm::vec3& relativePosition) {
     glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
 
     glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
@@ -13,28 +13,36 @@
 #define hifi_AudioMixerSlave_h
 
 #include <AABox.h>
+#include <PortableHighResolutionClock.h>
 #include <AudioHRTF.h>
 #include <AudioRingBuffer.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
 #include <NodeList.h>
 
+#include "AudioMixerBroadcast.h"
 #include "AudioMixerStats.h"
 
 class PositionalAudioStream;
 class AvatarAudioStream;
 class AudioHRTF;
 class AudioMixerClientData;
+class HostedAudioInjector;
 
 class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
 
+    // listeners not reached by this long into the frame get a fallback mix of only their loudest few sources
+    static const std::chrono::microseconds MIX_DEADLINE;
+    static const int FALLBACK_MIXED_NODES;
+
     // process packets for a given node (requires no configuration)
     void processPackets(const SharedNodePointer& node);
 
     // configure a round of mixing
-    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    void configureMix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            p_high_resolution_clock::time_point frameStart, const AudioMixerBroadcasts* broadcasts);
 
     // mix and broadcast non-ignored streams to the node (requires configuration using configureMix, above)
     // returns true if a mixed packet was sent to the node
@@ -44,14 +52,18 @@ public:
 
 private:
     // create mix, returns true if mix has audio
-    bool prepareMix(const SharedNodePointer& listener);
-    void throttleStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
-            const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
+    bool prepareMix(const SharedNodePointer& listener, bool isLate);
+    // the broadcast whose shared mix the listener hears, if any
+    const AudioMixerBroadcast* findBroadcast(const SharedNodePointer& listener, AudioMixerClientData& listenerData,
+            const AvatarAudioStream& listenerStream);
     void mixStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer);
     void addStream(AudioMixerClientData& listenerData, const QUuid& streamerID,
             const AvatarAudioStream& listenerStream, const PositionalAudioStream& streamer,
             bool throttle);
+    void addHostedInjector(AudioMixerClientData& listenerData, const QUuid& streamerID,
+            const AvatarAudioStream& listenerStream, const HostedAudioInjector& injector,
+            bool throttle);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
@@ -62,6 +74,8 @@ private:
     ConstIter _end;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    p_high_resolution_clock::time_point _frameStart;
+    const AudioMixerBroadcasts* _broadcasts { nullptr };
 };
 
 #endif // hifi_AudioMixerSlave_h
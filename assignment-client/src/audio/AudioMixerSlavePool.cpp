@@ -11,6 +11,11 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <limits>
+
+#include <glm/gtx/norm.hpp>
+
+#include "AudioMixerClientData.h"
 
 #include "AudioMixerSlavePool.h"
 
@@ -74,31 +79,108 @@ void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     run(begin, end);
 }
 
-void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio) {
+void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+        p_high_resolution_clock::time_point frameStart, const AudioMixerBroadcasts* broadcasts) {
     _function = &AudioMixerSlave::mix;
     _configure = [=](AudioMixerSlave& slave) {
-        slave.configureMix(_begin, _end, _frame, _throttlingRatio);
+        slave.configureMix(_begin, _end, _frame, _throttlingRatio, _frameStart, _broadcasts);
     };
     _frame = frame;
     _throttlingRatio = throttlingRatio;
+    _frameStart = frameStart;
+    _broadcasts = broadcasts;
 
+    prioritizeListeners(begin, end);
     run(begin, end);
 }
 
+void AudioMixerSlavePool::prioritizeListeners(ConstIter begin, ConstIter end) {
+    // find everything that is audible this frame (prepareFrame has already popped the streams)
+    struct Talker {
+        glm::vec3 position;
+        const Node* node;
+    };
+    std::vector<Talker> talkers;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+        if (data) {
+            for (auto& streamPair : data->getAudioStreams()) {
+                auto& stream = streamPair.second;
+                if (stream->lastPopSucceeded() && stream->getLastPopOutputLoudness() > 0.0f) {
+                    talkers.push_back({ stream->getPosition(), node.data() });
+                }
+            }
+            for (auto& injectorPair : data->getHostedInjectors()) {
+                auto& injector = injectorPair.second;
+                if (injector->hasFrame() && injector->getLoudness() > 0.0f) {
+                    talkers.push_back({ injector->getPosition(), node.data() });
+                }
+            }
+        }
+    });
+
+    // with nobody talking, every mix is as cheap and as (un)important as the next
+    _priorityOrder.clear();
+    if (talkers.empty()) {
+        return;
+    }
+
+    // order listeners by their distance to the closest talker, other than themselves
+    std::vector<std::pair<float, SharedNodePointer>> listeners;
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
+        auto avatarStream = data ? data->getAvatarAudioStream() : nullptr;
+
+        float closestTalker = std::numeric_limits<float>::max();
+        if (avatarStream) {
+            for (const auto& talker : talkers) {
+                if (talker.node != node.data()) {
+                    closestTalker = std::min(closestTalker, glm::distance2(talker.position, avatarStream->getPosition()));
+                }
+            }
+        }
+        listeners.emplace_back(closestTalker, node);
+    });
+
+    std::stable_sort(listeners.begin(), listeners.end(),
+        [](const std::pair<float, SharedNodePointer>& a, const std::pair<float, SharedNodePointer>& b) {
+            return a.first < b.first;
+        });
+
+    _priorityOrder.reserve(listeners.size());
+    for (auto& listener : listeners) {
+        _priorityOrder.push_back(std::move(listener.second));
+    }
+}
+
 void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
     _begin = begin;
     _end = end;
 
 #ifdef AUDIO_SINGLE_THREADED
     _configure(slave);
-    std::for_each(begin, end, [&](const SharedNodePointer& node) {
-        _function(slave, node);
-    });
+    if (!_priorityOrder.empty()) {
+        for (const auto& node : _priorityOrder) {
+            (slave.*_function)(node);
+        }
+    } else {
+        std::for_each(begin, end, [&](const SharedNodePointer& node) {
+            (slave.*_function)(node);
+        });
+    }
+    _priorityOrder.clear();
 #else
     // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.emplace(node);
-    });
+    if (!_priorityOrder.empty()) {
+        for (const auto& node : _priorityOrder) {
+            _queue.emplace(node);
+        }
+        _priorityOrder.clear();
+    } else {
+        std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+            _queue.emplace(node);
+        });
+    }
 
     {
         Lock lock(_mutex);
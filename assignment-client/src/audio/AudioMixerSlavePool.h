@@ -64,8 +64,9 @@ public:
     // process packets on slave threads
     void processPackets(ConstIter begin, ConstIter end);
 
-    // mix on slave threads
-    void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio);
+    // mix on slave threads, listeners closest to someone talking first
+    void mix(ConstIter begin, ConstIter end, unsigned int frame, float throttlingRatio,
+            p_high_resolution_clock::time_point frameStart, const AudioMixerBroadcasts* broadcasts);
 
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
@@ -75,6 +76,7 @@ public:
 
 private:
     void run(ConstIter begin, ConstIter end);
+    void prioritizeListeners(ConstIter begin, ConstIter end);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
@@ -98,8 +100,11 @@ private:
     Queue _queue;
     unsigned int _frame { 0 };
     float _throttlingRatio { 0.0f };
+    p_high_resolution_clock::time_point _frameStart;
+    const AudioMixerBroadcasts* _broadcasts { nullptr };
     ConstIter _begin;
     ConstIter _end;
+    std::vector<SharedNodePointer> _priorityOrder; // if set, the order run() queues the nodes in
 };
 
 #endif // hifi_AudioMixerSlavePool_h
@@ -11,16 +11,22 @@
 
 #include "AudioMixerStats.h"
 
+#include <algorithm>
+
 void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
     sumListenersSilent = 0;
+    sumListenersLate = 0;
+    sumListenersBroadcast = 0;
+    sumBroadcastEncodes = 0;
     totalMixes = 0;
     hrtfRenders = 0;
     hrtfSilentRenders = 0;
     hrtfThrottleRenders = 0;
     manualStereoMixes = 0;
     manualEchoMixes = 0;
+    mixLatency.fill(0);
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -30,13 +36,25 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
+    sumListenersLate += otherStats.sumListenersLate;
+    sumListenersBroadcast += otherStats.sumListenersBroadcast;
+    sumBroadcastEncodes += otherStats.sumBroadcastEncodes;
     totalMixes += otherStats.totalMixes;
     hrtfRenders += otherStats.hrtfRenders;
     hrtfSilentRenders += otherStats.hrtfSilentRenders;
     hrtfThrottleRenders += otherStats.hrtfThrottleRenders;
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
+    for (int i = 0; i < NUM_MIX_LATENCY_BUCKETS; ++i) {
+        mixLatency[i] += otherStats.mixLatency[i];
+    }
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
 }
+
+void AudioMixerStats::recordMixLatency(uint64_t usecs) {
+    const uint64_t USECS_PER_BUCKET = 1000;
+    uint64_t bucket = std::min(usecs / USECS_PER_BUCKET, (uint64_t)(NUM_MIX_LATENCY_BUCKETS - 1));
+    ++mixLatency[bucket];
+}
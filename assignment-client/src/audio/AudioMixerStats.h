@@ -12,14 +12,16 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
+#include <array>
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
+    int sumListenersLate { 0 };
+    int sumListenersBroadcast { 0 };
+    int sumBroadcastEncodes { 0 };
 
     int totalMixes { 0 };
 
@@ -30,12 +32,17 @@ struct AudioMixerStats {
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
+    // how long after the start of the frame each listener's mix was sent, in 1ms buckets (the last one is open)
+    static const int NUM_MIX_LATENCY_BUCKETS = 12;
+    std::array<int, NUM_MIX_LATENCY_BUCKETS> mixLatency {};
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
 
     void reset();
     void accumulate(const AudioMixerStats& otherStats);
+    void recordMixLatency(uint64_t usecs);
 };
 
 #endif // hifi_AudioMixerStats_h
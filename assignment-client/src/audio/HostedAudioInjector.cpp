@@ -0,0 +1,128 @@
+//
+//  HostedAudioInjector.cpp
+//  assignment-client/src/audio
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HostedAudioInjector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <AudioConstants.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// a looping injector (or one whose sound never loaded) is dropped if its client stops refreshing it for this long
+static const quint64 HOSTED_INJECTOR_TIMEOUT_USECS = 5 * USECS_PER_SECOND;
+
+static float sanitizeSeconds(float seconds) {
+    return std::isfinite(seconds) ? std::max(seconds, 0.0f) : 0.0f;
+}
+
+HostedAudioInjector::HostedAudioInjector(const QUuid& id, SharedSoundPointer sound, float playbackSeconds) :
+    _id(id),
+    _sound(sound)
+{
+    setPlaybackSeconds(playbackSeconds);
+    refresh();
+}
+
+void HostedAudioInjector::setPlaybackSeconds(float playbackSeconds) {
+    // once playing, the mixer keeps its own time, so that refreshes do not make it skip
+    if (_frameOffset < 0) {
+        _startSeconds = sanitizeSeconds(playbackSeconds);
+        _startUsecs = usecTimestampNow();
+    }
+}
+
+void HostedAudioInjector::refresh() {
+    _lastRefreshUsecs = usecTimestampNow();
+}
+
+bool HostedAudioInjector::isExpired(quint64 now) const {
+    return (_loop || !_hasFrame) && now - _lastRefreshUsecs > HOSTED_INJECTOR_TIMEOUT_USECS;
+}
+
+int HostedAudioInjector::getNumFrames() const {
+    return _sound->getByteArray().size() / (getNumChannels() * AudioConstants::SAMPLE_SIZE);
+}
+
+bool HostedAudioInjector::advanceFrame() {
+    if (!_sound->isReady()) {
+        _hasFrame = false;
+        return !_sound->isFailed();
+    }
+
+    // the mixer has no ambisonic renderer, clients play those locally
+    int numFrames = getNumFrames();
+    if (numFrames == 0 || _sound->isAmbisonic()) {
+        return false;
+    }
+
+    if (_frameOffset < 0) {
+        // start where the client is by now, which is later than requested if the sound took a while to load
+        float seconds = _startSeconds + (usecTimestampNow() - _startUsecs) / (float)USECS_PER_SECOND;
+        _frameOffset = (int)std::min(seconds * AudioConstants::SAMPLE_RATE, (float)numFrames);
+    } else {
+        _frameOffset += AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    }
+
+    if (_loop) {
+        _frameOffset %= numFrames;
+    } else if (_frameOffset >= numFrames) {
+        _hasFrame = false;
+        return false;
+    }
+
+    _hasFrame = true;
+    computeLoudness();
+    return true;
+}
+
+void HostedAudioInjector::readFrame(int16_t* output) const {
+    int numChannels = getNumChannels();
+    if (!_hasFrame) {
+        memset(output, 0, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * numChannels * sizeof(int16_t));
+        return;
+    }
+
+    const int16_t* samples = reinterpret_cast<const int16_t*>(_sound->getByteArray().constData());
+    int numFrames = getNumFrames();
+    int offset = _frameOffset;
+    int remaining = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    while (remaining > 0) {
+        int count = std::min(remaining, numFrames - offset);
+        memcpy(output, samples + offset * numChannels, count * numChannels * sizeof(int16_t));
+        output += count * numChannels;
+        remaining -= count;
+        offset += count;
+
+        if (offset >= numFrames) {
+            if (!_loop) {
+                memset(output, 0, remaining * numChannels * sizeof(int16_t));
+                break;
+            }
+            offset = 0;
+        }
+    }
+}
+
+void HostedAudioInjector::computeLoudness() {
+    int16_t frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    readFrame(frame);
+
+    int numSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * getNumChannels();
+    float loudness = 0.0f;
+    for (int i = 0; i < numSamples; ++i) {
+        loudness += (float)std::abs(frame[i]);
+    }
+    _loudness = loudness / numSamples / AudioConstants::MAX_SAMPLE_VALUE;
+}
@@ -0,0 +1,85 @@
+//
+//  HostedAudioInjector.h
+//  assignment-client/src/audio
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HostedAudioInjector_h
+#define hifi_HostedAudioInjector_h
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QtCore/QUuid>
+
+#include <Sound.h>
+
+// A sound that a client asked the mixer to play by reference, rather than streaming it as PCM.
+// The samples are read straight out of the Sound shared through the SoundCache, so every injector of the same
+// URL uses one decoded copy, and there is no per-injector ring buffer.
+//
+// Injectors are only changed on the AudioMixer assignment thread, between mixes; the slaves only read them.
+class HostedAudioInjector {
+public:
+    HostedAudioInjector(const QUuid& id, SharedSoundPointer sound, float playbackSeconds);
+
+    const QUuid& getID() const { return _id; }
+    const QUrl& getURL() const { return _sound->getURL(); }
+
+    void setPosition(const glm::vec3& position) { _position = position; }
+    void setOrientation(const glm::quat& orientation) { _orientation = orientation; }
+    void setVolume(float volume) { _volume = volume; }
+    void setLoop(bool loop) { _loop = loop; }
+
+    // the client's playback position, used to start in step with it once the sound has loaded
+    void setPlaybackSeconds(float playbackSeconds);
+
+    glm::vec3 getPosition() const { return _position; }
+    glm::quat getOrientation() const { return _orientation; }
+    float getVolume() const { return _volume; }
+    bool isStereo() const { return _sound->isStereo(); }
+
+    // true once the sound has loaded and a frame has been advanced to
+    bool hasFrame() const { return _hasFrame; }
+
+    // loudness of the current frame, as for PositionalAudioStream::getLastPopOutputLoudness
+    float getLoudness() const { return _loudness; }
+
+    // reads the current frame (interleaved, if stereo), padded with silence past the end of a sound that does not loop
+    void readFrame(int16_t* output) const;
+
+    // moves on to the next frame, returns false once a sound that does not loop has played out
+    bool advanceFrame();
+
+    // whether the client still refreshes this injector, if it loops
+    void refresh();
+    bool isExpired(quint64 now) const;
+
+private:
+    int getNumChannels() const { return isStereo() ? 2 : 1; }
+    int getNumFrames() const;
+    void computeLoudness();
+
+    QUuid _id;
+    SharedSoundPointer _sound;
+
+    glm::vec3 _position;
+    glm::quat _orientation;
+    float _volume { 1.0f };
+    bool _loop { false };
+
+    float _startSeconds { 0.0f };
+    quint64 _startUsecs { 0 };
+    quint64 _lastRefreshUsecs { 0 };
+
+    int _frameOffset { -1 };    // in sample frames, or -1 until the sound has loaded
+    bool _hasFrame { false };
+    float _loudness { 0.0f };
+};
+
+#endif // hifi_HostedAudioInjector_h
@@ -26,6 +26,7 @@
 #include <AvatarLogging.h>
 #include <LogHandler.h>
 #include <NodeList.h>
+#include <Profile.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
@@ -217,15 +218,20 @@ void AvatarMixer::start() {
     unsigned int frame = 1;
     auto frameTimestamp = p_high_resolution_clock::now();
 
+    // several frames late means avatars visibly freeze for everyone, so trace what led up to it
+    static const quint64 STALLED_FRAME_USECS = 5 * USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+
     while (!_isFinished) {
 
         auto frameDuration = timeFrame(frameTimestamp); // calculates last frame duration and sleeps remainder of target amount
         throttle(frameDuration, frame); // determines _throttlingRatio for upcoming mix frame
+        auto frameStart = usecTimestampNow();
 
         int lockWait, nodeTransform, functor;
 
         // Allow nodes to process any pending/queued packets across our worker threads
         {
+            PROFILE_RANGE(app, "AvatarMixer::processIncomingPackets");
             auto start = usecTimestampNow();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
@@ -257,6 +263,7 @@ void AvatarMixer::start() {
 
         // this is where we need to put the real work...
         {
+            PROFILE_RANGE(app, "AvatarMixer::broadcastAvatarData");
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
@@ -276,6 +283,11 @@ void AvatarMixer::start() {
         ++_numTightLoopFrames;
         _loopRate.increment();
 
+        auto frameUsecs = usecTimestampNow() - frameStart;
+        if (frameUsecs > STALLED_FRAME_USECS) {
+            tracing::TraceRing::getInstance().reportStall("Avatar mixer frame", frameUsecs);
+        }
+
         // play nice with qt event-looping
         {
             // since we're a while loop we need to yield to qt's event processing
@@ -21,8 +21,8 @@
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
-    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
-    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::queueEditingEntityPointer, Qt::QueuedConnection);
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::queueDeletingEntityPointer, Qt::QueuedConnection);
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -91,6 +91,8 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 void EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
+    processEntityChanges();
+
     if (viewFrustumChanged || _traversal.finished()) {
         ViewFrustum viewFrustum;
         nodeData->copyCurrentViewFrustum(viewFrustum);
@@ -467,6 +469,36 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     return true;
 }
 
+void EntityTreeSendThread::queueEditingEntityPointer(const EntityItemPointer& entity) {
+    if (entity) {
+        {
+            std::lock_guard<std::mutex> lock(_entityChangesMutex);
+            _entityChanges.push_back({ entity, nullptr });
+        }
+        _myServer->wakeSendThread(this);
+    }
+}
+
+void EntityTreeSendThread::queueDeletingEntityPointer(EntityItem* entity) {
+    std::lock_guard<std::mutex> lock(_entityChangesMutex);
+    _entityChanges.push_back({ EntityItemPointer(), entity });
+}
+
+void EntityTreeSendThread::processEntityChanges() {
+    std::vector<EntityChange> entityChanges;
+    {
+        std::lock_guard<std::mutex> lock(_entityChangesMutex);
+        entityChanges.swap(_entityChanges);
+    }
+    for (const auto& change : entityChanges) {
+        if (change.edited) {
+            editingEntityPointer(change.edited);
+        } else {
+            deletingEntityPointer(change.deleted);
+        }
+    }
+}
+
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
         if (_entitiesInQueue.find(entity.get()) == _entitiesInQueue.end() && _knownState.find(entity.get()) != _knownState.end()) {
@@ -12,7 +12,9 @@
 #ifndef hifi_EntityTreeSendThread_h
 #define hifi_EntityTreeSendThread_h
 
+#include <mutex>
 #include <unordered_set>
+#include <vector>
 
 #include "../octree/OctreeSendThread.h"
 
@@ -46,6 +48,9 @@ private:
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
     void preStartNewScene(OctreeQueryNode* nodeData, bool isFullScene) override {};
     bool shouldTraverseAndSend(OctreeQueryNode* nodeData) override { return true; }
+    bool hasPendingWork(OctreeQueryNode* nodeData) override { return !_sendQueue.empty() || !_traversal.finished(); }
+
+    void processEntityChanges();
 
     DiffTraversal _traversal;
     EntityPriorityQueue _sendQueue;
@@ -58,7 +63,21 @@ private:
     int32_t _numEntitiesOffset { 0 };
     uint16_t _numEntities { 0 };
 
+    // Entity edits and deletes are queued to the server's thread, which also destroys this object, so they can never
+    // arrive during or after its destruction. The send pass runs on a scheduler thread, so they are kept here (in
+    // order) and applied at the start of the next pass.
+    struct EntityChange {
+        EntityItemPointer edited;
+        EntityItem* deleted;
+    };
+    std::mutex _entityChangesMutex;
+    std::vector<EntityChange> _entityChanges;
+
 private slots:
+    void queueEditingEntityPointer(const EntityItemPointer& entity);
+    void queueDeletingEntityPointer(EntityItem* entity);
+
+private:
     void editingEntityPointer(const EntityItemPointer& entity);
     void deletingEntityPointer(EntityItem* entity);
 };
@@ -9,18 +9,27 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 #include "MessagesMixer.h"
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 
-MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
+static const int DEFAULT_MAX_MESSAGES_PER_SECOND_PER_CHANNEL = 1000;
+static const int MAX_CHANNELS_IN_STATS = 10;
+
+MessagesMixer::MessagesMixer(ReceivedMessage& message) :
+    ThreadedAssignment(message),
+    _maxMessagesPerSecondPerChannel(DEFAULT_MAX_MESSAGES_PER_SECOND_PER_CHANNEL)
 {
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &MessagesMixer::nodeKilled);
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -30,43 +39,115 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    for (auto it = _channels.begin(); it != _channels.end();) {
+        auto& subscribers = it->subscribers;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), killedNode), subscribers.end());
+        if (subscribers.empty()) {
+            it = _channels.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool MessagesMixer::allowMessage(Channel& channel, quint64 now) {
+    if (_maxMessagesPerSecondPerChannel <= 0) {
+        return true;
+    }
+
+    // allow bursts of up to a second's worth of messages
+    float maxMessages = (float)_maxMessagesPerSecondPerChannel;
+    if (channel.lastRefillUsecs == 0) {
+        channel.availableMessages = maxMessages;
+    } else {
+        float elapsedSeconds = (float)(now - channel.lastRefillUsecs) / USECS_PER_SECOND;
+        channel.availableMessages = std::min(maxMessages, channel.availableMessages + elapsedSeconds * maxMessages);
+    }
+    channel.lastRefillUsecs = now;
+
+    if (channel.availableMessages < 1.0f) {
+        return false;
     }
+    channel.availableMessages -= 1.0f;
+    return true;
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
+    QString channelName, message;
     QByteArray data;
     QUuid senderID;
     bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    MessagesClient::decodeMessagesPacket(receivedMessage, channelName, isText, message, data, senderID);
+
+    ++_numMessages;
+
+    auto it = _channels.find(channelName);
+    if (it == _channels.end()) {
+        // nobody is listening
+        ++_numUnroutedMessages;
+        return;
+    }
+
+    auto& channel = it.value();
+    ++channel.numMessages;
+
+    if (!allowMessage(channel, usecTimestampNow())) {
+        ++channel.numDroppedMessages;
+        ++_numDroppedMessages;
+        return;
+    }
+
+    // encode the message once, each subscriber then only gets a copy of the payload behind its own headers
+    auto encodedPacketList = isText ? MessagesClient::encodeMessagesPacket(channelName, message, senderID) :
+                                      MessagesClient::encodeMessagesDataPacket(channelName, data, senderID);
+    const QByteArray payload = encodedPacketList->getMessage();
 
     auto nodeList = DependencyManager::get<NodeList>();
+    for (auto& node : channel.subscribers) {
+        if (!node->getActiveSocket()) {
+            continue;
+        }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
+        auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+        packetList->write(payload);
         nodeList->sendPacketList(std::move(packetList), *node);
-    });
+
+        ++channel.numDeliveries;
+        ++_numDeliveries;
+        channel.bytesSent += payload.size();
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    QString channel = QString::fromUtf8(message->getMessage());
-    _channelSubscribers[channel] << senderNode->getUUID();
+    QString channelName = QString::fromUtf8(message->getMessage());
+    auto& subscribers = _channels[channelName].subscribers;
+    if (std::find(subscribers.begin(), subscribers.end(), senderNode) == subscribers.end()) {
+        subscribers.push_back(senderNode);
+    }
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
-    QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    QString channelName = QString::fromUtf8(message->getMessage());
+    auto it = _channels.find(channelName);
+    if (it != _channels.end()) {
+        auto& subscribers = it->subscribers;
+        subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), senderNode), subscribers.end());
+        if (subscribers.empty()) {
+            _channels.erase(it);
+        }
     }
 }
 
+void MessagesMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
+    const QString MESSAGES_MIXER_SETTINGS_KEY = "messages_mixer";
+    QJsonObject messagesMixerGroupObject = domainSettings[MESSAGES_MIXER_SETTINGS_KEY].toObject();
+
+    const QString MAX_MESSAGES_PER_SECOND_PER_CHANNEL_KEY = "max_messages_per_second_per_channel";
+    _maxMessagesPerSecondPerChannel = messagesMixerGroupObject[MAX_MESSAGES_PER_SECOND_PER_CHANNEL_KEY]
+        .toInt(DEFAULT_MAX_MESSAGES_PER_SECOND_PER_CHANNEL);
+    qDebug() << "The maximum messages per second per channel is" << _maxMessagesPerSecondPerChannel;
+}
+
 void MessagesMixer::sendStatsPacket() {
     QJsonObject statsObject, messagesMixerObject;
 
@@ -80,11 +161,58 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // only the busiest channels are listed individually
+    std::vector<QHash<QString, Channel>::iterator> busiestChannels;
+    for (auto it = _channels.begin(); it != _channels.end(); ++it) {
+        busiestChannels.push_back(it);
+    }
+    auto numListed = std::min((int)busiestChannels.size(), MAX_CHANNELS_IN_STATS);
+    std::partial_sort(busiestChannels.begin(), busiestChannels.begin() + numListed, busiestChannels.end(),
+        [](const QHash<QString, Channel>::iterator& a, const QHash<QString, Channel>::iterator& b) {
+            return a->numMessages > b->numMessages;
+        });
+
+    QJsonObject channelsObject;
+    for (int i = 0; i < numListed; ++i) {
+        auto& channel = busiestChannels[i].value();
+        QJsonObject channelStats;
+        channelStats["subscribers"] = (double)channel.subscribers.size();
+        channelStats["messages"] = (double)channel.numMessages;
+        channelStats["dropped_messages"] = (double)channel.numDroppedMessages;
+        channelStats["deliveries"] = (double)channel.numDeliveries;
+        channelStats["sent_kbytes"] = (double)channel.bytesSent / BYTES_PER_KILOBYTE;
+        channelsObject[busiestChannels[i].key()] = channelStats;
+    }
+
+    QJsonObject channelTotals;
+    channelTotals["channels"] = _channels.size();
+    channelTotals["messages"] = (double)_numMessages;
+    channelTotals["unrouted_messages"] = (double)_numUnroutedMessages;
+    channelTotals["dropped_messages"] = (double)_numDroppedMessages;
+    channelTotals["deliveries"] = (double)_numDeliveries;
+    channelTotals["busiest_channels"] = channelsObject;
+    statsObject["channels"] = channelTotals;
+
+    for (auto& channel : _channels) {
+        channel.numMessages = 0;
+        channel.numDroppedMessages = 0;
+        channel.numDeliveries = 0;
+        channel.bytesSent = 0;
+    }
+    _numMessages = 0;
+    _numUnroutedMessages = 0;
+    _numDroppedMessages = 0;
+    _numDeliveries = 0;
+
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
+
+    DomainHandler& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+    connect(&domainHandler, &DomainHandler::settingsReceived, this, &MessagesMixer::parseDomainServerSettings);
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 }
@@ -15,6 +15,8 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <vector>
+
 #include <ThreadedAssignment.h>
 
 /// Handles assignments of type MessagesMixer - distribution of avatar data to various clients
@@ -32,9 +34,33 @@ private slots:
     void handleMessages(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void parseDomainServerSettings(const QJsonObject& domainSettings);
 
 private:
-    QHash<QString,QSet<QUuid>> _channelSubscribers;
+    struct Channel {
+        std::vector<SharedNodePointer> subscribers;
+
+        // token bucket for the rate limit, refilled as messages come in
+        float availableMessages { 0.0f };
+        quint64 lastRefillUsecs { 0 };
+
+        // stats since the last stats packet
+        quint64 numMessages { 0 };
+        quint64 numDroppedMessages { 0 };
+        quint64 numDeliveries { 0 };
+        quint64 bytesSent { 0 };
+    };
+
+    bool allowMessage(Channel& channel, quint64 now);
+
+    QHash<QString, Channel> _channels;
+    int _maxMessagesPerSecondPerChannel;
+
+    // stats since the last stats packet
+    quint64 _numMessages { 0 };
+    quint64 _numUnroutedMessages { 0 };
+    quint64 _numDroppedMessages { 0 };
+    quint64 _numDeliveries { 0 };
 };
 
 #endif // hifi_MessagesMixer_h
@@ -14,6 +14,7 @@
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
+#include <Profile.h>
 
 #include "OctreeServer.h"
 #include "OctreeServerConsts.h"
@@ -160,6 +161,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             quint64 startProcess, startLock = usecTimestampNow();
             int editDataBytesRead;
             _myServer->getOctree()->withWriteLock([&] {
+                PROFILE_RANGE(app, "OctreeInboundPacketProcessor::processEdit");
                 startProcess = usecTimestampNow();
                 editDataBytesRead =
                     _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
@@ -177,6 +179,16 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
             processTime += thisProcessTime;
             lockWaitTime += thisLockWaitTime;
 
+            if (thisLockWaitTime > STALLED_TREE_LOCK_USECS) {
+                tracing::TraceRing::getInstance().reportStall("Entity edit waiting on the tree lock", thisLockWaitTime);
+            }
+
+            // an edit that reads nothing leaves nothing in the packet that can be trusted
+            if (editDataBytesRead <= 0) {
+                qDebug() << "OctreeInboundPacketProcessor::processPacket() edit read no data, dropping the rest of the packet";
+                break;
+            }
+
             // skip to next edit record in the packet
             message->seek(message->getPosition() + editDataBytesRead);
 
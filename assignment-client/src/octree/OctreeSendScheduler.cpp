@@ -0,0 +1,236 @@
+//
+//  OctreeSendScheduler.cpp
+//  assignment-client/src/octree
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "OctreeSendThread.h"
+#include "OctreeServerConsts.h"
+
+const int OctreeSendScheduler::MAX_PARKED_USECS = USECS_PER_SECOND;
+
+const std::array<quint64, OctreeSendScheduler::NUM_LATENESS_BUCKETS - 1> OctreeSendScheduler::LATENESS_BUCKET_LIMITS {{
+    1000, 2000, 5000, 10000, 20000, 50000
+}};
+
+OctreeSendScheduler::OctreeSendScheduler(int numThreads, ChangeStamp changeStamp) :
+    _changeStamp(changeStamp)
+{
+    numThreads = std::max(1, numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { run(); });
+    }
+}
+
+OctreeSendScheduler::~OctreeSendScheduler() {
+    stop();
+}
+
+void OctreeSendScheduler::add(OctreeSendThread* sendThread) {
+    Lock lock(_mutex);
+    Job& job = _jobs[sendThread];
+    job.sendThread = sendThread;
+    schedule(job, usecTimestampNow());
+}
+
+void OctreeSendScheduler::remove(OctreeSendThread* sendThread) {
+    Lock lock(_mutex);
+    // the job can't be erased from under a worker, so wait for its pass to end
+    // (look it up again after waiting, since other jobs may have been added meanwhile)
+    _doneCondition.wait(lock, [&] {
+        auto it = _jobs.find(sendThread);
+        return it == _jobs.end() || !it->second.isRunning;
+    });
+    // any entry left in the queue is stale from now on
+    _jobs.erase(sendThread);
+}
+
+void OctreeSendScheduler::wake(OctreeSendThread* sendThread) {
+    Lock lock(_mutex);
+    auto it = _jobs.find(sendThread);
+    if (it != _jobs.end()) {
+        wakeJob(it->second, usecTimestampNow());
+    }
+}
+
+void OctreeSendScheduler::wakeAll() {
+    Lock lock(_mutex);
+    quint64 now = usecTimestampNow();
+    for (auto& it : _jobs) {
+        wakeJob(it.second, now);
+    }
+}
+
+void OctreeSendScheduler::stop() {
+    {
+        Lock lock(_mutex);
+        _isStopping = true;
+    }
+    _workCondition.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+    _threads.clear();
+
+    Lock lock(_mutex);
+    _jobs.clear();
+    _queue = std::priority_queue<Entry>();
+    _doneCondition.notify_all();
+}
+
+void OctreeSendScheduler::schedule(Job& job, quint64 deadline) {
+    job.generation = ++_nextGeneration;
+    _queue.push({ deadline, job.generation, job.sendThread });
+    _workCondition.notify_one();
+}
+
+void OctreeSendScheduler::wakeJob(Job& job, quint64 now) {
+    if (job.isFinished) {
+        return;
+    }
+    if (job.isRunning) {
+        // whatever woke it may have happened after the pass looked, so don't let the pass park it
+        job.wokenWhileRunning = true;
+    } else if (job.isParked) {
+        job.isParked = false;
+        ++_numWakes;
+        schedule(job, now);
+    }
+}
+
+void OctreeSendScheduler::checkForTreeChanges(Lock& lock, quint64 now) {
+    if (now < _nextChangeCheck) {
+        return;
+    }
+    // advanced even without a stamp to read, since run() waits for it
+    _nextChangeCheck = now + OCTREE_SEND_INTERVAL_USECS;
+    if (!_changeStamp) {
+        return;
+    }
+
+    // whoever holds the tree's lock may be waiting on ours to wake a client, so don't hold ours while reading the stamp
+    lock.unlock();
+    quint64 changeStamp = _changeStamp();
+    lock.lock();
+
+    if (changeStamp != _lastChangeStamp) {
+        _lastChangeStamp = changeStamp;
+        for (auto& it : _jobs) {
+            wakeJob(it.second, now);
+        }
+    }
+}
+
+void OctreeSendScheduler::trackLateness(quint64 lateness) {
+    int bucket = 0;
+    while (bucket < (int)LATENESS_BUCKET_LIMITS.size() && lateness >= LATENESS_BUCKET_LIMITS[bucket]) {
+        ++bucket;
+    }
+    ++_latenessHistogram[bucket];
+    _totalLateness += lateness;
+    _maxLateness = std::max(_maxLateness, lateness);
+}
+
+void OctreeSendScheduler::run() {
+    Lock lock(_mutex);
+    while (!_isStopping) {
+        quint64 now = usecTimestampNow();
+        checkForTreeChanges(lock, now);
+
+        quint64 waitUntil = _nextChangeCheck;
+        if (!_queue.empty()) {
+            const Entry entry = _queue.top();
+            auto it = _jobs.find(entry.sendThread);
+            if (it == _jobs.end() || it->second.generation != entry.generation) {
+                // the job was removed or rescheduled since this entry was pushed
+                _queue.pop();
+                continue;
+            }
+
+            if (entry.deadline <= now) {
+                _queue.pop();
+                Job& job = it->second;
+                job.isRunning = true;
+                job.wokenWhileRunning = false;
+                if (job.isParked) {
+                    // reached the end of the parked interval without being woken
+                    job.isParked = false;
+                    ++_numParkedPasses;
+                }
+                ++_numPasses;
+                trackLateness(now - entry.deadline);
+
+                lock.unlock();
+                OctreeSendThread::PassResult result = job.sendThread->process();
+                quint64 end = usecTimestampNow();
+                lock.lock();
+
+                // references into _jobs stay valid across inserts, and remove() waits for isRunning to clear
+                job.isRunning = false;
+                if (result == OctreeSendThread::PassResult::Finished) {
+                    job.isFinished = true;
+                } else if (result == OctreeSendThread::PassResult::Busy || job.wokenWhileRunning) {
+                    schedule(job, std::max(now + OCTREE_SEND_INTERVAL_USECS, end));
+                } else {
+                    job.isParked = true;
+                    schedule(job, end + MAX_PARKED_USECS);
+                }
+                _doneCondition.notify_all();
+                continue;
+            }
+            waitUntil = std::min(waitUntil, entry.deadline);
+        }
+
+        // the clock may have moved past waitUntil while a stamp was being read; don't let the wait wrap around
+        _workCondition.wait_for(lock, std::chrono::microseconds(waitUntil > now ? waitUntil - now : 0));
+    }
+}
+
+QJsonObject OctreeSendScheduler::getStats() {
+    Lock lock(_mutex);
+
+    int numParked = 0;
+    for (auto& it : _jobs) {
+        if (it.second.isParked) {
+            ++numParked;
+        }
+    }
+
+    QJsonObject histogram;
+    quint64 lowerLimit = 0;
+    for (int i = 0; i < NUM_LATENESS_BUCKETS; ++i) {
+        QString label;
+        if (i < (int)LATENESS_BUCKET_LIMITS.size()) {
+            label = QString("%1. %2-%3 usecs").arg(i + 1).arg(lowerLimit).arg(LATENESS_BUCKET_LIMITS[i]);
+            lowerLimit = LATENESS_BUCKET_LIMITS[i];
+        } else {
+            label = QString("%1. %2+ usecs").arg(i + 1).arg(lowerLimit);
+        }
+        histogram[label] = (double)_latenessHistogram[i];
+    }
+
+    QJsonObject stats;
+    stats["1. threads"] = (double)_threads.size();
+    stats["2. clients"] = (double)_jobs.size();
+    stats["3. parkedClients"] = (double)numParked;
+    stats["4. passes"] = (double)_numPasses;
+    stats["5. parkedTimeoutPasses"] = (double)_numParkedPasses;
+    stats["6. wakes"] = (double)_numWakes;
+    stats["7. avgLatenessUsecs"] = _numPasses > 0 ? (double)_totalLateness / (double)_numPasses : 0.0;
+    stats["8. maxLatenessUsecs"] = (double)_maxLateness;
+    stats["9. latenessHistogram"] = histogram;
+    return stats;
+}
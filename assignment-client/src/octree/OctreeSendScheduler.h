@@ -0,0 +1,112 @@
+//
+//  OctreeSendScheduler.h
+//  assignment-client/src/octree
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Fixed pool of worker threads that runs the send passes of every connected client
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendScheduler_h
+#define hifi_OctreeSendScheduler_h
+
+#include <array>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+
+class OctreeSendThread;
+
+/// Runs OctreeSendThread::process() for each client on a fixed number of threads, ordered by deadline.
+///
+/// A client that had something to send is run again one send interval after its last pass started. A client
+/// with nothing to send is parked and costs nothing until it is woken: by its own query or nack packets, by
+/// an edit to an entity it knows about, or when the tree changes. Parked clients are still run every
+/// MAX_PARKED_USECS as a safety net.
+class OctreeSendScheduler {
+public:
+    using ChangeStamp = std::function<quint64()>;
+
+    static const int MAX_PARKED_USECS;
+
+    /// \param changeStamp returns a time that moves forward whenever the tree changes, checked once per interval.
+    /// It is called without the scheduler's lock held, so it may take the tree's lock.
+    OctreeSendScheduler(int numThreads, ChangeStamp changeStamp);
+    ~OctreeSendScheduler();
+
+    void add(OctreeSendThread* sendThread);
+
+    /// blocks until no pass is running for sendThread, after which the scheduler does not touch it again
+    void remove(OctreeSendThread* sendThread);
+
+    /// run a parked client as soon as possible
+    void wake(OctreeSendThread* sendThread);
+    void wakeAll();
+
+    /// stop the workers; no more passes will run
+    void stop();
+
+    int getNumThreads() const { return (int)_threads.size(); }
+    QJsonObject getStats();
+
+private:
+    struct Job {
+        OctreeSendThread* sendThread;
+        quint64 generation { 0 }; // identifies the queue entry that is current for this job
+        bool isParked { false };
+        bool isRunning { false };
+        bool isFinished { false };
+        bool wokenWhileRunning { false };
+    };
+
+    struct Entry {
+        quint64 deadline;
+        quint64 generation;
+        OctreeSendThread* sendThread;
+        bool operator<(const Entry& other) const { return deadline > other.deadline; } // earliest on top
+    };
+
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+    void run();
+    void schedule(Job& job, quint64 deadline); // requires _mutex
+    void wakeJob(Job& job, quint64 now); // requires _mutex
+    void checkForTreeChanges(Lock& lock, quint64 now); // requires _mutex, which it releases around _changeStamp
+    void trackLateness(quint64 lateness); // requires _mutex
+
+    ChangeStamp _changeStamp;
+    std::vector<std::thread> _threads;
+
+    Mutex _mutex;
+    std::condition_variable _workCondition;
+    std::condition_variable _doneCondition;
+    bool _isStopping { false };
+    std::unordered_map<OctreeSendThread*, Job> _jobs;
+    std::priority_queue<Entry> _queue;
+    quint64 _nextGeneration { 0 };
+    quint64 _lastChangeStamp { 0 };
+    quint64 _nextChangeCheck { 0 };
+
+    // stats, guarded by _mutex
+    static const int NUM_LATENESS_BUCKETS = 7;
+    static const std::array<quint64, NUM_LATENESS_BUCKETS - 1> LATENESS_BUCKET_LIMITS;
+    std::array<quint64, NUM_LATENESS_BUCKETS> _latenessHistogram {};
+    quint64 _totalLateness { 0 };
+    quint64 _maxLateness { 0 };
+    quint64 _numPasses { 0 };
+    quint64 _numParkedPasses { 0 };
+    quint64 _numWakes { 0 };
+};
+
+#endif // hifi_OctreeSendScheduler_h
@@ -9,13 +9,11 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
-#include <chrono>
-#include <thread>
-
 #include <NodeList.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
+#include <Profile.h>
 
 #include "OctreeSendThread.h"
 #include "OctreeServer.h"
@@ -32,7 +30,7 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
 {
     QString safeServerName("Octree");
 
-    // set our QThread object name so we can identify this thread while debugging
+    // set our object name so we can identify this client while debugging
     setObjectName(QString("Octree Send Thread (%1)").arg(uuidStringWithoutCurlyBraces(_nodeUuid)));
 
     if (_myServer) {
@@ -40,7 +38,7 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
     }
 
     qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client connected "
-                                            "- starting sending thread [" << this << "]";
+                                            "- starting sending [" << this << "]";
 
     OctreeServer::clientConnected();
 }
@@ -54,7 +52,7 @@ OctreeSendThread::~OctreeSendThread() {
     }
 
     qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client disconnected "
-                                            "- ending sending thread [" << this << "]";
+                                            "- ending sending [" << this << "]";
 
     OctreeServer::clientDisconnected();
     OctreeServer::stopTrackingThread(this);
@@ -65,60 +63,54 @@ void OctreeSendThread::setIsShuttingDown() {
 }
 
 
-bool OctreeSendThread::process() {
+OctreeSendThread::PassResult OctreeSendThread::process() {
     if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
+        return finish(); // exit early if we're shutting down
     }
 
     OctreeServer::didProcess(this);
 
-    quint64  start = usecTimestampNow();
-
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
     // don't do any send processing until the initial load of the octree is complete...
-    if (_myServer->isInitialLoadComplete()) {
-        if (auto node = _node.lock()) {
-            OctreeQueryNode* nodeData = static_cast<OctreeQueryNode*>(node->getLinkedData());
-
-            // Sometimes the node data has not yet been linked, in which case we can't really do anything
-            if (nodeData && !nodeData->isShuttingDown()) {
-                bool viewFrustumChanged = nodeData->updateCurrentViewFrustum();
-                packetDistributor(node, nodeData, viewFrustumChanged);
-            }
-        } else {
-            return false; // exit early if we're shutting down
-        }
+    if (!_myServer->isInitialLoadComplete()) {
+        return PassResult::Busy;
     }
 
-    if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
+    auto node = _node.lock();
+    if (!node) {
+        return finish();
     }
 
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
+    OctreeQueryNode* nodeData = static_cast<OctreeQueryNode*>(node->getLinkedData());
 
-        if (usecToSleep <= 0) {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usecToSleep = MIN_USEC_TO_SLEEP;
-        }
+    // Sometimes the node data has not yet been linked, in which case we can't really do anything
+    if (!nodeData || nodeData->isShuttingDown()) {
+        return PassResult::Busy;
+    }
 
-        {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
-        }
+    bool viewFrustumChanged = nodeData->updateCurrentViewFrustum();
+    packetDistributor(node, nodeData, viewFrustumChanged);
 
+    if (_isShuttingDown) {
+        return finish(); // exit early if we're shutting down
     }
 
-    return isStillRunning();  // keep running till they terminate us
+    // with a settled view and everything sent there is nothing to do until the tree or the view changes
+    bool isIdle = !viewFrustumChanged && !nodeData->getViewFrustumJustStoppedChanging() &&
+        !nodeData->isPacketWaiting() && !nodeData->hasNextNackedPacket() && !hasPendingWork(nodeData);
+    return isIdle ? PassResult::Idle : PassResult::Busy;
+}
+
+OctreeSendThread::PassResult OctreeSendThread::finish() {
+    if (!_hasFinished) {
+        _hasFinished = true;
+        emit finished();
+    }
+    return PassResult::Finished;
 }
 
-AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
-AtomicUIntStat OctreeSendThread::_usleepCalls { 0 };
 AtomicUIntStat OctreeSendThread::_totalBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalWastedBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalPackets { 0 };
@@ -468,7 +460,12 @@ bool OctreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamPara
         quint64 lockWaitStart = encodeStart;
 
         _myServer->getOctree()->withReadLock([&]{
-            OctreeServer::trackTreeWaitTime((float)(usecTimestampNow() - lockWaitStart));
+            PROFILE_RANGE(app, "OctreeSendThread::encode");
+            quint64 lockWait = usecTimestampNow() - lockWaitStart;
+            OctreeServer::trackTreeWaitTime((float)lockWait);
+            if (lockWait > STALLED_TREE_LOCK_USECS) {
+                tracing::TraceRing::getInstance().reportStall("Octree send waiting on the tree lock", lockWait);
+            }
 
             OctreeElementPointer subTree = nodeData->elementBag.extract();
             if (subTree) {
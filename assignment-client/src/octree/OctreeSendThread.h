@@ -16,7 +16,8 @@
 
 #include <atomic>
 
-#include <GenericThread.h>
+#include <QObject>
+
 #include <Node.h>
 #include <OctreePacketData.h>
 #include "OctreeQueryNode.h"
@@ -26,13 +27,22 @@ class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
-class OctreeSendThread : public GenericThread {
+/// Processor for sending octree packets to a single client. Its passes are run by the server's OctreeSendScheduler.
+class OctreeSendThread : public QObject {
     Q_OBJECT
 public:
+    enum class PassResult {
+        Busy,     // run again at the next send interval
+        Idle,     // nothing left to send, wait until something changes
+        Finished  // the client is gone, never run again
+    };
+
     OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
     virtual ~OctreeSendThread();
 
+    /// Runs one send pass for this client.
+    PassResult process();
+
     void setIsShuttingDown();
     bool isShuttingDown() { return _isShuttingDown; }
 
@@ -45,13 +55,11 @@ public:
     static AtomicUIntStat _totalSpecialBytes;
     static AtomicUIntStat _totalSpecialPackets;
 
-    static AtomicUIntStat _usleepTime;
-    static AtomicUIntStat _usleepCalls;
+signals:
+    /// emitted once, from the pass that finds the client gone
+    void finished();
 
 protected:
-    /// Implements generic processing behavior for this thread.
-    virtual bool process() override;
-
     virtual void traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene);
     virtual bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters);
@@ -70,13 +78,17 @@ private:
     virtual bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) { return viewFrustumChanged || !hasSomethingToSend(nodeData); }
     virtual void preStartNewScene(OctreeQueryNode* nodeData, bool isFullScene);
     virtual bool shouldTraverseAndSend(OctreeQueryNode* nodeData) { return hasSomethingToSend(nodeData); }
+    virtual bool hasPendingWork(OctreeQueryNode* nodeData) { return hasSomethingToSend(nodeData); }
+
+    PassResult finish();
 
     QUuid _nodeUuid;
 
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
-    bool _isShuttingDown { false };
+    std::atomic<bool> _isShuttingDown { false };
+    bool _hasFinished { false };
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -13,6 +13,7 @@
 
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QThread>
 #include <QTimer>
 
 #include <time.h>
@@ -233,6 +234,7 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _statusPort(0),
     _packetsPerClientPerInterval(10),
     _packetsTotalPerInterval(DEFAULT_PACKETS_PER_INTERVAL),
+    _numSendThreads(std::max(1, QThread::idealThreadCount() / 2)),
     _tree(NULL),
     _wantPersist(true),
     _debugSending(false),
@@ -892,9 +894,9 @@ OctreeServer::UniqueSendThread OctreeServer::newSendThread(const SharedNodePoint
 OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePointer& node) {
     auto sendThread = newSendThread(node);
 
-    // we want to be notified when the thread finishes
-    connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+    // we want to be notified when the client is done
+    connect(sendThread.get(), &OctreeSendThread::finished, this, &OctreeServer::removeSendThread);
+    _sendScheduler->add(sendThread.get());
 
     return sendThread;
 }
@@ -902,11 +904,18 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
+        // make sure no pass is still using it, then delete the unique_ptr, so sendThread is destructed after that line
+        _sendScheduler->remove(sendThread);
         _sendThreads.erase(sendThread->getNodeUuid());
     }
 }
 
+void OctreeServer::wakeSendThread(OctreeSendThread* sendThread) {
+    if (_sendScheduler) {
+        _sendScheduler->wake(sendThread);
+    }
+}
+
 void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     if (!_isFinished && !_isShuttingDown) {
         // If we got a query packet, then we're talking to an agent, and we
@@ -918,9 +927,13 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         if (it == _sendThreads.end()) {
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
         } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
+            _sendScheduler->remove(it->second.get());
+            _sendThreads.erase(it); // Remove right away, the scheduler is done with it
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
+        } else {
+            // the view may have changed
+            _sendScheduler->wake(it->second.get());
         }
     }
 }
@@ -931,6 +944,11 @@ void OctreeServer::handleOctreeDataNackPacket(QSharedPointer<ReceivedMessage> me
     OctreeQueryNode* nodeData = dynamic_cast<OctreeQueryNode*>(senderNode->getLinkedData());
     if (nodeData) {
         nodeData->parseNackPacket(*message);
+
+        auto it = _sendThreads.find(senderNode->getUUID());
+        if (it != _sendThreads.end()) {
+            _sendScheduler->wake(it->second.get());
+        }
     }
 }
 
@@ -1209,6 +1227,13 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // Check to see if the user passed in a command line option for the number of threads sending to clients
+    int sendThreads = -1;
+    if (readOptionInt(QString("sendThreads"), settingsSectionObject, sendThreads) && sendThreads > 0) {
+        _numSendThreads = sendThreads;
+    }
+    qDebug("sendThreads=%d", _numSendThreads);
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1248,6 +1273,16 @@ void OctreeServer::domainSettingsRequestComplete() {
 
     readConfiguration();
 
+    // every client is served by this fixed pool, and an idle client is only run again once the tree changes
+    _sendScheduler.reset(new OctreeSendScheduler(_numSendThreads, [this] {
+        quint64 lastChanged = 0;
+        _tree->withReadLock([&] {
+            auto root = _tree->getRoot();
+            lastChanged = root ? root->getLastChanged() : 0;
+        });
+        return lastChanged;
+    }));
+
     beforeRun(); // after payload has been processed
 
     connect(nodeList.data(), SIGNAL(nodeAdded(SharedNodePointer)), SLOT(nodeAdded(SharedNodePointer)));
@@ -1405,6 +1440,8 @@ void OctreeServer::nodeKilled(SharedNodePointer node) {
     if (it != _sendThreads.end()) {
         auto& sendThread = *it->second;
         sendThread.setIsShuttingDown();
+        // let its next pass notice
+        _sendScheduler->wake(&sendThread);
     }
 
     // calling this here since nodeKilled slot in ReceivedPacketProcessor can't be triggered by signals yet!!
@@ -1452,8 +1489,11 @@ void OctreeServer::aboutToFinish() {
         sendThread.setIsShuttingDown();
     }
 
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Stopping the scheduler waits for any running pass to be done, so it is then safe to
+    // destruct all the unique_ptr to OctreeSendThreads
+    if (_sendScheduler) {
+        _sendScheduler->stop();
+    }
     _sendThreads.clear(); // Cleans up all the send threads.
 
     if (_persistThread) {
@@ -1579,6 +1619,9 @@ void OctreeServer::sendStatsPacket() {
     statsArray1["4. persistFileLoadTime"] = getFileLoadTime();
     statsArray1["5. clients"] = getCurrentClientCount();
     statsArray1["6. threads"] = threadsStats;
+    if (_sendScheduler) {
+        statsArray1["7. sendScheduler"] = _sendScheduler->getStats();
+    }
 
     // Octree Stats
     QJsonObject octreeStats;
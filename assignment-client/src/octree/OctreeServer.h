@@ -23,6 +23,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendScheduler.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -64,6 +65,9 @@ public:
     QString getPersistFileMimeType() const { return (_persistThread) ? _persistThread->getPersistFileMimeType() : "text/plain"; }
     QByteArray getPersistFileContents() const { return (_persistThread) ? _persistThread->getPersistFileContents() : QByteArray(); }
 
+    /// run a client's send pass as soon as possible, e.g. because something it knows about changed (thread-safe)
+    void wakeSendThread(OctreeSendThread* sendThread);
+
     // Subclasses must implement these methods
     virtual std::unique_ptr<OctreeQueryNode> createOctreeQueryNode() = 0;
     virtual char getMyNodeType() const = 0;
@@ -184,6 +188,7 @@ protected:
     QString _backupDirectoryPath;
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
+    int _numSendThreads;
     OctreePointer _tree; // this IS a reaveraging tree
     bool _wantPersist;
     bool _debugSending;
@@ -207,6 +212,7 @@ protected:
     QString _safeServerName;
     
     SendThreads _sendThreads;
+    std::unique_ptr<OctreeSendScheduler> _sendScheduler;
 
     static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
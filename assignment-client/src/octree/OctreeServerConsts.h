@@ -27,4 +27,7 @@ const int MAX_FILENAME_LENGTH = 1024;
 const int INTERVALS_PER_SECOND = 90;
 const int OCTREE_SEND_INTERVAL_USECS = (1000 * 1000)/INTERVALS_PER_SECOND;
 
+/// Waiting this long for the octree lock holds up edits or sends noticeably, so a trace of what led up to it is kept
+const quint64 STALLED_TREE_LOCK_USECS = 100 * 1000;
+
 #endif // hifi_OctreeServerConsts_h
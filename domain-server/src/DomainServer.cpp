@@ -71,7 +71,9 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     _automaticNetworkingSetting(),
     _settingsManager(),
     _iceServerAddr(ICE_SERVER_DEFAULT_HOSTNAME),
-    _iceServerPort(ICE_SERVER_DEFAULT_PORT)
+    _iceServerPort(ICE_SERVER_DEFAULT_PORT),
+    // start somewhere new each run, so a node can't mistake a list revision from a previous run for one of ours
+    _lastDomainListRevision((DomainListRevision)(usecTimestampNow() / USECS_PER_MSEC))
 {
     parseCommandLine();
 
@@ -935,6 +937,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
+    // the domain list the node has, so that it only needs to hear what changed since
+    DomainListRevision domainListRevision = NO_DOMAIN_LIST_REVISION;
+    packetStream >> domainListRevision;
+    nodeData->acknowledgeDomainList(domainListRevision);
+
     sendDomainListToNode(sendingNode, message->getSenderSockAddr());
 }
 
@@ -1034,7 +1041,8 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(newNode->getLinkedData());
 
-    // reply back to the user with a PacketType::DomainList
+    // reply back to the user with a full PacketType::DomainList
+    nodeData->acknowledgeDomainList(NO_DOMAIN_LIST_REVISION);
     sendDomainListToNode(newNode, nodeData->getSendingSockAddr());
 
     // if this node is a user (unassigned Agent), signal
@@ -1051,51 +1059,102 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
+// FNV-1a, to tell whether what we would send about a node differs from what we sent last time
+static quint64 fingerprintForDomainListEntry(const QByteArray& entry) {
+    const quint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    const quint64 FNV_PRIME = 1099511628211ULL;
+
+    quint64 fingerprint = FNV_OFFSET_BASIS;
+    for (auto byte : entry) {
+        fingerprint = (fingerprint ^ (quint8)byte) * FNV_PRIME;
+    }
+    return fingerprint;
+}
+
 void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2
+        + 2 * sizeof(DomainListRevision) + sizeof(quint32);
+
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // the list is sent as the changes from the last one the node acknowledged, if any
+    const auto& baseList = nodeData->getAcknowledgedDomainList();
+
+    DomainServerNodeData::DomainList newList;
+    newList.revision = ++_lastDomainListRevision;
+    if (newList.revision == NO_DOMAIN_LIST_REVISION) {
+        newList.revision = ++_lastDomainListRevision;
+    }
+
+    std::vector<std::pair<SharedNodePointer, QByteArray>> changedNodes;
+    std::vector<QUuid> removedNodes;
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+    if (nodeInterestSet.size() > 0 && nodeData->isAuthenticated()) {
+        // if this authenticated node has any interest types, find those nodes and what changed about them
+        limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+            if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                QByteArray entry;
+                QDataStream entryStream(&entry, QIODevice::WriteOnly);
+                entryStream << *otherNode.data();
+
+                auto fingerprint = fingerprintForDomainListEntry(entry);
+                newList.entries.insert(otherNode->getUUID(), fingerprint);
+
+                auto it = baseList.entries.find(otherNode->getUUID());
+                if (it == baseList.entries.end() || it.value() != fingerprint) {
+                    changedNodes.emplace_back(otherNode, entry);
+                }
+            }
+        });
+    }
+
+    for (auto it = baseList.entries.begin(); it != baseList.entries.end(); ++it) {
+        if (!newList.entries.contains(it.key())) {
+            removedNodes.push_back(it.key());
+        }
+    }
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
 
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
+    extendedHeaderStream << newList.revision << baseList.revision;
+    extendedHeaderStream << (quint32)(changedNodes.size() + removedNodes.size());
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
-
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+    for (auto& changedNode : changedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-    if (nodeInterestSet.size() > 0) {
+        domainListStream << (quint8)DomainListRecordType::Node;
+        domainListPackets->write(changedNode.second);
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+        // pack the secret that these two nodes will use to communicate with each other,
+        // only made when the pair is first told about each other
+        domainListStream << connectionSecretForNodes(node, changedNode.first);
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
-
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
+    }
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+    for (auto& removedNode : removedNodes) {
+        domainListPackets->startSegment();
+        domainListStream << (quint8)DomainListRecordType::RemovedNode << removedNode;
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -1103,6 +1162,8 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
 
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+
+    nodeData->setSentDomainList(std::move(newList));
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
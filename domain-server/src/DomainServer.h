@@ -246,6 +246,8 @@ private:
     bool _sendICEServerAddressToMetaverseAPIRedo { false };
 
     QHash<QUuid, QPointer<HTTPSConnection>> _pendingOAuthConnections;
+
+    DomainListRevision _lastDomainListRevision;
 };
 
 
@@ -25,6 +25,16 @@ DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
+void DomainServerNodeData::acknowledgeDomainList(DomainListRevision revision) {
+    if (revision != NO_DOMAIN_LIST_REVISION && revision == _sentDomainList.revision) {
+        _acknowledgedDomainList = std::move(_sentDomainList);
+        _sentDomainList = DomainList();
+    } else if (revision != _acknowledgedDomainList.revision) {
+        // the node lost track of its list (or never had one), start over from a full list
+        _acknowledgedDomainList = DomainList();
+    }
+}
+
 void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
     auto document = QJsonDocument::fromBinaryData(statsByteArray);
     Q_ASSERT(document.isObject());
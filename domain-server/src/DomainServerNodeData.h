@@ -17,12 +17,19 @@
 #include <QtCore/QUuid>
 
 #include <HifiSockAddr.h>
+#include <LimitedNodeList.h>
 #include <NLPacket.h>
 #include <NodeData.h>
 #include <NodeType.h>
 
 class DomainServerNodeData : public NodeData {
 public:
+    /// What a revision of the domain list sent to this node said about each of the other nodes
+    struct DomainList {
+        DomainListRevision revision { NO_DOMAIN_LIST_REVISION };
+        QHash<QUuid, quint64> entries; // node UUID => fingerprint of its entry
+    };
+
     DomainServerNodeData();
 
     const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
@@ -48,6 +55,12 @@ public:
 
     QHash<QUuid, QUuid>& getSessionSecretHash() { return _sessionSecretHash; }
 
+    /// Called with the revision the node says it has, 0 if none. The next list sent is a delta from the
+    /// acknowledged list, or a full list if the node has neither that nor the last one sent.
+    void acknowledgeDomainList(DomainListRevision revision);
+    const DomainList& getAcknowledgedDomainList() const { return _acknowledgedDomainList; }
+    void setSentDomainList(DomainList sentDomainList) { _sentDomainList = std::move(sentDomainList); }
+
     const NodeSet& getNodeInterestSet() const { return _nodeInterestSet; }
     void setNodeInterestSet(const NodeSet& nodeInterestSet) { _nodeInterestSet = nodeInterestSet; }
     
@@ -74,6 +87,8 @@ private:
     QJsonArray overrideValuesIfNeeded(const QJsonArray& newStats);
     
     QHash<QUuid, QUuid> _sessionSecretHash;
+    DomainList _acknowledgedDomainList;
+    DomainList _sentDomainList;
     QUuid _assignmentUUID;
     QUuid _walletUUID;
     QString _username;
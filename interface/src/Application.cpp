@@ -4436,6 +4436,9 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    auto shapeCache = std::make_shared<ShapeCache>();
+    shapeCache->initialize();
+    _shapeManager.setShapeCache(shapeCache);
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
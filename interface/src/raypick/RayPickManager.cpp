@@ -10,6 +10,11 @@
 //
 #include "RayPickManager.h"
 
+#include <cfloat>
+
+#include <Profile.h>
+#include <TBBHelpers.h>
+
 #include "Application.h"
 #include "EntityScriptingInterface.h"
 #include "ui/overlays/Overlays.h"
@@ -42,9 +47,73 @@ void RayPickManager::cacheResult(const bool intersects, const RayPickResult& res
     }
 }
 
+void RayPickManager::findEntityIntersections(const std::vector<PendingRayPick>& pendingRayPicks, RayPickCache& results) {
+    // one query per ray and entity filter, as the cache would have it
+    struct EntityQuery {
+        const PendingRayPick* pick;
+        RayPickFilter::Flags mask;
+        bool intersects { false };
+        float distance { FLT_MAX };
+        BoxFace face;
+        glm::vec3 surfaceNormal;
+        EntityItemPointer entity;
+    };
+    std::vector<EntityQuery> queries;
+
+    for (auto& pending : pendingRayPicks) {
+        const RayPickFilter& filter = pending.rayPick->getFilter();
+        if (!filter.doesPickEntities()) {
+            continue;
+        }
+        RayPickFilter::Flags entityMask = filter.getEntityFlags();
+        auto& rayResults = results[pending.rayKey];
+        if (rayResults.find(entityMask) == rayResults.end()) {
+            rayResults[entityMask] = RayPickResult(pending.ray);
+            EntityQuery query;
+            query.pick = &pending;
+            query.mask = entityMask;
+            queries.push_back(query);
+        }
+    }
+
+    auto entityTree = DependencyManager::get<EntityScriptingInterface>()->getEntityTree();
+    if (queries.empty() || !entityTree) {
+        return;
+    }
+
+    // the tree stays read locked while the hierarchy is in use, so that no entity is changed or deleted under it
+    entityTree->withReadLock([&] {
+        PROFILE_RANGE(simulation, "traceEntityRays");
+        _entityBoundsHierarchy.update(entityTree);
+
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, queries.size()), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                EntityQuery& query = queries[i];
+                const PendingRayPick& pending = *query.pick;
+                const RayPickFilter& filter = pending.rayPick->getFilter();
+                query.intersects = _entityBoundsHierarchy.findRayIntersection(pending.ray.origin, pending.ray.direction,
+                    pending.rayPick->getIncludeEntites(), pending.rayPick->getIgnoreEntites(),
+                    !filter.doesPickInvisible(), !filter.doesPickNonCollidable(), !filter.doesPickCourse(),
+                    query.distance, query.face, query.surfaceNormal, query.entity);
+            }
+        });
+    });
+
+    for (auto& query : queries) {
+        if (query.intersects) {
+            const PickRay& ray = query.pick->ray;
+            glm::vec3 intersection = ray.origin + ray.direction * query.distance;
+            results[query.pick->rayKey][query.mask] = RayPickResult(IntersectionType::ENTITY, query.entity->getEntityItemID(),
+                query.distance, intersection, ray, query.surfaceNormal);
+        }
+    }
+}
+
 void RayPickManager::update() {
     QReadLocker lock(&_containsLock);
     RayPickCache results;
+
+    std::vector<PendingRayPick> pendingRayPicks;
     for (auto& uid : _rayPicks.keys()) {
         std::shared_ptr<RayPick> rayPick = _rayPicks[uid];
         if (!rayPick->isEnabled() || rayPick->getFilter().doesPickNothing() || rayPick->getMaxDistance() < 0.0f) {
@@ -58,25 +127,21 @@ void RayPickManager::update() {
             continue;
         }
 
-        QPair<glm::vec3, glm::vec3> rayKey = QPair<glm::vec3, glm::vec3>(ray.origin, ray.direction);
+        pendingRayPicks.push_back({ uid, rayPick, ray, QPair<glm::vec3, glm::vec3>(ray.origin, ray.direction) });
+    }
+
+    // the entity rays of all the picks are traced at once, the other results are then found one pick at a time
+    findEntityIntersections(pendingRayPicks, results);
+
+    for (auto& pending : pendingRayPicks) {
+        const QUuid& uid = pending.uid;
+        const std::shared_ptr<RayPick>& rayPick = pending.rayPick;
+        const PickRay& ray = pending.ray;
+        QPair<glm::vec3, glm::vec3> rayKey = pending.rayKey;
         RayPickResult res = RayPickResult(ray);
 
         if (rayPick->getFilter().doesPickEntities()) {
-            RayToEntityIntersectionResult entityRes;
-            bool fromCache = true;
-            bool invisible = rayPick->getFilter().doesPickInvisible();
-            bool nonCollidable = rayPick->getFilter().doesPickNonCollidable();
-            RayPickFilter::Flags entityMask = rayPick->getFilter().getEntityFlags();
-            if (!checkAndCompareCachedResults(rayKey, results, res, entityMask)) {
-                entityRes = DependencyManager::get<EntityScriptingInterface>()->findRayIntersectionVector(ray, !rayPick->getFilter().doesPickCourse(),
-                    rayPick->getIncludeEntites(), rayPick->getIgnoreEntites(), !invisible, !nonCollidable);
-                fromCache = false;
-            }
-
-            if (!fromCache) {
-                cacheResult(entityRes.intersects, RayPickResult(IntersectionType::ENTITY, entityRes.entityID, entityRes.distance, entityRes.intersection, ray, entityRes.surfaceNormal),
-                    entityMask, res, rayKey, results);
-            }
+            checkAndCompareCachedResults(rayKey, results, res, rayPick->getFilter().getEntityFlags());
         }
 
         if (rayPick->getFilter().doesPickOverlays()) {
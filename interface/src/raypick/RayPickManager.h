@@ -19,8 +19,11 @@
 
 #include "RegisteredMetaTypes.h"
 
+#include <EntityBoundsHierarchy.h>
+
 #include <unordered_map>
 #include <queue>
+#include <vector>
 
 class RayPickResult;
 
@@ -55,6 +58,18 @@ private:
     // Returns true if this ray exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(QPair<glm::vec3, glm::vec3>& ray, RayPickCache& cache, RayPickResult& res, const RayPickFilter::Flags& mask);
     void cacheResult(const bool intersects, const RayPickResult& resTemp, const RayPickFilter::Flags& mask, RayPickResult& res, QPair<glm::vec3, glm::vec3>& ray, RayPickCache& cache);
+
+    struct PendingRayPick {
+        QUuid uid;
+        std::shared_ptr<RayPick> rayPick;
+        PickRay ray;
+        QPair<glm::vec3, glm::vec3> rayKey;
+    };
+
+    // Traces the entity rays of all the picks in one parallel pass through _entityBoundsHierarchy, and caches the results
+    void findEntityIntersections(const std::vector<PendingRayPick>& pendingRayPicks, RayPickCache& results);
+
+    EntityBoundsHierarchy _entityBoundsHierarchy;
 };
 
 #endif // hifi_RayPickManager_h
\ No newline at end of file
@@ -167,7 +167,6 @@ AudioClient::AudioClient() :
     _audioOutput(NULL),
     _desiredOutputFormat(),
     _outputFormat(),
-    _outputFrameSize(0),
     _numOutputCallbackBytes(0),
     _loopbackAudioOutput(NULL),
     _loopbackOutputDevice(NULL),
@@ -1308,32 +1307,14 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
 }
 
 void AudioClient::processReceivedSamples(const QByteArray& decodedBuffer, QByteArray& outputBuffer) {
-
-    const int16_t* decodedSamples = reinterpret_cast<const int16_t*>(decodedBuffer.data());
-    assert(decodedBuffer.size() == AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-
-    outputBuffer.resize(_outputFrameSize * AudioConstants::SAMPLE_SIZE);
-    int16_t* outputSamples = reinterpret_cast<int16_t*>(outputBuffer.data());
-
     bool hasReverb = _reverb || _receivedAudioStream.hasReverb();
-
-    // apply stereo reverb
     if (hasReverb) {
         updateReverbOptions();
-        int16_t* reverbSamples = _networkToOutputResampler ? _networkScratchBuffer : outputSamples;
-        _listenerReverb.render(decodedSamples, reverbSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
     }
 
-    // resample to output sample rate
-    if (_networkToOutputResampler) {
-        const int16_t* inputSamples = hasReverb ? _networkScratchBuffer : decodedSamples;
-        _networkToOutputResampler->render(inputSamples, outputSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-    }
-
-    // if no transformations were applied, we still need to copy the buffer
-    if (!hasReverb && !_networkToOutputResampler) {
-        memcpy(outputSamples, decodedSamples, decodedBuffer.size());
-    }
+    // apply stereo reverb, and resample to output sample rate, however many frames the jitter buffer stretched this to
+    MixedProcessedAudioStream::renderToOutput(decodedBuffer, outputBuffer, hasReverb ? &_listenerReverb : nullptr,
+                                              _networkToOutputResampler, _networkScratchBuffer);
 }
 
 void AudioClient::sendMuteEnvironmentPacket() {
@@ -1413,8 +1394,6 @@ bool AudioClient::outputLocalInjector(const AudioInjectorPointer& injector) {
 }
 
 void AudioClient::outputFormatChanged() {
-    _outputFrameSize = (AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * OUTPUT_CHANNEL_COUNT * _outputFormat.sampleRate()) /
-        _desiredOutputFormat.sampleRate();
     _receivedAudioStream.outputFormatChanged(_outputFormat.sampleRate(), OUTPUT_CHANNEL_COUNT);
 }
 
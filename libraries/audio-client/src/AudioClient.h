@@ -296,7 +296,6 @@ private:
     QAudioOutput* _audioOutput;
     QAudioFormat _desiredOutputFormat;
     QAudioFormat _outputFormat;
-    int _outputFrameSize;
     int _numOutputCallbackBytes;
     QAudioOutput* _loopbackAudioOutput;
     QIODevice* _loopbackOutputDevice;
@@ -341,8 +340,8 @@ private:
     AudioSRC* _networkToOutputResampler;
     AudioSRC* _localToOutputResampler;
 
-    // for network audio (used by network audio thread)
-    int16_t _networkScratchBuffer[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+    // for network audio (used by network audio thread), as long as the longest frame the jitter buffer stretched
+    std::vector<int16_t> _networkScratchBuffer;
 
     // for output audio (used by this thread)
     int _outputPeriod { 0 };
@@ -0,0 +1,51 @@
+//
+//  AudioBitrateController.cpp
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioBitrateController.h"
+
+#include <algorithm>
+#include <cmath>
+
+const int AudioBitrateController::BITRATE_LEVELS[NUM_LEVELS] = { 16000, 24000, 32000, 48000, 64000 };
+
+// weight of the newest report in the smoothed loss (reports come about once a second)
+static const float LOSS_SMOOTHING = 0.3f;
+
+static const float CONGESTED_LOSS = 0.05f;
+static const int CONGESTED_RTT_MSECS = 400;
+
+static const float CLEAN_LOSS = 0.01f;
+static const int CLEAN_RTT_MSECS = 200;
+
+bool AudioBitrateController::update(float lossRate, int rttMsecs) {
+    if (!std::isfinite(lossRate)) {
+        lossRate = 0.0f;
+    }
+    lossRate = std::min(std::max(lossRate, 0.0f), 1.0f);
+    _smoothedLoss += LOSS_SMOOTHING * (lossRate - _smoothedLoss);
+
+    int previousLevel = _level;
+
+    if (_smoothedLoss > CONGESTED_LOSS || rttMsecs > CONGESTED_RTT_MSECS) {
+        _level = std::max(_level - 1, 0);
+        _cleanReports = 0;
+    } else if (_smoothedLoss < CLEAN_LOSS && rttMsecs < CLEAN_RTT_MSECS) {
+        if (++_cleanReports >= CLEAN_REPORTS_TO_STEP_UP) {
+            _level = std::min(_level + 1, NUM_LEVELS - 1);
+            _cleanReports = 0;
+        }
+    } else {
+        // neither congested nor clean, hold where we are
+        _cleanReports = 0;
+    }
+
+    return _level != previousLevel;
+}
@@ -0,0 +1,47 @@
+//
+//  AudioBitrateController.h
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioBitrateController_h
+#define hifi_AudioBitrateController_h
+
+//
+// Picks the bitrate a listener's mix is encoded at, from the loss and round trip time of its link.
+//
+// Each report steps down one level as soon as the (smoothed) loss or the delay shows congestion, and steps back up
+// one level only after several clean reports in a row, so that a link which is near its limit does not oscillate.
+//
+class AudioBitrateController {
+public:
+    static const int NUM_LEVELS = 5;
+    static const int BITRATE_LEVELS[NUM_LEVELS];  // in bits per second, increasing
+
+    static const int CLEAN_REPORTS_TO_STEP_UP = 5;
+
+    // starts at the highest level
+    AudioBitrateController() {}
+
+    // lossRate is the fraction of packets lost since the last report, rttMsecs is negative if unknown
+    // returns true if the bitrate changed
+    bool update(float lossRate, int rttMsecs);
+
+    int getBitrate() const { return BITRATE_LEVELS[_level]; }
+    int getLevel() const { return _level; }
+
+    // smoothed loss, for codecs to size their forward error correction
+    float getExpectedPacketLoss() const { return _smoothedLoss; }
+
+private:
+    int _level { NUM_LEVELS - 1 };
+    int _cleanReports { 0 };
+    float _smoothedLoss { 0.0f };
+};
+
+#endif // hifi_AudioBitrateController_h
@@ -15,6 +15,8 @@
 #include <QtCore/QDataStream>
 
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ResourceManager.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
@@ -41,6 +43,7 @@ AudioInjectorState& operator|= (AudioInjectorState& lhs, AudioInjectorState rhs)
 AudioInjector::AudioInjector(const Sound& sound, const AudioInjectorOptions& injectorOptions) :
     AudioInjector(sound.getByteArray(), injectorOptions)
 {
+    _soundURL = sound.getURL();
 }
 
 AudioInjector::AudioInjector(const QByteArray& audioData, const AudioInjectorOptions& injectorOptions) :
@@ -62,9 +65,11 @@ void AudioInjector::setOptions(const AudioInjectorOptions& options) {
     // we need to copy it from existing options just in case.
     bool currentlyStereo = _options.stereo;
     bool currentlyAmbisonic = _options.ambisonic;
+    bool currentlyMixerHosted = _options.mixerHosted;
     _options = options;
     _options.stereo = currentlyStereo;
     _options.ambisonic = currentlyAmbisonic;
+    _options.mixerHosted = currentlyMixerHosted;
 }
 
 void AudioInjector::finishNetworkInjection() {
@@ -85,6 +90,11 @@ void AudioInjector::finishLocalInjection() {
 }
 
 void AudioInjector::finish() {
+    if (!_hostedID.isNull() && !stateHas(AudioInjectorState::NetworkInjectionFinished)) {
+        // we were stopped before the end, so the mixer has to be told
+        sendStopHostedInjectorPacket();
+    }
+
     _state |= AudioInjectorState::Finished;
 
     emit finished();
@@ -191,6 +201,23 @@ const uchar MAX_INJECTOR_VOLUME = packFloatGainToByte(1.0f);
 static const int64_t NEXT_FRAME_DELTA_ERROR_OR_FINISHED = -1;
 static const int64_t NEXT_FRAME_DELTA_IMMEDIATELY = 0;
 
+// a hosted injector checks its options this often, and resends them at least this often
+static const int64_t HOSTED_INJECTOR_POLL_USECS = 100 * USECS_PER_MSEC;
+static const quint64 HOSTED_INJECTOR_REFRESH_USECS = USECS_PER_SECOND;
+
+static float computeLoudness(const QByteArray& audioData, int offset, int numBytes) {
+    if (numBytes <= 0) {
+        return 0.0f;
+    }
+
+    float loudness = 0.0f;
+    for (int i = 0; i < numBytes; i += sizeof(int16_t)) {
+        loudness += abs(*reinterpret_cast<const int16_t*>(audioData.constData() + ((offset + i) % audioData.size()))) /
+            (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+    }
+    return loudness / (float)(numBytes / sizeof(int16_t));
+}
+
 qint64 writeStringToStream(const QString& string, QDataStream& stream) {
     QByteArray data = string.toUtf8();
     uint32_t length = data.length();
@@ -212,6 +239,10 @@ int64_t AudioInjector::injectNextFrame() {
         return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
     }
 
+    if (isHosted()) {
+        return injectHostedFrame();
+    }
+
     // if we haven't setup the packet to send then do so now
     static int loopbackOptionOffset = -1;
     static int positionOptionOffset = -1;
@@ -314,12 +345,7 @@ int64_t AudioInjector::injectNextFrame() {
     }
 
     //  Measure the loudness of this frame
-    _loudness = 0.0f;
-    for (int i = 0; i < totalBytesLeftToCopy; i += sizeof(int16_t)) {
-        _loudness += abs(*reinterpret_cast<int16_t*>(_audioData.data() + ((_currentSendOffset + i) % _audioData.size()))) /
-            (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
-    }
-    _loudness /= (float)(totalBytesLeftToCopy/ sizeof(int16_t));
+    _loudness = computeLoudness(_audioData, _currentSendOffset, totalBytesLeftToCopy);
 
     _currentPacket->seek(0);
 
@@ -398,6 +424,103 @@ int64_t AudioInjector::injectNextFrame() {
     return std::max(INT64_C(0), playNextFrameAt - currentTime);
 }
 
+bool AudioInjector::isMixerHostableURL(const QUrl& url) {
+    // only the domain's own asset server; a client must not be able to make the mixer fetch arbitrary
+    // http(s) URLs (or read its own files) on its behalf
+    return url.isValid() && url.scheme() == URL_SCHEME_ATP;
+}
+
+bool AudioInjector::isHosted() const {
+    return _options.mixerHosted && !_options.localOnly && !_options.ambisonic && isMixerHostableURL(_soundURL);
+}
+
+int64_t AudioInjector::injectHostedFrame() {
+    int bytesPerFrame = (_options.stereo ? 2 : 1) * AudioConstants::SAMPLE_SIZE;
+    int64_t numFrames = _audioData.size() / bytesPerFrame;
+    if (numFrames == 0) {
+        qCDebug(audio) << "AudioInjector::injectHostedFrame() called with no samples to inject. Returning.";
+        return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+    }
+
+    if (!_frameTimer) {
+        _frameTimer = std::unique_ptr<QElapsedTimer>(new QElapsedTimer);
+    }
+
+    bool isStarting = !_hasSentFirstFrame;
+    if (isStarting) {
+        // every play gets its own ID, so that the mixer starts it over from our offset
+        if (!_hostedID.isNull()) {
+            sendStopHostedInjectorPacket();
+        }
+        _hostedID = QUuid::createUuid();
+        _hasSentFirstFrame = true;
+        _frameTimer->restart();
+    }
+
+    // the mixer plays the sound, we only keep track of where it is
+    int64_t elapsedUsecs = _frameTimer->nsecsElapsed() / NSECS_PER_USEC;
+    int64_t frame = _currentSendOffset / bytesPerFrame + elapsedUsecs * AudioConstants::SAMPLE_RATE / (int64_t)USECS_PER_SECOND;
+    if (!_options.loop && frame >= numFrames) {
+        finishNetworkInjection();
+        return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+    }
+    frame %= numFrames;
+
+    int loudnessBytes = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * bytesPerFrame;
+    if (!_options.loop) {
+        loudnessBytes = std::min(loudnessBytes, (int)((numFrames - frame) * bytesPerFrame));
+    }
+    _loudness = computeLoudness(_audioData, (int)(frame * bytesPerFrame), loudnessBytes);
+
+    bool optionsChanged = _options.position != _hostedOptions.position ||
+        _options.orientation != _hostedOptions.orientation ||
+        _options.volume != _hostedOptions.volume ||
+        _options.loop != _hostedOptions.loop;
+    if (isStarting || optionsChanged || usecTimestampNow() - _lastHostedSendUsecs >= HOSTED_INJECTOR_REFRESH_USECS) {
+        sendHostedInjectorPacket((float)frame / AudioConstants::SAMPLE_RATE);
+    }
+
+    int64_t nextCallDelta = HOSTED_INJECTOR_POLL_USECS;
+    if (!_options.loop) {
+        nextCallDelta = std::min(nextCallDelta, (numFrames - frame) * (int64_t)USECS_PER_SECOND / AudioConstants::SAMPLE_RATE);
+    }
+    return nextCallDelta;
+}
+
+void AudioInjector::sendHostedInjectorPacket(float playbackSeconds) {
+    _hostedOptions = _options;
+    _lastHostedSendUsecs = usecTimestampNow();
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer) {
+        return;
+    }
+
+    // these are resent every so often, so a lost one only delays an update
+    auto packet = NLPacket::create(PacketType::HostedAudioInjector);
+    packet->write(_hostedID.toRfc4122());
+    packet->writeString(_soundURL.toString());
+    packet->writePrimitive(_options.position);
+    packet->writePrimitive(_options.orientation);
+    packet->writePrimitive(_options.volume);
+    packet->writePrimitive((uchar)_options.loop);
+    packet->writePrimitive(playbackSeconds);
+
+    nodeList->sendUnreliablePacket(*packet, *audioMixer);
+}
+
+void AudioInjector::sendStopHostedInjectorPacket() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (audioMixer) {
+        auto packet = NLPacket::create(PacketType::StopHostedAudioInjector, NUM_BYTES_RFC4122_UUID, true);
+        packet->write(_hostedID.toRfc4122());
+        nodeList->sendPacket(std::move(packet), *audioMixer);
+    }
+    _hostedID = QUuid();
+}
+
 void AudioInjector::stop() {
     // trigger a call on the injector's thread to change state to finished
     QMetaObject::invokeMethod(this, "finish");
@@ -451,6 +574,20 @@ AudioInjectorPointer AudioInjector::playSound(SharedSoundPointer sound, const fl
     return playSoundAndDelete(resampled, options);
 }
 
+AudioInjectorPointer AudioInjector::playSound(SharedSoundPointer sound, const AudioInjectorOptions options) {
+    if (!sound) {
+        return AudioInjectorPointer();
+    }
+
+    // keep the sound's URL, so that the mixer can be asked to host it
+    AudioInjectorPointer injector = AudioInjectorPointer::create(*sound, options);
+
+    if (!injector->inject(&AudioInjectorManager::threadInjector)) {
+        qWarning() << "AudioInjector::playSound failed to thread injector";
+    }
+    return injector;
+}
+
 AudioInjectorPointer AudioInjector::playSoundAndDelete(const QByteArray& buffer, const AudioInjectorOptions options) {
     AudioInjectorPointer sound = playSound(buffer, options);
 
@@ -18,6 +18,8 @@
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThread>
+#include <QtCore/QUrl>
+#include <QtCore/QUuid>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
@@ -78,6 +80,11 @@ public:
     static AudioInjectorPointer playSound(const QByteArray& buffer, const AudioInjectorOptions options);
     static AudioInjectorPointer playSound(SharedSoundPointer sound, const float volume,
                                           const float stretchFactor, const glm::vec3 position);
+    static AudioInjectorPointer playSound(SharedSoundPointer sound, const AudioInjectorOptions options);
+
+    // whether the audio mixer can load a sound from this URL, to play it for a mixerHosted injector:
+    // only ATP URLs are, other sounds are streamed by the client as usual
+    static bool isMixerHostableURL(const QUrl& url);
 
 public slots:
     void restart();
@@ -100,6 +107,10 @@ signals:
 
 private:
     int64_t injectNextFrame();
+    int64_t injectHostedFrame();
+    bool isHosted() const;
+    void sendHostedInjectorPacket(float playbackSeconds);
+    void sendStopHostedInjectorPacket();
     bool inject(bool(AudioInjectorManager::*injection)(const AudioInjectorPointer&));
     bool injectLocally();
     void deleteLocalBuffer();
@@ -119,6 +130,12 @@ private:
     std::unique_ptr<QElapsedTimer> _frameTimer { nullptr };
     quint16 _outgoingSequenceNumber { 0 };
 
+    // when the mixer hosts the sound, we only send it the URL and our options
+    QUrl _soundURL;
+    QUuid _hostedID;
+    AudioInjectorOptions _hostedOptions;
+    quint64 _lastHostedSendUsecs { 0 };
+
     // when the injector is local, we need this
     AudioHRTF _localHRTF;
     AudioFOA _localFOA;
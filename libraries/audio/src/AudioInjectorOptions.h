@@ -29,6 +29,7 @@ public:
     bool ignorePenumbra;
     bool localOnly;
     float secondOffset;
+    bool mixerHosted;   // ask the audio mixer to play the sound by its URL, instead of streaming it
 };
 
 Q_DECLARE_METATYPE(AudioInjectorOptions);
@@ -13,6 +13,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <thread>
+#include <vector>
+
+#include <TBBHelpers.h>
+
 #include "AudioSRC.h"
 #include "AudioSRCData.h"
 
@@ -903,7 +908,7 @@ void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames
 
 // fast TPDF dither in [-1.0f, 1.0f]
 static inline __m128 dither4() {
-    static __m128i rz;
+    static thread_local __m128i rz;
 
     // update the 8 different maximum-length LCGs
     rz = _mm_mullo_epi16(rz, _mm_set_epi16(25173, -25511, -5975, -23279, 19445, -27591, 30185, -3495));
@@ -1196,7 +1201,7 @@ void AudioSRC::convertInput(const int16_t* input, float** outputs, int numFrames
 
 // fast TPDF dither in [-1.0f, 1.0f]
 static inline float dither() {
-    static uint32_t rz = 0;
+    static thread_local uint32_t rz = 0;
     rz = rz * 69069 + 1;
     int32_t r0 = rz & 0xffff;
     int32_t r1 = rz >> 16;
@@ -1423,6 +1428,7 @@ AudioSRC::AudioSRC(int inputSampleRate, int outputSampleRate, int numChannels, Q
     _inputSampleRate = inputSampleRate;
     _outputSampleRate = outputSampleRate;
     _numChannels = numChannels;
+    _quality = quality;
 
     // reduce to the smallest rational fraction
     int divisor = gcd(inputSampleRate, outputSampleRate);
@@ -1570,3 +1576,48 @@ int AudioSRC::getMaxInput(int outputFrames) {
         return (int)(((int64_t)outputFrames * _step) >> 32);
     }
 }
+
+// below this many input frames per chunk, the parallel tasks cost more than they save
+static const int PARALLEL_MIN_CHUNK_FRAMES = 1 << 16;
+
+int AudioSRC::renderParallel(const int16_t* input, int16_t* output, int inputFrames) {
+
+    int numThreads = (int)std::thread::hardware_concurrency();
+    if (_step != 0 || numThreads < 2 || inputFrames < 2 * PARALLEL_MIN_CHUNK_FRAMES) {
+        return render(input, output, inputFrames);
+    }
+
+    // chunks (and the warm up before each) are whole periods, so that every chunk starts at phase 0
+    int period = _downFactor;
+    int warmUpFrames = ((_numHistory + period - 1) / period) * period;
+    int chunkFrames = MAX((inputFrames + numThreads - 1) / numThreads, MAX(PARALLEL_MIN_CHUNK_FRAMES, warmUpFrames));
+    chunkFrames = ((chunkFrames + period - 1) / period) * period;
+    int numChunks = (inputFrames + chunkFrames - 1) / chunkFrames;
+
+    std::vector<int> chunkOutputFrames(numChunks, 0);
+
+    // on the shared TBB pool, so that callers that are pool tasks themselves (e.g. many sounds decoding at once)
+    // don't each start a thread per core
+    tbb::parallel_for(0, numChunks, [&](int k) {
+        if (k == 0) {
+            // the first chunk starts from this one's fresh state
+            chunkOutputFrames[0] = render(input, output, MIN(chunkFrames, inputFrames));
+            return;
+        }
+
+        int start = k * chunkFrames;
+        int frames = MIN(chunkFrames, inputFrames - start);
+        int outputStart = (int)((int64_t)(start / period) * _upFactor);
+
+        AudioSRC src(_inputSampleRate, _outputSampleRate, _numChannels, _quality);
+
+        // refill the filter history from the end of the previous chunk, discarding what it renders
+        std::vector<int16_t> warmUpOutput(src.getMaxOutput(warmUpFrames) * _numChannels);
+        src.render(input + (start - warmUpFrames) * _numChannels, warmUpOutput.data(), warmUpFrames);
+
+        chunkOutputFrames[k] = src.render(input + start * _numChannels, output + outputStart * _numChannels, frames);
+    });
+
+    int lastStart = (numChunks - 1) * chunkFrames;
+    return (int)((int64_t)(lastStart / period) * _upFactor) + chunkOutputFrames[numChunks - 1];
+}
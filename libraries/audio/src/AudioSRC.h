@@ -54,7 +54,15 @@ public:
     int getMinInput(int outputFrames);
     int getMaxInput(int outputFrames);
 
+    // offline version of render(), for a whole interleaved int16_t buffer starting from a fresh AudioSRC.
+    // A rational ratio returns to the same phase every _downFactor input frames, so the input is split into chunks
+    // on those boundaries and rendered as parallel TBB tasks, each after warming up its filter history.
+    // Irrational ratios, and short inputs, are rendered serially. The AudioSRC cannot render a continuation afterwards.
+    int renderParallel(const int16_t* input, int16_t* output, int inputFrames);
+
 private:
+    friend class AudioSRCBatch;     // shares the polyphase filter, to run it across many streams
+
     float* _polyphaseFilter;
     int* _stepTable;
 
@@ -66,6 +74,7 @@ private:
     int _outputSampleRate;
     int _numChannels;
     int _inputBlock;
+    Quality _quality;
 
     int _upFactor;
     int _downFactor;
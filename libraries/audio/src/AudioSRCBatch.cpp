@@ -0,0 +1,281 @@
+//
+//  AudioSRCBatch.cpp
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <assert.h>
+#include <string.h>
+
+#include "AudioSRCBatch.h"
+
+#ifndef MAX
+#define MAX(a,b)  (((a) > (b)) ? (a) : (b))
+#endif
+#ifndef MIN
+#define MIN(a,b)  (((a) < (b)) ? (a) : (b))
+#endif
+
+// high/low part of int64_t
+#define LO32(a)   ((uint32_t)(a))
+#define HI32(a)   ((int32_t)((a) >> 32))
+
+AudioSRCBatch::AudioSRCBatch(int inputSampleRate, int outputSampleRate, int numStreams, int numChannels,
+                             AudioSRC::Quality quality) :
+    _src(inputSampleRate, outputSampleRate, 1, quality),
+    _numStreams(numStreams),
+    _numChannels(numChannels)
+{
+    assert(numStreams > 0);
+    assert(numChannels > 0);
+
+    _numGroups = (numStreams * numChannels + SIMD_LANES - 1) / SIMD_LANES;
+
+    // unused lanes of the last group stay silent
+    int inputSize = _numGroups * (_src._numHistory + _src._inputBlock) * SIMD_LANES;
+    _inputs = new float[inputSize];
+    memset(_inputs, 0, inputSize * sizeof(float));
+
+    _outputs = new float[_numGroups * SRC_BLOCK * SIMD_LANES];
+}
+
+AudioSRCBatch::~AudioSRCBatch() {
+    delete[] _inputs;
+    delete[] _outputs;
+}
+
+//
+// scalar reference version, each coefficient is applied to the 8 interleaved lanes
+//
+int AudioSRCBatch::multirateFilter8_ref(const float* input, float* output, int inputFrames) {
+    int outputFrames = 0;
+
+    const float* filter = _src._polyphaseFilter;
+    int numTaps = _src._numTaps;
+
+    if (_src._step == 0) {  // rational
+
+        int32_t i = HI32(_src._offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &filter[numTaps * _src._phase];
+
+            float acc[SIMD_LANES] = {};
+
+            for (int j = 0; j < numTaps; j++) {
+
+                float coef = c0[j];
+
+                const float* x = &input[(i + j) * SIMD_LANES];
+                for (int k = 0; k < SIMD_LANES; k++) {
+                    acc[k] += x[k] * coef;
+                }
+            }
+
+            memcpy(&output[outputFrames * SIMD_LANES], acc, sizeof(acc));
+            outputFrames += 1;
+
+            i += _src._stepTable[_src._phase];
+            if (++_src._phase == _src._upFactor) {
+                _src._phase = 0;
+            }
+        }
+        _src._offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_src._offset) < inputFrames) {
+
+            int32_t i = HI32(_src._offset);
+            uint32_t f = LO32(_src._offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float frac = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &filter[numTaps * (phase + 0)];
+            const float* c1 = &filter[numTaps * (phase + 1)];
+
+            float acc[SIMD_LANES] = {};
+
+            for (int j = 0; j < numTaps; j++) {
+
+                float coef = c0[j] + frac * (c1[j] - c0[j]);
+
+                const float* x = &input[(i + j) * SIMD_LANES];
+                for (int k = 0; k < SIMD_LANES; k++) {
+                    acc[k] += x[k] * coef;
+                }
+            }
+
+            memcpy(&output[outputFrames * SIMD_LANES], acc, sizeof(acc));
+            outputFrames += 1;
+
+            _src._offset += _src._step;
+        }
+        _src._offset -= (int64_t)inputFrames << 32;
+    }
+
+    return outputFrames;
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+int AudioSRCBatch::multirateFilter8(const float* input, float* output, int inputFrames) {
+    static auto f = cpuSupportsAVX2() ? &AudioSRCBatch::multirateFilter8_AVX2 : &AudioSRCBatch::multirateFilter8_ref;
+    return (this->*f)(input, output, inputFrames);  // dispatch
+}
+
+#else   // portable reference code
+
+int AudioSRCBatch::multirateFilter8(const float* input, float* output, int inputFrames) {
+    return multirateFilter8_ref(input, output, inputFrames);
+}
+
+#endif
+
+// filters a block of input, already in place after the history of each group
+int AudioSRCBatch::renderBlock(int inputFrames) {
+    int numHistory = _src._numHistory;
+    int outputFrames = 0;
+
+    // every group starts from the same phase
+    int phase = _src._phase;
+    int64_t offset = _src._offset;
+
+    for (int g = 0; g < _numGroups; g++) {
+        _src._phase = phase;
+        _src._offset = offset;
+
+        float* input = groupInput(g);
+        outputFrames = multirateFilter8(input, groupOutput(g), inputFrames);
+
+        // shift history buffers
+        memmove(input, input + inputFrames * SIMD_LANES, numHistory * SIMD_LANES * sizeof(float));
+    }
+
+    return outputFrames;
+}
+
+// fast TPDF dither in [-1.0f, 1.0f]
+static inline float dither() {
+    static thread_local uint32_t rz = 0;
+    rz = rz * 69069 + 1;
+    int32_t r0 = rz & 0xffff;
+    int32_t r1 = rz >> 16;
+    return (int32_t)(r0 - r1) * (1/65536.0f);
+}
+
+//
+// This version handles input/output as interleaved int16_t
+//
+int AudioSRCBatch::render(const int16_t* const* inputs, int16_t* const* outputs, int inputFrames) {
+    const float inputScale = 1/32768.0f;
+    const float outputScale = 32768.0f;
+
+    int numHistory = _src._numHistory;
+    int inputOffset = 0;
+    int outputFrames = 0;
+
+    while (inputFrames) {
+        int ni = MIN(inputFrames, _src._inputBlock);
+
+        // convert int16_t to float, interleave the lanes after the history
+        for (int s = 0; s < _numStreams; s++) {
+            const int16_t* input = inputs[s] + inputOffset * _numChannels;
+            for (int ch = 0; ch < _numChannels; ch++) {
+                int lane = s * _numChannels + ch;
+                float* x = groupInput(lane / SIMD_LANES) + numHistory * SIMD_LANES + (lane % SIMD_LANES);
+                for (int i = 0; i < ni; i++) {
+                    x[i * SIMD_LANES] = (float)input[i * _numChannels + ch] * inputScale;
+                }
+            }
+        }
+
+        int no = renderBlock(ni);
+        assert(no <= SRC_BLOCK);
+
+        // convert float to int16_t with dither, deinterleave the lanes
+        for (int s = 0; s < _numStreams; s++) {
+            int16_t* output = outputs[s] + outputFrames * _numChannels;
+            for (int i = 0; i < no; i++) {
+                float d = dither();
+                for (int ch = 0; ch < _numChannels; ch++) {
+                    int lane = s * _numChannels + ch;
+                    float f = groupOutput(lane / SIMD_LANES)[i * SIMD_LANES + (lane % SIMD_LANES)] * outputScale;
+
+                    f += d;
+
+                    // round and saturate
+                    f += (f < 0.0f ? -0.5f : +0.5f);
+                    f = MAX(MIN(f, 32767.0f), -32768.0f);
+
+                    output[i * _numChannels + ch] = (int16_t)f;
+                }
+            }
+        }
+
+        inputOffset += ni;
+        inputFrames -= ni;
+        outputFrames += no;
+    }
+
+    return outputFrames;
+}
+
+//
+// This version handles input/output as interleaved float
+//
+int AudioSRCBatch::render(const float* const* inputs, float* const* outputs, int inputFrames) {
+    int numHistory = _src._numHistory;
+    int inputOffset = 0;
+    int outputFrames = 0;
+
+    while (inputFrames) {
+        int ni = MIN(inputFrames, _src._inputBlock);
+
+        // interleave the lanes after the history
+        for (int s = 0; s < _numStreams; s++) {
+            const float* input = inputs[s] + inputOffset * _numChannels;
+            for (int ch = 0; ch < _numChannels; ch++) {
+                int lane = s * _numChannels + ch;
+                float* x = groupInput(lane / SIMD_LANES) + numHistory * SIMD_LANES + (lane % SIMD_LANES);
+                for (int i = 0; i < ni; i++) {
+                    x[i * SIMD_LANES] = input[i * _numChannels + ch];
+                }
+            }
+        }
+
+        int no = renderBlock(ni);
+        assert(no <= SRC_BLOCK);
+
+        // deinterleave the lanes
+        for (int s = 0; s < _numStreams; s++) {
+            float* output = outputs[s] + outputFrames * _numChannels;
+            for (int ch = 0; ch < _numChannels; ch++) {
+                int lane = s * _numChannels + ch;
+                const float* y = groupOutput(lane / SIMD_LANES) + (lane % SIMD_LANES);
+                for (int i = 0; i < no; i++) {
+                    output[i * _numChannels + ch] = y[i * SIMD_LANES];
+                }
+            }
+        }
+
+        inputOffset += ni;
+        inputFrames -= ni;
+        outputFrames += no;
+    }
+
+    return outputFrames;
+}
@@ -0,0 +1,66 @@
+//
+//  AudioSRCBatch.h
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSRCBatch_h
+#define hifi_AudioSRCBatch_h
+
+#include "AudioSRC.h"
+
+// Resamples many streams of the same rates and channel count at once.
+//
+// Every channel of every stream is a lane, and lanes are filtered 8 at a time with SIMD across the lanes,
+// so that each filter coefficient is loaded once for 8 channels rather than once per channel. The streams share
+// the polyphase filter and the filter phase, so they must all be rendered together, with the same number of frames.
+class AudioSRCBatch {
+
+public:
+    static const int SIMD_LANES = 8;
+
+    AudioSRCBatch(int inputSampleRate, int outputSampleRate, int numStreams, int numChannels,
+                  AudioSRC::Quality quality = AudioSRC::MEDIUM_QUALITY);
+    ~AudioSRCBatch();
+
+    int getNumStreams() const { return _numStreams; }
+    int getNumChannels() const { return _numChannels; }
+
+    // one interleaved int16_t input/output per stream
+    int render(const int16_t* const* inputs, int16_t* const* outputs, int inputFrames);
+
+    // one interleaved float input/output per stream
+    int render(const float* const* inputs, float* const* outputs, int inputFrames);
+
+    int getMinOutput(int inputFrames) { return _src.getMinOutput(inputFrames); }
+    int getMaxOutput(int inputFrames) { return _src.getMaxOutput(inputFrames); }
+    int getMinInput(int outputFrames) { return _src.getMinInput(outputFrames); }
+    int getMaxInput(int outputFrames) { return _src.getMaxInput(outputFrames); }
+
+private:
+    AudioSRC _src;      // the polyphase filter and the phase, shared by all lanes
+
+    int _numStreams;
+    int _numChannels;
+    int _numGroups;     // of SIMD_LANES lanes
+
+    // per group, the filter history followed by a block of input, with the lanes interleaved
+    float* _inputs;
+    float* _outputs;
+
+    float* groupInput(int group) { return _inputs + group * (_src._numHistory + _src._inputBlock) * SIMD_LANES; }
+    float* groupOutput(int group) { return _outputs + group * SRC_BLOCK * SIMD_LANES; }
+
+    int renderBlock(int inputFrames);
+
+    int multirateFilter8(const float* input, float* output, int inputFrames);
+    int multirateFilter8_ref(const float* input, float* output, int inputFrames);
+    int multirateFilter8_AVX2(const float* input, float* output, int inputFrames);
+};
+
+#endif // hifi_AudioSRCBatch_h
@@ -0,0 +1,125 @@
+//
+//  AudioTimeStretch.cpp
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioTimeStretch.h"
+
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+
+// minimum normalized correlation between adjacent periods for a stretch to be inaudible
+static const float CORRELATION_THRESHOLD = 0.5f;
+
+// below this mean-square level (about -60dBFS) the frame is treated as silence, and any lag will do
+static const float SILENCE_ENERGY = 32.768f * 32.768f;
+
+static inline int16_t crossfade(int16_t from, int16_t to, float t) {
+    return (int16_t)lrintf(from + t * (to - from));
+}
+
+int AudioTimeStretch::findLag(const int16_t* input, int numFrames, int numChannels) {
+
+    int maxLag = std::min(MAX_LAG, numFrames / 2);
+    if (maxLag < MIN_LAG) {
+        return 0;
+    }
+
+    // downmix the two periods that could be compared
+    float mono[2 * MAX_LAG];
+    float energy = 0.0f;
+    for (int i = 0; i < 2 * maxLag; i++) {
+        float sum = 0.0f;
+        for (int ch = 0; ch < numChannels; ch++) {
+            sum += input[i * numChannels + ch];
+        }
+        mono[i] = sum / numChannels;
+        energy += mono[i] * mono[i];
+    }
+
+    if (energy < SILENCE_ENERGY * (2 * maxLag)) {
+        return maxLag;  // remove or repeat as much as possible
+    }
+
+    int bestLag = 0;
+    float bestCorrelation = CORRELATION_THRESHOLD;
+
+    for (int lag = MIN_LAG; lag <= maxLag; lag++) {
+        float xy = 0.0f;
+        float xx = 0.0f;
+        float yy = 0.0f;
+        for (int i = 0; i < lag; i++) {
+            float x = mono[i];
+            float y = mono[i + lag];
+            xy += x * y;
+            xx += x * x;
+            yy += y * y;
+        }
+
+        float norm = sqrtf(xx * yy);
+        if (norm > 0.0f && xy > bestCorrelation * norm) {
+            bestCorrelation = xy / norm;
+            bestLag = lag;
+        }
+    }
+    return bestLag;
+}
+
+//
+// x[0:L] crossfaded into x[L:2L], followed by x[2L:N]
+//
+int AudioTimeStretch::accelerate(const int16_t* input, int16_t* output, int numFrames, int numChannels) {
+    assert(input != output);
+
+    int lag = findLag(input, numFrames, numChannels);
+    if (lag == 0) {
+        memcpy(output, input, numFrames * numChannels * sizeof(int16_t));
+        return numFrames;
+    }
+
+    for (int i = 0; i < lag; i++) {
+        float t = (i + 0.5f) / lag;
+        for (int ch = 0; ch < numChannels; ch++) {
+            int16_t from = input[i * numChannels + ch];
+            int16_t to = input[(i + lag) * numChannels + ch];
+            output[i * numChannels + ch] = crossfade(from, to, t);
+        }
+    }
+    memcpy(&output[lag * numChannels], &input[2 * lag * numChannels], (numFrames - 2 * lag) * numChannels * sizeof(int16_t));
+
+    return numFrames - lag;
+}
+
+//
+// x[0:2L], then x[L:2L] crossfaded back into x[0:L], followed by x[2L:N]
+//
+int AudioTimeStretch::expand(const int16_t* input, int16_t* output, int numFrames, int numChannels) {
+    assert(input != output);
+
+    int lag = findLag(input, numFrames, numChannels);
+    if (lag == 0) {
+        memcpy(output, input, numFrames * numChannels * sizeof(int16_t));
+        return numFrames;
+    }
+
+    memcpy(output, input, 2 * lag * numChannels * sizeof(int16_t));
+    for (int i = 0; i < lag; i++) {
+        float t = (i + 0.5f) / lag;
+        for (int ch = 0; ch < numChannels; ch++) {
+            int16_t from = input[(i + lag) * numChannels + ch];
+            int16_t to = input[i * numChannels + ch];
+            output[(2 * lag + i) * numChannels + ch] = crossfade(from, to, t);
+        }
+    }
+    memcpy(&output[3 * lag * numChannels], &input[2 * lag * numChannels], (numFrames - 2 * lag) * numChannels * sizeof(int16_t));
+
+    return numFrames + lag;
+}
@@ -0,0 +1,41 @@
+//
+//  AudioTimeStretch.h
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioTimeStretch_h
+#define hifi_AudioTimeStretch_h
+
+#include <stdint.h>
+
+//
+// WSOLA-style time-stretching of a single frame, used by the jitter buffer to converge on its target delay
+// without dropping or repeating whole frames.
+//
+// The pitch period of the frame is found by normalized cross-correlation, and one period is removed (accelerate)
+// or repeated (expand) with a crossfade, so the result keeps the pitch and has no discontinuity.
+// When no period is similar enough (transients, noise) the frame is left unchanged.
+//
+class AudioTimeStretch {
+public:
+    static const int MIN_LAG = 60;      // 400Hz at 24KHz
+    static const int MAX_LAG = 120;     // 200Hz at 24KHz, and no more than half a network frame
+
+    // interleaved int16_t input/output, returns the number of output frames
+    // accelerate: output holds at least numFrames frames, the result has numFrames - lag frames
+    // expand: output holds at least numFrames + MAX_LAG frames, the result has numFrames + lag frames
+    static int accelerate(const int16_t* input, int16_t* output, int numFrames, int numChannels);
+    static int expand(const int16_t* input, int16_t* output, int numFrames, int numChannels);
+
+private:
+    // returns the best lag, or 0 if no lag is similar enough
+    static int findLag(const int16_t* input, int numFrames, int numChannels);
+};
+
+#endif // hifi_AudioTimeStretch_h
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <glm/glm.hpp>
 
 #include <NLPacket.h>
@@ -17,6 +19,7 @@
 
 #include "InboundAudioStream.h"
 #include "AudioLogging.h"
+#include "AudioTimeStretch.h"
 
 const bool InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED = true;
 const int InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES = 1;
@@ -27,8 +30,6 @@ const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
-static const int STARVE_HISTORY_CAPACITY = 50;
-
 // This is called 1x/s, and we want it to log the last 5s
 static const int UNPLAYED_MS_WINDOW_SECS = 5;
 
@@ -42,6 +43,23 @@ static const int DESIRED_JITTER_BUFFER_FRAMES_PADDING = 1;
 // _desiredJitterBufferFrames calculation)
 static const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
 
+// the jitter buffer target covers this fraction of the packet delays seen over the last DELAY_WINDOW_PACKETS (~5s),
+// and is recomputed every TARGET_UPDATE_INTERVAL_PACKETS
+static const float TARGET_DELAY_PERCENTILE = 0.95f;
+static const int DELAY_WINDOW_PACKETS = 500;
+static const int TARGET_UPDATE_INTERVAL_PACKETS = 25;
+static const int MIN_PACKETS_FOR_TARGET = 50;
+
+// a jump in sequence numbers this large means the sender restarted, so its earlier delays no longer apply
+static const int MAX_SEQUENCE_JUMP_FOR_DELAYS = 1000;
+
+// frames are time-stretched when the buffer is further than this from the target; the old frame dropping
+// (MAX_FRAMES_OVER_DESIRED) is only the last resort when stretching can't keep up
+static const int STRETCH_MARGIN_FRAMES = 1;
+
+// underruns are concealed for this many consecutive frames (~50ms) before the stream is starved and refilled
+static const int MAX_CONCEALED_FRAMES = 5;
+
 // this controls the window size of the time-weighted avg of frames available.  Every time the window fills up,
 // _currentJitterBufferFrames is updated with the time-weighted avg and the running time-weighted avg is reset.
 static const quint64 FRAMES_AVAILABLE_STAT_WINDOW_USECS = 10 * USECS_PER_SECOND;
@@ -53,7 +71,6 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _staticJitterBufferFrames(std::max(numStaticJitterBlocks, DEFAULT_STATIC_JITTER_FRAMES)),
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
-    _starveHistory(STARVE_HISTORY_CAPACITY),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
@@ -81,11 +98,19 @@ void InboundAudioStream::resetStats() {
     _starveCount = 0;
     _silentFramesDropped = 0;
     _oldFramesDropped = 0;
+    _concealedFrames = 0;
+    _acceleratedFrames = 0;
+    _expandedFrames = 0;
+    _consecutiveLostFrames = 0;
+    _underrunConcealedFrames = 0;
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
-    _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
-    _timeGapStatsForDesiredReduction.reset();
-    _starveHistory.clear();
+    _calculatedJitterBufferFrames = 0;
+    _relativeDelays.clear();
+    _nextRelativeDelay = 0;
+    _packetsSinceTargetUpdate = 0;
+    _arrivalFrameIndex = -1;
+    _delayHistogram.fill(0);
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
     _timeGapStatsForStatsPacket.reset();
@@ -106,13 +131,15 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
 
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
-    _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
-    _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
 }
 
 int InboundAudioStream::parseData(ReceivedMessage& message) {
+    return parseData(message, usecTimestampNow());
+}
+
+int InboundAudioStream::parseData(ReceivedMessage& message, quint64 arrivalUsecs) {
     // parse sequence number and track it
     quint16 sequence;
     message.readPrimitive(&sequence);
@@ -120,9 +147,11 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                                                                                                        message.getSourceID());
     QString codecInPacket = message.readString();
 
-    packetReceivedUpdateTimingStats();
+    packetReceivedUpdateTimingStats(arrivalUsecs);
+    packetArrived(sequence, arrivalUsecs);
 
     int networkFrames;
+    int lostPackets = 0;
 
     // parse the info after the seq number and before the audio data (the stream properties)
     int prePropertyPosition = message.getPosition();
@@ -141,8 +170,10 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // OnTime packet and this packet were lost. If we're using a codec this will 
             // also result in allowing the codec to interpolate lost data. Then
             // fall through to the "on time" logic to actually handle this packet
+            // Frames that were already concealed when the buffer ran dry stand in for the first of them.
+            // The last of them is produced once this packet has been read, as a codec may recover it from this one.
             int packetsDropped = arrivalInfo._seqDiffFromExpected;
-            lostAudioData(packetsDropped);
+            lostPackets = packetsDropped - std::min(packetsDropped, _underrunConcealedFrames);
 
             // fall through to OnTime case
         }
@@ -152,6 +183,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                 || message.getType() == PacketType::ReplicatedSilentAudioFrame) {
                 // If we recieved a SilentAudioFrame from our sender, we might want to drop
                 // some of the samples in order to catch up to our desired jitter buffer size.
+                lostAudioData(lostPackets);
                 writeDroppableSilentFrames(networkFrames);
             } else {
                 // note: PCM and no codec are identical
@@ -159,6 +191,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                 bool packetPCM = codecInPacket == "pcm" || codecInPacket == "";
                 if (codecInPacket == _selectedCodecName || (packetPCM && selectedPCM)) {
                     auto afterProperties = message.readWithoutCopy(message.getBytesLeftToRead());
+                    lostAudioData(lostPackets, afterProperties);
                     parseAudioData(message.getType(), afterProperties);
                 } else {
                     qDebug(audio) << "Codec mismatch: expected" << _selectedCodecName << "got" << codecInPacket << "writing silence";
@@ -166,7 +199,7 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
                     // Since the data in the stream is using a codec that we aren't prepared for,
                     // we need to let the codec know that we don't have data for it, this will
                     // allow the codec to interpolate missing data and produce a fade to silence.
-                    lostAudioData(1);
+                    lostAudioData(lostPackets + 1);
 
                     // inform others of the mismatch
                     auto sendingNode = DependencyManager::get<NodeList>()->nodeWithUUID(message.getSourceID());
@@ -185,14 +218,18 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         }
     }
 
+    if (arrivalInfo._status == SequenceNumberStats::OnTime || arrivalInfo._status == SequenceNumberStats::Early) {
+        _underrunConcealedFrames = 0;
+    }
+
     int framesAvailable = _ringBuffer.framesAvailable();
     // if this stream was starved, check if we're still starved.
     if (_isStarved && framesAvailable >= _desiredJitterBufferFrames) {
         qCInfo(audiostream, "Starve ended");
         _isStarved = false;
     }
-    // if the ringbuffer exceeds the desired size by more than the threshold specified,
-    // drop the oldest frames so the ringbuffer is down to the desired size.
+    // if time-stretching could not keep up and the ringbuffer exceeds the desired size by more than the threshold
+    // specified, drop the oldest frames so the ringbuffer is down to the desired size.
     if (framesAvailable > _desiredJitterBufferFrames + MAX_FRAMES_OVER_DESIRED) {
         int framesToDrop = framesAvailable - (_desiredJitterBufferFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING);
         _ringBuffer.shiftReadPosition(framesToDrop * _ringBuffer.getNumFrameSamples());
@@ -224,16 +261,11 @@ int InboundAudioStream::parseStreamProperties(PacketType type, const QByteArray&
     }
 }
 
-int InboundAudioStream::lostAudioData(int numPackets) {
+int InboundAudioStream::lostAudioData(int numPackets, const QByteArray& nextEncodedBuffer) {
     QByteArray decodedBuffer;
 
     while (numPackets--) {
-        if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
-        } else {
-            decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-            memset(decodedBuffer.data(), 0, decodedBuffer.size());
-        }
+        lostFrame(decodedBuffer, numPackets == 0 ? nextEncodedBuffer : QByteArray());
         _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
     }
     return 0;
@@ -246,10 +278,88 @@ int InboundAudioStream::parseAudioData(PacketType type, const QByteArray& packet
     } else {
         decodedBuffer = packetAfterStreamProperties;
     }
+    frameDecoded(decodedBuffer);
+    timeStretch(decodedBuffer);
+
     auto actualSize = decodedBuffer.size();
     return _ringBuffer.writeData(decodedBuffer.data(), actualSize);
 }
 
+void InboundAudioStream::lostFrame(QByteArray& decodedBuffer, const QByteArray& nextEncodedBuffer) {
+    _consecutiveLostFrames++;
+    _concealedFrames++;
+
+    if (_decoder) {
+        if (nextEncodedBuffer.isEmpty()) {
+            _decoder->lostFrame(decodedBuffer);
+        } else {
+            _decoder->recoverLostFrame(nextEncodedBuffer, decodedBuffer);
+        }
+        return;
+    }
+
+    int frameSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * _numChannels;
+    if (_lastDecodedFrame.size() != frameSamples * (int)sizeof(int16_t)) {
+        decodedBuffer.resize(frameSamples * sizeof(int16_t));
+        memset(decodedBuffer.data(), 0, decodedBuffer.size());
+        return;
+    }
+
+    // repeat the last frame, ramping between the fade factors of this repeat and the next to avoid steps
+    decodedBuffer = _lastDecodedFrame;
+    int16_t* samples = reinterpret_cast<int16_t*>(decodedBuffer.data());
+    float fadeStart = calculateRepeatedFrameFadeFactor(_consecutiveLostFrames);
+    float fadeEnd = calculateRepeatedFrameFadeFactor(_consecutiveLostFrames + 1);
+    for (int i = 0; i < frameSamples; i++) {
+        int frame = i / _numChannels;
+        float fade = fadeStart + (fadeEnd - fadeStart) * frame / AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+        samples[i] = (int16_t)(samples[i] * fade);
+    }
+}
+
+void InboundAudioStream::frameDecoded(const QByteArray& decodedBuffer) {
+    _consecutiveLostFrames = 0;
+
+    // only the fallback concealment needs it
+    if (!_decoder) {
+        _lastDecodedFrame = decodedBuffer;
+    }
+}
+
+void InboundAudioStream::timeStretch(QByteArray& decodedBuffer) {
+    if (!_dynamicJitterBufferEnabled || !_hasStarted || _isStarved) {
+        return;
+    }
+
+    // the ring buffer frames may be in another format (see MixedProcessedAudioStream), but have the same duration
+    float framesBuffered = _ringBuffer.samplesAvailable() / (float)_ringBuffer.getNumFrameSamples();
+
+    bool accelerate = framesBuffered > _desiredJitterBufferFrames + STRETCH_MARGIN_FRAMES;
+    bool expand = framesBuffered + 1 < _desiredJitterBufferFrames;
+    if (!accelerate && !expand) {
+        return;
+    }
+
+    int frameBytes = _numChannels * sizeof(int16_t);
+    int numFrames = decodedBuffer.size() / frameBytes;
+    QByteArray stretchedBuffer((numFrames + AudioTimeStretch::MAX_LAG) * frameBytes, Qt::Uninitialized);
+
+    auto input = reinterpret_cast<const int16_t*>(decodedBuffer.constData());
+    auto output = reinterpret_cast<int16_t*>(stretchedBuffer.data());
+    int stretchedFrames = accelerate ? AudioTimeStretch::accelerate(input, output, numFrames, _numChannels)
+                                     : AudioTimeStretch::expand(input, output, numFrames, _numChannels);
+
+    if (stretchedFrames != numFrames) {
+        stretchedBuffer.resize(stretchedFrames * frameBytes);
+        decodedBuffer = stretchedBuffer;
+        if (accelerate) {
+            _acceleratedFrames++;
+        } else {
+            _expandedFrames++;
+        }
+    }
+}
+
 int InboundAudioStream::writeDroppableSilentFrames(int silentFrames) {
 
     // We can't guarentee that all clients have faded the stream down
@@ -318,6 +428,10 @@ int InboundAudioStream::popSamples(int maxSamples, bool allOrNothing) {
             // samples available, so pop all those (except in all-or-nothing mode)
             popSamplesNoCheck(samplesAvailable);
             samplesPopped = samplesAvailable;
+        } else if (concealUnderrun(maxSamples)) {
+            // the next packet is late or lost, and was concealed rather than starving
+            popSamplesNoCheck(maxSamples);
+            samplesPopped = maxSamples;
         } else {
             // we can't pop any samples, set this stream to starved
             setToStarved();
@@ -334,6 +448,19 @@ int InboundAudioStream::popFrames(int maxFrames, bool allOrNothing) {
     return samplesPopped / numFrameSamples;
 }
 
+bool InboundAudioStream::concealUnderrun(int samplesNeeded) {
+    if (!_concealUnderruns || !_hasStarted || _consecutiveLostFrames >= MAX_CONCEALED_FRAMES) {
+        return false;
+    }
+
+    int numFrameSamples = _ringBuffer.getNumFrameSamples();
+    int framesNeeded = (samplesNeeded - _ringBuffer.samplesAvailable() + numFrameSamples - 1) / numFrameSamples;
+    lostAudioData(framesNeeded);
+    _underrunConcealedFrames += framesNeeded;
+
+    return _ringBuffer.samplesAvailable() >= samplesNeeded;
+}
+
 void InboundAudioStream::popSamplesNoCheck(int samples) {
     float unplayedMs = (_ringBuffer.samplesAvailable() / (float)_ringBuffer.getNumFrameSamples()) * AudioConstants::NETWORK_FRAME_MSECS;
     _unplayedMs.update(unplayedMs);
@@ -367,43 +494,6 @@ void InboundAudioStream::setToStarved() {
     // if we have more than the desired frames when setToStarved() is called, then we'll immediately
     // be considered refilled. in that case, there's no need to set _isStarved to true.
     _isStarved = (_ringBuffer.framesAvailable() < _desiredJitterBufferFrames);
-
-    // record the time of this starve in the starve history
-    quint64 now = usecTimestampNow();
-    _starveHistory.insert(now);
-
-    if (_dynamicJitterBufferEnabled) {
-        // dynamic jitter buffers are enabled. check if this starve put us over the window
-        // starve threshold
-        quint64 windowEnd = now - WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES * USECS_PER_SECOND;
-        RingBufferHistory<quint64>::Iterator starvesIterator = _starveHistory.begin();
-        RingBufferHistory<quint64>::Iterator end = _starveHistory.end();
-        int starvesInWindow = 1;
-        do {
-            ++starvesIterator;
-            if (*starvesIterator < windowEnd) {
-                break;
-            }
-            starvesInWindow++;
-        } while (starvesIterator != end);
-
-        // this starve put us over the starve threshold. update _desiredJitterBufferFrames to
-        // value determined by window A.
-        if (starvesInWindow >= WINDOW_STARVE_THRESHOLD) {
-            int calculatedJitterBufferFrames;
-            // we don't know when the next packet will arrive, so it's possible the gap between the last packet and the
-            // next packet will exceed the max time gap in the window.  If the time since the last packet has already exceeded
-            // the window max gap, then we should use that value to calculate desired frames.
-            int framesSinceLastPacket = ceilf((float)(now - _lastPacketReceivedTime)
-                                              / (float)AudioConstants::NETWORK_FRAME_USECS);
-            calculatedJitterBufferFrames = std::max(_calculatedJitterBufferFrames, framesSinceLastPacket);
-            // make sure _desiredJitterBufferFrames does not become lower here
-            if (calculatedJitterBufferFrames >= _desiredJitterBufferFrames) {
-                _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                qCInfo(audiostream, "Set desired jitter frames to %d (starved)", _desiredJitterBufferFrames);
-            }
-        }
-    }
 }
 
 void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
@@ -411,8 +501,8 @@ void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
         _desiredJitterBufferFrames = _staticJitterBufferFrames;
     } else {
         if (!_dynamicJitterBufferEnabled) {
-            // if we're enabling dynamic jitter buffer frames, start desired frames at 1
-            _desiredJitterBufferFrames = 1;
+            // if we're enabling dynamic jitter buffer frames, start from the current estimate (or 1 without one)
+            _desiredJitterBufferFrames = std::max(1, _calculatedJitterBufferFrames);
         }
     }
     _dynamicJitterBufferEnabled = enable;
@@ -425,42 +515,77 @@ void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrame
     }
 }
 
-void InboundAudioStream::packetReceivedUpdateTimingStats() {
+void InboundAudioStream::packetReceivedUpdateTimingStats(quint64 now) {
     
-    // update our timegap stats and desired jitter buffer frames if necessary
+    // update our timegap stats
     // discard the first few packets we receive since they usually have gaps that aren't represensative of normal jitter
     const quint32 NUM_INITIAL_PACKETS_DISCARD = 1000; // 10s
-    quint64 now = usecTimestampNow();
     if (_incomingSequenceNumberStats.getReceived() > NUM_INITIAL_PACKETS_DISCARD) {
         quint64 gap = now - _lastPacketReceivedTime;
         _timeGapStatsForStatsPacket.update(gap);
+    }
 
-        // update all stats used for desired frames calculations under dynamic jitter buffer mode
-        _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
-        _timeGapStatsForDesiredReduction.update(gap);
+    _lastPacketReceivedTime = now;
+}
 
-        if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
-            _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
-                                                             / (float) AudioConstants::NETWORK_FRAME_USECS);
-            _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
-        }
+void InboundAudioStream::packetArrived(quint16 sequence, quint64 arrivalUsecs) {
+    // unwrap the sequence number into the index of the frame the sender sent
+    int sequenceDelta = (int16_t)(sequence - _lastArrivalSequence);
+    if (_arrivalFrameIndex < 0 || std::abs(sequenceDelta) > MAX_SEQUENCE_JUMP_FOR_DELAYS) {
+        _relativeDelays.clear();
+        _nextRelativeDelay = 0;
+        _packetsSinceTargetUpdate = 0;
+        _arrivalFrameIndex = 0;
+        _lastArrivalSequence = sequence;
+        sequenceDelta = 0;
+    }
 
-        if (_dynamicJitterBufferEnabled) {
-            // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
-            if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
-                int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
-                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
-                    qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
-                }
-                _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
-            }
-        }
+    qint64 frameIndex = _arrivalFrameIndex + sequenceDelta;
+    if (sequenceDelta > 0) {
+        _arrivalFrameIndex = frameIndex;
+        _lastArrivalSequence = sequence;
     }
 
-    _lastPacketReceivedTime = now;
+    // late (reordered) packets are kept, since how late they were is exactly what the target should cover
+    qint64 relativeDelay = (qint64)arrivalUsecs - (qint64)(frameIndex * (double)AudioConstants::NETWORK_FRAME_MSECS * USECS_PER_MSEC);
+    if ((int)_relativeDelays.size() < DELAY_WINDOW_PACKETS) {
+        _relativeDelays.push_back(relativeDelay);
+    } else {
+        _relativeDelays[_nextRelativeDelay] = relativeDelay;
+        _nextRelativeDelay = (_nextRelativeDelay + 1) % DELAY_WINDOW_PACKETS;
+    }
+
+    if (++_packetsSinceTargetUpdate >= TARGET_UPDATE_INTERVAL_PACKETS && (int)_relativeDelays.size() >= MIN_PACKETS_FOR_TARGET) {
+        _packetsSinceTargetUpdate = 0;
+        updateDesiredJitterBufferFrames();
+    }
+}
+
+void InboundAudioStream::updateDesiredJitterBufferFrames() {
+    // the earliest packet in the window had the least delay, everything else was delayed relative to it
+    std::vector<qint64> delays = _relativeDelays;
+    qint64 minDelay = *std::min_element(delays.begin(), delays.end());
+
+    const float FRAME_USECS = AudioConstants::NETWORK_FRAME_MSECS * USECS_PER_MSEC;
+    _delayHistogram.fill(0);
+    for (auto& delay : delays) {
+        delay -= minDelay;
+        int bucket = std::min((int)(delay / FRAME_USECS), NUM_DELAY_HISTOGRAM_BUCKETS - 1);
+        _delayHistogram[bucket]++;
+    }
+
+    auto percentile = delays.begin() + (int)((delays.size() - 1) * TARGET_DELAY_PERCENTILE);
+    std::nth_element(delays.begin(), percentile, delays.end());
+
+    // one frame for the packet being played, and as many as it takes to cover the delay
+    int maxFrames = std::max(1, _ringBuffer.getFrameCapacity() / 2);
+    int calculatedJitterBufferFrames = 1 + (int)ceilf(*percentile / FRAME_USECS);
+    _calculatedJitterBufferFrames = std::min(calculatedJitterBufferFrames, maxFrames);
+
+    if (_dynamicJitterBufferEnabled && _calculatedJitterBufferFrames != _desiredJitterBufferFrames) {
+        _desiredJitterBufferFrames = _calculatedJitterBufferFrames;
+        qCDebug(audiostream, "Set desired jitter frames to %d (p95 delay %d usecs)", _desiredJitterBufferFrames, (int)*percentile);
+    }
 }
 
 AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
@@ -12,6 +12,9 @@
 #ifndef hifi_InboundAudioStream_h
 #define hifi_InboundAudioStream_h
 
+#include <array>
+#include <vector>
+
 #include <Node.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
@@ -46,6 +49,10 @@ public:
     static const bool USE_STDEV_FOR_JITTER;
     static const bool REPETITION_WITH_FADE;
 
+    // the delay histogram has one bucket per frame of delay, the last one holds everything above
+    static const int NUM_DELAY_HISTOGRAM_BUCKETS = 16;
+    using DelayHistogram = std::array<int, NUM_DELAY_HISTOGRAM_BUCKETS>;
+
     InboundAudioStream() = delete;
     InboundAudioStream(int numChannels, int numFrames, int numBlocks, int numStaticJitterBlocks);
     ~InboundAudioStream();
@@ -56,6 +63,9 @@ public:
 
     virtual int parseData(ReceivedMessage& packet) override;
 
+    /// as parseData, with the time the packet arrived, which is what the jitter buffer target is estimated from
+    int parseData(ReceivedMessage& packet, quint64 arrivalUsecs);
+
     int popFrames(int maxFrames, bool allOrNothing);
     int popSamples(int maxSamples, bool allOrNothing);
 
@@ -73,6 +83,9 @@ public:
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
     int getCalculatedJitterBufferFrames() const { return _calculatedJitterBufferFrames; }
+
+    /// the delay of recent packets relative to the earliest one, in frames, as used for the jitter buffer target
+    const DelayHistogram& getDelayHistogram() const { return _delayHistogram; }
     
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
@@ -91,6 +104,9 @@ public:
     int getStarveCount() const { return _starveCount; }
     int getSilentFramesDropped() const { return _silentFramesDropped; }
     int getOverflowCount() const { return _ringBuffer.getOverflowCount(); }
+    int getConcealedFrames() const { return _concealedFrames; }
+    int getAcceleratedFrames() const { return _acceleratedFrames; }
+    int getExpandedFrames() const { return _expandedFrames; }
 
     int getPacketsReceived() const { return _incomingSequenceNumberStats.getReceived(); }
     
@@ -107,13 +123,16 @@ signals:
     void mismatchedAudioCodec(SharedNodePointer sendingNode, const QString& currentCodec, const QString& recievedCodec);
 
 public slots:
-    /// This function should be called every second for all the stats to function properly. If dynamic jitter buffers
-    /// is enabled, those stats are used to calculate _desiredJitterBufferFrames.
-    /// If the stats are not used and dynamic jitter buffers is disabled, it's not necessary to call this function.
+    /// This function should be called every second for all the stats to function properly.
+    /// The dynamic jitter buffer is sized from packet arrivals, so if the stats are not used it's not necessary to
+    /// call this function.
     void perSecondCallbackForUpdatingStats();
 
 private:
-    void packetReceivedUpdateTimingStats();
+    void packetReceivedUpdateTimingStats(quint64 now);
+    void packetArrived(quint16 sequence, quint64 arrivalUsecs);
+    void updateDesiredJitterBufferFrames();
+    bool concealUnderrun(int samplesNeeded);
 
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
@@ -133,10 +152,21 @@ protected:
     virtual int parseAudioData(PacketType type, const QByteArray& packetAfterStreamProperties);
 
     /// produces audio data for lost network packets.
-    virtual int lostAudioData(int numPackets);
+    /// nextEncodedBuffer is the audio data of the packet that followed them, if any, to recover the last one from
+    virtual int lostAudioData(int numPackets, const QByteArray& nextEncodedBuffer = QByteArray());
 
     /// writes silent frames to the buffer that may be dropped to reduce latency caused by the buffer
     virtual int writeDroppableSilentFrames(int silentFrames);
+
+    /// shortens or lengthens a decoded network frame by about a pitch period, when the buffer is away from its target
+    void timeStretch(QByteArray& decodedBuffer);
+
+    /// produces a frame in place of a lost one: the codec's concealment (or its recovery from nextEncodedBuffer,
+    /// if not empty), or the last decoded frame repeated with a fade
+    void lostFrame(QByteArray& decodedBuffer, const QByteArray& nextEncodedBuffer = QByteArray());
+
+    /// remembers a decoded frame, which lostFrame repeats if the next ones are lost
+    void frameDecoded(const QByteArray& decodedBuffer);
     
 protected:
 
@@ -153,21 +183,37 @@ protected:
     bool _isStarved { true };
     bool _hasStarted { false };
 
+    // underruns are concealed on pop, which writes to the ring buffer; only streams that are parsed and popped on
+    // the same thread can do it
+    bool _concealUnderruns { true };
+
+    QByteArray _lastDecodedFrame;
+    int _consecutiveLostFrames { 0 };
+    int _underrunConcealedFrames { 0 }; // since the last packet, which a later packet may reveal as lost
+
     // stats
 
     int _consecutiveNotMixedCount { 0 };
     int _starveCount { 0 };
     int _silentFramesDropped { 0 };
     int _oldFramesDropped { 0 };
+    int _concealedFrames { 0 };
+    int _acceleratedFrames { 0 };
+    int _expandedFrames { 0 };
 
     SequenceNumberStats _incomingSequenceNumberStats;
 
     quint64 _lastPacketReceivedTime { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
     int _calculatedJitterBufferFrames { 0 };
-    MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
 
-    RingBufferHistory<quint64> _starveHistory;
+    // arrival time of recent packets minus their send time (sequence number times frame length), whose spread is
+    // the jitter; the target covers a high percentile of it, so that rare late packets are concealed instead
+    std::vector<qint64> _relativeDelays;
+    int _nextRelativeDelay { 0 };
+    int _packetsSinceTargetUpdate { 0 };
+    qint64 _arrivalFrameIndex { -1 };
+    quint16 _lastArrivalSequence { 0 };
+    DelayHistogram _delayHistogram {};
 
     TimeWeightedAvg<int> _framesAvailableStat;
     MovingMinMaxAvg<float> _unplayedMs;
@@ -11,10 +11,16 @@
 
 #include "MixedProcessedAudioStream.h"
 #include "AudioLogging.h"
+#include "AudioReverb.h"
+#include "AudioSRC.h"
 
 MixedProcessedAudioStream::MixedProcessedAudioStream(int numFramesCapacity, int numStaticJitterFrames)
     : InboundAudioStream(AudioConstants::STEREO, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL,
-        numFramesCapacity, numStaticJitterFrames) {}
+        numFramesCapacity, numStaticJitterFrames) {
+    // packets are parsed on the client's thread while the audio device pops on its own, so an underrun can't be
+    // concealed into the ring buffer from the pop; lost packets are still concealed as they are detected
+    _concealUnderruns = false;
+}
 
 void MixedProcessedAudioStream::outputFormatChanged(int sampleRate, int channelCount) {
     _outputSampleRate = sampleRate;
@@ -24,6 +30,33 @@ void MixedProcessedAudioStream::outputFormatChanged(int sampleRate, int channelC
     _ringBuffer.resizeForFrameSize(deviceOutputFrameSamples);
 }
 
+void MixedProcessedAudioStream::renderToOutput(const QByteArray& inputBuffer, QByteArray& outputBuffer,
+                                               AudioReverb* reverb, AudioSRC* resampler, std::vector<int16_t>& scratchBuffer) {
+    const int FRAME_BYTES = AudioConstants::STEREO * AudioConstants::SAMPLE_SIZE;
+    int numFrames = inputBuffer.size() / FRAME_BYTES;
+    const int16_t* input = reinterpret_cast<const int16_t*>(inputBuffer.constData());
+
+    outputBuffer.resize((resampler ? resampler->getMaxOutput(numFrames) : numFrames) * FRAME_BYTES);
+    int16_t* output = reinterpret_cast<int16_t*>(outputBuffer.data());
+
+    if (reverb) {
+        int16_t* reverbOutput = output;
+        if (resampler) {
+            scratchBuffer.resize(numFrames * AudioConstants::STEREO);
+            reverbOutput = scratchBuffer.data();
+        }
+        reverb->render(input, reverbOutput, numFrames);
+        input = reverbOutput;
+    }
+
+    if (resampler) {
+        int numOutputFrames = resampler->render(input, output, numFrames);
+        outputBuffer.resize(numOutputFrames * FRAME_BYTES);
+    } else if (!reverb) {
+        memcpy(output, input, numFrames * FRAME_BYTES);
+    }
+}
+
 int MixedProcessedAudioStream::writeDroppableSilentFrames(int silentFrames) {
     int deviceSilentFrames = networkToDeviceFrames(silentFrames);
     int deviceSilentFramesWritten = InboundAudioStream::writeDroppableSilentFrames(deviceSilentFrames);
@@ -31,17 +64,12 @@ int MixedProcessedAudioStream::writeDroppableSilentFrames(int silentFrames) {
     return deviceSilentFramesWritten;
 }
 
-int MixedProcessedAudioStream::lostAudioData(int numPackets) {
+int MixedProcessedAudioStream::lostAudioData(int numPackets, const QByteArray& nextEncodedBuffer) {
     QByteArray decodedBuffer;
     QByteArray outputBuffer;
 
     while (numPackets--) {
-        if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
-        } else {
-            decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-            memset(decodedBuffer.data(), 0, decodedBuffer.size());
-        }
+        lostFrame(decodedBuffer, numPackets == 0 ? nextEncodedBuffer : QByteArray());
 
         emit addedStereoSamples(decodedBuffer);
 
@@ -60,6 +88,8 @@ int MixedProcessedAudioStream::parseAudioData(PacketType type, const QByteArray&
     } else {
         decodedBuffer = packetAfterStreamProperties;
     }
+    frameDecoded(decodedBuffer);
+    timeStretch(decodedBuffer);
 
     emit addedStereoSamples(decodedBuffer);
 
@@ -12,9 +12,13 @@
 #ifndef hifi_MixedProcessedAudioStream_h
 #define hifi_MixedProcessedAudioStream_h
 
+#include <vector>
+
 #include "InboundAudioStream.h"
 
 class AudioClient;
+class AudioReverb;
+class AudioSRC;
 
 class MixedProcessedAudioStream  : public InboundAudioStream {
     Q_OBJECT
@@ -32,10 +36,15 @@ signals:
 public:
     void outputFormatChanged(int sampleRate, int channelCount);
 
+    // What a processSamples receiver does with the stereo network frames: the reverb, then the resampler, when given.
+    // The frames are not always a network frame long, as the jitter buffer stretches them, and neither is the output.
+    static void renderToOutput(const QByteArray& inputBuffer, QByteArray& outputBuffer,
+                               AudioReverb* reverb, AudioSRC* resampler, std::vector<int16_t>& scratchBuffer);
+
 protected:
     int writeDroppableSilentFrames(int silentFrames) override;
     int parseAudioData(PacketType type, const QByteArray& packetAfterStreamProperties) override;
-    int lostAudioData(int numPackets) override;
+    int lostAudioData(int numPackets, const QByteArray& nextEncodedBuffer = QByteArray()) override;
 
 private:
     int networkToDeviceFrames(int networkFrames);
@@ -137,9 +137,10 @@ void SoundProcessor::downSample(const QByteArray& rawAudioByteArray, int sampleR
         int maxDestinationBytes = maxDestinationFrames * numChannels * sizeof(AudioConstants::AudioSample);
         _data.resize(maxDestinationBytes);
 
-        int numDestinationFrames = resampler.render((int16_t*)rawAudioByteArray.data(), 
-                                                    (int16_t*)_data.data(),
-                                                    numSourceFrames);
+        // long files are split across threads
+        int numDestinationFrames = resampler.renderParallel((int16_t*)rawAudioByteArray.data(),
+                                                            (int16_t*)_data.data(),
+                                                            numSourceFrames);
 
         // truncate to actual output
         int numDestinationBytes = numDestinationFrames * numChannels * sizeof(AudioConstants::AudioSample);
@@ -0,0 +1,96 @@
+//
+//  AudioSRCBatch_avx2.cpp
+//  libraries/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AudioSRCBatch.h"
+
+// high/low part of int64_t
+#define LO32(a)   ((uint32_t)(a))
+#define HI32(a)   ((int32_t)((a) >> 32))
+
+static_assert(AudioSRCBatch::SIMD_LANES == 8, "one lane per float of __m256");
+
+int AudioSRCBatch::multirateFilter8_AVX2(const float* input, float* output, int inputFrames) {
+    int outputFrames = 0;
+
+    const float* filter = _src._polyphaseFilter;
+    int numTaps = _src._numTaps;
+
+    if (_src._step == 0) {  // rational
+
+        int32_t i = HI32(_src._offset);
+
+        while (i < inputFrames) {
+
+            const float* c0 = &filter[numTaps * _src._phase];
+
+            __m256 acc0 = _mm256_setzero_ps();
+
+            for (int j = 0; j < numTaps; j++) {
+
+                //float coef = c0[j];
+                __m256 coef0 = _mm256_broadcast_ss(&c0[j]);
+
+                //acc[k] += input[i + j][k] * coef;
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&input[(i + j) * 8]), coef0, acc0);
+            }
+
+            _mm256_storeu_ps(&output[outputFrames * 8], acc0);
+            outputFrames += 1;
+
+            i += _src._stepTable[_src._phase];
+            if (++_src._phase == _src._upFactor) {
+                _src._phase = 0;
+            }
+        }
+        _src._offset = (int64_t)(i - inputFrames) << 32;
+
+    } else {    // irrational
+
+        while (HI32(_src._offset) < inputFrames) {
+
+            int32_t i = HI32(_src._offset);
+            uint32_t f = LO32(_src._offset);
+
+            uint32_t phase = f >> SRC_FRACBITS;
+            float frac = (f & SRC_FRACMASK) * QFRAC_TO_FLOAT;
+
+            const float* c0 = &filter[numTaps * (phase + 0)];
+            const float* c1 = &filter[numTaps * (phase + 1)];
+
+            __m256 acc0 = _mm256_setzero_ps();
+
+            for (int j = 0; j < numTaps; j++) {
+
+                float coef = c0[j] + frac * (c1[j] - c0[j]);
+                __m256 coef0 = _mm256_broadcast_ss(&coef);
+
+                //acc[k] += input[i + j][k] * coef;
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&input[(i + j) * 8]), coef0, acc0);
+            }
+
+            _mm256_storeu_ps(&output[outputFrames * 8], acc0);
+            outputFrames += 1;
+
+            _src._offset += _src._step;
+        }
+        _src._offset -= (int64_t)inputFrames << 32;
+    }
+    _mm256_zeroupper();
+
+    return outputFrames;
+}
+
+#endif
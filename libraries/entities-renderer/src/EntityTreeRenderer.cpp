@@ -265,51 +265,39 @@ void EntityTreeRenderer::update(bool simulate) {
             render::Transaction transaction;
             addPendingEntities(scene, transaction);
             updateChangedEntities(scene, transaction);
-            scene->enqueueTransaction(transaction);
+            scene->enqueueTransaction(std::move(transaction));
         }
     }
 }
 
 bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar) {
     bool didUpdate = false;
-    float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
-    QVector<EntityItemPointer> foundEntities;
 
-    // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
 
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
-        std::static_pointer_cast<EntityTree>(_tree)->findEntities(_avatarPosition, radius, foundEntities);
+        // only zones, and entities with scripts, are in the containment index, all other entities can be
+        // ignored because no events are fired on them.
+        // FIXME - this could be optimized further by determining if the script is loaded
+        // and if it has either an enterEntity or leaveEntity method
+        QVector<EntityItemPointer> foundEntities =
+            std::static_pointer_cast<EntityTree>(_tree)->findEntitiesContainingPoint(_avatarPosition);
 
         LayeredZones oldLayeredZones(std::move(_layeredZones));
         _layeredZones.clear();
 
-        // create a list of entities that actually contain the avatar's position
+        // the entities found actually contain the avatar's position
         for (auto& entity : foundEntities) {
-            auto isZone = entity->getType() == EntityTypes::Zone;
-            auto hasScript = !entity->getScript().isEmpty();
-
-            // only consider entities that are zones or have scripts, all other entities can
-            // be ignored because they can have events fired on them.
-            // FIXME - this could be optimized further by determining if the script is loaded
-            // and if it has either an enterEntity or leaveEntity method
-            if (isZone || hasScript) {
-                // now check to see if the point contains our entity, this can be expensive if
-                // the entity has a collision hull
-                if (entity->contains(_avatarPosition)) {
-                    if (entitiesContainingAvatar) {
-                        *entitiesContainingAvatar << entity->getEntityItemID();
-                    }
+            if (entitiesContainingAvatar) {
+                *entitiesContainingAvatar << entity->getEntityItemID();
+            }
 
-                    // if this entity is a zone and visible, determine if it is the bestZone
-                    if (isZone && entity->getVisible() && renderableForEntity(entity)) {
-                            auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
-                            _layeredZones.insert(zone);
-                        }
-                    }
-                }
+            // if this entity is a zone and visible, determine if it is the bestZone
+            if (entity->getType() == EntityTypes::Zone && entity->getVisible() && renderableForEntity(entity)) {
+                auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
+                _layeredZones.insert(zone);
             }
+        }
 
         // check if our layered zones have changed
         if (_layeredZones.empty()) {
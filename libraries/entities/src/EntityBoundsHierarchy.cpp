@@ -0,0 +1,94 @@
+//
+//  EntityBoundsHierarchy.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBoundsHierarchy.h"
+
+#include <cfloat>
+
+#include "EntityTreeElement.h"
+
+void EntityBoundsHierarchy::update(const EntityTreePointer& tree) {
+    // read before the map, so that an entity added in between only makes the next update rebuild again
+    quint64 revision = tree->getEntityMapRevision();
+    if (tree.get() == _tree && revision == _revision && _numRefits < MAX_REFITS) {
+        updateBoxes();
+        _hierarchy.refit(_boxes);
+        _numRefits++;
+        return;
+    }
+
+    // only held while building, as the tree would have to copy a map still shared with us on its next edit
+    QHash<EntityItemID, EntityItemPointer> entityMap = tree->getEntityMap();
+    _tree = tree.get();
+    _revision = revision;
+    _entities.clear();
+    _entities.reserve(entityMap.size());
+    for (const auto& entity : entityMap) {
+        _entities.push_back(entity);
+    }
+    entityMap.clear();
+    updateBoxes();
+    _hierarchy.build(_boxes);
+    _numRefits = 0;
+}
+
+void EntityBoundsHierarchy::updateBoxes() {
+    // Finding the bounds resolves the parent pointers of the entity and of its ancestors, which writes to them.
+    // That is only done here, on one thread, so that the ray tests, which run on many, find them already resolved.
+    _boxes.resize(_entities.size());
+    _hasBounds.resize(_entities.size());
+    for (size_t i = 0; i < _entities.size(); i++) {
+        bool success;
+        AABox box = _entities[i]->getAABox(success);
+        // an entity whose parent isn't known yet is skipped by the ray tests until an update finds its bounds
+        _boxes[i] = success ? box : AABox(_entities[i]->getPosition(), 0.0f);
+        _hasBounds[i] = success;
+    }
+}
+
+bool EntityBoundsHierarchy::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        bool visibleOnly, bool collidableOnly, bool precisionPicking,
+        float& distance, BoxFace& face, glm::vec3& surfaceNormal, EntityItemPointer& intersectedEntity) const {
+    distance = FLT_MAX;
+
+    int bestIndex = -1;
+    _hierarchy.findRayIntersection(origin, direction, distance, [&](uint32_t index, float& bestDistance) {
+        if (!_hasBounds[index]) {
+            return false;
+        }
+        bool keepSearching = true;
+        OctreeElementPointer element;
+        void* intersectedObject = nullptr;
+        if (EntityTreeElement::findEntityRayIntersection(_entities[index], _boxes[index], origin, direction, keepSearching, element,
+                bestDistance, face, surfaceNormal, entityIdsToInclude, entityIdsToDiscard, visibleOnly, collidableOnly,
+                &intersectedObject, precisionPicking)) {
+            bestIndex = (int)index;
+            return true;
+        }
+        return false;
+    });
+
+    if (bestIndex < 0) {
+        return false;
+    }
+    intersectedEntity = _entities[bestIndex];
+    return true;
+}
+
+void EntityBoundsHierarchy::clear() {
+    _tree = nullptr;
+    _entities.clear();
+    _boxes.clear();
+    _hasBounds.clear();
+    _hierarchy.clear();
+    _numRefits = 0;
+}
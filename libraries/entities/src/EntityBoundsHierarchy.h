@@ -0,0 +1,60 @@
+//
+//  EntityBoundsHierarchy.h
+//  libraries/entities/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBoundsHierarchy_h
+#define hifi_EntityBoundsHierarchy_h
+
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include <BoundingVolumeHierarchy.h>
+
+#include "EntityItem.h"
+#include "EntityTree.h"
+
+// A bounding volume hierarchy over the bounds of all the entities of a tree, for tracing many rays in a frame.
+// The octree has cells much larger than most entities, which are tested one by one, and its traversal takes the
+// tree's lock for every ray. This is brought up to date once a frame instead, after which rays can be traced from
+// any number of threads, for the same results as EntityTree::findRayIntersection(). The update finds every entity's
+// bounds, and with them resolves its parents, serially; the ray tests only read what it cached.
+class EntityBoundsHierarchy {
+public:
+    // rebuilt at least this often, as refitting to entities that moved makes the hierarchy looser
+    static const int MAX_REFITS = 60;
+
+    // Rebuilds the hierarchy when entities were added or removed, otherwise refits it to their current bounds.
+    // Call with the tree read locked, and keep it locked until the rays of this update have been traced.
+    void update(const EntityTreePointer& tree);
+
+    bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        bool visibleOnly, bool collidableOnly, bool precisionPicking,
+        float& distance, BoxFace& face, glm::vec3& surfaceNormal, EntityItemPointer& intersectedEntity) const;
+
+    void clear();
+
+    size_t size() const { return _entities.size(); }
+
+private:
+    void updateBoxes();
+
+    // the tree and the revision of its map as of the last build, to tell whether entities were added or removed since
+    const EntityTree* _tree { nullptr };
+    quint64 _revision { 0 };
+    std::vector<EntityItemPointer> _entities;
+    std::vector<AABox> _boxes; // what the ray tests use, rather than asking the entities from many threads at once
+    std::vector<bool> _hasBounds;
+    BoundingVolumeHierarchy _hierarchy;
+    int _numRefits { 0 };
+};
+
+#endif // hifi_EntityBoundsHierarchy_h
@@ -0,0 +1,162 @@
+//
+//  EntityContainmentIndex.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityContainmentIndex.h"
+
+#include "EntityItem.h"
+
+bool EntityContainmentIndex::isIndexed(const EntityItemPointer& entity) {
+    return entity->getType() == EntityTypes::Zone || !entity->getScript().isEmpty();
+}
+
+void EntityContainmentIndex::updateEntity(const EntityItemPointer& entity) {
+    // asked before locking, as queries lock entities (for their bounds) while holding _mutex, never the other way around
+    bool indexed = isIndexed(entity);
+    EntityItemID id = entity->getEntityItemID();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!indexed) {
+        removeEntityLocked(id);
+        return;
+    }
+    if (_indices.contains(id)) {
+        return;
+    }
+    _indices.insert(id, (uint32_t)_entities.size());
+    _entities.push_back(entity);
+    entity->setContainmentIndexed(true);
+    _needsBuild = true;
+}
+
+void EntityContainmentIndex::removeEntity(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    removeEntityLocked(id);
+}
+
+void EntityContainmentIndex::removeEntityLocked(const EntityItemID& id) {
+    auto itr = _indices.find(id);
+    if (itr == _indices.end()) {
+        return;
+    }
+    uint32_t index = itr.value();
+    _indices.erase(itr);
+    _entities[index]->setContainmentIndexed(false);
+
+    // move the last entity in its place, the hierarchy is rebuilt before the next query anyway
+    uint32_t last = (uint32_t)_entities.size() - 1;
+    if (index != last) {
+        _entities[index] = std::move(_entities[last]);
+        _indices[_entities[index]->getEntityItemID()] = index;
+    }
+    _entities.pop_back();
+    _unknownBounds.remove(id);
+    _needsBuild = true;
+
+    std::lock_guard<std::mutex> changedLock(_changedMutex);
+    _changed.remove(id);
+}
+
+void EntityContainmentIndex::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& entity : _entities) {
+        entity->setContainmentIndexed(false);
+    }
+    _indices.clear();
+    _entities.clear();
+    _boxes.clear();
+    _unknownBounds.clear();
+    _hierarchy.clear();
+    _needsBuild = false;
+    _numRefits = 0;
+
+    std::lock_guard<std::mutex> changedLock(_changedMutex);
+    _changed.clear();
+}
+
+void EntityContainmentIndex::boundsChanged(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_changedMutex);
+    _changed.insert(id);
+}
+
+QVector<EntityItemPointer> EntityContainmentIndex::findEntitiesContainingPoint(const glm::vec3& point) {
+    QVector<EntityItemPointer> candidates;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        updateHierarchy();
+        _hierarchy.findPointCandidates(point, [&](uint32_t index) {
+            if (_boxes[index].contains(point)) {
+                candidates.push_back(_entities[index]);
+            }
+        });
+    }
+
+    // contains() can be expensive for entities with a collision hull, so it is not asked under the lock
+    QVector<EntityItemPointer> entities;
+    for (auto& entity : candidates) {
+        if (entity->contains(point)) {
+            entities.push_back(entity);
+        }
+    }
+    return entities;
+}
+
+size_t EntityContainmentIndex::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entities.size();
+}
+
+void EntityContainmentIndex::updateHierarchy() {
+    QSet<EntityItemID> changed;
+    {
+        std::lock_guard<std::mutex> lock(_changedMutex);
+        changed.swap(_changed);
+    }
+
+    if (_needsBuild || _numRefits >= MAX_REFITS) {
+        _unknownBounds.clear();
+        _boxes.resize(_entities.size());
+        for (uint32_t i = 0; i < _entities.size(); i++) {
+            updateBox(i);
+        }
+        _hierarchy.build(_boxes);
+        _needsBuild = false;
+        _numRefits = 0;
+        return;
+    }
+
+    changed.unite(_unknownBounds);
+    _unknownBounds.clear();
+
+    bool moved = false;
+    for (const auto& id : changed) {
+        auto itr = _indices.find(id);
+        if (itr != _indices.end()) {
+            updateBox(itr.value());
+            moved = true;
+        }
+    }
+    if (moved) {
+        _hierarchy.refit(_boxes);
+        _numRefits++;
+    }
+}
+
+void EntityContainmentIndex::updateBox(uint32_t index) {
+    const EntityItemPointer& entity = _entities[index];
+    bool success;
+    AABox box = entity->getAABox(success);
+    if (!success) {
+        // an entity whose parent is not known yet, tried again on the next query
+        _unknownBounds.insert(entity->getEntityItemID());
+        box = AABox(entity->getPosition(), 0.0f);
+    }
+    _boxes[index] = box;
+}
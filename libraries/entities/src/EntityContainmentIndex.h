@@ -0,0 +1,74 @@
+//
+//  EntityContainmentIndex.h
+//  libraries/entities/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityContainmentIndex_h
+#define hifi_EntityContainmentIndex_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+
+#include <BoundingVolumeHierarchy.h>
+
+#include "EntityItemID.h"
+#include "EntityTypes.h"
+
+// Answers which entities contain a point (the avatar, for zones and enter/leave events), without searching the octree.
+// Only the entities that can be entered and left are indexed: zones, and entities with a script.
+//
+// The tree keeps it up to date as entities are added, removed, or have their script changed, and entities tell it
+// when their bounds change. The bounding volume hierarchy over them is only rebuilt or refit on the next query.
+// Only client trees keep one, as nothing asks a server which entities contain a point.
+class EntityContainmentIndex {
+public:
+    // rebuilt at least this often, as refitting to entities that moved makes the hierarchy looser
+    static const int MAX_REFITS = 60;
+
+    static bool isIndexed(const EntityItemPointer& entity);
+
+    // adds or removes the entity, depending on whether it should be indexed now
+    // call EntityTree::updateContainmentIndex() instead, which makes sure the entity is still in the tree
+    void updateEntity(const EntityItemPointer& entity);
+    void removeEntity(const EntityItemID& id);
+    void clear();
+
+    // called when an indexed entity moved or was resized, from any thread
+    void boundsChanged(const EntityItemID& id);
+
+    // the indexed entities which contain the point, as tested by EntityItem::contains()
+    QVector<EntityItemPointer> findEntitiesContainingPoint(const glm::vec3& point);
+
+    size_t size() const;
+
+private:
+    void removeEntityLocked(const EntityItemID& id);
+    void updateHierarchy();
+    void updateBox(uint32_t index);
+
+    // the bounds that changed since the last query, on their own lock so that entities never wait on queries
+    std::mutex _changedMutex;
+    QSet<EntityItemID> _changed;
+
+    mutable std::mutex _mutex;
+    QHash<EntityItemID, uint32_t> _indices;
+    std::vector<EntityItemPointer> _entities;
+    std::vector<AABox> _boxes;
+    QSet<EntityItemID> _unknownBounds; // their bounds could not be computed yet, checked again on every query
+    BoundingVolumeHierarchy _hierarchy;
+    bool _needsBuild { false };
+    int _numRefits { 0 };
+};
+
+#endif // hifi_EntityContainmentIndex_h
@@ -29,7 +29,8 @@ void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<Received
 }
 
 void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) {
-    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics) {
+    if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics ||
+            type == PacketType::EntityPhysicsBulk) {
         EntityItem::adjustEditPacketForClockSkew(buffer, clockSkew);
     }
 }
@@ -90,6 +91,12 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         return;
     }
 
+    if (type == PacketType::EntityPhysics && EntityPhysicsUpdate::canEncode(properties)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _physicsUpdates.emplace_back(entityItemID, properties);
+        return;
+    }
+
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
 
     bool success;
@@ -113,6 +120,34 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
     }
 }
 
+void EntityEditPacketSender::releaseQueuedPhysicsUpdates() {
+    std::vector<EntityPhysicsUpdate> updates;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        updates.swap(_physicsUpdates);
+    }
+    if (updates.empty()) {
+        return;
+    }
+
+    // each bulk message fills the payload of one packet (after the edit sequence number and timestamp)
+    const int MAX_BULK_MESSAGE_SIZE = NLPacket::maxPayloadSize(PacketType::EntityPhysicsBulk) - sizeof(quint16) - sizeof(quint64);
+    int numUpdates = (int)updates.size();
+    int numPacked = 0;
+    while (numPacked < numUpdates) {
+        QByteArray bufferOut(MAX_BULK_MESSAGE_SIZE, 0);
+        int numInMessage = EntityPhysicsUpdate::encodeBulkMessage(&updates[numPacked], numUpdates - numPacked, bufferOut);
+        if (numInMessage == 0) {
+            break;
+        }
+        queueOctreeEditMessage(PacketType::EntityPhysicsBulk, bufferOut);
+        numPacked += numInMessage;
+    }
+
+    // physics updates are stale by next frame so don't wait for the pending packets to fill
+    releaseQueuedMessages();
+}
+
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
     if (!_shouldSend) {
         return; // bail early
@@ -15,8 +15,10 @@
 #include <OctreeEditPacketSender.h>
 
 #include <mutex>
+#include <vector>
 
 #include "EntityItem.h"
+#include "EntityPhysicsUpdate.h"
 #include "AvatarData.h"
 
 /// Utility for processing, packing, queueing and sending of outbound edit voxel messages.
@@ -36,6 +38,9 @@ public:
     void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
                                 EntityItemID entityItemID, const EntityItemProperties& properties);
 
+    /// EntityPhysics edits that only carry a transform and velocities are collected rather than sent one by one.
+    /// Call this once the simulation has harvested its changes to pack them into EntityPhysicsBulk messages.
+    void releaseQueuedPhysicsUpdates();
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
 
@@ -52,6 +57,7 @@ private:
 
 private:
     std::mutex _mutex;
+    std::vector<EntityPhysicsUpdate> _physicsUpdates; // guarded by _mutex
     AvatarData* _myAvatar { nullptr };
     QScriptEngine _scriptEngine;
 };
@@ -2432,6 +2432,12 @@ void EntityItem::requiresRecalcBoxes() {
         _recalcMinAACube = true; 
         _recalcMaxAACube = true;
     });
+    if (_containmentIndexed) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->getContainmentIndex().boundsChanged(getEntityItemID());
+        }
+    }
 }
 
 QString EntityItem::getHref() const {
@@ -2565,9 +2571,18 @@ QString EntityItem::getScript() const {
 }
 
 void EntityItem::setScript(const QString& value) { 
+    bool hadScript;
     withWriteLock([&] {
+        hadScript = !_script.isEmpty();
         _script = value;
     });
+    // entities with a script can be entered and left
+    if (hadScript == value.isEmpty()) {
+        EntityTreePointer tree = getTree();
+        if (tree) {
+            tree->updateContainmentIndex(getThisPointer());
+        }
+    }
 }
 
 quint64 EntityItem::getScriptTimestamp() const { 
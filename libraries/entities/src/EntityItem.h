@@ -12,6 +12,7 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 
@@ -357,6 +358,10 @@ public:
 
     bool isSimulated() const { return _simulated; }
 
+    // whether the tree's EntityContainmentIndex has this entity, which then has to hear of its bounds changing
+    bool isContainmentIndexed() const { return _containmentIndexed; }
+    void setContainmentIndexed(bool indexed) { _containmentIndexed = indexed; }
+
     void* getPhysicsInfo() const { return _physicsInfo; }
 
     void setPhysicsInfo(void* data) { _physicsInfo = data; }
@@ -553,6 +558,7 @@ protected:
     EntityTreeElementPointer _element; // set by EntityTreeElement
     void* _physicsInfo { nullptr }; // set by EntitySimulation
     bool _simulated { false }; // set by EntitySimulation
+    std::atomic<bool> _containmentIndexed { false }; // set by EntityContainmentIndex
 
     bool addActionInternal(EntitySimulationPointer simulation, EntityDynamicPointer action);
     bool removeActionInternal(const QUuid& actionID, EntitySimulationPointer simulation = nullptr);
@@ -0,0 +1,286 @@
+//
+//  EntityPhysicsUpdate.cpp
+//  libraries/entities/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsUpdate.h"
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#include <GLMHelpers.h>
+#include <OctalCode.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+#include "EntitiesLogging.h"
+#include "EntityItemProperties.h"
+
+// bulk message layout:
+//     root octcode | quint64 lastEdited | quint16 numUpdates | numUpdates * update
+// which puts lastEdited in the same place as an EntityPhysics edit so EntityItem::adjustEditPacketForClockSkew() works.
+//
+// update layout:
+//     id | quint8 flags | quint32 editedBefore | vec3 position | packed quat rotation | [vec3 velocity] | [vec3 angularVelocity]
+//     | [vec3 acceleration] | [vec3 queryAACube corner, float queryAACube scale]
+// where the bracketed fields are omitted when their flag is not set (vectors are zero when omitted), and editedBefore
+// is how many usecs before the message's lastEdited the update was made, so that each entity keeps its own timestamp.
+
+enum EntityPhysicsUpdateFlags : quint8 {
+    HAS_VELOCITY = 0x01,
+    HAS_ANGULAR_VELOCITY = 0x02,
+    HAS_ACCELERATION = 0x04,
+    HAS_QUERY_AA_CUBE = 0x08
+};
+
+const int PACKED_QUAT_SIZE = 4 * sizeof(uint16_t); // see packOrientationQuatToBytes()
+const int MIN_UPDATE_SIZE = NUM_BYTES_RFC4122_UUID + sizeof(quint8) + sizeof(quint32) + sizeof(glm::vec3) + PACKED_QUAT_SIZE;
+
+static int rootOctcodeLength() {
+    static int length = [] {
+        unsigned char* octcode = pointToOctalCode(0.0f, 0.0f, 0.0f, 0.5f);
+        int result = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(octcode));
+        delete[] octcode;
+        return result;
+    }();
+    return length;
+}
+
+static quint8 computeFlags(const EntityPhysicsUpdate& update) {
+    quint8 flags = 0;
+    if (update.velocity != Vectors::ZERO) {
+        flags |= HAS_VELOCITY;
+    }
+    if (update.angularVelocity != Vectors::ZERO) {
+        flags |= HAS_ANGULAR_VELOCITY;
+    }
+    if (update.acceleration != Vectors::ZERO) {
+        flags |= HAS_ACCELERATION;
+    }
+    if (update.hasQueryAACube) {
+        flags |= HAS_QUERY_AA_CUBE;
+    }
+    return flags;
+}
+
+static int computeEncodedSize(quint8 flags) {
+    int size = MIN_UPDATE_SIZE;
+    if (flags & HAS_VELOCITY) {
+        size += sizeof(glm::vec3);
+    }
+    if (flags & HAS_ANGULAR_VELOCITY) {
+        size += sizeof(glm::vec3);
+    }
+    if (flags & HAS_ACCELERATION) {
+        size += sizeof(glm::vec3);
+    }
+    if (flags & HAS_QUERY_AA_CUBE) {
+        size += sizeof(glm::vec3) + sizeof(float);
+    }
+    return size;
+}
+
+bool EntityPhysicsUpdate::canEncode(const EntityItemProperties& properties) {
+    if (properties.getClientOnly()) {
+        // avatar-entities are updated through the avatar-mixer
+        return false;
+    }
+    if (!(properties.positionChanged() && properties.rotationChanged() && properties.velocityChanged() &&
+            properties.angularVelocityChanged() && properties.accelerationChanged())) {
+        return false;
+    }
+
+    static EntityPropertyFlags allowedProperties;
+    static std::once_flag once;
+    std::call_once(once, [&] {
+        allowedProperties += PROP_POSITION;
+        allowedProperties += PROP_ROTATION;
+        allowedProperties += PROP_VELOCITY;
+        allowedProperties += PROP_ANGULAR_VELOCITY;
+        allowedProperties += PROP_ACCELERATION;
+        allowedProperties += PROP_QUERY_AA_CUBE;
+        allowedProperties += PROP_CLIENT_ONLY;
+        allowedProperties += PROP_OWNING_AVATAR_ID;
+    });
+
+    EntityPropertyFlags changedProperties = properties.getChangedProperties();
+    for (int flag = (int)changedProperties.firstFlag(); flag <= (int)changedProperties.lastFlag(); ++flag) {
+        EntityPropertyList property = (EntityPropertyList)flag;
+        if (changedProperties.getHasProperty(property) && !allowedProperties.getHasProperty(property)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+EntityPhysicsUpdate::EntityPhysicsUpdate(const EntityItemID& entityID, const EntityItemProperties& properties) :
+    id(entityID),
+    position(properties.getPosition()),
+    rotation(properties.getRotation()),
+    velocity(properties.getVelocity()),
+    angularVelocity(properties.getAngularVelocity()),
+    acceleration(properties.getAcceleration()),
+    queryAACube(properties.getQueryAACube()),
+    lastEdited(properties.getLastEdited()),
+    hasQueryAACube(properties.queryAACubeChanged()) {
+}
+
+void EntityPhysicsUpdate::copyToProperties(EntityItemProperties& properties) const {
+    properties.setPosition(position);
+    properties.setRotation(rotation);
+    properties.setVelocity(velocity);
+    properties.setAngularVelocity(angularVelocity);
+    properties.setAcceleration(acceleration);
+    if (hasQueryAACube) {
+        properties.setQueryAACube(queryAACube);
+    }
+    properties.setLastEdited(lastEdited);
+}
+
+int EntityPhysicsUpdate::encodeBulkMessage(const EntityPhysicsUpdate* updates, int numUpdates, QByteArray& buffer) {
+    int octcodeLength = rootOctcodeLength();
+    int headerLength = octcodeLength + sizeof(quint64) + sizeof(quint16);
+    if (buffer.size() < headerLength + MIN_UPDATE_SIZE) {
+        qCDebug(entities) << "ERROR - EntityPhysicsUpdate::encodeBulkMessage() called with buffer that is too small!";
+        return 0;
+    }
+
+    unsigned char* start = reinterpret_cast<unsigned char*>(buffer.data());
+    unsigned char* end = start + buffer.size();
+
+    unsigned char* octcode = pointToOctalCode(0.0f, 0.0f, 0.0f, 0.5f);
+    memcpy(start, octcode, octcodeLength);
+    delete[] octcode;
+
+    // the message carries the most recent timestamp, and each update how long before it it was made
+    const int MAX_UPDATES_PER_MESSAGE = std::numeric_limits<quint16>::max();
+    int numToPack = std::min(numUpdates, MAX_UPDATES_PER_MESSAGE);
+    quint64 lastEdited = 0;
+    for (int i = 0; i < numToPack; ++i) {
+        lastEdited = std::max(lastEdited, updates[i].lastEdited);
+    }
+
+    unsigned char* copyAt = start + headerLength;
+    quint16 numPacked = 0;
+    while (numPacked < numToPack) {
+        const EntityPhysicsUpdate& update = updates[numPacked];
+        quint8 flags = computeFlags(update);
+        if (copyAt + computeEncodedSize(flags) > end) {
+            break;
+        }
+
+        memcpy(copyAt, update.id.toRfc4122().constData(), NUM_BYTES_RFC4122_UUID);
+        copyAt += NUM_BYTES_RFC4122_UUID;
+        *copyAt++ = flags;
+        quint32 editedBefore = (quint32)std::min(lastEdited - update.lastEdited,
+                                                 (quint64)std::numeric_limits<quint32>::max());
+        memcpy(copyAt, &editedBefore, sizeof(editedBefore));
+        copyAt += sizeof(editedBefore);
+        memcpy(copyAt, &update.position, sizeof(glm::vec3));
+        copyAt += sizeof(glm::vec3);
+        copyAt += packOrientationQuatToBytes(copyAt, update.rotation);
+        if (flags & HAS_VELOCITY) {
+            memcpy(copyAt, &update.velocity, sizeof(glm::vec3));
+            copyAt += sizeof(glm::vec3);
+        }
+        if (flags & HAS_ANGULAR_VELOCITY) {
+            memcpy(copyAt, &update.angularVelocity, sizeof(glm::vec3));
+            copyAt += sizeof(glm::vec3);
+        }
+        if (flags & HAS_ACCELERATION) {
+            memcpy(copyAt, &update.acceleration, sizeof(glm::vec3));
+            copyAt += sizeof(glm::vec3);
+        }
+        if (flags & HAS_QUERY_AA_CUBE) {
+            glm::vec3 corner = update.queryAACube.getCorner();
+            float scale = update.queryAACube.getScale();
+            memcpy(copyAt, &corner, sizeof(glm::vec3));
+            copyAt += sizeof(glm::vec3);
+            memcpy(copyAt, &scale, sizeof(float));
+            copyAt += sizeof(float);
+        }
+
+        ++numPacked;
+    }
+
+    memcpy(start + octcodeLength, &lastEdited, sizeof(lastEdited));
+    memcpy(start + octcodeLength + sizeof(lastEdited), &numPacked, sizeof(numPacked));
+    buffer.resize((int)(copyAt - start));
+    return numPacked;
+}
+
+int EntityPhysicsUpdate::decodeBulkMessage(const unsigned char* data, int maxLength,
+                                           quint64& lastEdited, std::vector<EntityPhysicsUpdate>& updates) {
+    const unsigned char* dataAt = data;
+    const unsigned char* end = data + maxLength;
+
+    int octets = numberOfThreeBitSectionsInCode(dataAt, maxLength);
+    if (octets < 0) {
+        return 0;
+    }
+    int octcodeLength = (int)bytesRequiredForCodeLength(octets);
+    if (octcodeLength + (int)(sizeof(quint64) + sizeof(quint16)) > maxLength) {
+        return 0;
+    }
+    dataAt += octcodeLength;
+
+    memcpy(&lastEdited, dataAt, sizeof(lastEdited));
+    dataAt += sizeof(lastEdited);
+    quint16 numUpdates;
+    memcpy(&numUpdates, dataAt, sizeof(numUpdates));
+    dataAt += sizeof(numUpdates);
+
+    updates.clear();
+    updates.reserve(numUpdates);
+    for (quint16 i = 0; i < numUpdates; ++i) {
+        if (dataAt + MIN_UPDATE_SIZE > end) {
+            return 0;
+        }
+        quint8 flags = dataAt[NUM_BYTES_RFC4122_UUID];
+        if (dataAt + computeEncodedSize(flags) > end) {
+            return 0;
+        }
+
+        updates.emplace_back();
+        EntityPhysicsUpdate& update = updates.back();
+        update.id = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(dataAt), NUM_BYTES_RFC4122_UUID));
+        dataAt += NUM_BYTES_RFC4122_UUID + sizeof(flags);
+        quint32 editedBefore;
+        memcpy(&editedBefore, dataAt, sizeof(editedBefore));
+        dataAt += sizeof(editedBefore);
+        update.lastEdited = lastEdited - std::min((quint64)editedBefore, lastEdited);
+        memcpy(&update.position, dataAt, sizeof(glm::vec3));
+        dataAt += sizeof(glm::vec3);
+        dataAt += unpackOrientationQuatFromBytes(dataAt, update.rotation);
+        if (flags & HAS_VELOCITY) {
+            memcpy(&update.velocity, dataAt, sizeof(glm::vec3));
+            dataAt += sizeof(glm::vec3);
+        }
+        if (flags & HAS_ANGULAR_VELOCITY) {
+            memcpy(&update.angularVelocity, dataAt, sizeof(glm::vec3));
+            dataAt += sizeof(glm::vec3);
+        }
+        if (flags & HAS_ACCELERATION) {
+            memcpy(&update.acceleration, dataAt, sizeof(glm::vec3));
+            dataAt += sizeof(glm::vec3);
+        }
+        if (flags & HAS_QUERY_AA_CUBE) {
+            glm::vec3 corner;
+            float scale;
+            memcpy(&corner, dataAt, sizeof(glm::vec3));
+            dataAt += sizeof(glm::vec3);
+            memcpy(&scale, dataAt, sizeof(float));
+            dataAt += sizeof(float);
+            update.queryAACube = AACube(corner, scale);
+            update.hasQueryAACube = true;
+        }
+    }
+    return (int)(dataAt - data);
+}
@@ -0,0 +1,60 @@
+//
+//  EntityPhysicsUpdate.h
+//  libraries/entities/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsUpdate_h
+#define hifi_EntityPhysicsUpdate_h
+
+#include <vector>
+
+#include <QByteArray>
+
+#include <AACube.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "EntityItemID.h"
+
+class EntityItemProperties;
+
+/// The transform and velocities that a simulation owner sends to the entity-server for a moving body.
+/// Many of these are packed into a single PacketType::EntityPhysicsBulk edit message, which the server
+/// applies under one lock of its tree.  Everything is in the parent frame, like EntityPhysics edits.
+class EntityPhysicsUpdate {
+public:
+    /// \return true if the properties hold nothing more than an EntityPhysicsUpdate can carry
+    static bool canEncode(const EntityItemProperties& properties);
+
+    EntityPhysicsUpdate() { }
+    EntityPhysicsUpdate(const EntityItemID& entityID, const EntityItemProperties& properties);
+
+    void copyToProperties(EntityItemProperties& properties) const;
+
+    /// packs updates[0, numUpdates) into buffer until it is full
+    /// \return number of updates that were packed
+    static int encodeBulkMessage(const EntityPhysicsUpdate* updates, int numUpdates, QByteArray& buffer);
+
+    /// lastEdited is the timestamp of the message, which none of its updates is more recent than
+    /// \return number of bytes read or zero if the message was malformed
+    static int decodeBulkMessage(const unsigned char* data, int maxLength,
+                                 quint64& lastEdited, std::vector<EntityPhysicsUpdate>& updates);
+
+    EntityItemID id;
+    glm::vec3 position { 0.0f };
+    glm::quat rotation;
+    glm::vec3 velocity { 0.0f };
+    glm::vec3 angularVelocity { 0.0f };
+    glm::vec3 acceleration { 0.0f };
+    AACube queryAACube;
+    quint64 lastEdited { 0 };
+    bool hasQueryAACube { false };
+};
+
+#endif // hifi_EntityPhysicsUpdate_h
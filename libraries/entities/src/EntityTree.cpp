@@ -29,6 +29,7 @@
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "EntityPhysicsUpdate.h"
 
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
@@ -90,7 +91,12 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         _simulation->clearEntities();
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
-    localMap.swap(_entityMap);
+    {
+        QWriteLocker locker(&_entityMapLock);
+        localMap.swap(_entityMap);
+        _entityMapRevision++;
+    }
+    _containmentIndex.clear();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -218,6 +224,7 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
         case PacketType::EntityEdit:
         case PacketType::EntityErase:
         case PacketType::EntityPhysics:
+        case PacketType::EntityPhysicsBulk:
             return true;
         default:
             return false;
@@ -1100,6 +1107,10 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             break;
         }
 
+        case PacketType::EntityPhysicsBulk:
+            processedBytes = processPhysicsBulkMessage(editData, maxLength, senderNode);
+            break;
+
         case PacketType::EntityAdd:
             isAdd = true;  // fall through to next case
         case PacketType::EntityPhysics:
@@ -1325,6 +1336,74 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     return processedBytes;
 }
 
+int EntityTree::processPhysicsBulkMessage(const unsigned char* editData, int maxLength, const SharedNodePointer& senderNode) {
+    quint64 startDecode = usecTimestampNow();
+    quint64 lastEdited = 0;
+    std::vector<EntityPhysicsUpdate> updates;
+    int processedBytes = EntityPhysicsUpdate::decodeBulkMessage(editData, maxLength, lastEdited, updates);
+    quint64 endDecode = usecTimestampNow();
+    if (processedBytes == 0) {
+        // skip the rest of the message, as nothing after a malformed update can be trusted
+        qCDebug(entities) << "Malformed EntityPhysicsBulk message from" << senderNode->getUUID();
+        return maxLength;
+    }
+
+    // the whole message was received under one write lock, so every update in it is applied in one pass
+    quint64 lookupTime = 0, filterTime = 0, updateTime = 0;
+    for (const auto& update : updates) {
+        _totalEditMessages++;
+
+        quint64 startLookup = usecTimestampNow();
+        EntityItemPointer existingEntity = findEntityByEntityItemID(update.id);
+        quint64 endLookup = usecTimestampNow();
+        lookupTime += endLookup - startLookup;
+        if (!existingEntity) {
+            static QString repeatedMessage =
+                LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
+            qCDebug(entities) << "Edit failed. [" << PacketType::EntityPhysicsBulk << "] " <<
+                    "entity id:" << update.id;
+            continue;
+        }
+
+        EntityItemProperties properties;
+        update.copyToProperties(properties);
+
+        quint64 startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        bool allowed = filterProperties(existingEntity, properties, properties, wasChanged, FilterType::Physics);
+        if (!allowed) {
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!allowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        quint64 endFilter = usecTimestampNow();
+        filterTime += endFilter - startFilter;
+
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << update.id;
+            qCDebug(entities) << "   properties:" << properties;
+        }
+
+        quint64 startUpdate = usecTimestampNow();
+        updateEntity(existingEntity, properties, senderNode);
+        existingEntity->markAsChangedOnServer();
+        quint64 endUpdate = usecTimestampNow();
+        updateTime += endUpdate - startUpdate;
+        _totalUpdates++;
+    }
+
+    _totalDecodeTime += endDecode - startDecode;
+    _totalLookupTime += lookupTime;
+    _totalFilterTime += filterTime;
+    _totalUpdateTime += updateTime;
+
+    return processedBytes;
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -1642,11 +1721,46 @@ void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
         return;
     }
     _entityMap.insert(id, entity);
+    _entityMapRevision++;
+    locker.unlock();
+    updateContainmentIndex(entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
     QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
+    _entityMapRevision++;
+    locker.unlock();
+    _containmentIndex.removeEntity(id);
+}
+
+QHash<EntityItemID, EntityItemPointer> EntityTree::getEntityMap() const {
+    QReadLocker locker(&_entityMapLock);
+    return _entityMap;
+}
+
+void EntityTree::updateContainmentIndex(const EntityItemPointer& entity) {
+    if (!getIsClient()) {
+        return;
+    }
+    _containmentIndex.updateEntity(entity);
+
+    // Removed from the tree meanwhile by another thread, which may have already removed it from the index too.
+    // Checking after the index took it, rather than before under the map's lock, keeps the two locks apart.
+    EntityItemID id = entity->getEntityItemID();
+    bool inTree;
+    {
+        QReadLocker locker(&_entityMapLock);
+        inTree = _entityMap.value(id) == entity;
+    }
+    if (!inTree) {
+        _containmentIndex.removeEntity(id);
+    }
+}
+
+quint64 EntityTree::getEntityMapRevision() const {
+    QReadLocker locker(&_entityMapLock);
+    return _entityMapRevision;
 }
 
 void EntityTree::debugDumpMap() {
@@ -22,6 +22,7 @@ class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 #include "AddEntityOperator.h"
+#include "EntityContainmentIndex.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
@@ -138,6 +139,12 @@ public:
     EntityItemPointer findEntityByEntityItemID(const EntityItemID& entityID);
     virtual SpatiallyNestablePointer findByID(const QUuid& id) override { return findEntityByID(id); }
 
+    // QHash's are implicitly shared, so this is a cheap copy, but holding on to it makes the next edit of the map copy it all
+    QHash<EntityItemID, EntityItemPointer> getEntityMap() const;
+
+    // changes whenever entities are added or removed, to tell whether a getEntityMap() taken earlier is still current
+    quint64 getEntityMapRevision() const;
+
     EntityItemID assignEntityID(const EntityItemID& entityItemID); /// Assigns a known ID for a creator token ID
 
 
@@ -148,6 +155,17 @@ public:
     /// \remark Side effect: any initial contents in foundEntities will be lost
     void findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities);
 
+    /// finds the zones, and entities with a script, which contain a point, without searching the octree
+    /// \param point the point in world-frame (meters)
+    /// \return the entities whose volume contains the point, as tested by EntityItem::contains()
+    QVector<EntityItemPointer> findEntitiesContainingPoint(const glm::vec3& point) {
+        return _containmentIndex.findEntitiesContainingPoint(point);
+    }
+    EntityContainmentIndex& getContainmentIndex() { return _containmentIndex; }
+
+    /// adds the entity to, or removes it from, the containment index, if this is a client tree and the entity is still in it
+    void updateContainmentIndex(const EntityItemPointer& entity);
+
     /// finds all entities that touch a cube
     /// \param cube the query cube in world-frame (meters)
     /// \param foundEntities[out] vector of non-EntityItemPointer
@@ -185,6 +203,7 @@ public:
 
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
+    int processPhysicsBulkMessage(const unsigned char* editData, int maxLength, const SharedNodePointer& senderNode);
 
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
@@ -315,6 +334,8 @@ protected:
 
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
+    quint64 _entityMapRevision { 0 };
+    EntityContainmentIndex _containmentIndex;
 
     EntitySimulationPointer _simulation;
 
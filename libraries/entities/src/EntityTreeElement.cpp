@@ -637,79 +637,118 @@ bool EntityTreeElement::findDetailedRayIntersection(const glm::vec3& origin, con
                                     bool visibleOnly, bool collidableOnly, void** intersectedObject, bool precisionPicking, float distanceToElementCube) {
 
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
-    int entityNumber = 0;
     bool somethingIntersected = false;
     forEachEntity([&](EntityItemPointer entity) {
-        if ( (visibleOnly && !entity->isVisible()) || (collidableOnly && (entity->getCollisionless() || entity->getShapeType() == SHAPE_TYPE_NONE))
-            || (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID()))
-            || (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
+        if (findEntityRayIntersection(entity, origin, direction, keepSearching, element, distance, face, surfaceNormal,
+                entityIdsToInclude, entityIDsToDiscard, visibleOnly, collidableOnly, intersectedObject, precisionPicking)) {
+            somethingIntersected = true;
         }
+    });
+    return somethingIntersected;
+}
 
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        if (!success) {
-            return;
-        }
+static bool isExcludedFromRay(const EntityItemPointer& entity, const QVector<EntityItemID>& entityIdsToInclude,
+                              const QVector<EntityItemID>& entityIDsToDiscard, bool visibleOnly, bool collidableOnly) {
+    return (visibleOnly && !entity->isVisible()) || (collidableOnly && (entity->getCollisionless() || entity->getShapeType() == SHAPE_TYPE_NONE))
+        || (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID()))
+        || (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID()));
+}
 
-        float localDistance;
-        BoxFace localFace;
-        glm::vec3 localSurfaceNormal;
+static bool findRayIntersectionInEntityBox(const EntityItemPointer& entity, const AABox& entityBox, const glm::vec3& origin,
+                                           const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element,
+                                           float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                           void** intersectedObject, bool precisionPicking);
 
-        // if the ray doesn't intersect with our cube, we can stop searching!
-        if (!entityBox.findRayIntersection(origin, direction, localDistance, localFace, localSurfaceNormal)) {
-            return;
-        }
+bool EntityTreeElement::findEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element,
+                                    float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
+                                    bool visibleOnly, bool collidableOnly, void** intersectedObject, bool precisionPicking) {
+    if (isExcludedFromRay(entity, entityIdsToInclude, entityIDsToDiscard, visibleOnly, collidableOnly)) {
+        return false;
+    }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
-        glm::mat4 translation = glm::translate(entity->getPosition());
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-        glm::vec3 dimensions = entity->getDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint);
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedRayIntersection()) {
-                    if (entity->findDetailedRayIntersection(origin, direction, keepSearching, element, localDistance,
-                        localFace, localSurfaceNormal, intersectedObject, precisionPicking)) {
-
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            *intersectedObject = (void*)entity.get();
-                            somethingIntersected = true;
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    if (!success) {
+        return false;
+    }
+    return findRayIntersectionInEntityBox(entity, entityBox, origin, direction, keepSearching, element, distance, face,
+                                          surfaceNormal, intersectedObject, precisionPicking);
+}
+
+bool EntityTreeElement::findEntityRayIntersection(const EntityItemPointer& entity, const AABox& entityBox,
+                                    const glm::vec3& origin, const glm::vec3& direction, bool& keepSearching,
+                                    OctreeElementPointer& element, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
+                                    bool visibleOnly, bool collidableOnly, void** intersectedObject, bool precisionPicking) {
+    if (isExcludedFromRay(entity, entityIdsToInclude, entityIDsToDiscard, visibleOnly, collidableOnly)) {
+        return false;
+    }
+    return findRayIntersectionInEntityBox(entity, entityBox, origin, direction, keepSearching, element, distance, face,
+                                          surfaceNormal, intersectedObject, precisionPicking);
+}
+
+static bool findRayIntersectionInEntityBox(const EntityItemPointer& entity, const AABox& entityBox, const glm::vec3& origin,
+                                    const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element,
+                                    float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    void** intersectedObject, bool precisionPicking) {
+    float localDistance;
+    BoxFace localFace;
+    glm::vec3 localSurfaceNormal;
+
+    // if the ray doesn't intersect with our cube, we can stop searching!
+    if (!entityBox.findRayIntersection(origin, direction, localDistance, localFace, localSurfaceNormal)) {
+        return false;
+    }
+
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::mat4 rotation = glm::mat4_cast(entity->getRotation());
+    glm::mat4 translation = glm::translate(entity->getPosition());
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint);
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedRayIntersection()) {
+                if (entity->findDetailedRayIntersection(origin, direction, keepSearching, element, localDistance,
+                    localFace, localSurfaceNormal, intersectedObject, precisionPicking)) {
+
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 1.0f));
+                        surfaceNormal = localSurfaceNormal;
                         *intersectedObject = (void*)entity.get();
-                        somethingIntersected = true;
+                        return true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 1.0f));
+                    *intersectedObject = (void*)entity.get();
+                    return true;
+                }
             }
         }
-        entityNumber++;
-    });
-    return somethingIntersected;
+    }
+    return false;
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
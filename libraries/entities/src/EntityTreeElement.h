@@ -155,6 +155,20 @@ public:
                          BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
                          const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly,
                          void** intersectedObject, bool precisionPicking, float distanceToElementCube);
+
+    // the ray test findDetailedRayIntersection() runs on each of its entities, also used by EntityBoundsHierarchy
+    static bool findEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                         const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element, float& distance,
+                         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                         const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly,
+                         void** intersectedObject, bool precisionPicking);
+    // the same, with the entity's bounds already known, so that its parents are not looked up for them
+    static bool findEntityRayIntersection(const EntityItemPointer& entity, const AABox& entityBox, const glm::vec3& origin,
+                         const glm::vec3& direction, bool& keepSearching, OctreeElementPointer& element, float& distance,
+                         BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                         const QVector<EntityItemID>& entityIdsToDiscard, bool visibleOnly, bool collidableOnly,
+                         void** intersectedObject, bool precisionPicking);
+
     virtual bool findSpherePenetration(const glm::vec3& center, float radius,
                         glm::vec3& penetration, void** penetratedObject) const override;
 
@@ -0,0 +1,589 @@
+//
+//  FBXGeometrySerializer.cpp
+//  libraries/fbx/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXGeometrySerializer.h"
+
+#include <memory>
+
+#include "FBXReader.h"
+
+const quint32 FBXGeometrySerializer::CURRENT_VERSION = 2;
+
+namespace {
+
+const quint32 GEOMETRY_MAGIC = 0x4d474648; // "HFGM"
+
+// Smallest encoding of each repeated element, used to reject a section count that the remaining bytes cannot hold
+// before anything is allocated for it
+const size_t MIN_TEXTURE_SIZE = 5 * sizeof(quint32) + 2 * sizeof(int) + 2 * sizeof(uint8_t);
+const size_t MIN_MATERIAL_SIZE = 3 * sizeof(glm::vec3) + 9 * sizeof(float) + 3 * sizeof(quint32) +
+    sizeof(uint8_t) + 11 * MIN_TEXTURE_SIZE + sizeof(glm::vec2) + 9 * sizeof(uint8_t);
+const size_t MIN_JOINT_SIZE = 4 * sizeof(glm::mat4) + 6 * sizeof(glm::quat) + 6 * sizeof(glm::vec3) +
+    5 * sizeof(quint32) + sizeof(int) + sizeof(float) + 4 * sizeof(uint8_t);
+const size_t MIN_JOINT_INDEX_SIZE = sizeof(quint32) + sizeof(int);
+const size_t MIN_MESH_PART_SIZE = 4 * sizeof(quint32);
+const size_t MIN_MESH_SIZE = 12 * sizeof(quint32) + 2 * sizeof(glm::vec3) + sizeof(glm::mat4) + sizeof(unsigned int) +
+    sizeof(uint8_t);
+const size_t CLUSTER_SIZE = sizeof(int) + sizeof(glm::mat4);
+const size_t MIN_BLENDSHAPE_SIZE = 3 * sizeof(quint32);
+const size_t MIN_ANIMATION_FRAME_SIZE = 2 * sizeof(quint32);
+const size_t MIN_MESH_NAME_SIZE = sizeof(int) + sizeof(quint32);
+const size_t MIN_STRING_SIZE = sizeof(quint32);
+
+class Writer {
+public:
+    QByteArray data;
+
+    template<class T>
+    void write(const T& value) {
+        data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    // bools go out as a single byte of 0 or 1 whatever the size of bool, so that the reader can validate them
+    void writeBool(bool value) { write<uint8_t>(value ? 1 : 0); }
+
+    template<class T>
+    void writeArray(const T* values, size_t count) {
+        write<quint32>((quint32)count);
+        data.append(reinterpret_cast<const char*>(values), (int)(count * sizeof(T)));
+    }
+
+    template<class T>
+    void writeVector(const QVector<T>& values) { writeArray(values.constData(), values.size()); }
+
+    template<class T>
+    void writeVector(const std::vector<T>& values) { writeArray(values.data(), values.size()); }
+
+    void writeBytes(const QByteArray& bytes) { writeArray(bytes.constData(), bytes.size()); }
+    void writeString(const QString& string) { writeBytes(string.toUtf8()); }
+
+    void writeExtents(const Extents& extents) {
+        write(extents.minimum);
+        write(extents.maximum);
+    }
+
+    void writeTexture(const FBXTexture& texture);
+    void writeMaterial(const FBXMaterial& material);
+    void writeJoint(const FBXJoint& joint);
+    void writeMesh(const FBXMesh& mesh);
+    void writeGeometry(const FBXGeometry& geometry);
+};
+
+class Reader {
+public:
+    Reader(const char* data, size_t size) : _cursor(data), _end(data + size) { }
+
+    bool atEnd() const { return _cursor == _end; }
+
+    template<class T>
+    T read() {
+        T value;
+        copy(&value, sizeof(T));
+        return value;
+    }
+
+    bool readBool() {
+        uint8_t value = read<uint8_t>();
+        if (value > 1) {
+            throw QString("corrupt geometry cache entry");
+        }
+        return value != 0;
+    }
+
+    template<class T>
+    void readVector(QVector<T>& values) {
+        quint32 count = readCount(sizeof(T));
+        values.resize(count);
+        copy(values.data(), count * sizeof(T));
+    }
+
+    template<class T>
+    void readVector(std::vector<T>& values) {
+        quint32 count = readCount(sizeof(T));
+        values.resize(count);
+        copy(values.data(), count * sizeof(T));
+    }
+
+    QByteArray readBytes() {
+        quint32 count = readCount(1);
+        QByteArray bytes(_cursor, count);
+        _cursor += count;
+        return bytes;
+    }
+
+    QString readString() { return QString::fromUtf8(readBytes()); }
+
+    Extents readExtents() {
+        glm::vec3 minimum = read<glm::vec3>();
+        glm::vec3 maximum = read<glm::vec3>();
+        return Extents(minimum, maximum);
+    }
+
+    void readTexture(FBXTexture& texture);
+    void readMaterial(FBXMaterial& material);
+    void readJoint(FBXJoint& joint);
+    void readMesh(FBXMesh& mesh, const QString& url);
+    void readGeometry(FBXGeometry& geometry, const QString& url);
+
+private:
+    void require(size_t numBytes) const {
+        if ((size_t)(_end - _cursor) < numBytes) {
+            throw QString("corrupt geometry cache entry");
+        }
+    }
+
+    // reads an element count and checks that that many elements of at least elementSize bytes are actually present
+    quint32 readCount(size_t elementSize) {
+        quint32 count = read<quint32>();
+        require((size_t)count * elementSize);
+        return count;
+    }
+
+    void copy(void* destination, size_t numBytes) {
+        require(numBytes);
+        if (numBytes > 0) {
+            memcpy(destination, _cursor, numBytes);
+            _cursor += numBytes;
+        }
+    }
+
+    const char* _cursor;
+    const char* const _end;
+};
+
+void Writer::writeTexture(const FBXTexture& texture) {
+    writeString(texture.id);
+    writeString(texture.name);
+    writeBytes(texture.filename);
+    writeBytes(texture.content);
+    bool isIdentity = texture.transform.isIdentity();
+    writeBool(isIdentity);
+    if (!isIdentity) {
+        write(texture.transform.getTranslation());
+        write(texture.transform.getRotation());
+        write(texture.transform.getScale());
+    }
+    write(texture.maxNumPixels);
+    write(texture.texcoordSet);
+    writeString(texture.texcoordSetName);
+    writeBool(texture.isBumpmap);
+}
+
+void Reader::readTexture(FBXTexture& texture) {
+    texture.id = readString();
+    texture.name = readString();
+    texture.filename = readBytes();
+    texture.content = readBytes();
+    if (!readBool()) {
+        texture.transform.setTranslation(read<glm::vec3>());
+        texture.transform.setRotation(read<glm::quat>());
+        texture.transform.setScale(read<glm::vec3>());
+    }
+    texture.maxNumPixels = read<int>();
+    texture.texcoordSet = read<int>();
+    texture.texcoordSetName = readString();
+    texture.isBumpmap = readBool();
+}
+
+void Writer::writeMaterial(const FBXMaterial& material) {
+    write(material.diffuseColor);
+    write(material.diffuseFactor);
+    write(material.specularColor);
+    write(material.specularFactor);
+    write(material.emissiveColor);
+    write(material.emissiveFactor);
+    write(material.shininess);
+    write(material.opacity);
+    write(material.metallic);
+    write(material.roughness);
+    write(material.emissiveIntensity);
+    write(material.ambientFactor);
+    writeString(material.materialID);
+    writeString(material.name);
+    writeString(material.shadingModel);
+
+    bool hasMaterial = (bool)material._material;
+    writeBool(hasMaterial);
+    if (hasMaterial) {
+        // the readers only ever set these values on the model::Material (textures come from the FBXTextures)
+        const model::Material& modelMaterial = *material._material;
+        write(modelMaterial.getEmissive(false));
+        write(modelMaterial.getAlbedo(false));
+        write(modelMaterial.getFresnel(false));
+        write(modelMaterial.getRoughness());
+        write(modelMaterial.getMetallic());
+        write(modelMaterial.getScattering());
+        write(modelMaterial.getOpacity());
+        writeBool(modelMaterial.isUnlit());
+    }
+
+    writeTexture(material.normalTexture);
+    writeTexture(material.albedoTexture);
+    writeTexture(material.opacityTexture);
+    writeTexture(material.glossTexture);
+    writeTexture(material.roughnessTexture);
+    writeTexture(material.specularTexture);
+    writeTexture(material.metallicTexture);
+    writeTexture(material.emissiveTexture);
+    writeTexture(material.occlusionTexture);
+    writeTexture(material.scatteringTexture);
+    writeTexture(material.lightmapTexture);
+    write(material.lightmapParams);
+
+    writeBool(material.isPBSMaterial);
+    writeBool(material.useNormalMap);
+    writeBool(material.useAlbedoMap);
+    writeBool(material.useOpacityMap);
+    writeBool(material.useRoughnessMap);
+    writeBool(material.useSpecularMap);
+    writeBool(material.useMetallicMap);
+    writeBool(material.useEmissiveMap);
+    writeBool(material.useOcclusionMap);
+}
+
+void Reader::readMaterial(FBXMaterial& material) {
+    material.diffuseColor = read<glm::vec3>();
+    material.diffuseFactor = read<float>();
+    material.specularColor = read<glm::vec3>();
+    material.specularFactor = read<float>();
+    material.emissiveColor = read<glm::vec3>();
+    material.emissiveFactor = read<float>();
+    material.shininess = read<float>();
+    material.opacity = read<float>();
+    material.metallic = read<float>();
+    material.roughness = read<float>();
+    material.emissiveIntensity = read<float>();
+    material.ambientFactor = read<float>();
+    material.materialID = readString();
+    material.name = readString();
+    material.shadingModel = readString();
+
+    if (readBool()) {
+        material._material = std::make_shared<model::Material>();
+        glm::vec3 emissive = read<glm::vec3>();
+        glm::vec3 albedo = read<glm::vec3>();
+        glm::vec3 fresnel = read<glm::vec3>();
+        float roughness = read<float>();
+        float metallic = read<float>();
+        float scattering = read<float>();
+        float opacity = read<float>();
+        bool isUnlit = readBool();
+
+        // same order as the readers, so that the material key comes out the same
+        material._material->setEmissive(emissive, false);
+        material._material->setAlbedo(albedo, false);
+        material._material->setFresnel(fresnel, false);
+        material._material->setRoughness(roughness);
+        material._material->setMetallic(metallic);
+        if (scattering > 0.0f) {
+            material._material->setScattering(scattering);
+        }
+        material._material->setUnlit(isUnlit);
+        material._material->setOpacity(opacity);
+    }
+
+    readTexture(material.normalTexture);
+    readTexture(material.albedoTexture);
+    readTexture(material.opacityTexture);
+    readTexture(material.glossTexture);
+    readTexture(material.roughnessTexture);
+    readTexture(material.specularTexture);
+    readTexture(material.metallicTexture);
+    readTexture(material.emissiveTexture);
+    readTexture(material.occlusionTexture);
+    readTexture(material.scatteringTexture);
+    readTexture(material.lightmapTexture);
+    material.lightmapParams = read<glm::vec2>();
+
+    material.isPBSMaterial = readBool();
+    material.useNormalMap = readBool();
+    material.useAlbedoMap = readBool();
+    material.useOpacityMap = readBool();
+    material.useRoughnessMap = readBool();
+    material.useSpecularMap = readBool();
+    material.useMetallicMap = readBool();
+    material.useEmissiveMap = readBool();
+    material.useOcclusionMap = readBool();
+}
+
+void Writer::writeJoint(const FBXJoint& joint) {
+    write(joint.shapeInfo.avgPoint);
+    writeVector(joint.shapeInfo.dots);
+    writeVector(joint.shapeInfo.points);
+    writeVector(joint.shapeInfo.debugLines);
+    writeVector(joint.freeLineage);
+    writeBool(joint.isFree);
+    write(joint.parentIndex);
+    write(joint.distanceToParent);
+    write(joint.translation);
+    write(joint.preTransform);
+    write(joint.preRotation);
+    write(joint.rotation);
+    write(joint.postRotation);
+    write(joint.postTransform);
+    write(joint.transform);
+    write(joint.rotationMin);
+    write(joint.rotationMax);
+    write(joint.inverseDefaultRotation);
+    write(joint.inverseBindRotation);
+    write(joint.bindTransform);
+    writeString(joint.name);
+    writeBool(joint.isSkeletonJoint);
+    writeBool(joint.bindTransformFoundInCluster);
+    writeBool(joint.hasGeometricOffset);
+    write(joint.geometricTranslation);
+    write(joint.geometricRotation);
+    write(joint.geometricScaling);
+}
+
+void Reader::readJoint(FBXJoint& joint) {
+    joint.shapeInfo.avgPoint = read<glm::vec3>();
+    readVector(joint.shapeInfo.dots);
+    readVector(joint.shapeInfo.points);
+    readVector(joint.shapeInfo.debugLines);
+    readVector(joint.freeLineage);
+    joint.isFree = readBool();
+    joint.parentIndex = read<int>();
+    joint.distanceToParent = read<float>();
+    joint.translation = read<glm::vec3>();
+    joint.preTransform = read<glm::mat4>();
+    joint.preRotation = read<glm::quat>();
+    joint.rotation = read<glm::quat>();
+    joint.postRotation = read<glm::quat>();
+    joint.postTransform = read<glm::mat4>();
+    joint.transform = read<glm::mat4>();
+    joint.rotationMin = read<glm::vec3>();
+    joint.rotationMax = read<glm::vec3>();
+    joint.inverseDefaultRotation = read<glm::quat>();
+    joint.inverseBindRotation = read<glm::quat>();
+    joint.bindTransform = read<glm::mat4>();
+    joint.name = readString();
+    joint.isSkeletonJoint = readBool();
+    joint.bindTransformFoundInCluster = readBool();
+    joint.hasGeometricOffset = readBool();
+    joint.geometricTranslation = read<glm::vec3>();
+    joint.geometricRotation = read<glm::quat>();
+    joint.geometricScaling = read<glm::vec3>();
+}
+
+void Writer::writeMesh(const FBXMesh& mesh) {
+    write<quint32>(mesh.parts.size());
+    for (const FBXMeshPart& part : mesh.parts) {
+        writeVector(part.quadIndices);
+        writeVector(part.quadTrianglesIndices);
+        writeVector(part.triangleIndices);
+        writeString(part.materialID);
+    }
+    writeVector(mesh.vertices);
+    writeVector(mesh.normals);
+    writeVector(mesh.tangents);
+    writeVector(mesh.colors);
+    writeVector(mesh.texCoords);
+    writeVector(mesh.texCoords1);
+    writeVector(mesh.clusterIndices);
+    writeVector(mesh.clusterWeights);
+    writeVector(mesh.originalIndices);
+    write<quint32>(mesh.clusters.size());
+    for (const FBXCluster& cluster : mesh.clusters) {
+        write(cluster.jointIndex);
+        write(cluster.inverseBindMatrix);
+    }
+    writeExtents(mesh.meshExtents);
+    write(mesh.modelTransform);
+    write<quint32>(mesh.blendshapes.size());
+    for (const FBXBlendshape& blendshape : mesh.blendshapes) {
+        writeVector(blendshape.indices);
+        writeVector(blendshape.vertices);
+        writeVector(blendshape.normals);
+    }
+    write(mesh.meshIndex);
+    writeBool(mesh.wasCompressed);
+}
+
+void Reader::readMesh(FBXMesh& mesh, const QString& url) {
+    mesh.parts.resize(readCount(MIN_MESH_PART_SIZE));
+    for (FBXMeshPart& part : mesh.parts) {
+        readVector(part.quadIndices);
+        readVector(part.quadTrianglesIndices);
+        readVector(part.triangleIndices);
+        part.materialID = readString();
+    }
+    readVector(mesh.vertices);
+    readVector(mesh.normals);
+    readVector(mesh.tangents);
+    readVector(mesh.colors);
+    readVector(mesh.texCoords);
+    readVector(mesh.texCoords1);
+    readVector(mesh.clusterIndices);
+    readVector(mesh.clusterWeights);
+    readVector(mesh.originalIndices);
+    mesh.clusters.resize(readCount(CLUSTER_SIZE));
+    for (FBXCluster& cluster : mesh.clusters) {
+        cluster.jointIndex = read<int>();
+        cluster.inverseBindMatrix = read<glm::mat4>();
+    }
+    mesh.meshExtents = readExtents();
+    mesh.modelTransform = read<glm::mat4>();
+    mesh.blendshapes.resize(readCount(MIN_BLENDSHAPE_SIZE));
+    for (FBXBlendshape& blendshape : mesh.blendshapes) {
+        readVector(blendshape.indices);
+        readVector(blendshape.vertices);
+        readVector(blendshape.normals);
+    }
+    mesh.meshIndex = read<unsigned int>();
+    mesh.wasCompressed = readBool();
+
+    FBXReader::buildModelMesh(mesh, url);
+}
+
+void Writer::writeGeometry(const FBXGeometry& geometry) {
+    writeString(geometry.originalURL);
+    writeString(geometry.author);
+    writeString(geometry.applicationName);
+
+    write<quint32>(geometry.joints.size());
+    for (const FBXJoint& joint : geometry.joints) {
+        writeJoint(joint);
+    }
+    write<quint32>(geometry.jointIndices.size());
+    for (auto it = geometry.jointIndices.constBegin(); it != geometry.jointIndices.constEnd(); ++it) {
+        writeString(it.key());
+        write(it.value());
+    }
+    writeBool(geometry.hasSkeletonJoints);
+
+    write<quint32>(geometry.meshes.size());
+    for (const FBXMesh& mesh : geometry.meshes) {
+        writeMesh(mesh);
+    }
+    write<quint32>(geometry.materials.size());
+    for (auto it = geometry.materials.constBegin(); it != geometry.materials.constEnd(); ++it) {
+        writeString(it.key());
+        writeMaterial(it.value());
+    }
+
+    write(geometry.offset);
+    write(geometry.leftEyeJointIndex);
+    write(geometry.rightEyeJointIndex);
+    write(geometry.neckJointIndex);
+    write(geometry.rootJointIndex);
+    write(geometry.leanJointIndex);
+    write(geometry.headJointIndex);
+    write(geometry.leftHandJointIndex);
+    write(geometry.rightHandJointIndex);
+    write(geometry.leftToeJointIndex);
+    write(geometry.rightToeJointIndex);
+    write(geometry.leftEyeSize);
+    write(geometry.rightEyeSize);
+    writeVector(geometry.humanIKJointIndices);
+    write(geometry.palmDirection);
+    write(geometry.neckPivot);
+    writeExtents(geometry.bindExtents);
+    writeExtents(geometry.meshExtents);
+
+    write<quint32>(geometry.animationFrames.size());
+    for (const FBXAnimationFrame& frame : geometry.animationFrames) {
+        writeVector(frame.rotations);
+        writeVector(frame.translations);
+    }
+    write<quint32>(geometry.meshIndicesToModelNames.size());
+    for (auto it = geometry.meshIndicesToModelNames.constBegin(); it != geometry.meshIndicesToModelNames.constEnd(); ++it) {
+        write(it.key());
+        writeString(it.value());
+    }
+    write<quint32>(geometry.blendshapeChannelNames.size());
+    for (const QString& name : geometry.blendshapeChannelNames) {
+        writeString(name);
+    }
+}
+
+void Reader::readGeometry(FBXGeometry& geometry, const QString& url) {
+    geometry.originalURL = readString();
+    geometry.author = readString();
+    geometry.applicationName = readString();
+
+    geometry.joints.resize(readCount(MIN_JOINT_SIZE));
+    for (FBXJoint& joint : geometry.joints) {
+        readJoint(joint);
+    }
+    for (quint32 i = 0, count = readCount(MIN_JOINT_INDEX_SIZE); i < count; ++i) {
+        QString name = readString();
+        geometry.jointIndices.insert(name, read<int>());
+    }
+    geometry.hasSkeletonJoints = readBool();
+
+    geometry.meshes.resize(readCount(MIN_MESH_SIZE));
+    for (FBXMesh& mesh : geometry.meshes) {
+        readMesh(mesh, url);
+    }
+    for (quint32 i = 0, count = readCount(MIN_STRING_SIZE + MIN_MATERIAL_SIZE); i < count; ++i) {
+        QString key = readString();
+        readMaterial(geometry.materials[key]);
+    }
+
+    geometry.offset = read<glm::mat4>();
+    geometry.leftEyeJointIndex = read<int>();
+    geometry.rightEyeJointIndex = read<int>();
+    geometry.neckJointIndex = read<int>();
+    geometry.rootJointIndex = read<int>();
+    geometry.leanJointIndex = read<int>();
+    geometry.headJointIndex = read<int>();
+    geometry.leftHandJointIndex = read<int>();
+    geometry.rightHandJointIndex = read<int>();
+    geometry.leftToeJointIndex = read<int>();
+    geometry.rightToeJointIndex = read<int>();
+    geometry.leftEyeSize = read<float>();
+    geometry.rightEyeSize = read<float>();
+    readVector(geometry.humanIKJointIndices);
+    geometry.palmDirection = read<glm::vec3>();
+    geometry.neckPivot = read<glm::vec3>();
+    geometry.bindExtents = readExtents();
+    geometry.meshExtents = readExtents();
+
+    geometry.animationFrames.resize(readCount(MIN_ANIMATION_FRAME_SIZE));
+    for (FBXAnimationFrame& frame : geometry.animationFrames) {
+        readVector(frame.rotations);
+        readVector(frame.translations);
+    }
+    for (quint32 i = 0, count = readCount(MIN_MESH_NAME_SIZE); i < count; ++i) {
+        int meshIndex = read<int>();
+        geometry.meshIndicesToModelNames.insert(meshIndex, readString());
+    }
+    for (quint32 i = 0, count = readCount(MIN_STRING_SIZE); i < count; ++i) {
+        geometry.blendshapeChannelNames.append(readString());
+    }
+}
+
+}
+
+QByteArray FBXGeometrySerializer::serialize(const FBXGeometry& geometry) {
+    Writer writer;
+    writer.write(GEOMETRY_MAGIC);
+    writer.write(CURRENT_VERSION);
+    writer.writeGeometry(geometry);
+    return writer.data;
+}
+
+FBXGeometry* FBXGeometrySerializer::deserialize(const char* data, size_t size, const QString& url) {
+    if (!data) {
+        throw QString("no geometry cache data");
+    }
+    Reader reader(data, size);
+    if (reader.read<quint32>() != GEOMETRY_MAGIC || reader.read<quint32>() != CURRENT_VERSION) {
+        throw QString("unknown geometry cache format");
+    }
+    std::unique_ptr<FBXGeometry> geometry(new FBXGeometry());
+    reader.readGeometry(*geometry, url);
+    if (!reader.atEnd()) {
+        throw QString("corrupt geometry cache entry");
+    }
+    return geometry.release();
+}
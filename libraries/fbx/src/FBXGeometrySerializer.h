@@ -0,0 +1,35 @@
+//
+//  FBXGeometrySerializer.h
+//  libraries/fbx/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXGeometrySerializer_h
+#define hifi_FBXGeometrySerializer_h
+
+#include "FBX.h"
+
+// Flat binary encoding of a fully extracted FBXGeometry, so that a model which has already been parsed
+// can be restored without running the FBX/OBJ readers again.
+//
+// The layout is length-prefixed and in native byte order (the encoding is a local cache and never leaves the
+// machine); the bulk arrays (vertices, indices, weights...) are stored exactly as they sit in memory, so
+// decoding them is a single copy out of a (usually mapped) file.
+// The gpu side of each mesh is rebuilt from those arrays with FBXReader::buildModelMesh().
+class FBXGeometrySerializer {
+public:
+    // Whenever a change is made to the encoding, or to what the readers extract, this value should be incremented
+    static const quint32 CURRENT_VERSION;
+
+    static QByteArray serialize(const FBXGeometry& geometry);
+
+    /// \return the decoded geometry, or throws a QString if the data is not a valid encoding of the current version
+    static FBXGeometry* deserialize(const char* data, size_t size, const QString& url);
+};
+
+#endif // hifi_FBXGeometrySerializer_h
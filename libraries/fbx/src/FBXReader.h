@@ -107,6 +107,7 @@ public:
 
     FBXNode _rootNode;
     static FBXNode parseFBX(QIODevice* device);
+    static FBXNode parseBinaryFBX(const char* data, size_t size);
 
     FBXGeometry* extractFBXGeometry(const QVariantHash& mapping, const QString& url);
 
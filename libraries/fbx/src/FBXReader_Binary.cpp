@@ -0,0 +1,321 @@
+//
+//  FBXReader_Binary.cpp
+//  libraries/fbx/src
+//
+//  Created by Sam Gateau on 8/27/2015.
+//  Split from FBXReader_Node.cpp by agent on 10/18/2026
+//  Copyright 2015-2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QThread>
+#include <QtCore/QtEndian>
+
+#include <zlib.h>
+
+#include "ModelFormatLogging.h"
+
+// see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
+// of the FBX binary format
+//
+// The whole file is in memory (usually mapped), so the nodes are decoded straight from it: arrays are copied
+// or inflated directly into the QVector that the node property holds, with no intermediate buffers.
+// Compressed arrays are the bulk of the work in large models, so they are inflated after the node tree is
+// built, in parallel when there is enough compressed data to be worth it.
+
+namespace {
+
+// below this much compressed data it is faster to inflate everything on the calling thread
+const size_t MIN_PARALLEL_INFLATE_BYTES = 1024 * 1024;
+const int MAX_INFLATE_THREADS = 4;
+
+class InflateJob {
+public:
+    const char* source;
+    size_t sourceSize;
+    char* destination;
+    size_t destinationSize;
+    size_t elementSize;
+
+    bool run() const {
+        uLongf inflatedSize = (uLongf)destinationSize;
+        int result = uncompress(reinterpret_cast<Bytef*>(destination), &inflatedSize,
+            reinterpret_cast<const Bytef*>(source), (uLong)sourceSize);
+        if (result != Z_OK || inflatedSize != destinationSize) {
+            return false;
+        }
+        if (QSysInfo::ByteOrder != QSysInfo::LittleEndian) {
+            swapElements(destination, destinationSize, elementSize);
+        }
+        return true;
+    }
+
+    static void swapElements(char* data, size_t size, size_t elementSize) {
+        if (elementSize < 2) {
+            return;
+        }
+        for (char* element = data, *end = data + size; element < end; element += elementSize) {
+            std::reverse(element, element + elementSize);
+        }
+    }
+};
+
+class BinaryFBXParser {
+public:
+    BinaryFBXParser(const char* data, size_t size) : _begin(data), _end(data + size), _cursor(data) { }
+
+    FBXNode parse();
+
+private:
+    void require(size_t numBytes) const {
+        if ((size_t)(_end - _cursor) < numBytes) {
+            throw QString("corrupt fbx file");
+        }
+    }
+
+    template<class T>
+    T read() {
+        require(sizeof(T));
+        T value = qFromLittleEndian<T>(reinterpret_cast<const uchar*>(_cursor));
+        _cursor += sizeof(T);
+        return value;
+    }
+
+    quint64 position() const { return (quint64)(_cursor - _begin); }
+
+    FBXNode parseNode();
+    QVariant parseProperty();
+
+    template<class T>
+    QVariant parseArray();
+
+    void inflateArrays();
+
+    const char* const _begin;
+    const char* const _end;
+    const char* _cursor;
+    bool _has64BitPositions { false };
+
+    std::vector<InflateJob> _inflateJobs;
+    size_t _numCompressedBytes { 0 };
+};
+
+template<>
+float BinaryFBXParser::read<float>() {
+    quint32 bits = read<quint32>();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<>
+double BinaryFBXParser::read<double>() {
+    quint64 bits = read<quint64>();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+template<>
+bool BinaryFBXParser::read<bool>() {
+    return read<quint8>() != 0;
+}
+
+template<class T>
+QVariant BinaryFBXParser::parseArray() {
+    quint32 arrayLength = read<quint32>();
+    quint32 encoding = read<quint32>();
+    quint32 compressedLength = read<quint32>();
+
+    static_assert(sizeof(bool) == 1, "FBX stores booleans as bytes");
+    size_t numBytes = (size_t)arrayLength * sizeof(T);
+    QVector<T> values(arrayLength);
+    char* destination = reinterpret_cast<char*>(values.data());
+
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        require(compressedLength);
+        if (numBytes > 0) {
+            // the vector storage is shared with the QVariant that is returned, and nothing reads it
+            // until parse() has run the inflate jobs
+            _inflateJobs.push_back({ _cursor, compressedLength, destination, numBytes, sizeof(T) });
+            _numCompressedBytes += compressedLength;
+        }
+        _cursor += compressedLength;
+    } else {
+        require(numBytes);
+        if (numBytes > 0) {
+            memcpy(destination, _cursor, numBytes);
+            if (QSysInfo::ByteOrder != QSysInfo::LittleEndian) {
+                InflateJob::swapElements(destination, numBytes, sizeof(T));
+            }
+        }
+        _cursor += numBytes;
+    }
+    return QVariant::fromValue(values);
+}
+
+QVariant BinaryFBXParser::parseProperty() {
+    char ch = (char)read<quint8>();
+    switch (ch) {
+        case 'Y':
+            return QVariant::fromValue(read<qint16>());
+        case 'C':
+            return QVariant::fromValue(read<bool>());
+        case 'I':
+            return QVariant::fromValue(read<qint32>());
+        case 'F':
+            return QVariant::fromValue(read<float>());
+        case 'D':
+            return QVariant::fromValue(read<double>());
+        case 'L':
+            return QVariant::fromValue(read<qint64>());
+        case 'f':
+            return parseArray<float>();
+        case 'd':
+            return parseArray<double>();
+        case 'l':
+            return parseArray<qint64>();
+        case 'i':
+            return parseArray<qint32>();
+        case 'b':
+            return parseArray<bool>();
+        case 'S':
+        case 'R': {
+            quint32 length = read<quint32>();
+            require(length);
+            QByteArray value(_cursor, length);
+            _cursor += length;
+            return QVariant::fromValue(value);
+        }
+        default:
+            throw QString("Unknown property type: ") + ch;
+    }
+}
+
+FBXNode BinaryFBXParser::parseNode() {
+    quint64 endOffset;
+    quint64 propertyCount;
+
+    // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
+    if (_has64BitPositions) {
+        endOffset = read<quint64>();
+        propertyCount = read<quint64>();
+        read<quint64>(); // property list length
+    } else {
+        endOffset = read<quint32>();
+        propertyCount = read<quint32>();
+        read<quint32>(); // property list length
+    }
+    quint8 nameLength = read<quint8>();
+
+    FBXNode node;
+    const quint64 MIN_VALID_OFFSET = 40;
+    if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
+        // use a null name to indicate a null node
+        return node;
+    }
+    if (endOffset > (quint64)(_end - _begin)) {
+        throw QString("corrupt fbx file");
+    }
+    require(nameLength);
+    node.name = QByteArray(_cursor, nameLength);
+    _cursor += nameLength;
+
+    node.properties.reserve((int)std::min<quint64>(propertyCount, (quint64)(_end - _cursor)));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseProperty());
+    }
+
+    while (endOffset > position()) {
+        FBXNode child = parseNode();
+        if (child.name.isNull()) {
+            return node;
+        } else {
+            node.children.append(child);
+        }
+    }
+    return node;
+}
+
+void BinaryFBXParser::inflateArrays() {
+    if (_inflateJobs.empty()) {
+        return;
+    }
+
+    // hand out the biggest arrays first so that no thread is left with a large one at the end
+    std::sort(_inflateJobs.begin(), _inflateJobs.end(), [](const InflateJob& a, const InflateJob& b) {
+        return a.sourceSize > b.sourceSize;
+    });
+
+    std::atomic<size_t> nextJob { 0 };
+    std::atomic<bool> failed { false };
+    auto work = [&] {
+        size_t jobIndex;
+        while ((jobIndex = nextJob++) < _inflateJobs.size()) {
+            if (!_inflateJobs[jobIndex].run()) {
+                failed = true;
+            }
+        }
+    };
+
+    int numThreads = 0;
+    if (_numCompressedBytes >= MIN_PARALLEL_INFLATE_BYTES) {
+        // the calling thread works too
+        numThreads = std::min(QThread::idealThreadCount(), MAX_INFLATE_THREADS) - 1;
+        numThreads = std::min(numThreads, (int)_inflateJobs.size() - 1);
+    }
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failed) {
+        throw QString("corrupt fbx file");
+    }
+}
+
+FBXNode BinaryFBXParser::parse() {
+    // The first 27 bytes contain the header.
+    //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
+    //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
+    //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
+    require(FBX_HEADER_BYTES_BEFORE_VERSION);
+    _cursor += FBX_HEADER_BYTES_BEFORE_VERSION;
+    quint32 fileVersion = read<quint32>();
+    qCDebug(modelformat) << "fileVersion:" << fileVersion;
+    _has64BitPositions = (fileVersion >= FBX_VERSION_2016);
+
+    // parse the top-level node
+    FBXNode top;
+    while (_cursor < _end) {
+        FBXNode next = parseNode();
+        if (next.name.isNull()) {
+            break;
+        } else {
+            top.children.append(next);
+        }
+    }
+
+    inflateArrays();
+    return top;
+}
+
+}
+
+FBXNode FBXReader::parseBinaryFBX(const char* data, size_t size) {
+    BinaryFBXParser parser(data, size);
+    return parser.parse();
+}
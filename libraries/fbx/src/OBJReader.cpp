@@ -490,7 +490,48 @@ done:
 }
 
 
-FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping, bool combineParts, const QUrl& url) {
+OBJReader::MaterialLibraries OBJReader::fetchMaterialLibraries(const QByteArray& model, const QUrl& url) {
+    MaterialLibraries libraries;
+    if (url.isEmpty()) {
+        return libraries;
+    }
+    static const QByteArray MTLLIB { "mtllib" };
+    for (int index = model.indexOf(MTLLIB); index != -1; index = model.indexOf(MTLLIB, index + MTLLIB.size())) {
+        // only a statement at the start of a line, not a name that happens to contain the word
+        int lineStart = index;
+        while (lineStart > 0 && (model[lineStart - 1] == ' ' || model[lineStart - 1] == '\t')) {
+            --lineStart;
+        }
+        int nameStart = index + MTLLIB.size();
+        if ((lineStart > 0 && model[lineStart - 1] != '\n' && model[lineStart - 1] != '\r') ||
+            nameStart >= model.size() || !QChar(model[nameStart]).isSpace()) {
+            continue;
+        }
+        int lineEnd = model.indexOf('\n', nameStart);
+        QByteArray line = model.mid(nameStart, lineEnd == -1 ? -1 : lineEnd - nameStart);
+
+        // same tokenization as parseOBJGroup
+        QBuffer buffer { &line };
+        buffer.open(QIODevice::ReadOnly);
+        OBJTokenizer tokenizer { &buffer };
+        if (tokenizer.nextToken() != OBJTokenizer::DATUM_TOKEN) {
+            continue;
+        }
+        QByteArray libraryName = tokenizer.getDatum();
+        if (libraries.contains(libraryName)) {
+            continue;
+        }
+        QUrl libraryUrl = url.resolved(QUrl(libraryName).fileName());
+        bool success;
+        QByteArray data;
+        std::tie<bool, QByteArray>(success, data) = requestData(libraryUrl);
+        libraries[libraryName] = success ? data : QByteArray();
+    }
+    return libraries;
+}
+
+FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping, bool combineParts, const QUrl& url,
+                                const MaterialLibraries* materialLibraries) {
     PROFILE_RANGE_EX(resource_parse, __FUNCTION__, 0xffff0000, nullptr);
     QBuffer buffer { &model };
     buffer.open(QIODevice::ReadOnly);
@@ -707,7 +748,12 @@ FBXGeometry* OBJReader::readOBJ(QByteArray& model, const QVariantHash& mapping,
             qCDebug(modelformat) << "OBJ Reader material library" << libraryName << "used in" << _url;
             bool success;
             QByteArray data;
-            std::tie<bool, QByteArray>(success, data) = requestData(libraryUrl);
+            if (materialLibraries && materialLibraries->contains(libraryName.toUtf8())) {
+                data = materialLibraries->value(libraryName.toUtf8());
+                success = !data.isNull();
+            } else {
+                std::tie<bool, QByteArray>(success, data) = requestData(libraryUrl);
+            }
             if (success) {
                 QBuffer buffer { &data };
                 buffer.open(QIODevice::ReadOnly);
@@ -75,7 +75,16 @@ public:
     QString currentMaterialName;
     QHash<QString, OBJMaterial> materials;
 
-    FBXGeometry* readOBJ(QByteArray& model, const QVariantHash& mapping, bool combineParts, const QUrl& url = QUrl());
+    // Material libraries of a model, by the name that its mtllib statements use. A library that could not be
+    // fetched maps to a null QByteArray.
+    typedef QHash<QByteArray, QByteArray> MaterialLibraries;
+
+    // Fetches every material library that model names, resolved against url, so that a caller can take their
+    // content into account (e.g. in a cache key) and then pass them to readOBJ instead of having them fetched again.
+    static MaterialLibraries fetchMaterialLibraries(const QByteArray& model, const QUrl& url);
+
+    FBXGeometry* readOBJ(QByteArray& model, const QVariantHash& mapping, bool combineParts, const QUrl& url = QUrl(),
+                         const MaterialLibraries* materialLibraries = nullptr);
 
 private:
     QUrl _url;
@@ -30,6 +30,12 @@ ProfileRangeBatch::~ProfileRangeBatch() {
 
 using namespace gpu;
 
+// batches released beyond this many are freed instead of pooled
+static const size_t MAX_POOLED_BATCHES = 256;
+
+static std::mutex batchPoolMutex;
+static std::vector<Batch*> batchPool;
+
 size_t Batch::_commandsMax { BATCH_PREALLOCATE_MIN };
 size_t Batch::_commandOffsetsMax { BATCH_PREALLOCATE_MIN };
 size_t Batch::_paramsMax { BATCH_PREALLOCATE_MIN };
@@ -73,6 +79,60 @@ Batch::Batch(const Batch& batch_) {
     _enableSkybox = batch._enableSkybox;
 }
 
+void Batch::swap(Batch& batch) {
+    _commands.swap(batch._commands);
+    _commandOffsets.swap(batch._commandOffsets);
+    _params.swap(batch._params);
+    _data.swap(batch._data);
+    std::swap(_invalidModel, batch._invalidModel);
+    std::swap(_currentModel, batch._currentModel);
+    _objects.swap(batch._objects);
+    _currentNamedCall.swap(batch._currentNamedCall);
+
+    _buffers._items.swap(batch._buffers._items);
+    _textures._items.swap(batch._textures._items);
+    _streamFormats._items.swap(batch._streamFormats._items);
+    _transforms._items.swap(batch._transforms._items);
+    _pipelines._items.swap(batch._pipelines._items);
+    _framebuffers._items.swap(batch._framebuffers._items);
+    _drawCallInfos.swap(batch._drawCallInfos);
+    _queries._items.swap(batch._queries._items);
+    _lambdas._items.swap(batch._lambdas._items);
+    _profileRanges._items.swap(batch._profileRanges._items);
+    _names._items.swap(batch._names._items);
+    _namedData.swap(batch._namedData);
+    std::swap(_enableStereo, batch._enableStereo);
+    std::swap(_enableSkybox, batch._enableSkybox);
+}
+
+BatchPointer Batch::acquire() {
+    Batch* batch = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(batchPoolMutex);
+        if (!batchPool.empty()) {
+            batch = batchPool.back();
+            batchPool.pop_back();
+        }
+    }
+    if (!batch) {
+        batch = new Batch();
+    }
+    return BatchPointer(batch);
+}
+
+void BatchDeleter::operator()(Batch* batch) const {
+    // clear outside of the lock, it releases the resources the batch referenced
+    batch->clear();
+    {
+        std::lock_guard<std::mutex> lock(batchPoolMutex);
+        if (batchPool.size() < MAX_POOLED_BATCHES) {
+            batchPool.push_back(batch);
+            return;
+        }
+    }
+    delete batch;
+}
+
 Batch::~Batch() {
     _commandsMax = std::max(_commands.size(), _commandsMax);
     _commandOffsetsMax = std::max(_commandOffsets.size(), _commandOffsetsMax);
@@ -100,8 +160,156 @@ void Batch::clear() {
     _transforms.clear();
     _pipelines.clear();
     _framebuffers.clear();
+    _queries.clear();
+    _lambdas.clear();
+    _profileRanges.clear();
+    _names.clear();
     _objects.clear();
     _drawCallInfos.clear();
+    _namedData.clear();
+    _currentNamedCall.clear();
+    _invalidModel = true;
+    _currentModel = Transform();
+    _enableStereo = true;
+    _enableSkybox = false;
+}
+
+void Batch::append(Batch&& batch) {
+    Q_ASSERT(_currentNamedCall.empty() && batch._currentNamedCall.empty());
+
+    // the offsets into the caches and data recorded in the params of the appended commands are rebased
+    // onto the end of ours
+    const uint32 paramsBase = (uint32)_params.size();
+    const uint32 dataBase = (uint32)_data.size();
+    const uint32 objectsBase = (uint32)_objects.size();
+    const uint32 buffersBase = (uint32)_buffers.append(batch._buffers);
+    const uint32 texturesBase = (uint32)_textures.append(batch._textures);
+    const uint32 streamFormatsBase = (uint32)_streamFormats.append(batch._streamFormats);
+    const uint32 transformsBase = (uint32)_transforms.append(batch._transforms);
+    const uint32 pipelinesBase = (uint32)_pipelines.append(batch._pipelines);
+    const uint32 framebuffersBase = (uint32)_framebuffers.append(batch._framebuffers);
+    const uint32 queriesBase = (uint32)_queries.append(batch._queries);
+    const uint32 lambdasBase = (uint32)_lambdas.append(batch._lambdas);
+    const uint32 profileRangesBase = (uint32)_profileRanges.append(batch._profileRanges);
+    const uint32 namesBase = (uint32)_names.append(batch._names);
+
+    const size_t numCommands = batch._commands.size();
+    for (size_t i = 0; i < numCommands; ++i) {
+        Param* params = batch._params.data() + batch._commandOffsets[i];
+        switch (batch._commands[i]) {
+            case COMMAND_setInputFormat:
+                params[0]._uint += streamFormatsBase;
+                break;
+
+            case COMMAND_setInputBuffer:
+            case COMMAND_setUniformBuffer:
+                params[2]._uint += buffersBase;
+                break;
+            case COMMAND_setIndexBuffer:
+                params[1]._uint += buffersBase;
+                break;
+            case COMMAND_setIndirectBuffer:
+            case COMMAND_setResourceBuffer:
+                params[0]._uint += buffersBase;
+                break;
+
+            case COMMAND_setViewTransform:
+                params[0]._uint += transformsBase;
+                break;
+
+            case COMMAND_setProjectionTransform:
+            case COMMAND_setViewportTransform:
+            case COMMAND_setStateScissorRect:
+            case COMMAND_glUniform3fv:
+            case COMMAND_glUniform4fv:
+            case COMMAND_glUniform4iv:
+            case COMMAND_glUniformMatrix3fv:
+            case COMMAND_glUniformMatrix4fv:
+                params[0]._uint += dataBase;
+                break;
+
+            case COMMAND_setPipeline:
+                params[0]._uint += pipelinesBase;
+                break;
+
+            case COMMAND_setResourceTexture:
+            case COMMAND_generateTextureMips:
+                params[0]._uint += texturesBase;
+                break;
+
+            case COMMAND_setFramebuffer:
+                params[0]._uint += framebuffersBase;
+                break;
+            case COMMAND_blit:
+                params[0]._uint += framebuffersBase;
+                params[5]._uint += framebuffersBase;
+                break;
+
+            case COMMAND_beginQuery:
+            case COMMAND_endQuery:
+            case COMMAND_getQuery:
+                params[0]._uint += queriesBase;
+                break;
+
+            case COMMAND_runLambda:
+                params[0]._uint += lambdasBase;
+                break;
+
+            case COMMAND_startNamedCall:
+                params[0]._uint += namesBase;
+                break;
+
+            case COMMAND_pushProfileRange:
+                params[0]._uint += profileRangesBase;
+                break;
+
+            default:
+                break;
+        }
+        _commandOffsets.push_back(batch._commandOffsets[i] + paramsBase);
+    }
+    _commands.insert(_commands.end(), batch._commands.begin(), batch._commands.end());
+    _params.insert(_params.end(), batch._params.begin(), batch._params.end());
+    _data.insert(_data.end(), batch._data.begin(), batch._data.end());
+    _objects.insert(_objects.end(), batch._objects.begin(), batch._objects.end());
+
+    for (auto drawCallInfo : batch._drawCallInfos) {
+        _drawCallInfos.emplace_back((DrawCallInfo::Index)(drawCallInfo.index + objectsBase));
+    }
+
+    // the instances of the named calls are appended to ours, buffer by buffer
+    for (auto& mapItem : batch._namedData) {
+        auto& appended = mapItem.second;
+        auto& instance = _namedData[mapItem.first];
+        if (!instance.function) {
+            instance.function = appended.function;
+        }
+        for (auto drawCallInfo : appended.drawCallInfos) {
+            instance.drawCallInfos.emplace_back((DrawCallInfo::Index)(drawCallInfo.index + objectsBase));
+        }
+        if (instance.buffers.size() < appended.buffers.size()) {
+            instance.buffers.resize(appended.buffers.size());
+        }
+        for (size_t i = 0; i < appended.buffers.size(); ++i) {
+            const auto& appendedBuffer = appended.buffers[i];
+            if (!appendedBuffer) {
+                continue;
+            }
+            if (!instance.buffers[i]) {
+                instance.buffers[i] = appendedBuffer;
+            } else {
+                instance.buffers[i]->append(appendedBuffer->getSize(), appendedBuffer->getData());
+            }
+        }
+    }
+
+    // later draws in this batch use the model transform the appended batch ended with
+    if (!batch._commands.empty()) {
+        _currentModel = batch._currentModel;
+        _invalidModel = batch._invalidModel;
+    }
+
+    batch.clear();
 }
 
 size_t Batch::cacheData(size_t size, const void* data) {
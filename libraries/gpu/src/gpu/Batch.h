@@ -11,9 +11,12 @@
 #ifndef hifi_gpu_Batch_h
 #define hifi_gpu_Batch_h
 
+#include <algorithm>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <functional>
+#include <iterator>
 #include <glm/gtc/type_ptr.hpp>
 
 #include <shared/NsightHelpers.h>
@@ -40,6 +43,13 @@ enum ReservedSlot {
 // that will be called with the accumulated buffer data when the batch commands are finally 
 // executed against the backend
 
+class Batch;
+
+// Returns the batch to the pool it was acquired from
+struct BatchDeleter {
+    void operator()(Batch* batch) const;
+};
+using BatchPointer = std::unique_ptr<Batch, BatchDeleter>;
 
 class Batch {
 public:
@@ -95,8 +105,18 @@ public:
     explicit Batch(const Batch& batch);
     ~Batch();
 
+    // Pooled batches are reused from frame to frame, so that recording a frame does not reallocate their storage.
+    // Thread safe, a batch can be acquired on any thread and released on any other
+    static BatchPointer acquire();
+
     void clear();
 
+    // Append the commands recorded in another batch, as if they had been recorded at the end of this one.
+    // This is how sub-batches recorded on several threads are merged back, in a deterministic order.
+    // The appended batch is left cleared. Its first draw must follow a setModelTransform(), since the model
+    // transform of this batch does not carry over to it.
+    void append(Batch&& batch);
+
     // Batches may need to override the context level stereo settings
     // if they're performing framebuffer copy operations, like the 
     // deferred lighting resolution mechanism
@@ -408,6 +428,14 @@ public:
             void clear() {
                 _items.clear();
             }
+
+            // moves the items of another cache to the end of this one, returns the offset of the first of them
+            size_t append(Vector& vector) {
+                size_t offset = _items.size();
+                std::move(vector._items.begin(), vector._items.end(), std::back_inserter(_items));
+                vector._items.clear();
+                return offset;
+            }
         };
     };
 
@@ -485,6 +513,9 @@ protected:
     friend class Context;
     friend class Frame;
 
+    // Exchange the contents of two batches
+    void swap(Batch& batch);
+
     // Apply all the named calls to the end of the batch
     // and prepare updates for the render shadow copies of the buffers
     void finishFrame(BufferUpdates& updates);
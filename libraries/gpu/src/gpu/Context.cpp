@@ -69,7 +69,18 @@ void Context::appendFrameBatch(Batch& batch) {
         qWarning() << "Batch executed outside of frame boundaries";
         return;
     }
-    _currentFrame->batches.push_back(batch);
+    // the recorded commands move to a pooled batch, which the frame returns to the pool once it is rendered
+    auto frameBatch = Batch::acquire();
+    frameBatch->swap(batch);
+    _currentFrame->batches.push_back(std::move(frameBatch));
+}
+
+void Context::appendFrameBatch(BatchPointer batch) {
+    if (!_frameActive) {
+        qWarning() << "Batch executed outside of frame boundaries";
+        return;
+    }
+    _currentFrame->batches.push_back(std::move(batch));
 }
 
 FramePointer Context::endFrame() {
@@ -114,7 +125,7 @@ void Context::executeFrame(const FramePointer& frame) const {
 
         // Execute the frame rendering commands
         for (auto& batch : frame->batches) {
-            _backend->render(batch);
+            _backend->render(*batch);
         }
 
         Batch endBatch;
@@ -163,6 +163,7 @@ public:
 
     void beginFrame(const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(Batch& batch);
+    void appendFrameBatch(BatchPointer batch);
     FramePointer endFrame();
 
     // MUST only be called on the rendering thread
@@ -275,9 +276,9 @@ typedef std::shared_ptr<Context> ContextPointer;
 
 template<typename F>
 void doInBatch(std::shared_ptr<gpu::Context> context, F f) {
-    gpu::Batch batch;
-    f(batch);
-    context->appendFrameBatch(batch);
+    auto batch = gpu::Batch::acquire();
+    f(*batch);
+    context->appendFrameBatch(std::move(batch));
 }
 
 };
@@ -27,7 +27,7 @@ class Backend : public gpu::Backend {
     // Context Backend static interface required
     friend class gpu::Context;
     static void init() {}
-    static gpu::Backend* createBackend() { return new Backend(); }
+    static BackendPointer createBackend() { return BackendPointer(new Backend()); }
     static bool makeProgram(Shader& shader, const Shader::BindingSet& slotBindings) { return true; }
 
 protected:
@@ -36,6 +36,11 @@ protected:
 public:
     ~Backend() { }
 
+    const std::string& getVersion() const final {
+        static const std::string NULL_VERSION { "null" };
+        return NULL_VERSION;
+    }
+
     void render(const Batch& batch) final { }
 
     // This call synchronize the Full Backend cache with the current GLState
@@ -44,6 +49,10 @@ public:
     // Let's try to avoid to do that as much as possible!
     void syncCache() final { }
 
+    void recycle() const final { }
+
+    bool isTextureManagementSparseEnabled() const final { return false; }
+
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final { }
@@ -0,0 +1,133 @@
+//
+//  GeometryFileCache.cpp
+//  libraries/model-networking/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GeometryFileCache.h"
+
+#include <algorithm>
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QStringList>
+
+#include <FBXGeometrySerializer.h>
+#include <SettingHandle.h>
+
+#include "ModelNetworkingLogging.h"
+
+using File = cache::File;
+
+const int GeometryFileCache::INVALID_VERSION = 0x00;
+const char* GeometryFileCache::SETTING_VERSION_NAME = "hifi.geometry.cache_version";
+
+GeometryFileCache::GeometryFileCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+void GeometryFileCache::initialize() {
+    FileCache::initialize();
+    // entries from an older encoding can never be read, so drop them all at once rather than letting them age out
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, INVALID_VERSION);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != (int)FBXGeometrySerializer::CURRENT_VERSION) {
+        wipe();
+        cacheVersionHandle.set((int)FBXGeometrySerializer::CURRENT_VERSION);
+    }
+}
+
+// QHash iteration order changes from run to run, so the mapping is hashed with its keys sorted
+static void hashVariant(QCryptographicHash& hash, const QVariant& value) {
+    int type = value.userType();
+    hash.addData(reinterpret_cast<const char*>(&type), sizeof(type));
+    if (type == QMetaType::QVariantHash) {
+        QVariantHash variantHash = value.toHash();
+        QStringList keys = variantHash.uniqueKeys();
+        keys.sort();
+        for (const QString& key : keys) {
+            hash.addData(key.toUtf8());
+            for (const QVariant& child : variantHash.values(key)) {
+                hashVariant(hash, child);
+            }
+        }
+    } else if (type == QMetaType::QVariantMap) {
+        QVariantMap variantMap = value.toMap();
+        for (auto it = variantMap.constBegin(); it != variantMap.constEnd(); ++it) {
+            hash.addData(it.key().toUtf8());
+            hashVariant(hash, it.value());
+        }
+    } else if (type == QMetaType::QVariantList) {
+        for (const QVariant& child : value.toList()) {
+            hashVariant(hash, child);
+        }
+    } else {
+        hash.addData(value.toString().toUtf8());
+    }
+}
+
+GeometryFileCache::Key GeometryFileCache::computeKey(const QByteArray& data, const QVariantHash& mapping,
+                                                     const QUrl& url, bool combineParts,
+                                                     const QHash<QByteArray, QByteArray>& materialLibraries) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(data);
+    hashVariant(hash, mapping);
+    hash.addData(url.toString().toUtf8());
+    hash.addData(reinterpret_cast<const char*>(&combineParts), sizeof(combineParts));
+    QList<QByteArray> libraryNames = materialLibraries.keys();
+    std::sort(libraryNames.begin(), libraryNames.end());
+    for (const QByteArray& name : libraryNames) {
+        // lengths first, so that moving bytes between a name and its content changes the key
+        const QByteArray& content = materialLibraries[name];
+        int sizes[] = { name.size(), content.isNull() ? -1 : content.size() };
+        hash.addData(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+        hash.addData(name);
+        hash.addData(content);
+    }
+    return hash.result().toHex().toStdString();
+}
+
+FBXGeometry* GeometryFileCache::readGeometry(const Key& key, const QUrl& url) {
+    auto file = getFile(key);
+    if (!file) {
+        ++_numMisses;
+        return nullptr;
+    }
+
+    QFile geometryFile(QString::fromStdString(file->getFilepath()));
+    uchar* data = nullptr;
+    if (geometryFile.open(QFile::ReadOnly)) {
+        data = geometryFile.map(0, geometryFile.size());
+    }
+    if (!data) {
+        ++_numMisses;
+        return nullptr;
+    }
+
+    FBXGeometry* geometry = nullptr;
+    try {
+        geometry = FBXGeometrySerializer::deserialize(reinterpret_cast<const char*>(data), (size_t)geometryFile.size(),
+                                                      url.path());
+        ++_numHits;
+    } catch (const QString& error) {
+        ++_numMisses;
+        qCWarning(modelnetworking) << "Discarding geometry cache entry for" << url << ":" << error;
+    }
+    geometryFile.unmap(data);
+    return geometry;
+}
+
+void GeometryFileCache::writeGeometry(const Key& key, const FBXGeometry& geometry) {
+    QByteArray data = FBXGeometrySerializer::serialize(geometry);
+    // overwrite so that an unreadable entry gets replaced
+    writeFile(data.constData(), Metadata(key, data.size()), true);
+}
+
+std::unique_ptr<File> GeometryFileCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCInfo(file_cache) << "Wrote geometry" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
@@ -0,0 +1,56 @@
+//
+//  GeometryFileCache.h
+//  libraries/model-networking/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GeometryFileCache_h
+#define hifi_GeometryFileCache_h
+
+#include <atomic>
+
+#include <QUrl>
+#include <QVariantHash>
+
+#include <shared/FileCache.h>
+
+class FBXGeometry;
+
+// Disk cache of fully extracted model geometries (see FBXGeometrySerializer), so that reloading a model
+// skips the FBX/OBJ readers. Entries are keyed by a hash of the downloaded model data and of everything
+// else that the readers take as input, including the content of the material libraries of an OBJ.
+class GeometryFileCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    static const int INVALID_VERSION;
+    static const char* SETTING_VERSION_NAME;
+
+    GeometryFileCache(const std::string& dir, const std::string& ext);
+
+    void initialize() override;
+
+    static Key computeKey(const QByteArray& data, const QVariantHash& mapping, const QUrl& url, bool combineParts,
+                          const QHash<QByteArray, QByteArray>& materialLibraries = QHash<QByteArray, QByteArray>());
+
+    /// \return new geometry restored from disk, or nullptr if there is no valid entry for key
+    FBXGeometry* readGeometry(const Key& key, const QUrl& url);
+    void writeGeometry(const Key& key, const FBXGeometry& geometry);
+
+    int getNumHits() const { return _numHits; }
+    int getNumMisses() const { return _numMisses; }
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+
+private:
+    std::atomic<int> _numHits { 0 };
+    std::atomic<int> _numMisses { 0 };
+};
+
+#endif // hifi_GeometryFileCache_h
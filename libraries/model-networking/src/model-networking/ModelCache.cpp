@@ -180,25 +180,43 @@ void GeometryReader::run() {
             _url.path().toLower().endsWith(".obj.gz"))) {
             FBXGeometry::Pointer fbxGeometry;
 
-            if (_url.path().toLower().endsWith(".fbx")) {
+            // an OBJ is only as current as its material libraries, so those are fetched up front to go into the key
+            QByteArray objData;
+            OBJReader::MaterialLibraries materialLibraries;
+            if (_url.path().toLower().endsWith(".obj.gz")) {
+                if (!gunzip(_data, objData)) {
+                    throw QString("failed to decompress .obj.gz" );
+                }
+            } else if (_url.path().toLower().endsWith(".obj")) {
+                objData = _data;
+            }
+            if (!objData.isEmpty()) {
+                materialLibraries = OBJReader::fetchMaterialLibraries(objData, _url);
+            }
+
+            // a model that has been loaded before is restored from the geometry cache without parsing it again
+            auto geometryFileCache = DependencyManager::get<ModelCache>()->_geometryFileCache;
+            auto cacheKey = GeometryFileCache::computeKey(_data, _mapping, _url, _combineParts, materialLibraries);
+            fbxGeometry.reset(geometryFileCache->readGeometry(cacheKey, _url));
+            bool restoredFromCache = (bool)fbxGeometry;
+
+            if (restoredFromCache) {
+                qCDebug(modelnetworking) << "Restored" << _url << "from the geometry cache";
+            } else if (_url.path().toLower().endsWith(".fbx")) {
                 fbxGeometry.reset(readFBX(_data, _mapping, _url.path()));
                 if (fbxGeometry->meshes.size() == 0 && fbxGeometry->joints.size() == 0) {
                     throw QString("empty geometry, possibly due to an unsupported FBX version");
                 }
-            } else if (_url.path().toLower().endsWith(".obj")) {
-                fbxGeometry.reset(OBJReader().readOBJ(_data, _mapping, _combineParts, _url));
-            } else if (_url.path().toLower().endsWith(".obj.gz")) {
-                QByteArray uncompressedData;
-                if (gunzip(_data, uncompressedData)){
-                    fbxGeometry.reset(OBJReader().readOBJ(uncompressedData, _mapping, _combineParts, _url));
-                } else {
-                    throw QString("failed to decompress .obj.gz" );
-                }
-
+            } else if (_url.path().toLower().endsWith(".obj") || _url.path().toLower().endsWith(".obj.gz")) {
+                fbxGeometry.reset(OBJReader().readOBJ(objData, _mapping, _combineParts, _url, &materialLibraries));
             } else {
                 throw QString("unsupported format");
             }
 
+            if (!restoredFromCache) {
+                geometryFileCache->writeGeometry(cacheKey, *fbxGeometry);
+            }
+
             // Ensure the resource has not been deleted
             auto resource = _resource.toStrongRef();
             if (!resource) {
@@ -277,7 +295,11 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     finishedLoading(true);
 }
 
+const std::string ModelCache::GEOMETRY_CACHE_DIRNAME { "geometry_cache" };
+const std::string ModelCache::GEOMETRY_CACHE_EXT { "geometry" };
+
 ModelCache::ModelCache() {
+    _geometryFileCache->initialize();
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
@@ -19,6 +19,7 @@
 #include <model/Asset.h>
 
 #include "FBXReader.h"
+#include "GeometryFileCache.h"
 #include "TextureCache.h"
 
 // Alias instead of derive to avoid copying
@@ -153,8 +154,16 @@ protected:
                                                     const void* extra) override;
 
 private:
+    friend class GeometryReader;
+
     ModelCache();
     virtual ~ModelCache() = default;
+
+    static const std::string GEOMETRY_CACHE_DIRNAME;
+    static const std::string GEOMETRY_CACHE_EXT;
+
+    std::shared_ptr<GeometryFileCache> _geometryFileCache {
+        std::make_shared<GeometryFileCache>(GEOMETRY_CACHE_DIRNAME, GEOMETRY_CACHE_EXT) };
 };
 
 class NetworkMaterial : public model::Material {
@@ -126,9 +126,10 @@ void AssetClient::handleAssetMappingOperationReply(QSharedPointer<ReceivedMessag
         // Check if we have this pending request
         auto requestIt = messageCallbackMap.find(messageID);
         if (requestIt != messageCallbackMap.end()) {
+            // forget the request before calling back, since the callback may queue the next one
             auto callback = requestIt->second;
-            callback(true, error, message);
             messageCallbackMap.erase(requestIt);
+            callback(true, error, message);
         }
 
         // Although the messageCallbackMap may now be empty, we won't delete the node until we have disconnected from
@@ -238,7 +239,9 @@ MessageID AssetClient::getAsset(const QString& hash, DataOffset start, DataOffse
 
         auto messageID = ++_currentID;
 
-        auto payloadSize = sizeof(messageID) + SHA256_HASH_LENGTH + sizeof(start) + sizeof(end);
+        uint8_t acceptedEncodings = (1 << (uint8_t)AssetEncoding::Identity) | (1 << (uint8_t)AssetEncoding::Zlib);
+
+        auto payloadSize = sizeof(messageID) + SHA256_HASH_LENGTH + sizeof(start) + sizeof(end) + sizeof(acceptedEncodings);
         auto packet = NLPacket::create(PacketType::AssetGet, payloadSize, true);
 
         qCDebug(asset_client) << "Requesting data from" << start << "to" << end << "of" << hash << "from asset-server.";
@@ -249,6 +252,7 @@ MessageID AssetClient::getAsset(const QString& hash, DataOffset start, DataOffse
 
         packet->writePrimitive(start);
         packet->writePrimitive(end);
+        packet->writePrimitive(acceptedEncodings);
 
         if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
             _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback };
@@ -323,6 +327,24 @@ void AssetClient::handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> messag
     }
 }
 
+static bool decodeAssetData(AssetEncoding encoding, const QByteArray& encodedData, QByteArray& data) {
+    switch (encoding) {
+        case AssetEncoding::Identity:
+            data = encodedData;
+            return true;
+        case AssetEncoding::Zlib:
+            data = qUncompress(encodedData);
+            if (data.isEmpty() && !encodedData.isEmpty()) {
+                qCWarning(asset_client) << "Failed to decompress asset data";
+                return false;
+            }
+            return true;
+        default:
+            qCWarning(asset_client) << "Got asset data with unknown encoding" << (int)encoding;
+            return false;
+    }
+}
+
 void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -335,8 +357,10 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     AssetServerError error;
     message->readHeadPrimitive(&error);
 
+    AssetEncoding encoding = AssetEncoding::Identity;
     DataOffset length = 0;
     if (!error) {
+        message->readHeadPrimitive(&encoding);
         message->readHeadPrimitive(&length);
     } else {
         qCWarning(asset_client) << "Failure getting asset: " << error;
@@ -363,6 +387,7 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
 
     // Store message in case we need to disconnect from it later.
     callbacks.message = message;
+    callbacks.encoding = encoding;
 
 
     auto weakNode = senderNode.toWeakRef();
@@ -376,10 +401,11 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     if (message->isComplete()) {
         disconnect(message.data(), nullptr, this, nullptr);
 
-        if (length != message->getBytesLeftToRead()) {
-            callbacks.completeCallback(false, error, QByteArray());
+        QByteArray data;
+        if (length == message->getBytesLeftToRead() && decodeAssetData(encoding, message->readAll(), data)) {
+            callbacks.completeCallback(true, error, data);
         } else {
-            callbacks.completeCallback(true, error, message->readAll());
+            callbacks.completeCallback(false, error, QByteArray());
         }
 
 
@@ -447,10 +473,12 @@ void AssetClient::handleCompleteCallback(const QWeakPointer<Node>& node, Message
         return;
     }
 
-    if (message->failed() || length != message->getBytesLeftToRead()) {
+    QByteArray data;
+    if (message->failed() || length != message->getBytesLeftToRead()
+        || !decodeAssetData(callbacks.encoding, message->readAll(), data)) {
         callbacks.completeCallback(false, AssetServerError::NoError, QByteArray());
     } else {
-        callbacks.completeCallback(true, AssetServerError::NoError, message->readAll());
+        callbacks.completeCallback(true, AssetServerError::NoError, data);
     }
 
     // We should never get to this point without the associated senderNode and messageID
@@ -488,7 +516,8 @@ MessageID AssetClient::getAssetMapping(const AssetPath& path, MappingOperationCa
     return INVALID_MESSAGE_ID;
 }
 
-MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
+MessageID AssetClient::getAllAssetMappings(const AssetPath& prefix, const AssetPath& startAfter, uint32_t maxCount,
+                                           MappingOperationCallback callback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -502,6 +531,11 @@ MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
 
         packetList->writePrimitive(AssetMappingOperationType::GetAll);
 
+        // ask for one page of the mappings below prefix
+        packetList->writeString(prefix);
+        packetList->writeString(startAfter);
+        packetList->writePrimitive(maxCount);
+
         if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
             _pendingMappingRequests[assetServer][messageID] = callback;
 
@@ -79,7 +79,8 @@ private slots:
 
 private:
     MessageID getAssetMapping(const AssetHash& hash, MappingOperationCallback callback);
-    MessageID getAllAssetMappings(MappingOperationCallback callback);
+    MessageID getAllAssetMappings(const AssetPath& prefix, const AssetPath& startAfter, uint32_t maxCount,
+                                  MappingOperationCallback callback);
     MessageID setAssetMapping(const QString& path, const AssetHash& hash, MappingOperationCallback callback);
     MessageID deleteAssetMappings(const AssetPathList& paths, MappingOperationCallback callback);
     MessageID renameAssetMapping(const AssetPath& oldPath, const AssetPath& newPath, MappingOperationCallback callback);
@@ -104,6 +105,7 @@ private:
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
         ProgressCallback progressCallback;
+        AssetEncoding encoding { AssetEncoding::Identity };
     };
 
     static MessageID _currentID;
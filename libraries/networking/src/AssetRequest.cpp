@@ -12,8 +12,15 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
 
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <StatTracker.h>
 #include <Trace.h>
@@ -25,6 +32,18 @@
 
 static int requestID = 0;
 
+const DataOffset AssetRequest::PARALLEL_DOWNLOAD_MIN_SIZE = 4 * 1024 * 1024;
+const DataOffset AssetRequest::SEGMENT_SIZE = 1024 * 1024;
+const int AssetRequest::MAX_CONCURRENT_SEGMENTS = 4;
+const int AssetRequest::MAX_SEGMENT_ATTEMPTS = 3;
+
+static const int SEGMENT_RETRY_DELAY_MS = 1000;
+
+// partial downloads are kept next to the disk cache as <hash>.part, with the segments it holds in <hash>.segments
+static const QString PARTIAL_DOWNLOADS_SUBDIR = "partialAssets";
+static const QString PARTIAL_DATA_SUFFIX = ".part";
+static const QString PARTIAL_SEGMENTS_SUFFIX = ".segments";
+
 AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
     _hash(hash),
@@ -38,6 +57,10 @@ AssetRequest::~AssetRequest() {
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+    }
+    cancelSegmentRequests();
 }
 
 void AssetRequest::start() {
@@ -75,6 +98,110 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestAsset();
+        return;
+    }
+
+    if (hasPartialDownload()) {
+        // resuming needs the size of the asset up front, to match it against what was saved
+        requestAssetInfo();
+        return;
+    }
+
+    // most assets come whole in the first reply, without asking how big they are first
+    requestFirstRange();
+}
+
+void AssetRequest::requestFirstRange() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    _assetRequestID = assetClient->getAsset(_hash, 0, PARALLEL_DOWNLOAD_MIN_SIZE,
+        [this, that](bool responseReceived, AssetServerError serverError, const QByteArray& data) {
+
+        if (!that) {
+            return;
+        }
+        _assetRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived) {
+            _error = NetworkError;
+        } else if (serverError != AssetServerError::NoError) {
+            _error = errorForServerError(serverError);
+        } else if (data.size() >= PARALLEL_DOWNLOAD_MIN_SIZE) {
+            // the asset may go on past the range, so find out how far before fetching the rest in segments
+            _firstRange = data;
+            requestAssetInfo();
+            return;
+        } else if (hashData(data).toHex() != _hash) {
+            _error = HashVerificationFailed;
+        } else {
+            _data = data;
+            _totalReceived += data.size();
+            emit progress(_totalReceived, data.size());
+            saveToCache(getUrl(), data);
+        }
+
+        finish();
+    }, [this, that](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            return;
+        }
+        emit progress(totalReceived, total);
+    });
+}
+
+void AssetRequest::requestAssetInfo() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetServerError serverError, AssetInfo info) {
+
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived) {
+            _error = NetworkError;
+        } else if (serverError != AssetServerError::NoError) {
+            _error = errorForServerError(serverError);
+        } else if (info.size >= PARALLEL_DOWNLOAD_MIN_SIZE) {
+            requestSegmentedAsset(info.size);
+            return;
+        } else {
+            requestAsset();
+            return;
+        }
+
+        qCWarning(asset_client) << "Got error retrieving asset info" << _hash << "- error code" << _error;
+        finish();
+    });
+}
+
+AssetRequest::Error AssetRequest::errorForServerError(AssetServerError serverError) {
+    switch (serverError) {
+        case AssetServerError::AssetNotFound:
+            return NotFound;
+        case AssetServerError::InvalidByteRange:
+            return InvalidByteRange;
+        default:
+            return UnknownError;
+    }
+}
+
+void AssetRequest::finish() {
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::requestAsset() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -92,17 +219,7 @@ void AssetRequest::start() {
         if (!responseReceived) {
             _error = NetworkError;
         } else if (serverError != AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+            _error = errorForServerError(serverError);
         } else {
             if (!_byteRange.isSet() && hashData(data).toHex() != _hash) {
                 // the hash of the received data does not match what we expect, so we return an error
@@ -119,13 +236,8 @@ void AssetRequest::start() {
                 }
             }
         }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
-        }
-        
-        _state = Finished;
-        emit finished(this);
+
+        finish();
     }, [this, that](qint64 totalReceived, qint64 total) {
         if (!that) {
             // If the request is dead, return
@@ -134,3 +246,255 @@ void AssetRequest::start() {
         emit progress(totalReceived, total);
     });
 }
+
+void AssetRequest::requestSegmentedAsset(DataOffset size) {
+    for (DataOffset start = 0; start < size; start += SEGMENT_SIZE) {
+        Segment segment;
+        segment.start = start;
+        segment.end = std::min(start + SEGMENT_SIZE, size);
+        _segments.push_back(segment);
+    }
+
+    _data = QByteArray(size, Qt::Uninitialized);
+
+    if (loadPartialDownload(size)) {
+        qCDebug(asset_client) << "Resuming download of" << _hash << "with" << _completedSize << "of" << size << "bytes";
+        hashCompletedSegments();
+        emit progress(_completedSize, size);
+    }
+
+    // the segments that the first reply already covers don't need to be asked for again
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        auto& segment = _segments[i];
+        if (segment.isComplete || segment.end > _firstRange.size()) {
+            continue;
+        }
+        memcpy(_data.data() + segment.start, _firstRange.constData() + segment.start, segment.end - segment.start);
+        segment.isComplete = true;
+        _completedSize += segment.end - segment.start;
+        savePartialDownload(i);
+    }
+    if (!_firstRange.isEmpty()) {
+        _firstRange.clear();
+        hashCompletedSegments();
+        emit progress(_completedSize, size);
+    }
+
+    requestNextSegments();
+}
+
+void AssetRequest::requestNextSegments() {
+    if (_numHashedSegments == _segments.size()) {
+        // every segment is in, and the hash was checked along the way
+        _totalReceived = _data.size();
+        if (_hasher.result().toHex() != _hash) {
+            _error = HashVerificationFailed;
+            _data.clear();
+        } else {
+            saveToCache(getUrl(), _data);
+        }
+        removePartialDownload();
+        finish();
+        return;
+    }
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    int numPending = 0;
+    for (auto& segment : _segments) {
+        if (segment.messageID != INVALID_MESSAGE_ID) {
+            ++numPending;
+        }
+    }
+
+    for (size_t i = 0; i < _segments.size() && numPending < MAX_CONCURRENT_SEGMENTS; ++i) {
+        auto& segment = _segments[i];
+        if (segment.isComplete || segment.messageID != INVALID_MESSAGE_ID) {
+            continue;
+        }
+
+        ++segment.attempts;
+        ++numPending;
+
+        auto messageID = assetClient->getAsset(_hash, segment.start, segment.end,
+            [this, that, i](bool responseReceived, AssetServerError serverError, const QByteArray& data) {
+            if (that) {
+                handleSegmentReply(i, responseReceived, serverError, data);
+            }
+        }, [this, that, i](qint64 totalReceived, qint64 total) {
+            if (!that || _state != WaitingForData) {
+                return;
+            }
+            _segments[i].received = totalReceived;
+
+            qint64 received = _completedSize;
+            for (auto& segment : _segments) {
+                if (!segment.isComplete) {
+                    received += segment.received;
+                }
+            }
+            emit progress(received, _data.size());
+        });
+
+        if (messageID == INVALID_MESSAGE_ID) {
+            // the request could not be sent, and its callback already dealt with that
+            return;
+        }
+        segment.messageID = messageID;
+    }
+}
+
+void AssetRequest::handleSegmentReply(size_t index, bool responseReceived, AssetServerError serverError,
+                                      const QByteArray& data) {
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    auto& segment = _segments[index];
+    segment.messageID = INVALID_MESSAGE_ID;
+    segment.received = 0;
+
+    if (responseReceived && serverError != AssetServerError::NoError) {
+        // the server answered, and asking again would get the same answer
+        _error = errorForServerError(serverError);
+    } else if (!responseReceived || data.size() != segment.end - segment.start) {
+        // only a transfer that was lost or cut short is worth another try
+        if (segment.attempts < MAX_SEGMENT_ATTEMPTS) {
+            // give the connection to the asset server a moment to come back before asking again
+            QTimer::singleShot(SEGMENT_RETRY_DELAY_MS, this, [this] {
+                if (_state == WaitingForData) {
+                    requestNextSegments();
+                }
+            });
+            return;
+        }
+        _error = NetworkError;
+    }
+
+    if (_error != NoError) {
+        // what was received so far stays on disk for the next request of this asset to pick up
+        cancelSegmentRequests();
+        _data.clear();
+        finish();
+        return;
+    }
+
+    memcpy(_data.data() + segment.start, data.constData(), data.size());
+    segment.isComplete = true;
+    _completedSize += data.size();
+
+    savePartialDownload(index);
+    hashCompletedSegments();
+    emit progress(_completedSize, _data.size());
+
+    requestNextSegments();
+}
+
+void AssetRequest::hashCompletedSegments() {
+    while (_numHashedSegments < _segments.size() && _segments[_numHashedSegments].isComplete) {
+        auto& segment = _segments[_numHashedSegments];
+        _hasher.addData(_data.constData() + segment.start, segment.end - segment.start);
+        ++_numHashedSegments;
+    }
+}
+
+void AssetRequest::cancelSegmentRequests() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto& segment : _segments) {
+        if (segment.messageID != INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(segment.messageID);
+            segment.messageID = INVALID_MESSAGE_ID;
+        }
+    }
+}
+
+QString AssetRequest::getPartialDownloadPath() const {
+    auto cacheDirectory = DependencyManager::get<AssetClient>()->_cacheDir;
+    if (cacheDirectory.isEmpty()) {
+        return QString();
+    }
+    return QDir(cacheDirectory).filePath(PARTIAL_DOWNLOADS_SUBDIR + "/" + _hash);
+}
+
+bool AssetRequest::hasPartialDownload() const {
+    auto path = getPartialDownloadPath();
+    return !path.isEmpty() && QFile::exists(path + PARTIAL_SEGMENTS_SUFFIX);
+}
+
+bool AssetRequest::loadPartialDownload(DataOffset size) {
+    auto path = getPartialDownloadPath();
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    QFile segmentsFile { path + PARTIAL_SEGMENTS_SUFFIX };
+    QFile dataFile { path + PARTIAL_DATA_SUFFIX };
+    if (!segmentsFile.open(QIODevice::ReadOnly) || !dataFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&segmentsFile);
+    qint64 savedSize;
+    qint64 savedSegmentSize;
+    QByteArray completedSegments;
+    stream >> savedSize >> savedSegmentSize >> completedSegments;
+
+    if (stream.status() != QDataStream::Ok || savedSize != size || savedSegmentSize != SEGMENT_SIZE
+        || completedSegments.size() != (int)_segments.size() || dataFile.size() != size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        if (!completedSegments[(int)i]) {
+            continue;
+        }
+
+        auto& segment = _segments[i];
+        auto segmentSize = segment.end - segment.start;
+        if (!dataFile.seek(segment.start) || dataFile.read(_data.data() + segment.start, segmentSize) != segmentSize) {
+            continue;
+        }
+        segment.isComplete = true;
+        _completedSize += segmentSize;
+    }
+    return _completedSize > 0;
+}
+
+void AssetRequest::savePartialDownload(size_t index) {
+    auto path = getPartialDownloadPath();
+    if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+
+    auto& segment = _segments[index];
+    QFile dataFile { path + PARTIAL_DATA_SUFFIX };
+    if (!dataFile.open(QIODevice::ReadWrite) || (dataFile.size() != _data.size() && !dataFile.resize(_data.size()))
+        || !dataFile.seek(segment.start)
+        || dataFile.write(_data.constData() + segment.start, segment.end - segment.start) != segment.end - segment.start
+        || !dataFile.flush()) {
+        qCWarning(asset_client) << "Failed to save partial download of" << _hash << "-" << dataFile.errorString();
+        return;
+    }
+
+    // the data is written before the segment is recorded as complete, so a crash can only lose segments
+    QByteArray completedSegments(_segments.size(), 0);
+    for (size_t i = 0; i < _segments.size(); ++i) {
+        completedSegments[(int)i] = _segments[i].isComplete;
+    }
+
+    QSaveFile segmentsFile { path + PARTIAL_SEGMENTS_SUFFIX };
+    if (segmentsFile.open(QIODevice::WriteOnly)) {
+        QDataStream stream(&segmentsFile);
+        stream << (qint64)_data.size() << (qint64)SEGMENT_SIZE << completedSegments;
+        segmentsFile.commit();
+    }
+}
+
+void AssetRequest::removePartialDownload() {
+    auto path = getPartialDownloadPath();
+    if (!path.isEmpty()) {
+        QFile::remove(path + PARTIAL_SEGMENTS_SUFFIX);
+        QFile::remove(path + PARTIAL_DATA_SUFFIX);
+    }
+}
@@ -12,7 +12,10 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <vector>
+
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <QObject>
 #include <QString>
 
@@ -23,6 +26,12 @@
 
 const QString ATP_SCHEME { "atp:" };
 
+/// Downloads an asset, or a range of it, from the asset server.
+///
+/// A whole asset is first asked for as a range of PARALLEL_DOWNLOAD_MIN_SIZE bytes, which the server cuts short at
+/// the end of a smaller asset. Only an asset that fills that range has its size looked up, and the rest of it is
+/// fetched as SEGMENT_SIZE ranges, with up to MAX_CONCURRENT_SEGMENTS of them in flight as separate messages. Completed segments are hashed as soon as the
+/// ones before them are in, and kept on disk, so a download that fails is resumed by the next request for the asset.
 class AssetRequest : public QObject {
    Q_OBJECT
 public:
@@ -43,6 +52,11 @@ public:
         UnknownError
     };
 
+    static const DataOffset PARALLEL_DOWNLOAD_MIN_SIZE;
+    static const DataOffset SEGMENT_SIZE;
+    static const int MAX_CONCURRENT_SEGMENTS;
+    static const int MAX_SEGMENT_ATTEMPTS;
+
     AssetRequest(const QString& hash, const ByteRange& byteRange = ByteRange());
     virtual ~AssetRequest() override;
 
@@ -61,6 +75,33 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    struct Segment {
+        DataOffset start;
+        DataOffset end;
+        MessageID messageID { INVALID_MESSAGE_ID };
+        qint64 received { 0 };
+        int attempts { 0 };
+        bool isComplete { false };
+    };
+
+    static Error errorForServerError(AssetServerError serverError);
+
+    void requestAsset();
+    void requestFirstRange();
+    void requestAssetInfo();
+    void requestSegmentedAsset(DataOffset size);
+    void requestNextSegments();
+    void handleSegmentReply(size_t index, bool responseReceived, AssetServerError serverError, const QByteArray& data);
+    void hashCompletedSegments();
+    void cancelSegmentRequests();
+    void finish();
+
+    QString getPartialDownloadPath() const;
+    bool hasPartialDownload() const;
+    bool loadPartialDownload(DataOffset size);
+    void savePartialDownload(size_t index);
+    void removePartialDownload();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -71,6 +112,13 @@ private:
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
+
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    QByteArray _firstRange; // the start of an asset too big to come in one piece, until it is split into segments
+    std::vector<Segment> _segments;
+    qint64 _completedSize { 0 };
+    QCryptographicHash _hasher { QCryptographicHash::Sha256 };
+    size_t _numHashedSegments { 0 };
 };
 
 #endif
@@ -54,6 +54,13 @@ enum AssetMappingOperationType : uint8_t {
     SetBakingEnabled
 };
 
+// How the data of an asset reply is encoded. Clients send the set of encodings they accept as a bit mask
+// (1 << encoding), and the server may pick any of them for a whole-file request.
+enum class AssetEncoding : uint8_t {
+    Identity = 0,
+    Zlib // qCompress format
+};
+
 enum BakingStatus {
     Irrelevant,
     NotBaked,
@@ -0,0 +1,80 @@
+//
+//  CompressedAssetStore.cpp
+//  libraries/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CompressedAssetStore.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+// compressing is done once per asset, so it might as well be thorough
+static const int COMPRESSION_LEVEL = 9;
+static const float MAX_COMPRESSED_RATIO = 0.9f;
+
+// an empty file named after the asset with this suffix records that it isn't worth compressing
+static const QString NOT_WORTH_IT_SUFFIX = ".uncompressed";
+
+QString CompressedAssetStore::getCompressedFilePath(const AssetHash& hash) const {
+    return _directory.absoluteFilePath(hash);
+}
+
+QString CompressedAssetStore::getNotWorthItFilePath(const AssetHash& hash) const {
+    return _directory.absoluteFilePath(hash + NOT_WORTH_IT_SUFFIX);
+}
+
+CompressedAssetStore::Decision CompressedAssetStore::getDecision(const AssetHash& hash) const {
+    if (QFile::exists(getCompressedFilePath(hash))) {
+        return Decision::Compressed;
+    }
+    if (QFile::exists(getNotWorthItFilePath(hash))) {
+        return Decision::NotWorthIt;
+    }
+    return Decision::Unknown;
+}
+
+CompressedAssetStore::Decision CompressedAssetStore::compress(const AssetHash& hash, const QString& filePath) const {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return Decision::Unknown;
+    }
+    auto data = file.readAll();
+    file.close();
+
+    auto compressedData = qCompress(data, COMPRESSION_LEVEL);
+    if (compressedData.size() > data.size() * MAX_COMPRESSED_RATIO) {
+        QFile notWorthItFile { getNotWorthItFilePath(hash) };
+        return notWorthItFile.open(QIODevice::WriteOnly) ? Decision::NotWorthIt : Decision::Unknown;
+    }
+
+    // written atomically, since a send task may pick it up at any time
+    QSaveFile compressedFile { getCompressedFilePath(hash) };
+    if (compressedFile.open(QIODevice::WriteOnly) && compressedFile.write(compressedData) == compressedData.size()
+        && compressedFile.commit()) {
+        return Decision::Compressed;
+    }
+    return Decision::Unknown;
+}
+
+void CompressedAssetStore::remove(const AssetHash& hash) const {
+    QFile::remove(getCompressedFilePath(hash));
+    QFile::remove(getNotWorthItFilePath(hash));
+}
+
+void CompressedAssetStore::removeOrphans(const QDir& filesDirectory) const {
+    for (const auto& fileInfo : _directory.entryInfoList(QDir::Files)) {
+        auto hash = fileInfo.fileName();
+        if (hash.endsWith(NOT_WORTH_IT_SUFFIX)) {
+            hash.chop(NOT_WORTH_IT_SUFFIX.size());
+        }
+        if (isValidHash(hash) && !filesDirectory.exists(hash)) {
+            QFile::remove(fileInfo.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  CompressedAssetStore.h
+//  libraries/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompressedAssetStore_h
+#define hifi_CompressedAssetStore_h
+
+#include <QtCore/QDir>
+
+#include "AssetUtils.h"
+
+/// The zlib compressed variants of asset files, kept in a directory of their own and sent to the clients that accept
+/// them. Whether an asset was worth compressing is recorded on disk either way, so that a restarted server doesn't
+/// compress all of its assets again.
+class CompressedAssetStore {
+public:
+    enum class Decision {
+        Unknown, // not compressed yet
+        Compressed, // the compressed variant is at getCompressedFilePath()
+        NotWorthIt // compressing didn't save enough, the asset is sent as it is
+    };
+
+    CompressedAssetStore() = default;
+    explicit CompressedAssetStore(const QDir& directory) : _directory(directory) { }
+
+    const QDir& getDirectory() const { return _directory; }
+    QString getCompressedFilePath(const AssetHash& hash) const;
+
+    Decision getDecision(const AssetHash& hash) const;
+
+    /// Compresses the asset file and records whether the result was worth keeping. Safe to call from any thread,
+    /// but not for the same hash twice at once.
+    /// \return the decision, or Unknown if the asset couldn't be read or the result couldn't be written
+    Decision compress(const AssetHash& hash, const QString& filePath) const;
+
+    /// Forget the decision for an asset and remove its compressed variant
+    void remove(const AssetHash& hash) const;
+
+    /// Remove the entries of assets that are no longer in filesDirectory
+    void removeOrphans(const QDir& filesDirectory) const;
+
+private:
+    QString getNotWorthItFilePath(const AssetHash& hash) const;
+
+    QDir _directory;
+};
+
+#endif // hifi_CompressedAssetStore_h
@@ -23,6 +23,7 @@
 #include <QtNetwork/QHostInfo>
 
 #include <LogHandler.h>
+#include <Metrics.h>
 #include <shared/NetworkUtils.h>
 #include <NumericalConstants.h>
 #include <SettingHandle.h>
@@ -355,9 +356,14 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 }
 
 void LimitedNodeList::collectPacketStats(const NLPacket& packet) {
-    // stat collection for packets
-    ++_numCollectedPackets;
-    _numCollectedBytes += packet.getDataSize();
+    // stat collection for packets, from any thread sending them (streamed packets are counted on the send queue's)
+    _numCollectedPackets.fetch_add(1, std::memory_order_relaxed);
+    _numCollectedBytes.fetch_add((int)packet.getDataSize(), std::memory_order_relaxed);
+
+    static const MetricCounter packetsOut { "network.packets_out" };
+    static const MetricCounter bytesOut { "network.bytes_out" };
+    packetsOut.add();
+    bytesOut.add(packet.getDataSize());
 }
 
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, const QUuid& connectionSecret) {
@@ -372,6 +378,16 @@ void LimitedNodeList::fillPacketHeader(const NLPacket& packet, const QUuid& conn
     }
 }
 
+void LimitedNodeList::setStreamedPacketFinisher(NLPacketList& packetList, const QUuid& connectionSecret) {
+    // streamed packets only get their payload on the send queue's thread, right before they go out,
+    // so the header has to be filled in there as well
+    packetList._packetFinisher = [this, connectionSecret](udt::Packet& packet) {
+        NLPacket& nlPacket = static_cast<NLPacket&>(packet);
+        collectPacketStats(nlPacket);
+        fillPacketHeader(nlPacket, connectionSecret);
+    };
+}
+
 static const qint64 ERROR_SENDING_PACKET_BYTES = -1;
 
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode) {
@@ -471,10 +487,14 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
     // close the last packet in the list
     packetList->closeCurrentPacket();
 
-    for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
-        NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
-        collectPacketStats(*nlPacket);
-        fillPacketHeader(*nlPacket);
+    if (packetList->isStreamed()) {
+        setStreamedPacketFinisher(*packetList, QUuid());
+    } else {
+        for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
+            NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
+            collectPacketStats(*nlPacket);
+            fillPacketHeader(*nlPacket);
+        }
     }
 
     return _nodeSocket.writePacketList(std::move(packetList), sockAddr);
@@ -486,10 +506,14 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
         // close the last packet in the list
         packetList->closeCurrentPacket();
 
-        for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
-            NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
-            collectPacketStats(*nlPacket);
-            fillPacketHeader(*nlPacket, destinationNode.getConnectionSecret());
+        if (packetList->isStreamed()) {
+            setStreamedPacketFinisher(*packetList, destinationNode.getConnectionSecret());
+        } else {
+            for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
+                NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
+                collectPacketStats(*nlPacket);
+                fillPacketHeader(*nlPacket, destinationNode.getConnectionSecret());
+            }
         }
 
         return _nodeSocket.writePacketList(std::move(packetList), *activeSocket);
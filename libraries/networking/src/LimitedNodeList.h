@@ -68,6 +68,16 @@ const QString USERNAME_UUID_REPLACEMENT_STATS_KEY = "$username";
 
 const QString LOCAL_SOCKET_CHANGE_STAT = "LocalSocketChanges";
 
+// DomainList packets carry a revision of the list, and the revision it is a delta from (none for a full list),
+// followed by records that each either add or update a node, or remove one
+using DomainListRevision = quint32;
+const DomainListRevision NO_DOMAIN_LIST_REVISION = 0;
+
+enum class DomainListRecordType : quint8 {
+    Node = 0,
+    RemovedNode
+};
+
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
 
@@ -355,13 +365,14 @@ protected:
                        const QUuid& connectionSecret = QUuid());
     void collectPacketStats(const NLPacket& packet);
     void fillPacketHeader(const NLPacket& packet, const QUuid& connectionSecret = QUuid());
+    void setStreamedPacketFinisher(NLPacketList& packetList, const QUuid& connectionSecret);
 
     void setLocalSocket(const HifiSockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
-    void handleNodeKill(const SharedNodePointer& node);
+    virtual void handleNodeKill(const SharedNodePointer& node);
 
     void stopInitialSTUNUpdate(bool success);
 
@@ -106,12 +106,18 @@ void GetMappingRequest::doStart() {
     });
 };
 
-GetAllMappingsRequest::GetAllMappingsRequest() {
+const uint32_t GetAllMappingsRequest::PAGE_SIZE = 1000;
+
+GetAllMappingsRequest::GetAllMappingsRequest(const AssetPath& prefix) : _prefix(prefix) {
 };
 
 void GetAllMappingsRequest::doStart() {
+    requestPage(AssetPath());
+}
+
+void GetAllMappingsRequest::requestPage(const AssetPath& startAfter) {
     auto assetClient = DependencyManager::get<AssetClient>();
-    _mappingRequestID = assetClient->getAllAssetMappings(
+    _mappingRequestID = assetClient->getAllAssetMappings(_prefix, startAfter, PAGE_SIZE,
             [this, assetClient](bool responseReceived, AssetServerError error, QSharedPointer<ReceivedMessage> message) {
 
         _mappingRequestID = INVALID_MESSAGE_ID;
@@ -144,6 +150,16 @@ void GetAllMappingsRequest::doStart() {
                 }
                 _mappings[path] = { hash, status, lastBakeErrors };
             }
+
+            // the reply ends with where the next page starts, unless this was the last one
+            // (servers that don't page send everything at once and leave it out)
+            if (message->getBytesLeftToRead() > 0) {
+                auto nextPageStartAfter = message->readString();
+                if (!nextPageStartAfter.isEmpty()) {
+                    requestPage(nextPageStartAfter);
+                    return;
+                }
+            }
         }
         emit finished(this);
     });
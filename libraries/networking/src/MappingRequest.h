@@ -120,7 +120,10 @@ private:
 class GetAllMappingsRequest : public MappingRequest {
     Q_OBJECT
 public:
-    GetAllMappingsRequest();
+    static const uint32_t PAGE_SIZE;
+
+    /// lists the mappings below prefix, or all of them if it is empty
+    GetAllMappingsRequest(const AssetPath& prefix = AssetPath());
 
     AssetMapping getMappings() const { return _mappings;  }
 
@@ -129,7 +132,9 @@ signals:
 
 private:
     virtual void doStart() override;
-    
+    void requestPage(const AssetPath& startAfter);
+
+    AssetPath _prefix;
     AssetMapping _mappings;
 };
 
@@ -77,6 +77,9 @@ std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString chann
 
     packetList->write(senderID.toRfc4122());
 
+    // closed, so that getMessage() has all of it (the messages mixer forwards that payload)
+    packetList->closeCurrentPacket();
+
     return packetList;
 }
 
@@ -97,6 +100,9 @@ std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesDataPacket(QString c
 
     packetList->write(senderID.toRfc4122());
 
+    // closed, so that getMessage() has all of it (the messages mixer forwards that payload)
+    packetList->closeCurrentPacket();
+
     return packetList;
 }
 
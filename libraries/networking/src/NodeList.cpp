@@ -241,6 +241,10 @@ void NodeList::reset() {
 
     _numNoReplyDomainCheckIns = 0;
 
+    _domainListRevision = NO_DOMAIN_LIST_REVISION;
+    _receivingDomainListRevision = NO_DOMAIN_LIST_REVISION;
+    _numReceivedDomainListRecords = 0;
+
     // lock and clear our set of ignored IDs
     _ignoredSetLock.lockForWrite();
     _ignoredNodeIDs.clear();
@@ -395,6 +399,11 @@ void NodeList::sendDomainServerCheckIn() {
         packetStream << _ownerType.load() << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // let the domain-server know which list we have, so it only sends what changed since
+            packetStream << _domainListRevision.load();
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager->getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -624,9 +633,37 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
-    // pull each node in the packet
+    // the list may be split over several packets, each with this same header
+    DomainListRevision revision, baseRevision;
+    quint32 numRecords;
+    packetStream >> revision >> baseRevision >> numRecords;
+
+    if (revision != _receivingDomainListRevision) {
+        _receivingDomainListRevision = revision;
+        _numReceivedDomainListRecords = 0;
+    }
+
+    // pull each record in the packet, applying them is harmless even when a packet of the list was lost
+    _isApplyingDomainList = true;
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        quint8 recordType;
+        packetStream >> recordType;
+
+        if (recordType == (quint8)DomainListRecordType::RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+        ++_numReceivedDomainListRecords;
+    }
+    _isApplyingDomainList = false;
+
+    // only once every record of a list is in, and it applies to the list we had, can the domain-server build on it
+    bool appliesToOurList = baseRevision == NO_DOMAIN_LIST_REVISION || baseRevision == _domainListRevision;
+    if (_numReceivedDomainListRecords >= numRecords && appliesToOurList) {
+        _domainListRevision = revision;
     }
 }
 
@@ -674,6 +711,16 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 }
 
+void NodeList::handleNodeKill(const SharedNodePointer& node) {
+    // The domain-server still has the node in the list it thinks we have, and would never send it again if it
+    // comes back (e.g. it went silent for a while). Only the removals of a domain list keep our list in sync with it.
+    if (!_isApplyingDomainList || QThread::currentThread() != thread()) {
+        _domainListRevision = NO_DOMAIN_LIST_REVISION;
+    }
+
+    LimitedNodeList::handleNodeKill(node);
+}
+
 void NodeList::sendAssignment(Assignment& assignment) {
 
     PacketType assignmentPacketType = assignment.getCommand() == Assignment::CreateCommand
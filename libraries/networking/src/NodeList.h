@@ -92,6 +92,8 @@ public:
 
     void removeFromIgnoreMuteSets(const QUuid& nodeID);
 
+    DomainListRevision getDomainListRevision() const { return _domainListRevision; }
+
 public slots:
     void reset();
     void sendDomainServerCheckIn();
@@ -153,6 +155,8 @@ private:
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
+    void handleNodeKill(const SharedNodePointer& node) override;
+
     bool sockAddrBelongsToDomainOrNode(const HifiSockAddr& sockAddr);
 
     std::atomic<NodeType_t> _ownerType;
@@ -164,6 +168,13 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData;
 
+    // the last domain list revision that was received in full, acknowledged with each check in,
+    // and forgotten as soon as a node is removed other than by a domain list (nodes can be killed from any thread)
+    std::atomic<DomainListRevision> _domainListRevision { NO_DOMAIN_LIST_REVISION };
+    DomainListRevision _receivingDomainListRevision { NO_DOMAIN_LIST_REVISION };
+    quint32 _numReceivedDomainListRecords { 0 };
+    bool _isApplyingDomainList { false }; // only on our thread
+
     mutable QReadWriteLock _ignoredSetLock;
     tbb::concurrent_unordered_set<QUuid, UUIDHasher> _ignoredNodeIDs;
     mutable QReadWriteLock _personalMutedSetLock;
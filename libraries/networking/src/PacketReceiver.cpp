@@ -14,6 +14,8 @@
 
 #include <QMutexLocker>
 
+#include <Metrics.h>
+
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
@@ -200,6 +202,13 @@ void PacketReceiver::unregisterListener(QObject* listener) {
     _directlyConnectedObjects.remove(listener);
 }
 
+static void recordInboundPacketMetrics(const NLPacket& packet) {
+    static const MetricCounter packetsIn { "network.packets_in" };
+    static const MetricCounter bytesIn { "network.bytes_in" };
+    packetsIn.add();
+    bytesIn.add(packet.size());
+}
+
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     // if we're supposed to drop this packet then break out here
     if (_shouldDropPackets) {
@@ -214,6 +223,7 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
 
     _inPacketCount += 1;
     _inByteCount += nlPacket->size();
+    recordInboundPacketMetrics(*nlPacket);
 
     handleVerifiedMessage(receivedMessage, true);
 }
@@ -223,6 +233,7 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     _inPacketCount += 1;
     _inByteCount += nlPacket->size();
+    recordInboundPacketMetrics(*nlPacket);
 
     auto key = std::pair<HifiSockAddr, udt::Packet::MessageNumber>(nlPacket->getSenderSockAddr(), nlPacket->getMessageNumber());
     auto it = _pendingMessages.find(key);
@@ -38,6 +38,7 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _packetType(packet.getType()),
       _packetVersion(packet.getVersion()),
       _senderSockAddr(packet.getSenderSockAddr()),
+      _firstPacketReceiveTime(packet.getReceiveTime()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
 }
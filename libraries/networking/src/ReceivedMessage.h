@@ -43,6 +43,9 @@ public:
     const QUuid& getSourceID() const { return _sourceID; }
     const HifiSockAddr& getSenderSockAddr() { return _senderSockAddr; }
 
+    // when the socket read the first packet of this message, before it waited in any queue
+    p_high_resolution_clock::time_point getFirstPacketReceiveTime() const { return _firstPacketReceiveTime; }
+
     qint64 getPosition() const { return _position; }
 
     // Get the number of packets that were used to send this message
@@ -97,6 +100,7 @@ private:
     PacketType _packetType;
     PacketVersion _packetVersion;
     HifiSockAddr _senderSockAddr;
+    p_high_resolution_clock::time_point _firstPacketReceiveTime;
 
     std::atomic<bool> _isComplete { true };  
     std::atomic<bool> _failed { false };
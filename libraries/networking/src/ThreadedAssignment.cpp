@@ -9,13 +9,21 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <NumericalConstants.h>
+#include <PathUtils.h>
+#include <SharedUtil.h>
+#include <TraceRing.h>
 
 #include "ThreadedAssignment.h"
 
@@ -25,13 +33,16 @@ ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
     _isFinished(false),
     _domainServerTimer(this),
-    _statsTimer(this)
+    _statsTimer(this),
+    _metricsTimer(this)
 {
     static const int STATS_TIMEOUT_MS = 1000;
     _statsTimer.setInterval(STATS_TIMEOUT_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_statsTimer, &QTimer::timeout, this, &ThreadedAssignment::sendStatsPacket);
 
     connect(&_domainServerTimer, &QTimer::timeout, this, &ThreadedAssignment::checkInWithDomainServerOrExit);
+    connect(&_metricsTimer, &QTimer::timeout, this, &ThreadedAssignment::writeMetricsSample);
+    _metricsTimer.setTimerType(Qt::PreciseTimer);
     _domainServerTimer.setInterval(DOMAIN_SERVER_CHECK_IN_MSECS); // 1s, Qt::CoarseTimer acceptable
 
     // if the NL tells us we got a DS response, clear our member variable of queued check-ins
@@ -63,6 +74,7 @@ void ThreadedAssignment::setFinished(bool isFinished) {
             // stop our owned timers
             _domainServerTimer.stop();
             _statsTimer.stop();
+            stopMetricsStream();
 
             // call our virtual aboutToFinish method - this gives the ThreadedAssignment subclass a chance to cleanup
             aboutToFinish();
@@ -75,6 +87,7 @@ void ThreadedAssignment::setFinished(bool isFinished) {
 void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeType) {
     // change the logging target name while the assignment is running
     LogHandler::getInstance().setTargetName(targetName);
+    _targetName = targetName;
 
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->setOwnerType(nodeType);
@@ -88,6 +101,74 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
 
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
+
+    // the metrics stream is configured with the rest of the domain settings, for the assignments that ask for them
+    connect(&nodeList->getDomainHandler(), &DomainHandler::settingsReceived,
+            this, &ThreadedAssignment::parseMetricsSettings);
+}
+
+void ThreadedAssignment::parseMetricsSettings() {
+    static const QString METRICS_SETTINGS_KEY = "metrics";
+    static const QString INTERVAL_KEY = "interval_ms";
+    static const QString DIRECTORY_KEY = "directory";
+    static const QString TRACE_STALLS_KEY = "trace_stalls";
+    static const QString STALL_TRACE_SECONDS_KEY = "stall_trace_seconds";
+    static const int DEFAULT_STALL_TRACE_SECONDS = 5;
+
+    auto& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+    auto metricsObject = domainHandler.getSettingsObject()[METRICS_SETTINGS_KEY].toObject();
+
+    QString directory = metricsObject[DIRECTORY_KEY].toString();
+    if (directory.isEmpty()) {
+        directory = PathUtils::getAppDataFilePath("metrics/");
+    }
+    QString filePrefix = _targetName.toLower().replace(' ', '-');
+
+    // the trace ring records every PROFILE_RANGE, and is written out when the assignment reports a stall
+    auto& traceRing = tracing::TraceRing::getInstance();
+    int stallTraceSeconds = metricsObject[STALL_TRACE_SECONDS_KEY].toInt(DEFAULT_STALL_TRACE_SECONDS);
+    traceRing.setStallTraceOptions(directory, filePrefix, (quint64)std::max(stallTraceSeconds, 1) * USECS_PER_SECOND);
+    traceRing.setEnabled(metricsObject[TRACE_STALLS_KEY].toBool(false));
+
+    int intervalMsecs = metricsObject[INTERVAL_KEY].toInt(0);
+    if (intervalMsecs <= 0) {
+        stopMetricsStream();
+        return;
+    }
+
+    if (!_metricsWriter.isStarted()) {
+        QDir().mkpath(directory);
+
+        QString fileName = QString("%1-%2.%3").arg(filePrefix)
+            .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss")).arg(METRICS_STREAM_EXTENSION);
+        _metricsFile.setFileName(QDir(directory).filePath(fileName));
+
+        if (!_metricsFile.open(QIODevice::WriteOnly)) {
+            qCWarning(networking) << "Could not open" << _metricsFile.fileName() << "to write metrics -"
+                << _metricsFile.errorString();
+            return;
+        }
+
+        qCDebug(networking) << "Writing metrics every" << intervalMsecs << "ms to" << _metricsFile.fileName();
+        _metricsWriter.start(&_metricsFile);
+    }
+
+    _metricsTimer.start(intervalMsecs);
+}
+
+void ThreadedAssignment::writeMetricsSample() {
+    _metricsWriter.writeSample(usecTimestampNow());
+
+    // flush every sample, so that a crashing assignment still leaves its metrics up to the crash behind
+    _metricsFile.flush();
+}
+
+void ThreadedAssignment::stopMetricsStream() {
+    _metricsTimer.stop();
+    if (_metricsWriter.isStarted()) {
+        _metricsWriter.stop();
+        _metricsFile.close();
+    }
 }
 
 void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
@@ -12,8 +12,11 @@
 #ifndef hifi_ThreadedAssignment_h
 #define hifi_ThreadedAssignment_h
 
+#include <QtCore/QFile>
 #include <QtCore/QSharedPointer>
 
+#include <MetricsStream.h>
+
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
@@ -53,6 +56,16 @@ protected slots:
     
 private slots:
     void checkInWithDomainServerOrExit();
+    void parseMetricsSettings();
+    void writeMetricsSample();
+
+private:
+    void stopMetricsStream();
+
+    QString _targetName;
+    QTimer _metricsTimer;
+    QFile _metricsFile;
+    MetricsStreamWriter _metricsWriter;
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
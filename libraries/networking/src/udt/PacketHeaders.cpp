@@ -25,11 +25,14 @@ int packetTypeMetaTypeId = qRegisterMetaType<PacketType>();
 PacketVersion versionForPacketType(PacketType packetType) {
     switch (packetType) {
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::GetMachineFingerprintFromUUIDSupport);
+            return static_cast<PacketVersion>(DomainListVersion::IncrementalLists);
+        case PacketType::DomainListRequest:
+            return static_cast<PacketVersion>(DomainListRequestVersion::AcknowledgesListVersion);
         case PacketType::EntityAdd:
         case PacketType::EntityEdit:
         case PacketType::EntityData:
         case PacketType::EntityPhysics:
+        case PacketType::EntityPhysicsBulk:
             return VERSION_ENTITIES_ANIMATION_ALLOW_TRANSLATION_PROPERTIES;
         case PacketType::EntityQuery:
             return static_cast<PacketVersion>(EntityQueryPacketVersion::JSONFilterWithFamilyTree);
@@ -46,9 +49,11 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetMappingOperationReply:
             return static_cast<PacketVersion>(AssetServerPacketVersion::RedirectedMappings);
         case PacketType::AssetGetInfo:
-        case PacketType::AssetGet:
         case PacketType::AssetUpload:
             return static_cast<PacketVersion>(AssetServerPacketVersion::RangeRequestSupport);
+        case PacketType::AssetGet:
+        case PacketType::AssetGetReply:
+            return static_cast<PacketVersion>(AssetServerPacketVersion::ClampedAssetRanges);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
@@ -123,6 +123,9 @@ public:
         ReplicatedBulkAvatarData,
         OctreeFileReplacementFromUrl,
         ChallengeOwnership,
+        EntityPhysicsBulk,
+        HostedAudioInjector,
+        StopHostedAudioInjector,
         NUM_PACKET_TYPE
     };
 
@@ -276,7 +279,9 @@ enum class EntityQueryPacketVersion: PacketVersion {
 enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
-    RedirectedMappings
+    RedirectedMappings,
+    CompressedAssetReplies,
+    ClampedAssetRanges
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -324,7 +329,13 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    IncrementalLists
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreListAcknowledgement = 17,
+    AcknowledgesListVersion
 };
 
 enum class AudioVersion : PacketVersion {
@@ -13,6 +13,8 @@
 
 #include "../NetworkLogging.h"
 
+#include <cstring>
+
 #include <QDebug>
 
 using namespace udt;
@@ -64,6 +66,19 @@ void PacketList::endSegment() {
     _segmentStartIndex = -1;
 }
 
+size_t PacketList::getNumPackets() const {
+    size_t numPackets = _packets.size() + (_currentPacket ? 1 : 0);
+
+    // count the packets that streamed data still has to be read into
+    qint64 bytesToPack = _streamBytesRemaining - (_currentPacket ? _currentPacket->bytesAvailableForWrite() : 0);
+    if (bytesToPack > 0) {
+        qint64 bytesPerPacket = getMaxSegmentSize() - _extendedHeader.size();
+        numPackets += (size_t)((bytesToPack + bytesPerPacket - 1) / bytesPerPacket);
+    }
+
+    return numPackets;
+}
+
 size_t PacketList::getDataSize() const {
     size_t totalBytes = 0;
     for (const auto& packet : _packets) {
@@ -113,6 +128,11 @@ std::unique_ptr<Packet> PacketList::createPacketWithExtendedHeader() {
 }
 
 void PacketList::closeCurrentPacket(bool shouldSendEmpty) {
+    if (_isStreamed) {
+        // the current packet still has room for the start of the streamed data
+        return;
+    }
+
     if (shouldSendEmpty && !_currentPacket && _packets.empty()) {
         _currentPacket = createPacketWithExtendedHeader();
     }
@@ -158,6 +178,83 @@ void PacketList::preparePackets(MessageNumber messageNumber) {
     }
 }
 
+void PacketList::setStreamSource(std::unique_ptr<QIODevice> source, qint64 size) {
+    Q_ASSERT_X(_isReliable && _isOrdered, "PacketList::setStreamSource", "Only reliable ordered PacketLists can be streamed");
+    Q_ASSERT_X(!_isStreamed, "PacketList::setStreamSource", "PacketList already has a stream source");
+
+    _isStreamed = true;
+    _streamSource = std::move(source);
+    _streamBytesRemaining = size;
+
+    if (!hasStreamedPackets()) {
+        // nothing was written and nothing will be streamed, but the message still needs a packet
+        _currentPacket = createPacketWithExtendedHeader();
+    }
+}
+
+bool PacketList::hasStreamedPackets() const {
+    return !_packets.empty() || _currentPacket || _streamBytesRemaining > 0;
+}
+
+void PacketList::fillStreamedPacket() {
+    if (!_currentPacket) {
+        _currentPacket = createPacketWithExtendedHeader();
+    }
+
+    qint64 numBytes = std::min(_currentPacket->bytesAvailableForWrite(), _streamBytesRemaining);
+    if (numBytes > 0) {
+        // read straight into the packet payload
+        qint64 position = _currentPacket->pos();
+        char* destination = _currentPacket->getPayload() + position;
+        qint64 numBytesRead = std::max(_streamSource->read(destination, numBytes), (qint64)0);
+
+        if (numBytesRead < numBytes) {
+            // the size was promised to the receiver up front, so pad the message out rather than cutting it short
+            qCWarning(networking) << "PacketList could only read" << numBytesRead << "of" << numBytes
+                << "streamed bytes -" << _streamSource->errorString();
+            memset(destination + numBytesRead, 0, numBytes - numBytesRead);
+        }
+
+        _currentPacket->setPayloadSize(position + numBytes);
+        _currentPacket->seek(position + numBytes);
+        _streamBytesRemaining -= numBytes;
+    }
+
+    _packets.push_back(std::move(_currentPacket));
+
+    if (_streamBytesRemaining == 0) {
+        // let go of the source (e.g. close the file) as soon as its last bytes are read
+        _streamSource.reset();
+    }
+}
+
+PacketList::PacketPointer PacketList::takeNextStreamedPacket() {
+    Q_ASSERT(_isStreamed && hasStreamedPackets());
+
+    if (_packets.empty()) {
+        fillStreamedPacket();
+    }
+
+    auto packet = std::move(_packets.front());
+    _packets.pop_front();
+
+    bool isFirst = _nextMessagePartNumber == 0;
+    bool isLast = !hasStreamedPackets();
+    Packet::PacketPosition position;
+    if (isFirst) {
+        position = isLast ? Packet::PacketPosition::ONLY : Packet::PacketPosition::FIRST;
+    } else {
+        position = isLast ? Packet::PacketPosition::LAST : Packet::PacketPosition::MIDDLE;
+    }
+    packet->writeMessageNumber(_messageNumber, position, _nextMessagePartNumber++);
+
+    if (_packetFinisher) {
+        _packetFinisher(*packet);
+    }
+
+    return packet;
+}
+
 const qint64 PACKET_LIST_WRITE_ERROR = -1;
 
 qint64 PacketList::writeString(const QString& string) {
@@ -167,6 +264,8 @@ qint64 PacketList::writeString(const QString& string) {
 }
 
 qint64 PacketList::writeData(const char* data, qint64 maxSize) {
+    Q_ASSERT_X(!_isStreamed, "PacketList::writeData", "Cannot write to a PacketList after its stream source is set");
+
     auto sizeRemaining = maxSize;
 
     while (sizeRemaining > 0) {
@@ -12,6 +12,7 @@
 #ifndef hifi_PacketList_h
 #define hifi_PacketList_h
 
+#include <functional>
 #include <memory>
 
 #include <QtCore/QIODevice>
@@ -30,6 +31,7 @@ class PacketList : public QIODevice {
 public:
     using MessageNumber = uint32_t;
     using PacketPointer = std::unique_ptr<Packet>;
+    using PacketFinisher = std::function<void(Packet&)>;
     
     static std::unique_ptr<PacketList> create(PacketType packetType, QByteArray extendedHeader = QByteArray(),
                                               bool isReliable = false, bool isOrdered = false);
@@ -39,7 +41,7 @@ public:
     bool isReliable() const { return _isReliable; }
     bool isOrdered() const { return _isOrdered; }
     
-    size_t getNumPackets() const { return _packets.size() + (_currentPacket ? 1 : 0); }
+    size_t getNumPackets() const;
     size_t getDataSize() const;
     size_t getMessageSize() const;
     QByteArray getMessage() const;
@@ -55,6 +57,12 @@ public:
     
     void closeCurrentPacket(bool shouldSendEmpty = false);
 
+    // Appends size bytes read from source after everything written so far. The packets carrying them are only filled
+    // once the send queue is ready to send them, so a large message never has to be in memory all at once.
+    // Only for reliable ordered lists, and nothing else may be written afterwards.
+    void setStreamSource(std::unique_ptr<QIODevice> source, qint64 size);
+    bool isStreamed() const { return _isStreamed; }
+
     // QIODevice virtual functions
     virtual bool isSequential() const override { return false; }
     virtual qint64 size() const override { return getDataSize(); }
@@ -91,6 +99,11 @@ private:
     // Takes the first packet of the list and returns it.
     template<typename T> std::unique_ptr<T> takeFront();
     
+    // Streamed lists hand out their packets one at a time, with the message number and position already written
+    bool hasStreamedPackets() const;
+    PacketPointer takeNextStreamedPacket();
+    void fillStreamedPacket();
+
     // Creates a new packet, can be overriden to change return underlying type
     virtual std::unique_ptr<Packet> createPacket();
     std::unique_ptr<Packet> createPacketWithExtendedHeader();
@@ -103,6 +116,12 @@ private:
     int _segmentStartIndex = -1;
     
     QByteArray _extendedHeader;
+
+    bool _isStreamed = false;
+    std::unique_ptr<QIODevice> _streamSource;
+    qint64 _streamBytesRemaining = 0;
+    Packet::MessagePartNumber _nextMessagePartNumber = 0;
+    PacketFinisher _packetFinisher; // applied to streamed packets once they are filled (e.g. to sign them)
 };
 
 template <typename T> qint64 PacketList::readPrimitive(T* data) {
@@ -15,8 +15,29 @@
 
 using namespace udt;
 
+PacketQueue::Channel::~Channel() {
+}
+
+bool PacketQueue::Channel::empty() const {
+    return streamedList ? !nextStreamedPacket && !hasMoreToStream : packets.empty();
+}
+
+bool PacketQueue::Channel::isReady() const {
+    return streamedList ? (bool)nextStreamedPacket : !packets.empty();
+}
+
+PacketQueue::PacketPointer PacketQueue::Channel::take() {
+    if (streamedList) {
+        return std::move(nextStreamedPacket);
+    }
+
+    auto packet = std::move(packets.front());
+    packets.pop_front();
+    return packet;
+}
+
 PacketQueue::PacketQueue() {
-    _channels.emplace_back(new std::list<PacketPointer>());
+    _channels.emplace_back(new Channel());
 }
 
 MessageNumber PacketQueue::getNextMessageNumber() {
@@ -32,27 +53,50 @@ bool PacketQueue::isEmpty() const {
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
-    LockGuard locker(_packetsLock);
-    if (isEmpty()) {
-        return PacketPointer();
-    }
+    PacketPointer packet;
+    ChannelPointer channelToFill;
+    {
+        LockGuard locker(_packetsLock);
+        if (isEmpty()) {
+            return PacketPointer();
+        }
+
+        // Find next channel with a packet ready
+        bool isReady = false;
+        for (size_t i = 0; i < _channels.size() && !isReady; ++i) {
+            isReady = _channels[nextIndex()]->isReady();
+        }
+        if (!isReady) {
+            // only streamed channels are left, and they are still reading their next packet
+            return PacketPointer();
+        }
+        auto& channel = _channels[_currentIndex];
+
+        // Take front packet
+        packet = channel->take();
 
-    // Find next non empty channel
-    if (_channels[nextIndex()]->empty()) {
-        nextIndex();
+        if (channel->streamedList && channel->hasMoreToStream) {
+            // read its next packet once the lock is released, it stays queued until then
+            channelToFill = channel;
+        }
+
+        // Remove now empty channel (Don't remove the main channel)
+        if (channel->empty() && _currentIndex != 0) {
+            channel.swap(_channels.back());
+            _channels.pop_back();
+            --_currentIndex;
+        }
     }
-    auto& channel = _channels[_currentIndex];
-    Q_ASSERT(!channel->empty());
-
-    // Take front packet
-    auto packet = std::move(channel->front());
-    channel->pop_front();
-
-    // Remove now empty channel (Don't remove the main channel)
-    if (channel->empty() && _currentIndex != 0) {
-        channel->swap(*_channels.back());
-        _channels.pop_back();
-        --_currentIndex;
+
+    if (channelToFill) {
+        // The list is only ever read here, on the send queue's thread, or before its channel was queued.
+        // Only one packet is read ahead of what was taken, so the send rate still paces the reads.
+        PacketPointer nextPacket = channelToFill->streamedList->takeNextStreamedPacket();
+        bool hasMore = channelToFill->streamedList->hasStreamedPackets();
+
+        LockGuard locker(_packetsLock);
+        channelToFill->nextStreamedPacket = std::move(nextPacket);
+        channelToFill->hasMoreToStream = hasMore;
     }
 
     return packet;
@@ -65,15 +109,25 @@ unsigned int PacketQueue::nextIndex() {
 
 void PacketQueue::queuePacket(PacketPointer packet) {
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    _channels.front()->packets.push_back(std::move(packet));
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
-    if (packetList->isOrdered()) {
-        packetList->preparePackets(getNextMessageNumber());
+    ChannelPointer channel { new Channel() };
+
+    if (packetList->isStreamed()) {
+        // the packets are numbered as they are filled, the first one now, before anyone else can see the channel
+        packetList->_messageNumber = getNextMessageNumber();
+        channel->streamedList = std::move(packetList);
+        channel->nextStreamedPacket = channel->streamedList->takeNextStreamedPacket();
+        channel->hasMoreToStream = channel->streamedList->hasStreamedPackets();
+    } else {
+        if (packetList->isOrdered()) {
+            packetList->preparePackets(getNextMessageNumber());
+        }
+        channel->packets.swap(packetList->_packets);
     }
 
     LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    _channels.push_back(std::move(channel));
 }
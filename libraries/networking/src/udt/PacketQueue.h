@@ -30,8 +30,23 @@ class PacketQueue {
     using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
-    using Channel = std::unique_ptr<std::list<PacketPointer>>;
-    using Channels = std::vector<Channel>;
+
+    // Either holds packets that are ready to go, or a streamed packet list that fills them one ahead of the taker.
+    // A streamed list is only read outside of the lock, and only the packet read ahead is handed out under it,
+    // so that queueing packets never waits on the source (e.g. a file on disk).
+    struct Channel {
+        ~Channel();
+        bool empty() const;
+        bool isReady() const;
+        PacketPointer take();
+
+        std::list<PacketPointer> packets;
+        PacketListPointer streamedList;
+        PacketPointer nextStreamedPacket;
+        bool hasMoreToStream { false }; // the list still has packets to fill, and will have one ready soon
+    };
+    using ChannelPointer = std::shared_ptr<Channel>;
+    using Channels = std::vector<ChannelPointer>;
     
 public:
     PacketQueue();
@@ -39,6 +54,8 @@ public:
     void queuePacketList(PacketListPointer packetList);
     
     bool isEmpty() const;
+
+    // Only called from the send queue's thread. May read the next packet of a streamed list after taking one.
     PacketPointer takePacket();
     
     Mutex& getLock() { return _packetsLock; }
@@ -0,0 +1,173 @@
+//
+//  ConstraintSolverPool.cpp
+//  libraries/physics/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ConstraintSolverPool.h"
+
+#include <assert.h>
+#include <algorithm>
+
+#include "PhysicsLogging.h"
+
+ConstraintSolverThread::ConstraintSolverThread(ConstraintSolverPool& pool) :
+    _pool(pool),
+    _solver(new btSequentialImpulseConstraintSolver()) {
+}
+
+void ConstraintSolverThread::run() {
+    while (true) {
+        wait();
+
+        _pool.work(*_solver);
+
+        bool stopping = _stop;
+        notify(stopping);
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void ConstraintSolverThread::wait() {
+    Lock lock(_pool._mutex);
+    _pool._threadCondition.wait(lock, [&] {
+        assert(_pool._numStarted <= _pool._numThreads);
+        return _pool._numStarted != _pool._numThreads;
+    });
+    ++_pool._numStarted;
+}
+
+void ConstraintSolverThread::notify(bool stopping) {
+    {
+        Lock lock(_pool._mutex);
+        assert(_pool._numFinished < _pool._numThreads);
+        ++_pool._numFinished;
+        if (stopping) {
+            ++_pool._numStopped;
+        }
+    }
+    _pool._poolCondition.notify_one();
+}
+
+void ConstraintSolverPool::work(btConstraintSolver& solver) {
+    if (!_job) {
+        return;
+    }
+    int jobIndex = _nextJob++;
+    while (jobIndex < _numJobs) {
+        (*_job)(solver, jobIndex);
+        jobIndex = _nextJob++;
+    }
+}
+
+void ConstraintSolverPool::run(int numJobs, btConstraintSolver& callerSolver, const Job& job) {
+    _job = &job;
+    _numJobs = numJobs;
+    _nextJob = 0;
+
+    if (_numThreads == 0) {
+        work(callerSolver);
+        _job = nullptr;
+        return;
+    }
+
+    {
+        Lock lock(_mutex);
+        _numStarted = _numFinished = 0;
+    }
+    _threadCondition.notify_all();
+
+    // the calling thread pulls jobs too
+    work(callerSolver);
+
+    {
+        Lock lock(_mutex);
+        _poolCondition.wait(lock, [&] {
+            assert(_numFinished <= _numThreads);
+            return _numFinished == _numThreads;
+        });
+        assert(_numStarted == _numThreads);
+    }
+    _job = nullptr;
+}
+
+void ConstraintSolverPool::setNumThreads(int numThreads) {
+    // clamp to allowed size
+    {
+        int maxThreads = QThread::idealThreadCount();
+        if (maxThreads == -1) {
+            // idealThreadCount returns -1 if cores cannot be detected
+            static const int MAX_THREADS_IF_UNKNOWN = 4;
+            maxThreads = MAX_THREADS_IF_UNKNOWN;
+        }
+        // the calling thread also does work so we never need more than maxThreads - 1 helpers
+        int clampedThreads = std::min(std::max(0, numThreads), std::max(0, maxThreads - 1));
+        if (clampedThreads != numThreads) {
+            qCWarning(physics, "%s: clamped to %d (was %d)", __FUNCTION__, clampedThreads, numThreads);
+            numThreads = clampedThreads;
+        }
+    }
+
+    resize(numThreads);
+}
+
+void ConstraintSolverPool::resize(int numThreads) {
+    assert(_numThreads == (int)_threads.size());
+    if (numThreads == _numThreads) {
+        return;
+    }
+    qCDebug(physics, "%s: set %d threads (was %d)", __FUNCTION__, numThreads, _numThreads);
+
+    Lock lock(_mutex);
+
+    if (numThreads > _numThreads) {
+        // start new threads
+        // (new threads see _numStarted == _numThreads and wait for the next run)
+        for (int i = 0; i < numThreads - _numThreads; ++i) {
+            auto thread = new ConstraintSolverThread(*this);
+            thread->start();
+            _threads.emplace_back(thread);
+        }
+    } else {
+        auto extraBegin = _threads.begin() + numThreads;
+
+        // mark threads to stop...
+        auto thread = extraBegin;
+        while (thread != _threads.end()) {
+            (*thread)->_stop = true;
+            ++thread;
+        }
+
+        // ...cycle them until they do stop...
+        _numStopped = 0;
+        while (_numStopped != (_numThreads - numThreads)) {
+            _numStarted = _numFinished = _numStopped;
+            _threadCondition.notify_all();
+            _poolCondition.wait(lock, [&] {
+                assert(_numFinished <= _numThreads);
+                return _numFinished == _numThreads;
+            });
+        }
+
+        // ...wait for threads to finish...
+        thread = extraBegin;
+        while (thread != _threads.end()) {
+            static const int MAX_THREAD_WAIT_TIME = 10;
+            (*thread)->QThread::wait(MAX_THREAD_WAIT_TIME);
+            ++thread;
+        }
+
+        // ...and erase them
+        _threads.erase(extraBegin, _threads.end());
+    }
+
+    _numThreads = _numStarted = _numFinished = numThreads;
+    assert(_numThreads == (int)_threads.size());
+}
@@ -0,0 +1,95 @@
+//
+//  ConstraintSolverPool.h
+//  libraries/physics/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ConstraintSolverPool_h
+#define hifi_ConstraintSolverPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QThread>
+
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolver.h>
+
+class ConstraintSolverPool;
+
+// a worker thread with its own constraint solver (btSequentialImpulseConstraintSolver keeps per-solve state)
+class ConstraintSolverThread : public QThread {
+    Q_OBJECT
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+public:
+    ConstraintSolverThread(ConstraintSolverPool& pool);
+
+    void run() override final;
+
+private:
+    friend class ConstraintSolverPool;
+
+    void wait();
+    void notify(bool stopping);
+
+    ConstraintSolverPool& _pool;
+    std::unique_ptr<btSequentialImpulseConstraintSolver> _solver;
+    bool _stop { false };
+};
+
+// Pool of threads for solving independent batches of simulation islands.
+//   ConstraintSolverPool is not thread-safe! It should be instantiated and used from a single thread.
+//   The calling thread participates in the work using the solver it passes to run().
+class ConstraintSolverPool {
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ConditionVariable = std::condition_variable;
+
+public:
+    using Job = std::function<void(btConstraintSolver& solver, int jobIndex)>;
+
+    ConstraintSolverPool(int numThreads = 0) { setNumThreads(numThreads); }
+    ~ConstraintSolverPool() { resize(0); }
+
+    // run job for each index in [0, numJobs) and block until all are complete
+    void run(int numJobs, btConstraintSolver& callerSolver, const Job& job);
+
+    void setNumThreads(int numThreads);
+    int numThreads() const { return _numThreads; }
+
+private:
+    void resize(int numThreads);
+    void work(btConstraintSolver& solver);
+
+    std::vector<std::unique_ptr<ConstraintSolverThread>> _threads;
+
+    friend void ConstraintSolverThread::run();
+    friend void ConstraintSolverThread::wait();
+    friend void ConstraintSolverThread::notify(bool stopping);
+
+    // synchronization state
+    Mutex _mutex;
+    ConditionVariable _threadCondition;
+    ConditionVariable _poolCondition;
+    int _numThreads { 0 };
+    int _numStarted { 0 }; // guarded by _mutex
+    int _numFinished { 0 }; // guarded by _mutex
+    int _numStopped { 0 }; // guarded by _mutex
+
+    // job state
+    const Job* _job { nullptr };
+    int _numJobs { 0 };
+    std::atomic<int> _nextJob { 0 };
+};
+
+#endif // hifi_ConstraintSolverPool_h
@@ -316,6 +316,9 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
                 ++stateItr;
             }
         }
+
+        // pack this step's transform updates together rather than sending one edit per entity
+        _entityPacketSender->releaseQueuedPhysicsUpdates();
     }
 }
 
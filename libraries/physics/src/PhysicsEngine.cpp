@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <QThread>
+
 #include <PhysicsCollisionGroups.h>
 
 #include <PerfStat.h>
@@ -58,9 +60,29 @@ void PhysicsEngine::init() {
         // in order for its broadphase collision queries to work correctly. Look at how we use
         // _activeStaticBodies to track and update the Aabb's of moved static objects.
         _dynamicsWorld->setForceUpdateAllAabbs(false);
+
+        // Islands are solved in parallel only when Bullet's profiler and solver are thread-safe.
+        // We leave a couple of cores for the main and render threads.
+        if (ThreadSafeDynamicsWorld::canSolveIslandsInParallel()) {
+            const int MAX_NUM_SOLVER_THREADS = 3;
+            const int NUM_RESERVED_THREADS = 2;
+            int numThreads = std::min(QThread::idealThreadCount() - NUM_RESERVED_THREADS, MAX_NUM_SOLVER_THREADS);
+            if (numThreads > 0) {
+                _dynamicsWorld->setNumSolverThreads(numThreads);
+            }
+        }
     }
 }
 
+void PhysicsEngine::setNumSolverThreads(int numThreads) {
+    assert(_dynamicsWorld);
+    _dynamicsWorld->setNumSolverThreads(numThreads);
+}
+
+int PhysicsEngine::getNumSolverThreads() const {
+    return _dynamicsWorld ? _dynamicsWorld->getNumSolverThreads() : -1;
+}
+
 uint32_t PhysicsEngine::getNumSubsteps() {
     return _numSubsteps;
 }
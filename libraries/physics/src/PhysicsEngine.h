@@ -84,6 +84,10 @@ public:
 
     void setCharacterController(CharacterController* character);
 
+    /// \param numThreads number of helper threads for solving simulation islands (negative = serial Bullet solver)
+    void setNumSolverThreads(int numThreads);
+    int getNumSolverThreads() const;
+
     void dumpNextStats() { _dumpNextStats = true; }
 
     EntityDynamicPointer getDynamicByID(const QUuid& dynamicID) const;
@@ -0,0 +1,90 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShapeCache.h"
+
+#include <QCryptographicHash>
+#include <QFile>
+
+#include "PhysicsLogging.h"
+#include "ShapeFactory.h"
+
+using File = cache::File;
+
+const int ShapeCache::CURRENT_VERSION = 0x01;
+const std::string ShapeCache::DIRNAME { "shape_cache" };
+const std::string ShapeCache::EXT { "shape" };
+
+ShapeCache::ShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+bool ShapeCache::shouldCache(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND:
+        case SHAPE_TYPE_STATIC_MESH:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ShapeCache::Key ShapeCache::computeKey(const ShapeInfo& info) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    int32_t header[] = { CURRENT_VERSION, info.getType() };
+    hash.addData(reinterpret_cast<const char*>(header), sizeof(header));
+    hash.addData(reinterpret_cast<const char*>(&info.getHalfExtents()), sizeof(glm::vec3));
+    hash.addData(reinterpret_cast<const char*>(&info.getOffset()), sizeof(glm::vec3));
+    for (const auto& points : info.getPointCollection()) {
+        int32_t numPoints = points.size();
+        hash.addData(reinterpret_cast<const char*>(&numPoints), sizeof(numPoints));
+        hash.addData(reinterpret_cast<const char*>(points.constData()), numPoints * sizeof(glm::vec3));
+    }
+    const ShapeInfo::TriangleIndices& indices = info.getTriangleIndices();
+    hash.addData(reinterpret_cast<const char*>(indices.constData()), indices.size() * sizeof(int32_t));
+    return hash.result().toHex().toStdString();
+}
+
+const btCollisionShape* ShapeCache::readShape(const ShapeInfo& info) {
+    auto file = getFile(computeKey(info));
+    if (!file) {
+        ++_numMisses;
+        return nullptr;
+    }
+
+    QFile shapeFile(QString::fromStdString(file->getFilepath()));
+    if (!shapeFile.open(QFile::ReadOnly)) {
+        ++_numMisses;
+        return nullptr;
+    }
+    const btCollisionShape* shape = ShapeFactory::deserializeShape(shapeFile.readAll());
+    if (shape) {
+        ++_numHits;
+    } else {
+        ++_numMisses;
+        qCWarning(physics) << "ShapeCache: discarding unreadable entry" << file->getKey().c_str();
+    }
+    return shape;
+}
+
+void ShapeCache::writeShape(const ShapeInfo& info, const btCollisionShape* shape) {
+    QByteArray data;
+    if (ShapeFactory::serializeShape(shape, data)) {
+        // overwrite so that an unreadable entry gets replaced
+        writeFile(data.constData(), Metadata(computeKey(info), data.size()), true);
+    }
+}
+
+std::unique_ptr<File> ShapeCache::createFile(Metadata&& metadata, const std::string& filepath) {
+    qCDebug(physics) << "Wrote shape" << metadata.key.c_str();
+    return FileCache::createFile(std::move(metadata), filepath);
+}
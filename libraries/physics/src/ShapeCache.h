@@ -0,0 +1,58 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShapeCache_h
+#define hifi_ShapeCache_h
+
+#include <atomic>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <shared/FileCache.h>
+#include <ShapeInfo.h>
+
+// Disk-backed cache of the Bullet shapes that are expensive to build (convex hulls, compounds of hulls,
+// and static meshes with their optimized BVH) so they survive across sessions.
+// Entries are keyed by a hash of the ShapeInfo content rather than its DoubleHashKey.
+class ShapeCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    // Whenever a change is made to the serialized format for the shape cache that isn't backward compatible,
+    // this value should be incremented.  Old entries will no longer be found and will age out of the cache.
+    static const int CURRENT_VERSION;
+    static const std::string DIRNAME;
+    static const std::string EXT;
+
+    ShapeCache(const std::string& dir = DIRNAME, const std::string& ext = EXT);
+
+    /// \return true if shapes of this info are worth persisting
+    static bool shouldCache(const ShapeInfo& info);
+    static Key computeKey(const ShapeInfo& info);
+
+    /// \return new shape restored from disk, or nullptr if there is no valid entry for info
+    const btCollisionShape* readShape(const ShapeInfo& info);
+    void writeShape(const ShapeInfo& info, const btCollisionShape* shape);
+
+    int getNumHits() const { return _numHits; }
+    int getNumMisses() const { return _numMisses; }
+
+protected:
+    std::unique_ptr<cache::File> createFile(Metadata&& metadata, const std::string& filepath) override final;
+
+private:
+    std::atomic<int> _numHits { 0 };
+    std::atomic<int> _numMisses { 0 };
+};
+
+using ShapeCachePointer = std::shared_ptr<ShapeCache>;
+
+#endif // hifi_ShapeCache_h
@@ -11,6 +11,8 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include <QDataStream>
+
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "ShapeFactory.h"
@@ -448,13 +450,271 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+// serialized node types
+enum SerializedShapeType : int32_t {
+    SERIALIZED_HULL = 0,
+    SERIALIZED_COMPOUND,
+    SERIALIZED_STATIC_MESH
+};
+
+const int32_t VERTICES_PER_TRIANGLE = 3;
+const int32_t MAX_SERIALIZED_COMPOUND_DEPTH = 2; // compound of hulls, possibly wrapped in an offset compound
+
+// util method
+static bool serializeNode(const btCollisionShape* shape, QDataStream& stream, int32_t depth) {
+    switch (shape->getShapeType()) {
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+            int32_t numPoints = hull->getNumPoints();
+            stream << (int32_t)SERIALIZED_HULL << (float)hull->getMargin() << numPoints;
+            const btVector3* points = hull->getUnscaledPoints();
+            for (int32_t i = 0; i < numPoints; ++i) {
+                stream << (float)points[i].getX() << (float)points[i].getY() << (float)points[i].getZ();
+            }
+        }
+        break;
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            if (depth >= MAX_SERIALIZED_COMPOUND_DEPTH) {
+                return false;
+            }
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            int32_t numChildren = compound->getNumChildShapes();
+            stream << (int32_t)SERIALIZED_COMPOUND << numChildren;
+            for (int32_t i = 0; i < numChildren; ++i) {
+                const btTransform& transform = compound->getChildTransform(i);
+                btVector3 origin = transform.getOrigin();
+                btQuaternion rotation = transform.getRotation();
+                stream << (float)origin.getX() << (float)origin.getY() << (float)origin.getZ();
+                stream << (float)rotation.getX() << (float)rotation.getY() << (float)rotation.getZ() << (float)rotation.getW();
+                if (!serializeNode(compound->getChildShape(i), stream, depth + 1)) {
+                    return false;
+                }
+            }
+        }
+        break;
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            // the ShapeFactory only creates StaticMeshShapes of this type
+            // (btBvhTriangleMeshShape::getOptimizedBvh() is not const but we only read from it)
+            auto meshShape = static_cast<ShapeFactory::StaticMeshShape*>(const_cast<btCollisionShape*>(shape));
+            const btOptimizedBvh* bvh = meshShape->getOptimizedBvh();
+            const IndexedMeshArray& meshes = meshShape->getDataArray()->getIndexedMeshArray();
+            if (!bvh || meshes.size() != 1 || meshes[0].m_vertexType != PHY_FLOAT) {
+                return false;
+            }
+            const btIndexedMesh& mesh = meshes[0];
+            stream << (int32_t)SERIALIZED_STATIC_MESH << (int32_t)mesh.m_indexType
+                << (int32_t)mesh.m_numTriangles << (int32_t)mesh.m_numVertices;
+            stream.writeRawData(reinterpret_cast<const char*>(mesh.m_vertexBase), mesh.m_numVertices * mesh.m_vertexStride);
+            stream.writeRawData(reinterpret_cast<const char*>(mesh.m_triangleIndexBase),
+                    mesh.m_numTriangles * mesh.m_triangleIndexStride);
+
+            // btQuantizedBvh::serializeInPlace() requires a 16-byte aligned buffer
+            uint32_t bvhSize = bvh->calculateSerializeBufferSize();
+            void* bvhBuffer = btAlignedAlloc(bvhSize, 16);
+            bool success = bvh->serializeInPlace(bvhBuffer, bvhSize, false);
+            if (success) {
+                stream << bvhSize;
+                stream.writeRawData(reinterpret_cast<const char*>(bvhBuffer), bvhSize);
+            }
+            btAlignedFree(bvhBuffer);
+            return success;
+        }
+        break;
+        default:
+            // other shapes are cheap to build and not worth serializing
+            return false;
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+// whether count items of itemSize bytes are left to read, checked before a count read from a possibly corrupt
+// cache file sizes an allocation or a loop
+static bool canRead(QDataStream& stream, int64_t count, int64_t itemSize) {
+    return stream.status() == QDataStream::Ok && count >= 0 && count * itemSize <= stream.device()->bytesAvailable();
+}
+
+template <typename T>
+static bool indicesAreValid(const unsigned char* indexBase, int32_t numIndices, int32_t numVertices) {
+    const T* indices = reinterpret_cast<const T*>(indexBase);
+    for (int32_t i = 0; i < numIndices; ++i) {
+        if ((int64_t)indices[i] < 0 || (int64_t)indices[i] >= numVertices) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// util method
+static btCollisionShape* deserializeNode(QDataStream& stream, int32_t depth) {
+    int32_t type;
+    stream >> type;
+    if (stream.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+
+    switch (type) {
+        case SERIALIZED_HULL: {
+            float margin;
+            int32_t numPoints;
+            stream >> margin >> numPoints;
+            const int64_t POINT_SIZE = 3 * sizeof(float);
+            if (numPoints <= 0 || numPoints > MAX_HULL_POINTS || !canRead(stream, numPoints, POINT_SIZE)) {
+                return nullptr;
+            }
+            btConvexHullShape* hull = new btConvexHullShape();
+            hull->setMargin(margin);
+            for (int32_t i = 0; i < numPoints; ++i) {
+                float x, y, z;
+                stream >> x >> y >> z;
+                hull->addPoint(btVector3(x, y, z), false);
+            }
+            if (stream.status() != QDataStream::Ok) {
+                delete hull;
+                return nullptr;
+            }
+            hull->recalcLocalAabb();
+            return hull;
+        }
+        case SERIALIZED_COMPOUND: {
+            int32_t numChildren;
+            stream >> numChildren;
+            // each child is at least a transform and the type of its shape
+            const int64_t MIN_CHILD_SIZE = 7 * sizeof(float) + sizeof(int32_t);
+            if (depth >= MAX_SERIALIZED_COMPOUND_DEPTH || numChildren <= 0 || !canRead(stream, numChildren, MIN_CHILD_SIZE)) {
+                return nullptr;
+            }
+            btCompoundShape* compound = new btCompoundShape();
+            for (int32_t i = 0; i < numChildren; ++i) {
+                float x, y, z, w;
+                btTransform transform;
+                stream >> x >> y >> z;
+                transform.setOrigin(btVector3(x, y, z));
+                stream >> x >> y >> z >> w;
+                transform.setRotation(btQuaternion(x, y, z, w));
+                btCollisionShape* child = deserializeNode(stream, depth + 1);
+                if (!child) {
+                    ShapeFactory::deleteShape(compound);
+                    return nullptr;
+                }
+                compound->addChildShape(transform, child);
+            }
+            compound->recalculateLocalAabb();
+            return compound;
+        }
+        case SERIALIZED_STATIC_MESH: {
+            int32_t indexType, numTriangles, numVertices;
+            stream >> indexType >> numTriangles >> numVertices;
+            if (stream.status() != QDataStream::Ok || numTriangles <= 0 || numVertices < VERTICES_PER_TRIANGLE ||
+                    (indexType != PHY_SHORT && indexType != PHY_INTEGER)) {
+                return nullptr;
+            }
+            size_t indexSize = (indexType == PHY_SHORT) ? sizeof(int16_t) : sizeof(int32_t);
+            int64_t vertexBytes = (int64_t)numVertices * VERTICES_PER_TRIANGLE * sizeof(btScalar);
+            int64_t indexBytes = (int64_t)numTriangles * VERTICES_PER_TRIANGLE * indexSize;
+            if (!canRead(stream, vertexBytes + indexBytes + sizeof(uint32_t), 1)) {
+                return nullptr;
+            }
+
+            btIndexedMesh mesh;
+            mesh.m_numTriangles = numTriangles;
+            mesh.m_indexType = (PHY_ScalarType)indexType;
+            mesh.m_triangleIndexStride = VERTICES_PER_TRIANGLE * (int)indexSize;
+            mesh.m_numVertices = numVertices;
+            mesh.m_vertexStride = VERTICES_PER_TRIANGLE * sizeof(btScalar);
+            mesh.m_vertexType = PHY_FLOAT;
+
+            unsigned char* vertexBase = new unsigned char[vertexBytes];
+            unsigned char* indexBase = new unsigned char[indexBytes];
+            bool valid = stream.readRawData(reinterpret_cast<char*>(vertexBase), (int)vertexBytes) == vertexBytes &&
+                stream.readRawData(reinterpret_cast<char*>(indexBase), (int)indexBytes) == indexBytes;
+
+            // an index past the vertices would have bullet read out of bounds
+            int32_t numIndices = numTriangles * VERTICES_PER_TRIANGLE;
+            if (valid) {
+                valid = (indexType == PHY_SHORT) ? indicesAreValid<uint16_t>(indexBase, numIndices, numVertices) :
+                    indicesAreValid<int32_t>(indexBase, numIndices, numVertices);
+            }
+            mesh.m_vertexBase = vertexBase;
+            mesh.m_triangleIndexBase = indexBase;
+
+            uint32_t bvhSize = 0;
+            stream >> bvhSize;
+            void* bvhBuffer = nullptr;
+            if (valid && canRead(stream, bvhSize, 1) && bvhSize > 0) {
+                bvhBuffer = btAlignedAlloc(bvhSize, 16);
+                if (stream.readRawData(reinterpret_cast<char*>(bvhBuffer), bvhSize) != (int)bvhSize) {
+                    btAlignedFree(bvhBuffer);
+                    bvhBuffer = nullptr;
+                }
+            }
+            if (!bvhBuffer) {
+                delete[] vertexBase;
+                delete[] indexBase;
+                return nullptr;
+            }
+
+            btTriangleIndexVertexArray* dataArray = new btTriangleIndexVertexArray;
+            dataArray->addIndexedMesh(mesh, mesh.m_indexType);
+            return new ShapeFactory::StaticMeshShape(dataArray, bvhBuffer, bvhSize);
+        }
+        default:
+            return nullptr;
+    }
+}
+
+bool ShapeFactory::serializeShape(const btCollisionShape* shape, QByteArray& data) {
+    assert(shape);
+    data.clear();
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    if (!serializeNode(shape, stream, 0)) {
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+const btCollisionShape* ShapeFactory::deserializeShape(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    btCollisionShape* shape = deserializeNode(stream, 0);
+    if (shape && !stream.atEnd()) {
+        // trailing garbage means the data is not what we think it is
+        deleteShape(shape);
+        shape = nullptr;
+    }
+    return shape;
+}
+
 // the dataArray must be created before we create the StaticMeshShape
 ShapeFactory::StaticMeshShape::StaticMeshShape(btTriangleIndexVertexArray* dataArray)
 :   btBvhTriangleMeshShape(dataArray, true), _dataArray(dataArray) {
     assert(dataArray);
 }
 
+ShapeFactory::StaticMeshShape::StaticMeshShape(btTriangleIndexVertexArray* dataArray, void* bvhBuffer, uint32_t bvhBufferSize)
+:   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+    assert(dataArray);
+    assert(bvhBuffer);
+    // the deserialized BVH lives inside bvhBuffer and points into it
+    btQuantizedBvh* bvh = btQuantizedBvh::deSerializeInPlace(_bvhBuffer, bvhBufferSize, false);
+    if (bvh) {
+        setOptimizedBvh(static_cast<btOptimizedBvh*>(bvh));
+    } else {
+        btAlignedFree(_bvhBuffer);
+        _bvhBuffer = nullptr;
+        buildOptimizedBvh();
+    }
+}
+
 ShapeFactory::StaticMeshShape::~StaticMeshShape() {
     deleteStaticMeshArray(_dataArray);
     _dataArray = nullptr;
+    if (_bvhBuffer) {
+        // the BVH was not allocated separately (btBvhTriangleMeshShape does not own it) so freeing the buffer is enough
+        btAlignedFree(_bvhBuffer);
+        _bvhBuffer = nullptr;
+    }
 }
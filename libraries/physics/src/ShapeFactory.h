@@ -15,6 +15,8 @@
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
 
+#include <QByteArray>
+
 #include <ShapeInfo.h>
 
 // translates between ShapeInfo and btShape
@@ -23,6 +25,11 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
+    // convex hulls, compounds of them and static meshes (with their optimized BVH) can be serialized
+    // so that expensive shapes can be restored without being rebuilt from their ShapeInfo
+    bool serializeShape(const btCollisionShape* shape, QByteArray& data);
+    const btCollisionShape* deserializeShape(const QByteArray& data);
+
     //btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info);
     //void deleteStaticMeshArray(btTriangleIndexVertexArray* dataArray);
 
@@ -30,11 +37,17 @@ namespace ShapeFactory {
     public:
         StaticMeshShape() = delete;
         StaticMeshShape(btTriangleIndexVertexArray* dataArray);
+        // restores a BVH that was serialized by btQuantizedBvh::serializeInPlace() rather than building it
+        // (the StaticMeshShape takes ownership of bvhBuffer, which must be allocated with btAlignedAlloc)
+        StaticMeshShape(btTriangleIndexVertexArray* dataArray, void* bvhBuffer, uint32_t bvhBufferSize);
         ~StaticMeshShape();
 
+        const btTriangleIndexVertexArray* getDataArray() const { return _dataArray; }
+
     private:
         // the StaticMeshShape owns its vertex/index data
         btTriangleIndexVertexArray* _dataArray;
+        void* _bvhBuffer { nullptr };
     };
 };
 
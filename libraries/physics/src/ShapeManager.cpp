@@ -38,7 +38,17 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         shapeRef->refCount++;
         return shapeRef->shape;
     }
-    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    const btCollisionShape* shape = nullptr;
+    bool useCache = _shapeCache && ShapeCache::shouldCache(info);
+    if (useCache) {
+        shape = _shapeCache->readShape(info);
+    }
+    if (!shape) {
+        shape = ShapeFactory::createShapeFromInfo(info);
+        if (shape && useCache) {
+            _shapeCache->writeShape(info, shape);
+        }
+    }
     if (shape) {
         ShapeReference newRef;
         newRef.refCount = 1;
@@ -18,6 +18,7 @@
 #include <ShapeInfo.h>
 
 #include "DoubleHashKey.h"
+#include "ShapeCache.h"
 
 class ShapeManager {
 public:
@@ -34,6 +35,10 @@ public:
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// expensive shapes will be restored from (and saved to) cache when it is set
+    void setShapeCache(const ShapeCachePointer& cache) { _shapeCache = cache; }
+    const ShapeCachePointer& getShapeCache() const { return _shapeCache; }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
     int getNumReferences(const ShapeInfo& info) const;
@@ -53,6 +58,7 @@ private:
 
     btHashMap<DoubleHashKey, ShapeReference> _shapeMap;
     btAlignedObjectArray<DoubleHashKey> _pendingGarbage;
+    ShapeCachePointer _shapeCache;
 };
 
 #endif // hifi_ShapeManager_h
@@ -15,10 +15,79 @@
  * Copied and modified from btDiscreteDynamicsWorld.cpp by AndrewMeadows on 2014.11.12.
  * */
 
+#include <algorithm>
+#include <unordered_map>
+
 #include <LinearMath/btQuickprof.h>
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
 
+#include "ConstraintSolverPool.h"
+#include "PhysicsLogging.h"
 #include "ThreadSafeDynamicsWorld.h"
 
+// BT_PROFILE is sprinkled throughout the constraint solver and Bullet's profiler is only safe
+// to use from several threads when Bullet has been built with BT_THREADSAFE.
+#if defined(BT_THREADSAFE) && BT_THREADSAFE
+static const bool BULLET_IS_THREADSAFE = true;
+#else
+static const bool BULLET_IS_THREADSAFE = false;
+#endif
+
+// same as btGetConstraintIslandId() in btDiscreteDynamicsWorld.cpp
+static int getConstraintIslandId(const btTypedConstraint* constraint) {
+    const btCollisionObject& objectA = constraint->getRigidBodyA();
+    const btCollisionObject& objectB = constraint->getRigidBodyB();
+    return objectA.getIslandTag() >= 0 ? objectA.getIslandTag() : objectB.getIslandTag();
+}
+
+// same as btSortConstraintOnIslandPredicate in btDiscreteDynamicsWorld.cpp
+class SortConstraintOnIslandPredicate {
+public:
+    bool operator() (const btTypedConstraint* lhs, const btTypedConstraint* rhs) const {
+        return getConstraintIslandId(lhs) < getConstraintIslandId(rhs);
+    }
+};
+
+// copies each awake island out of the btSimulationIslandManager so it can be solved later
+class IslandGatherCallback : public btSimulationIslandManager::IslandCallback {
+public:
+    IslandGatherCallback(ThreadSafeDynamicsWorld& world, btTypedConstraint** constraints, int numConstraints) :
+        _world(world), _constraints(constraints), _numConstraints(numConstraints) { }
+
+    virtual void processIsland(btCollisionObject** bodies, int numBodies,
+                               btPersistentManifold** manifolds, int numManifolds, int islandId) override {
+        if ((int)_world._islands.size() == _world._numIslands) {
+            _world._islands.emplace_back();
+        }
+        ThreadSafeDynamicsWorld::IslandBatch& island = _world._islands[_world._numIslands++];
+        island.clear();
+        island.bodies.assign(bodies, bodies + numBodies);
+        island.manifolds.assign(manifolds, manifolds + numManifolds);
+
+        btTypedConstraint** constraintsEnd = _constraints + _numConstraints;
+        if (islandId < 0) {
+            // islands are not split: everything arrives in one call
+            island.constraints.assign(_constraints, constraintsEnd);
+        } else {
+            // constraints are sorted by islandId
+            btTypedConstraint** begin = std::lower_bound(_constraints, constraintsEnd, islandId,
+                [](const btTypedConstraint* constraint, int id) {
+                    return getConstraintIslandId(constraint) < id;
+                });
+            btTypedConstraint** end = begin;
+            while (end != constraintsEnd && getConstraintIslandId(*end) == islandId) {
+                ++end;
+            }
+            island.constraints.assign(begin, end);
+        }
+    }
+
+private:
+    ThreadSafeDynamicsWorld& _world;
+    btTypedConstraint** _constraints;
+    int _numConstraints;
+};
+
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
@@ -27,6 +96,35 @@ ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
     :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
 }
 
+ThreadSafeDynamicsWorld::~ThreadSafeDynamicsWorld() {
+    // stop worker threads before the rest of the world is torn down
+    _solverPool.reset();
+}
+
+bool ThreadSafeDynamicsWorld::canSolveIslandsInParallel() {
+    return BULLET_IS_THREADSAFE;
+}
+
+void ThreadSafeDynamicsWorld::setNumSolverThreads(int numThreads) {
+    if (numThreads < 0) {
+        _solverPool.reset();
+        return;
+    }
+    if (numThreads > 0 && !BULLET_IS_THREADSAFE) {
+        qCWarning(physics) << "Bullet was not built with BT_THREADSAFE: simulation islands will be solved on one thread";
+        numThreads = 0;
+    }
+    if (_solverPool) {
+        _solverPool->setNumThreads(numThreads);
+    } else {
+        _solverPool.reset(new ConstraintSolverPool(numThreads));
+    }
+}
+
+int ThreadSafeDynamicsWorld::getNumSolverThreads() const {
+    return _solverPool ? _solverPool->numThreads() : -1;
+}
+
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
                                                                btScalar fixedTimeStep, SubStepCallback onSubStep) {
     BT_PROFILE("stepSimulationWithSubstepCallback");
@@ -90,6 +188,126 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
     return subSteps;
 }
 
+void ThreadSafeDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo) {
+    if (!_solverPool || !m_islandManager->getSplitIslands()) {
+        btDiscreteDynamicsWorld::solveConstraints(solverInfo);
+        return;
+    }
+    BT_PROFILE("solveConstraints");
+
+    // NOTE: this follows btDiscreteDynamicsWorld::solveConstraints() except islands are collected
+    // into independent batches first and then the batches are solved on _solverPool
+    int numConstraints = getNumConstraints();
+    m_sortedConstraints.resize(numConstraints);
+    for (int i = 0; i < numConstraints; ++i) {
+        m_sortedConstraints[i] = m_constraints[i];
+    }
+    m_sortedConstraints.quickSort(SortConstraintOnIslandPredicate());
+    btTypedConstraint** constraints = numConstraints ? &m_sortedConstraints[0] : nullptr;
+
+    m_constraintSolver->prepareSolve(getCollisionWorld()->getNumCollisionObjects(),
+                                     getCollisionWorld()->getDispatcher()->getNumManifolds());
+
+    {
+        BT_PROFILE("gatherIslands");
+        _numIslands = 0;
+        IslandGatherCallback gatherCallback(*this, constraints, numConstraints);
+        m_islandManager->buildAndProcessIslands(getCollisionWorld()->getDispatcher(), getCollisionWorld(), &gatherCallback);
+        buildIslandBatches(solverInfo);
+    }
+
+    {
+        BT_PROFILE("solveIslandBatches");
+        btIDebugDraw* debugDrawer = getDebugDrawer();
+        btDispatcher* dispatcher = getDispatcher();
+        ConstraintSolverPool::Job solveBatch = [&](btConstraintSolver& solver, int batchIndex) {
+            IslandBatch& batch = _islandBatches[batchIndex];
+            solver.solveGroup(batch.bodies.data(), (int)batch.bodies.size(),
+                              batch.manifolds.data(), (int)batch.manifolds.size(),
+                              batch.constraints.data(), (int)batch.constraints.size(),
+                              solverInfo, debugDrawer, dispatcher);
+        };
+        _solverPool->run(_numIslandBatches, *m_constraintSolver, solveBatch);
+    }
+
+    m_constraintSolver->allSolved(solverInfo, m_debugDrawer);
+}
+
+void ThreadSafeDynamicsWorld::buildIslandBatches(const btContactSolverInfo& solverInfo) {
+    // Kinematic objects don't belong to any island, however the solver writes to their companionId
+    // so islands that touch the same kinematic object must be solved in the same batch.
+    std::vector<int> roots(_numIslands);
+    for (int i = 0; i < _numIslands; ++i) {
+        roots[i] = i;
+    }
+    auto findRoot = [&](int i) {
+        while (roots[i] != i) {
+            roots[i] = roots[roots[i]];
+            i = roots[i];
+        }
+        return i;
+    };
+    std::unordered_map<const btCollisionObject*, int> kinematicIslands;
+    auto shareKinematicObject = [&](const btCollisionObject* object, int islandIndex) {
+        if (object->isKinematicObject()) {
+            auto itr = kinematicIslands.find(object);
+            if (itr == kinematicIslands.end()) {
+                kinematicIslands.emplace(object, islandIndex);
+            } else {
+                int rootA = findRoot(itr->second);
+                int rootB = findRoot(islandIndex);
+                if (rootA != rootB) {
+                    // the lowest index is always the root
+                    roots[std::max(rootA, rootB)] = std::min(rootA, rootB);
+                }
+            }
+        }
+    };
+    for (int i = 0; i < _numIslands; ++i) {
+        const IslandBatch& island = _islands[i];
+        for (const btPersistentManifold* manifold : island.manifolds) {
+            shareKinematicObject(manifold->getBody0(), i);
+            shareKinematicObject(manifold->getBody1(), i);
+        }
+        for (const btTypedConstraint* constraint : island.constraints) {
+            shareKinematicObject(&(constraint->getRigidBodyA()), i);
+            shareKinematicObject(&(constraint->getRigidBodyB()), i);
+        }
+    }
+
+    // Solving several small islands in one solveGroup() call is cheaper than solving them one at a time
+    // so we accumulate root groups into batches of at least m_minimumSolverBatchSize manifolds + constraints.
+    // Islands are independent so the results do not depend on how they are batched.
+    std::vector<int> batchIndices(_numIslands, -1);
+    std::vector<int> groupSizes(_numIslands, 0);
+    for (int i = 0; i < _numIslands; ++i) {
+        groupSizes[findRoot(i)] += _islands[i].size();
+    }
+    _numIslandBatches = 0;
+    int batchSize = 0;
+    for (int i = 0; i < _numIslands; ++i) {
+        if (roots[i] == i) {
+            if (_numIslandBatches == 0 || batchSize >= solverInfo.m_minimumSolverBatchSize) {
+                if ((int)_islandBatches.size() == _numIslandBatches) {
+                    _islandBatches.emplace_back();
+                }
+                _islandBatches[_numIslandBatches].clear();
+                ++_numIslandBatches;
+                batchSize = 0;
+            }
+            batchIndices[i] = _numIslandBatches - 1;
+            batchSize += groupSizes[i];
+        }
+    }
+    for (int i = 0; i < _numIslands; ++i) {
+        const IslandBatch& island = _islands[i];
+        IslandBatch& batch = _islandBatches[batchIndices[findRoot(i)]];
+        batch.bodies.insert(batch.bodies.end(), island.bodies.begin(), island.bodies.end());
+        batch.manifolds.insert(batch.manifolds.end(), island.manifolds.begin(), island.manifolds.end());
+        batch.constraints.insert(batch.constraints.end(), island.constraints.begin(), island.constraints.end());
+    }
+}
+
 // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
 void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
     btAssert(body);
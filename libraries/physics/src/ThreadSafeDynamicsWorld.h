@@ -24,6 +24,10 @@
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <memory>
+#include <vector>
+
+class ConstraintSolverPool;
 
 using SubStepCallback = std::function<void()>;
 
@@ -36,6 +40,7 @@ public:
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
             btCollisionConfiguration* collisionConfiguration);
+    ~ThreadSafeDynamicsWorld();
 
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
                                           btScalar fixedTimeStep = btScalar(1.)/btScalar(60.),
@@ -53,7 +58,30 @@ public:
 
     void addChangedMotionState(ObjectMotionState* motionState) { _changedMotionStates.push_back(motionState); }
 
+    // Independent simulation islands can be solved in batches on a pool of worker threads.
+    // A negative count (the default) uses btDiscreteDynamicsWorld's serial solver, zero builds the same
+    // batches but solves them on the calling thread.  Every setting produces identical results.
+    static bool canSolveIslandsInParallel();
+    void setNumSolverThreads(int numThreads);
+    int getNumSolverThreads() const;
+
+protected:
+    virtual void solveConstraints(btContactSolverInfo& solverInfo) override;
+
 private:
+    // a batch of one or more simulation islands that share no non-static bodies with any other batch
+    class IslandBatch {
+    public:
+        void clear() { bodies.clear(); manifolds.clear(); constraints.clear(); }
+        int size() const { return (int)(manifolds.size() + constraints.size()); }
+        std::vector<btCollisionObject*> bodies;
+        std::vector<btPersistentManifold*> manifolds;
+        std::vector<btTypedConstraint*> constraints;
+    };
+    friend class IslandGatherCallback;
+
+    void buildIslandBatches(const btContactSolverInfo& solverInfo);
+
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
 
@@ -61,6 +89,12 @@ private:
     VectorOfMotionStates _deactivatedStates;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
+
+    std::unique_ptr<ConstraintSolverPool> _solverPool;
+    std::vector<IslandBatch> _islands;
+    std::vector<IslandBatch> _islandBatches;
+    int _numIslands { 0 };
+    int _numIslandBatches { 0 };
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
@@ -16,6 +16,14 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // codecs with a variable bitrate can be retuned while encoding, to follow the link to their listener
+    virtual bool supportsBitrateAdaptation() const { return false; }
+    virtual void setBitrate(int bitsPerSecond) { }
+    virtual int getBitrate() const { return 0; }
+
+    // expected loss, from 0 to 1, which codecs with forward error correction spend redundancy on
+    virtual void setExpectedPacketLoss(float lossRate) { }
 };
 
 class Decoder {
@@ -24,6 +32,12 @@ public:
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
 
     virtual void lostFrame(QByteArray& decodedBuffer) = 0;
+
+    // called instead of lostFrame for the frame just before nextEncodedBuffer, which codecs with
+    // forward error correction can rebuild from the redundancy carried in that next packet
+    virtual void recoverLostFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) {
+        lostFrame(decodedBuffer);
+    }
 };
 
 class CodecPlugin : public Plugin {
@@ -294,7 +294,11 @@ void DrawDeferred::run(const RenderContextPointer& renderContext, const Inputs&
         ShapeKey globalKey = keyBuilder.build();
         args->_globalShapeKey = globalKey._flags.to_ulong();
 
-        renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+        if (_parallelRecording) {
+            renderShapesInParallel(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+        } else {
+            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+        }
 
         args->_batch = nullptr;
         args->_globalShapeKey = 0;
@@ -342,7 +346,13 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         args->_globalShapeKey = globalKey._flags.to_ulong();
 
         if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            if (_parallelRecording) {
+                renderStateSortShapesInParallel(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            } else {
+                renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            }
+        } else if (_parallelRecording) {
+            renderShapesInParallel(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
         } else {
             renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
         }
@@ -48,6 +48,7 @@ class DrawConfig : public render::Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY newStats)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 
 public:
 
@@ -56,6 +57,9 @@ public:
 
     int maxDrawn{ -1 };
 
+    // record the items on the job pool, see render::renderShapesInParallel
+    bool parallelRecording{ false };
+
 signals:
     void newStats();
     void dirty();
@@ -72,12 +76,13 @@ public:
 
     DrawDeferred(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
 
-    void configure(const Config& config) { _maxDrawn = config.maxDrawn; }
+    void configure(const Config& config) { _maxDrawn = config.maxDrawn; _parallelRecording = config.parallelRecording; }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn; // initialized by Config
+    bool _parallelRecording;
 };
 
 class DrawStateSortConfig : public render::Job::Config {
@@ -85,6 +90,7 @@ class DrawStateSortConfig : public render::Job::Config {
         Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
         Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
         Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+        Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
 public:
 
     int getNumDrawn() { return numDrawn; }
@@ -93,6 +99,9 @@ public:
     int maxDrawn{ -1 };
     bool stateSort{ true };
 
+    // record the items on the job pool, see render::renderStateSortShapesInParallel
+    bool parallelRecording{ false };
+
 signals:
     void numDrawnChanged();
     void dirty();
@@ -110,13 +119,14 @@ public:
 
     DrawStateSortDeferred(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
 
-    void configure(const Config& config) { _maxDrawn = config.maxDrawn; _stateSort = config.stateSort; }
+    void configure(const Config& config) { _maxDrawn = config.maxDrawn; _stateSort = config.stateSort; _parallelRecording = config.parallelRecording; }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn; // initialized by Config
     bool _stateSort;
+    bool _parallelRecording;
 };
 
 class DrawOverlay3DConfig : public render::Job::Config {
@@ -65,6 +65,28 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext,
 
         std::vector<ShapeKey> skinnedShapeKeys{};
 
+        if (_parallelRecording) {
+            // gather the shapes of each pipeline, to record them all at once
+            ItemBounds unskinnedItems;
+            ItemBounds skinnedItems;
+            for (const auto& items : inShapes) {
+                auto& bucket = items.first.isSkinned() ? skinnedItems : unskinnedItems;
+                bucket.insert(bucket.end(), items.second.begin(), items.second.end());
+            }
+
+            args->_shapePipeline = shadowPipeline;
+            batch.setPipeline(shadowPipeline->pipeline);
+            renderItemsInParallel(renderContext, unskinnedItems);
+
+            args->_shapePipeline = shadowSkinnedPipeline;
+            batch.setPipeline(shadowSkinnedPipeline->pipeline);
+            renderItemsInParallel(renderContext, skinnedItems);
+
+            args->_shapePipeline = nullptr;
+            args->_batch = nullptr;
+            return;
+        }
+
         // Iterate through all inShapes and render the unskinned
         args->_shapePipeline = shadowPipeline;
         batch.setPipeline(shadowPipeline->pipeline);
@@ -19,16 +19,30 @@
 
 class ViewFrustum;
 
+class RenderShadowMapConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
+public:
+    // record the items on the job pool, see render::renderItemsInParallel
+    bool parallelRecording{ false };
+
+signals:
+    void dirty();
+};
+
 class RenderShadowMap {
 public:
-    using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, render::ShapeBounds, Config>;
 
     RenderShadowMap(render::ShapePlumberPointer shapePlumber) : _shapePlumber{ shapePlumber } {}
+    void configure(const Config& config) { _parallelRecording = config.parallelRecording; }
     void run(const render::RenderContextPointer& renderContext,
              const render::ShapeBounds& inShapes);
 
 protected:
     render::ShapePlumberPointer _shapePlumber;
+    bool _parallelRecording { false };
 };
 
 class RenderShadowTaskConfig : public render::Task::Config::Persistent {
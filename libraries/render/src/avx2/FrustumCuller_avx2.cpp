@@ -0,0 +1,59 @@
+//
+//  FrustumCuller_avx2.cpp
+//  render/src/avx2
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+// the distances must round exactly as Plane::distance() does, so multiplies and adds are not fused
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include <algorithm>
+#include <immintrin.h>
+
+#include "../render/FrustumCuller.h"
+
+using namespace render;
+
+static_assert(FrustumCuller::SIMD_WIDTH == 8, "one box per float of __m256");
+
+void FrustumCuller::test_AVX2(size_t begin, size_t end, uint8_t* inView) const {
+    const __m256 zero = _mm256_setzero_ps();
+
+    for (size_t i = begin; i < end; i += 8) {
+
+        __m256 outside = _mm256_setzero_ps();
+
+        for (const auto& plane : _planes) {
+            __m256 x = _mm256_loadu_ps(&_coordinates[plane.farthest[0]][i]);
+            __m256 y = _mm256_loadu_ps(&_coordinates[plane.farthest[1]][i]);
+            __m256 z = _mm256_loadu_ps(&_coordinates[plane.farthest[2]][i]);
+
+            //float distance = plane.d + (plane.normal[0] * x + plane.normal[1] * y + plane.normal[2] * z);
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal[0]), x),
+                                            _mm256_mul_ps(_mm256_set1_ps(plane.normal[1]), y));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal[2]), z));
+            distance = _mm256_add_ps(_mm256_set1_ps(plane.d), distance);
+
+            //outside |= (distance < 0.0f);
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, zero, _CMP_LT_OQ));
+        }
+
+        int mask = _mm256_movemask_ps(outside);
+        size_t count = std::min((size_t)8, end - i);
+        for (size_t k = 0; k < count; k++) {
+            inView[i + k] = ((mask >> k) & 1) ? 0 : 1;
+        }
+    }
+    _mm256_zeroupper();
+}
+
+#endif
@@ -16,9 +16,19 @@
 
 #include <OctreeUtils.h>
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 
 using namespace render;
 
+// culled items are tested in batches of this many on the job pool, a multiple of FrustumCuller::SIMD_WIDTH
+static const size_t CULL_BATCH_SIZE = 1024;
+
+enum CullResult : uint8_t {
+    CULL_OUT_OF_VIEW = 0,   // as set by FrustumCuller::test()
+    CULL_VISIBLE = 1,
+    CULL_TOO_SMALL,
+};
+
 void render::cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
                        const ItemBounds& inItems, ItemBounds& outItems) {
     assert(renderContext->args);
@@ -29,27 +39,31 @@ void render::cullItems(const RenderContextPointer& renderContext, const CullFunc
 
     details._considered += (int)inItems.size();
 
+    // TODO: some entity types (like lights) might want to be rendered even
+    // when they are outside of the view frustum...
+    FrustumCuller culler;
+    std::vector<uint8_t> inView(inItems.size());
+    {
+        PerformanceTimer perfTimer("boxIntersectsFrustum");
+        culler.setFrustum(frustum);
+        culler.resize(inItems.size());
+        for (size_t i = 0; i < inItems.size(); i++) {
+            culler.setBound(i, inItems[i].bound);
+        }
+        culler.test(0, inItems.size(), inView.data());
+    }
+
     // Culling / LOD
-    for (auto item : inItems) {
+    PerformanceTimer perfTimer("shouldRender");
+    for (size_t i = 0; i < inItems.size(); i++) {
+        const auto& item = inItems[i];
         if (item.bound.isNull()) {
             outItems.emplace_back(item); // One more Item to render
             continue;
         }
 
-        // TODO: some entity types (like lights) might want to be rendered even
-        // when they are outside of the view frustum...
-        bool inView;
-        {
-            PerformanceTimer perfTimer("boxIntersectsFrustum");
-            inView = frustum.boxIntersectsFrustum(item.bound);
-        }
-        if (inView) {
-            bool bigEnoughToRender;
-            {
-                PerformanceTimer perfTimer("shouldRender");
-                bigEnoughToRender = cullFunctor(args, item.bound);
-            }
-            if (bigEnoughToRender) {
+        if (inView[i]) {
+            if (cullFunctor(args, item.bound)) {
                 outItems.emplace_back(item); // One more Item to render
             } else {
                 details._tooSmall++;
@@ -131,52 +145,6 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         args->pushViewFrustum(_frozenFrutstum); // replace the true view frustum by the frozen one
     }
 
-    // Culling Frustum / solidAngle test helper class
-    struct Test {
-        CullFunctor _functor;
-        RenderArgs* _args;
-        RenderDetails::Item& _renderDetails;
-        glm::vec3 _eyePos;
-        float _squareTanAlpha;
-
-        Test(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails) :
-            _functor(functor),
-            _args(pargs),
-            _renderDetails(renderDetails)
-        {
-            // FIXME: Keep this code here even though we don't use it yet
-            /*_eyePos = _args->getViewFrustum().getPosition();
-            float a = glm::degrees(Octree::getAccuracyAngle(_args->_sizeScale, _args->_boundaryLevelAdjust));
-            auto angle = std::min(glm::radians(45.0f), a); // no worse than 45 degrees
-            angle = std::max(glm::radians(1.0f / 60.0f), a); // no better than 1 minute of degree
-            auto tanAlpha = tan(angle);
-            _squareTanAlpha = (float)(tanAlpha * tanAlpha);
-            */
-        }
-
-        bool frustumTest(const AABox& bound) {
-            if (!_args->getViewFrustum().boxIntersectsFrustum(bound)) {
-                _renderDetails._outOfView++;
-                return false;
-            }
-            return true;
-        }
-
-        bool solidAngleTest(const AABox& bound) {
-            // FIXME: Keep this code here even though we don't use it yet
-            //auto eyeToPoint = bound.calcCenter() - _eyePos;
-            //auto boundSize = bound.getDimensions();
-            //float test = (glm::dot(boundSize, boundSize) / glm::dot(eyeToPoint, eyeToPoint)) - squareTanAlpha;
-            //if (test < 0.0f) {
-            if (!_functor(_args, bound)) {
-                _renderDetails._tooSmall++;
-                return false;
-            }
-            return true;
-        }
-    };
-    Test test(_cullFunctor, args, details);
-
     // Now we have a selection of items to render
     outItems.clear();
     outItems.reserve(inSelection.numItems());
@@ -252,45 +220,19 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
         // inside & subcell items: filter & distance cull
         {
             PerformanceTimer perfTimer("insideSmallItems");
-            for (auto id : inSelection.insideSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.solidAngleTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
+            cullSelectedItems(renderContext, inSelection.insideSubcellItems, false, true, details, outItems);
         }
 
         // partial & fit items: filter & frustum cull
         {
             PerformanceTimer perfTimer("partialFitItems");
-            for (auto id : inSelection.partialItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        outItems.emplace_back(itemBound);
-                    }
-                }
-            }
+            cullSelectedItems(renderContext, inSelection.partialItems, true, false, details, outItems);
         }
 
         // partial & subcell items:: filter & frutum cull & solidangle cull
         {
             PerformanceTimer perfTimer("partialSmallItems");
-            for (auto id : inSelection.partialSubcellItems) {
-                auto& item = scene->getItem(id);
-                if (_filter.test(item.getKey())) {
-                    ItemBound itemBound(id, item.getBound());
-                    if (test.frustumTest(itemBound.bound)) {
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                        }
-                    }
-                }
-            }
+            cullSelectedItems(renderContext, inSelection.partialSubcellItems, true, true, details, outItems);
         }
     }
 
@@ -304,3 +246,73 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
 
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
+
+void CullSpatialSelection::cullSelectedItems(const RenderContextPointer& renderContext, const ItemIDs& inItems,
+    bool frustumTest, bool solidAngleTest, RenderDetails::Item& details, ItemBounds& outItems) {
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+
+    // filter and fetch the bounds on this thread, payloads are not safe to query from others
+    _candidates.clear();
+    for (auto id : inItems) {
+        auto& item = scene->getItem(id);
+        if (_filter.test(item.getKey())) {
+            _candidates.emplace_back(id, item.getBound());
+        }
+    }
+
+    size_t numCandidates = _candidates.size();
+    if (numCandidates == 0) {
+        return;
+    }
+
+    if (frustumTest) {
+        _culler.setFrustum(args->getViewFrustum());
+        _culler.resize(numCandidates);
+        for (size_t i = 0; i < numCandidates; i++) {
+            _culler.setBound(i, _candidates[i].bound);
+        }
+    }
+    _results.resize(numCandidates);
+
+    // test the bounds in batches on the job pool, 8 at a time against the frustum
+    size_t numBatches = (numCandidates + CULL_BATCH_SIZE - 1) / CULL_BATCH_SIZE;
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numBatches), [&](const tbb::blocked_range<size_t>& batches) {
+        size_t begin = batches.begin() * CULL_BATCH_SIZE;
+        size_t end = std::min(batches.end() * CULL_BATCH_SIZE, numCandidates);
+        uint8_t* results = _results.data();
+
+        if (frustumTest) {
+            _culler.test(begin, end, results);
+        } else {
+            std::fill(results + begin, results + end, (uint8_t)CULL_VISIBLE);
+        }
+
+        // FIXME: the solid angle test could run 8 wide with the frustum test, once it is no longer a CullFunctor:
+        //auto eyeToPoint = bound.calcCenter() - eyePos;
+        //auto boundSize = bound.getDimensions();
+        //float test = (glm::dot(boundSize, boundSize) / glm::dot(eyeToPoint, eyeToPoint)) - squareTanAlpha;
+        if (solidAngleTest) {
+            for (size_t i = begin; i < end; i++) {
+                if (results[i] == CULL_VISIBLE && !_cullFunctor(args, _candidates[i].bound)) {
+                    results[i] = CULL_TOO_SMALL;
+                }
+            }
+        }
+    });
+
+    // and keep the survivors in order
+    for (size_t i = 0; i < numCandidates; i++) {
+        switch (_results[i]) {
+            case CULL_VISIBLE:
+                outItems.emplace_back(_candidates[i]);
+                break;
+            case CULL_OUT_OF_VIEW:
+                details._outOfView++;
+                break;
+            case CULL_TOO_SMALL:
+                details._tooSmall++;
+                break;
+        }
+    }
+}
@@ -13,10 +13,12 @@
 #define hifi_render_CullTask_h
 
 #include "Engine.h"
+#include "FrustumCuller.h"
 #include "ViewFrustum.h"
 
 namespace render {
 
+    // Culling runs on the job pool, so a CullFunctor must be safe to call from several threads at once
     using CullFunctor = std::function<bool(const RenderArgs*, const AABox&)>;
 
     void cullItems(const RenderContextPointer& renderContext, const CullFunctor& cullFunctor, RenderDetails::Item& details,
@@ -107,6 +109,15 @@ namespace render {
 
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext, const ItemSpatialTree::ItemSelection& inSelection, ItemBounds& outItems);
+
+    private:
+        // reused from frame to frame
+        FrustumCuller _culler;
+        ItemBounds _candidates;
+        std::vector<uint8_t> _results;
+
+        void cullSelectedItems(const RenderContextPointer& renderContext, const ItemIDs& inItems,
+            bool frustumTest, bool solidAngleTest, RenderDetails::Item& details, ItemBounds& outItems);
     };
 
 }
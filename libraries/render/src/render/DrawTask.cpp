@@ -18,6 +18,7 @@
 #include <assert.h>
 
 #include <PerfStat.h>
+#include <TBBHelpers.h>
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
 
@@ -137,6 +138,191 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     args->_itemShapeKey = 0;
 }
 
+// Items are recorded in parallel in chunks of this many, whatever the number of threads, so that the merged batch is
+// always the same
+static const size_t RECORD_CHUNK_SIZE = 128;
+
+// Record the items [0, numItems) on the job pool, each chunk into its own pooled batch with its own copy of the args,
+// then append the chunks to args->_batch in order
+template <typename F>
+static void recordInParallel(RenderArgs* args, size_t numItems, F recordItems) {
+    assert(args->_batch);
+    size_t numChunks = (numItems + RECORD_CHUNK_SIZE - 1) / RECORD_CHUNK_SIZE;
+    std::vector<gpu::BatchPointer> batches(numChunks);
+    std::vector<RenderDetails> details(numChunks);
+
+    tbb::parallel_for((size_t)0, numChunks, [&](size_t chunk) {
+        RenderArgs chunkArgs(*args);
+        chunkArgs._details = RenderDetails();
+        batches[chunk] = gpu::Batch::acquire();
+        chunkArgs._batch = batches[chunk].get();
+
+        size_t begin = chunk * RECORD_CHUNK_SIZE;
+        recordItems(&chunkArgs, begin, std::min(begin + RECORD_CHUNK_SIZE, numItems));
+        details[chunk] = chunkArgs._details;
+    });
+
+    for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        args->_batch->append(std::move(*batches[chunk]));
+        args->_details._materialSwitches += details[chunk]._materialSwitches;
+        args->_details._trianglesRendered += details[chunk]._trianglesRendered;
+    }
+}
+
+namespace {
+    // A shape to record, with its pipeline looked up ahead of time since ShapePlumber lookups are not thread safe
+    struct ShapeRecord {
+        const Item* item;
+        ShapeKey key;
+        int pipeline; // index in the pipelines picked, or -1 if the shape has its own pipeline
+    };
+
+    class ShapeRecords {
+    public:
+        ShapeRecords(const ShapePlumberPointer& shapeContext) : _shapeContext(shapeContext) {}
+
+        void add(const Item& item, const ShapeKey& key) {
+            if (key.isValid() && !key.hasOwnPipeline()) {
+                auto& index = _indices[key];
+                if (index == 0) {
+                    auto pipeline = _shapeContext->findPipeline(key);
+                    if (!pipeline) {
+                        _indices.erase(key);
+                        return;
+                    }
+                    _pipelines.push_back(pipeline);
+                    index = (int)_pipelines.size();
+                }
+                records.push_back({ &item, key, index - 1 });
+            } else if (key.hasOwnPipeline()) {
+                records.push_back({ &item, key, -1 });
+            } else {
+                static QString repeatedCouldNotBeRendered = LogHandler::getInstance().addRepeatedMessageRegex(
+                    "Item could not be rendered with invalid key.*");
+                qCDebug(renderlogging) << "Item could not be rendered with invalid key" << key;
+            }
+        }
+
+        // record [begin, end), setting up the pipeline of every shape, or only when it changes
+        void record(RenderArgs* args, size_t begin, size_t end, bool pickEachShape) const {
+            int current = -1;
+            for (size_t i = begin; i < end; ++i) {
+                const auto& record = records[i];
+                args->_itemShapeKey = record.key._flags.to_ulong();
+                if (record.pipeline < 0) {
+                    args->_shapePipeline = nullptr;
+                    record.item->render(args);
+                    current = -1;
+                    continue;
+                }
+                if (pickEachShape || record.pipeline != current) {
+                    current = record.pipeline;
+                    args->_shapePipeline = _pipelines[current];
+                    args->_batch->setPipeline(args->_shapePipeline->pipeline);
+                    args->_shapePipeline->prepare(*args->_batch, args);
+                }
+                args->_shapePipeline->prepareShapeItem(args, record.key, *record.item);
+                record.item->render(args);
+            }
+            args->_shapePipeline = nullptr;
+            args->_itemShapeKey = 0;
+        }
+
+        std::vector<ShapeRecord> records;
+
+    private:
+        ShapePlumberPointer _shapeContext;
+        std::vector<ShapePipelinePointer> _pipelines;
+        std::unordered_map<ShapeKey, int, ShapeKey::Hash, ShapeKey::KeyEqual> _indices; // index + 1 in _pipelines
+    };
+}
+
+void render::renderItemsInParallel(const RenderContextPointer& renderContext, const ItemBounds& inItems, int maxDrawnItems) {
+    auto& scene = renderContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    int numItemsToDraw = (int)inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
+    }
+    recordInParallel(args, numItemsToDraw, [&](RenderArgs* chunkArgs, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& item = scene->getItem(inItems[i].id);
+            item.render(chunkArgs);
+        }
+    });
+}
+
+void render::renderShapesInParallel(const RenderContextPointer& renderContext,
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    auto& scene = renderContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    int numItemsToDraw = (int)inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
+    }
+
+    ShapeRecords shapes(shapeContext);
+    for (auto i = 0; i < numItemsToDraw; ++i) {
+        auto& item = scene->getItem(inItems[i].id);
+        assert(item.getKey().isShape());
+        shapes.add(item, item.getShapeKey() | globalKey);
+    }
+
+    // like renderShape(), every shape sets up its pipeline
+    recordInParallel(args, shapes.records.size(), [&](RenderArgs* chunkArgs, size_t begin, size_t end) {
+        shapes.record(chunkArgs, begin, end, true);
+    });
+}
+
+void render::renderStateSortShapesInParallel(const RenderContextPointer& renderContext,
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    auto& scene = renderContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    int numItemsToDraw = (int)inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
+    }
+
+    // sort by pipeline, in the order the pipelines first appear, then the shapes with their own pipeline
+    using SortedShapes = std::unordered_map<ShapeKey, std::vector<const Item*>, ShapeKey::Hash, ShapeKey::KeyEqual>;
+    std::vector<ShapeKey> sortedPipelines;
+    SortedShapes sortedShapes;
+
+    // the shapes with their own pipeline go first in the records, to be moved to the end
+    ShapeRecords shapes(shapeContext);
+    for (auto i = 0; i < numItemsToDraw; ++i) {
+        auto& item = scene->getItem(inItems[i].id);
+        assert(item.getKey().isShape());
+        auto key = item.getShapeKey() | globalKey;
+        if (key.isValid() && !key.hasOwnPipeline()) {
+            auto& bucket = sortedShapes[key];
+            if (bucket.empty()) {
+                sortedPipelines.push_back(key);
+            }
+            bucket.push_back(&item);
+        } else {
+            shapes.add(item, key);
+        }
+    }
+    std::vector<ShapeRecord> ownPipelineShapes;
+    std::swap(ownPipelineShapes, shapes.records);
+
+    for (auto& pipelineKey : sortedPipelines) {
+        for (auto item : sortedShapes[pipelineKey]) {
+            shapes.add(*item, pipelineKey);
+        }
+    }
+    shapes.records.insert(shapes.records.end(), ownPipelineShapes.begin(), ownPipelineShapes.end());
+
+    // each chunk sets up the pipeline it starts with, and then only when it changes
+    recordInParallel(args, shapes.records.size(), [&](RenderArgs* chunkArgs, size_t begin, size_t end) {
+        shapes.record(chunkArgs, begin, end, false);
+    });
+}
+
 void DrawLight::run(const RenderContextPointer& renderContext, const ItemBounds& inLights) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
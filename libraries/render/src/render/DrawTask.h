@@ -20,6 +20,13 @@ void renderItems(const RenderContextPointer& renderContext, const ItemBounds& in
 void renderShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
 
+// Same as above, but the items are recorded on the job pool, in chunks that each go to their own batch, and the chunks
+// are then appended to args->_batch in order. The recorded frame is the same whatever the number of threads.
+// The items' render() and their pipelines' setters are then called from several threads at once, so they must be thread safe.
+void renderItemsInParallel(const RenderContextPointer& renderContext, const ItemBounds& inItems, int maxDrawnItems = -1);
+void renderShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+void renderStateSortShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
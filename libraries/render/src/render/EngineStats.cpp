@@ -63,4 +63,11 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
 
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
+
+    const auto& transactionStats = renderContext->_scene->getTransactionStats();
+    config->frameTransactionCount = transactionStats.numTransactions;
+    config->frameTransactionResetCount = transactionStats.numResets;
+    config->frameTransactionUpdateCount = transactionStats.numUpdates;
+    config->frameTransactionRemoveCount = transactionStats.numRemoves;
+    config->frameTransactionApplyUsecs = (qint64)transactionStats.applyUsecs;
 }
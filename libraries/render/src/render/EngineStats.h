@@ -61,6 +61,12 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY dirty)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY dirty)
 
+        Q_PROPERTY(quint32 frameTransactionCount MEMBER frameTransactionCount NOTIFY dirty)
+        Q_PROPERTY(quint32 frameTransactionResetCount MEMBER frameTransactionResetCount NOTIFY dirty)
+        Q_PROPERTY(quint32 frameTransactionUpdateCount MEMBER frameTransactionUpdateCount NOTIFY dirty)
+        Q_PROPERTY(quint32 frameTransactionRemoveCount MEMBER frameTransactionRemoveCount NOTIFY dirty)
+        Q_PROPERTY(qint64 frameTransactionApplyUsecs MEMBER frameTransactionApplyUsecs NOTIFY dirty)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -102,6 +108,12 @@ namespace render {
 
         quint32 frameSetInputFormatCount{ 0 };
 
+        quint32 frameTransactionCount{ 0 };
+        quint32 frameTransactionResetCount{ 0 };
+        quint32 frameTransactionUpdateCount{ 0 };
+        quint32 frameTransactionRemoveCount{ 0 };
+        qint64 frameTransactionApplyUsecs{ 0 };
+
 
 
         void emitDirty() { emit dirty(); }
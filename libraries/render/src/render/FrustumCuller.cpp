@@ -0,0 +1,96 @@
+//
+//  FrustumCuller.cpp
+//  render/src/render
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCuller.h"
+
+#include <assert.h>
+
+using namespace render;
+
+void FrustumCuller::setFrustum(const ViewFrustum& frustum) {
+    const ::Plane* planes = frustum.getPlanes();
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        const glm::vec3& normal = planes[i].getNormal();
+        auto& plane = _planes[i];
+        for (int axis = 0; axis < 3; axis++) {
+            plane.normal[axis] = normal[axis];
+            plane.farthest[axis] = (normal[axis] > 0.0f) ? (MAX_X + axis) : (MIN_X + axis);
+        }
+        plane.d = planes[i].getDCoefficient();
+    }
+}
+
+void FrustumCuller::resize(size_t numBounds) {
+    _numBounds = numBounds;
+    size_t paddedSize = (numBounds + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    for (auto& coordinates : _coordinates) {
+        coordinates.resize(paddedSize);
+    }
+}
+
+void FrustumCuller::setBound(size_t index, const AABox& bound) {
+    assert(index < _numBounds);
+    const glm::vec3& corner = bound.getCorner();
+    const glm::vec3& scale = bound.getScale();
+
+    // as in AABox::getFarthestVertex()
+    for (int axis = 0; axis < 3; axis++) {
+        _coordinates[MIN_X + axis][index] = corner[axis];
+        _coordinates[MAX_X + axis][index] = corner[axis] + scale[axis];
+    }
+}
+
+//
+// scalar reference version
+//
+void FrustumCuller::test_ref(size_t begin, size_t end, uint8_t* inView) const {
+    for (size_t i = begin; i < end; i++) {
+        bool inside = true;
+        for (const auto& plane : _planes) {
+            float x = _coordinates[plane.farthest[0]][i];
+            float y = _coordinates[plane.farthest[1]][i];
+            float z = _coordinates[plane.farthest[2]][i];
+
+            // as in Plane::distance()
+            float distance = plane.d + (plane.normal[0] * x + plane.normal[1] * y + plane.normal[2] * z);
+            if (distance < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        inView[i] = inside ? 1 : 0;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include <CPUDetect.h>
+
+void FrustumCuller::test(size_t begin, size_t end, uint8_t* inView) const {
+    assert(begin % SIMD_WIDTH == 0);
+    assert(end <= _numBounds);
+    static auto f = cpuSupportsAVX2() ? &FrustumCuller::test_AVX2 : &FrustumCuller::test_ref;
+    (this->*f)(begin, end, inView);    // dispatch
+}
+
+#else   // portable reference code
+
+void FrustumCuller::test(size_t begin, size_t end, uint8_t* inView) const {
+    assert(begin % SIMD_WIDTH == 0);
+    assert(end <= _numBounds);
+    test_ref(begin, end, inView);
+}
+
+#endif
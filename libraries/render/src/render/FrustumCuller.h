@@ -0,0 +1,69 @@
+//
+//  FrustumCuller.h
+//  render/src/render
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_FrustumCuller_h
+#define hifi_render_FrustumCuller_h
+
+#include <array>
+#include <vector>
+
+#include <AABox.h>
+#include <ViewFrustum.h>
+
+namespace render {
+
+    // Tests many bounds against the planes of a view frustum, with the same result as ViewFrustum::boxIntersectsFrustum().
+    // The bounds are stored as a structure of arrays, one array per box coordinate, so that the AVX2 path tests
+    // 8 boxes per iteration, one per lane. Ranges of bounds can be tested on separate threads.
+    class FrustumCuller {
+    public:
+        static const int SIMD_WIDTH = 8;
+
+        void setFrustum(const ViewFrustum& frustum);
+
+        // sizes the arrays for numBounds bounds, padded to a multiple of SIMD_WIDTH
+        void resize(size_t numBounds);
+        size_t size() const { return _numBounds; }
+
+        void setBound(size_t index, const AABox& bound);
+
+        // sets inView[i] to 1 or 0 for the bounds in [begin, end), begin must be a multiple of SIMD_WIDTH
+        void test(size_t begin, size_t end, uint8_t* inView) const;
+
+        void test_ref(size_t begin, size_t end, uint8_t* inView) const;
+        void test_AVX2(size_t begin, size_t end, uint8_t* inView) const;
+
+    private:
+        enum Coordinate {
+            MIN_X = 0,
+            MIN_Y,
+            MIN_Z,
+            MAX_X,
+            MAX_Y,
+            MAX_Z,
+
+            NUM_COORDINATES
+        };
+
+        struct Plane {
+            float normal[3];
+            float d;
+            int farthest[3];    // the coordinates of the box vertex farthest along the normal
+        };
+
+        std::array<Plane, NUM_FRUSTUM_PLANES> _planes;
+        std::array<std::vector<float>, NUM_COORDINATES> _coordinates;
+        size_t _numBounds { 0 };
+    };
+
+}
+
+#endif // hifi_render_FrustumCuller_h
@@ -11,13 +11,23 @@
 #include "Scene.h"
 
 #include <numeric>
+#include <unordered_set>
+
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
+
 #include "Logging.h"
 #include "TransitionStage.h"
 
 // Comment this to disable transitions (fades)
 #define SCENE_ENABLE_TRANSITIONS
 
+// below this many updates in a frame, the job pool costs more than it saves
+static const size_t PARALLEL_UPDATES_MIN = 512;
+
+// updates are split across the job pool by item ID modulo this
+static const size_t NUM_UPDATE_PARTITIONS = 32;
+
 using namespace render;
 
 void Transaction::resetItem(ItemID id, const PayloadPointer& payload) {
@@ -89,28 +99,35 @@ bool Scene::isAllocatedID(const ItemID& id) const {
 
 /// Enqueue change batch to the scene
 void Scene::enqueueTransaction(const Transaction& transaction) {
-    _transactionQueueMutex.lock();
     _transactionQueue.push(transaction);
-    _transactionQueueMutex.unlock();
 }
 
-void consolidateTransaction(TransactionQueue& queue, Transaction& singleBatch) {
-    while (!queue.empty()) {
-        const auto& transaction = queue.front();
-        singleBatch.merge(transaction);
-        queue.pop();
-    };
+void Scene::enqueueTransaction(Transaction&& transaction) {
+    _transactionQueue.push(std::move(transaction));
 }
- 
+
 void Scene::processTransactionQueue() {
     PROFILE_RANGE(render, __FUNCTION__);
-    Transaction consolidatedTransaction;
 
-    {
-        std::unique_lock<std::mutex> lock(_transactionQueueMutex);
-        consolidateTransaction(_transactionQueue, consolidatedTransaction);
+    // take what has been queued so far, transactions queued from now on are for the next frame
+    _processedTransactions.clear();
+    Transaction transaction;
+    while (_transactionQueue.try_pop(transaction)) {
+        _processedTransactions.push_back(std::move(transaction));
+    }
+
+    // the transactions are applied in place rather than merged, each kind of change in the order they were queued
+    quint64 start = usecTimestampNow();
+    TransactionStats stats;
+    stats.numTransactions = (uint32_t)_processedTransactions.size();
+    bool touchTransactions = false;
+    for (const auto& processed : _processedTransactions) {
+        stats.numResets += (uint32_t)processed._resetItems.size();
+        stats.numUpdates += (uint32_t)processed._updatedItems.size();
+        stats.numRemoves += (uint32_t)processed._removedItems.size();
+        touchTransactions = touchTransactions || processed.touchTransactions();
     }
-    
+
     {
         std::unique_lock<std::mutex> lock(_itemsMutex);
         // Here we should be able to check the value of last ItemID allocated 
@@ -123,33 +140,54 @@ void Scene::processTransactionQueue() {
         // capture anything coming from the transaction
 
         // resets and potential NEW items
-        resetItems(consolidatedTransaction._resetItems);
+        for (const auto& processed : _processedTransactions) {
+            resetItems(processed._resetItems);
+        }
 
         // Update the numItemsAtomic counter AFTER the reset changes went through
         _numAllocatedItems.exchange(maxID);
 
         // updates
-        updateItems(consolidatedTransaction._updatedItems);
+        if (_parallelUpdates && stats.numUpdates >= PARALLEL_UPDATES_MIN) {
+            updateItemsInParallel(_processedTransactions, stats.numUpdates);
+        } else {
+            for (const auto& processed : _processedTransactions) {
+                updateItems(processed._updatedItems);
+            }
+        }
 
         // removes
-        removeItems(consolidatedTransaction._removedItems);
+        for (const auto& processed : _processedTransactions) {
+            removeItems(processed._removedItems);
+        }
 
 #ifdef SCENE_ENABLE_TRANSITIONS
         // add transitions
-        transitionItems(consolidatedTransaction._addedTransitions);
-        reApplyTransitions(consolidatedTransaction._reAppliedTransitions);
-        queryTransitionItems(consolidatedTransaction._queriedTransitions);
+        for (const auto& processed : _processedTransactions) {
+            transitionItems(processed._addedTransitions);
+        }
+        for (const auto& processed : _processedTransactions) {
+            reApplyTransitions(processed._reAppliedTransitions);
+        }
+        for (const auto& processed : _processedTransactions) {
+            queryTransitionItems(processed._queriedTransitions);
+        }
 #endif
         // Update the numItemsAtomic counter AFTER the pending changes went through
         _numAllocatedItems.exchange(maxID);
     }
 
-    if (consolidatedTransaction.touchTransactions()) {
+    if (touchTransactions) {
         std::unique_lock<std::mutex> lock(_selectionsMutex);
 
         // resets and potential NEW items
-        resetSelections(consolidatedTransaction._resetSelections);
+        for (const auto& processed : _processedTransactions) {
+            resetSelections(processed._resetSelections);
+        }
     }
+
+    stats.applyUsecs = usecTimestampNow() - start;
+    _transactionStats = stats;
 }
 
 void Scene::resetItems(const Transaction::Resets& transactions) {
@@ -211,28 +249,75 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
 
         // Update the item
         item.update(std::get<1>(update));
-        auto newKey = item.getKey();
 
         // Update the item's container
-        if (oldKey.isSpatial() == newKey.isSpatial()) {
-            if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            }
-        } else {
-            if (newKey.isSpatial()) {
-                _masterNonspatialSet.erase(updateID);
+        updateItemContainer(updateID, oldKey, oldCell);
+    }
+}
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), updateID, newKey);
-                item.resetCell(newCell, newKey.isSmall());
-            } else {
-                _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
-                item.resetCell();
+void Scene::updateItemsInParallel(const Transactions& transactions, size_t numUpdates) {
+    PROFILE_RANGE(render, __FUNCTION__);
 
-                _masterNonspatialSet.insert(updateID);
+    // split the updates by item, keeping their order, and note the state of each updated item before them
+    struct UpdatedItem {
+        ItemID id;
+        ItemKey oldKey;
+        ItemCell oldCell;
+    };
+    std::vector<std::vector<const Transaction::Update*>> partitions(NUM_UPDATE_PARTITIONS);
+    std::vector<UpdatedItem> updatedItems;
+    std::unordered_set<ItemID> updatedIDs;
+    updatedIDs.reserve(numUpdates);
+
+    for (const auto& transaction : transactions) {
+        for (const auto& update : transaction._updatedItems) {
+            auto updateID = std::get<0>(update);
+            if (updateID == Item::INVALID_ITEM_ID) {
+                continue;
+            }
+            partitions[updateID % NUM_UPDATE_PARTITIONS].push_back(&update);
+            if (updatedIDs.insert(updateID).second) {
+                const auto& item = _items[updateID];
+                updatedItems.push_back({ updateID, item.getKey(), item.getCell() });
             }
         }
     }
+
+    // update the payloads on the job pool, no item is in two partitions
+    tbb::parallel_for((size_t)0, NUM_UPDATE_PARTITIONS, [&](size_t partition) {
+        for (auto update : partitions[partition]) {
+            _items[std::get<0>(*update)].update(std::get<1>(*update));
+        }
+    });
+
+    // then move each item once from its old place in the containers to the new one
+    for (const auto& updated : updatedItems) {
+        updateItemContainer(updated.id, updated.oldKey, updated.oldCell);
+    }
+}
+
+void Scene::updateItemContainer(ItemID id, const ItemKey& oldKey, ItemCell oldCell) {
+    auto& item = _items[id];
+    auto newKey = item.getKey();
+
+    if (oldKey.isSpatial() == newKey.isSpatial()) {
+        if (newKey.isSpatial()) {
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), id, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        }
+    } else {
+        if (newKey.isSpatial()) {
+            _masterNonspatialSet.erase(id);
+
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(), id, newKey);
+            item.resetCell(newCell, newKey.isSmall());
+        } else {
+            _masterSpatialTree.removeItem(oldCell, oldKey, id);
+            item.resetCell();
+
+            _masterNonspatialSet.insert(id);
+        }
+    }
 }
 
 void Scene::transitionItems(const Transaction::TransitionAdds& transactions) {
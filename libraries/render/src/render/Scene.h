@@ -12,6 +12,8 @@
 #ifndef hifi_render_Scene_h
 #define hifi_render_Scene_h
 
+#include <TBBHelpers.h>
+
 #include "Item.h"
 #include "SpatialTree.h"
 #include "Stage.h"
@@ -39,7 +41,6 @@ public:
     typedef std::function<void(ItemID, const Transition*)> TransitionQueryFunc;
 
     Transaction() {}
-    ~Transaction() {}
 
     // Item transactions
     void resetItem(ItemID id, const PayloadPointer& payload);
@@ -51,8 +52,9 @@ public:
     void reApplyTransitionToItem(ItemID id);
     void queryTransitionOnItem(ItemID id, TransitionQueryFunc func);
 
+    // Update functors are allocated from TBB's per-thread pools, as there can be thousands of them per frame
     template <class T> void updateItem(ItemID id, std::function<void(T&)> func) {
-        updateItem(id, std::make_shared<UpdateFunctor<T>>(func));
+        updateItem(id, std::allocate_shared<UpdateFunctor<T>>(tbb::scalable_allocator<UpdateFunctor<T>>(), std::move(func)));
     }
 
     void updateItem(ItemID id, const UpdateFunctorPointer& functor);
@@ -92,7 +94,8 @@ protected:
     TransitionReApplies _reAppliedTransitions;
     SelectionResets _resetSelections;
 };
-typedef std::queue<Transaction> TransactionQueue;
+typedef tbb::concurrent_queue<Transaction> TransactionQueue;
+typedef std::vector<Transaction> Transactions;
 
 
 // Scene is a container for Items
@@ -115,11 +118,28 @@ public:
     size_t getNumItems() const { return _numAllocatedItems.load(); }
 
     // Enqueue transaction to the scene
+    // Thread safe, and lock free: producers never wait on each other nor on the processing
     void enqueueTransaction(const Transaction& transaction);
+    void enqueueTransaction(Transaction&& transaction);
 
     // Process the pending transactions queued
     void processTransactionQueue();
 
+    // Apply the updates of large batches on the job pool, one partition of the items per task.
+    // The update functors of distinct items, and their payloads' getKey() and getBound(), must then be thread safe.
+    void setParallelUpdates(bool enabled) { _parallelUpdates = enabled; }
+    bool getParallelUpdates() const { return _parallelUpdates; }
+
+    // What the last processTransactionQueue() applied, read from the thread that processes the queue
+    struct TransactionStats {
+        uint32_t numTransactions { 0 };
+        uint32_t numResets { 0 };
+        uint32_t numUpdates { 0 };
+        uint32_t numRemoves { 0 };
+        quint64 applyUsecs { 0 };
+    };
+    const TransactionStats& getTransactionStats() const { return _transactionStats; }
+
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
     Selection getSelection(const Selection::Name& name) const;
@@ -159,9 +179,13 @@ protected:
     // Thread safe elements that can be accessed from anywhere
     std::atomic<unsigned int> _IDAllocator{ 1 }; // first valid itemID will be One
     std::atomic<unsigned int> _numAllocatedItems{ 1 }; // num of allocated items, matching the _items.size()
-    std::mutex _transactionQueueMutex;
     TransactionQueue _transactionQueue;
 
+    // The transactions being applied, while the next ones are queued
+    Transactions _processedTransactions;
+    TransactionStats _transactionStats;
+    bool _parallelUpdates { false };
+
     // The actual database
     // database of items is protected for editing by a mutex
     std::mutex _itemsMutex;
@@ -172,6 +196,8 @@ protected:
     void resetItems(const Transaction::Resets& transactions);
     void removeItems(const Transaction::Removes& transactions);
     void updateItems(const Transaction::Updates& transactions);
+    void updateItemsInParallel(const Transactions& transactions, size_t numUpdates);
+    void updateItemContainer(ItemID id, const ItemKey& oldKey, ItemCell oldCell);
     void transitionItems(const Transaction::TransitionAdds& transactions);
     void reApplyTransitions(const Transaction::TransitionReApplies& transactions);
     void queryTransitionItems(const Transaction::TransitionQueries& transactions);
@@ -329,6 +329,10 @@ public:
 
     const PipelinePointer pickPipeline(RenderArgs* args, const Key& key) const;
 
+    // Find the pipeline for the key without setting it up in a batch, nullptr if there is none
+    // Not thread safe, the first lookup of a key can add its pipeline
+    const PipelinePointer findPipeline(const Key& key) const;
+
 protected:
     void addPipelineHelper(const Filter& filter, Key key, int bit, const PipelinePointer& pipeline) const;
     mutable PipelineMap _pipelineMap;
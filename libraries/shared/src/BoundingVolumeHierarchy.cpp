@@ -0,0 +1,127 @@
+//
+//  BoundingVolumeHierarchy.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <cfloat>
+
+void BoundingVolumeHierarchy::build(const std::vector<AABox>& boxes) {
+    clear();
+    if (boxes.empty()) {
+        return;
+    }
+
+    std::vector<glm::vec3> centroids;
+    centroids.reserve(boxes.size());
+    _indices.reserve(boxes.size());
+    for (size_t i = 0; i < boxes.size(); i++) {
+        centroids.push_back(boxes[i].calcCenter());
+        _indices.push_back((uint32_t)i);
+    }
+
+    // a guess, as leaves may come out smaller than MAX_LEAF_SIZE
+    _nodes.reserve(2 * boxes.size() / MAX_LEAF_SIZE + 1);
+    buildNode(boxes, centroids, 0, (uint32_t)boxes.size(), 0);
+}
+
+uint32_t BoundingVolumeHierarchy::buildNode(const std::vector<AABox>& boxes, const std::vector<glm::vec3>& centroids,
+                                            uint32_t begin, uint32_t end, int depth) {
+    uint32_t nodeIndex = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    glm::vec3 centroidMinimum(FLT_MAX);
+    glm::vec3 centroidMaximum(-FLT_MAX);
+    for (uint32_t i = begin; i < end; i++) {
+        const AABox& box = boxes[_indices[i]];
+        minimum = glm::min(minimum, box.getMinimumPoint());
+        maximum = glm::max(maximum, box.getMaximumPoint());
+        const glm::vec3& centroid = centroids[_indices[i]];
+        centroidMinimum = glm::min(centroidMinimum, centroid);
+        centroidMaximum = glm::max(centroidMaximum, centroid);
+    }
+    _nodes[nodeIndex].minimum = minimum;
+    _nodes[nodeIndex].maximum = maximum;
+
+    if (end - begin <= MAX_LEAF_SIZE) {
+        _nodes[nodeIndex].offset = begin;
+        _nodes[nodeIndex].count = end - begin;
+        return nodeIndex;
+    }
+
+    glm::vec3 extent = centroidMaximum - centroidMinimum;
+    int axis = 0;
+    if (extent.y > extent[axis]) {
+        axis = 1;
+    }
+    if (extent.z > extent[axis]) {
+        axis = 2;
+    }
+
+    auto first = _indices.begin() + begin;
+    auto last = _indices.begin() + end;
+    auto middle = first;
+    if (depth < MAX_MIDPOINT_DEPTH) {
+        float split = 0.5f * (centroidMinimum[axis] + centroidMaximum[axis]);
+        middle = std::partition(first, last, [&](uint32_t index) {
+            return centroids[index][axis] < split;
+        });
+    }
+
+    // all on one side of the middle (or too deep already), split them in equal halves instead
+    if (middle == first || middle == last) {
+        middle = first + (end - begin) / 2;
+        std::nth_element(first, middle, last, [&](uint32_t a, uint32_t b) {
+            return centroids[a][axis] < centroids[b][axis];
+        });
+    }
+
+    uint32_t split = (uint32_t)(middle - _indices.begin());
+    buildNode(boxes, centroids, begin, split, depth + 1);
+    uint32_t right = buildNode(boxes, centroids, split, end, depth + 1);
+    _nodes[nodeIndex].offset = right;
+    _nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+void BoundingVolumeHierarchy::refit(const std::vector<AABox>& boxes) {
+    // children always come after their parent, so going backwards the children are done first
+    for (size_t i = _nodes.size(); i-- > 0;) {
+        Node& node = _nodes[i];
+        if (node.count > 0) {
+            node.minimum = glm::vec3(FLT_MAX);
+            node.maximum = glm::vec3(-FLT_MAX);
+            for (uint32_t j = node.offset; j < node.offset + node.count; j++) {
+                const AABox& box = boxes[_indices[j]];
+                node.minimum = glm::min(node.minimum, box.getMinimumPoint());
+                node.maximum = glm::max(node.maximum, box.getMaximumPoint());
+            }
+        } else {
+            const Node& left = _nodes[i + 1];
+            const Node& right = _nodes[node.offset];
+            node.minimum = glm::min(left.minimum, right.minimum);
+            node.maximum = glm::max(left.maximum, right.maximum);
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::clear() {
+    _nodes.clear();
+    _indices.clear();
+}
+
+AABox BoundingVolumeHierarchy::getBounds() const {
+    if (_nodes.empty()) {
+        return AABox();
+    }
+    return AABox(_nodes[0].minimum, _nodes[0].maximum - _nodes[0].minimum);
+}
@@ -0,0 +1,202 @@
+//
+//  BoundingVolumeHierarchy.h
+//  libraries/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BoundingVolumeHierarchy_h
+#define hifi_BoundingVolumeHierarchy_h
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AABox.h"
+
+// A binary tree of axis aligned boxes over a set of primitives (triangles, entities...), flattened into an array
+// of compact nodes in depth first order, for tracing rays through many primitives.
+//
+// The primitives are only known by their index in the boxes given to build(), the caller intersects them.
+// Once built, the hierarchy is only read by findRayIntersection(), so any number of threads can trace rays at once.
+class BoundingVolumeHierarchy {
+public:
+    static const uint32_t MAX_LEAF_SIZE = 4;
+
+    // splits the primitives in halves, by the middle of their centroids along the longest axis
+    void build(const std::vector<AABox>& boxes);
+
+    // moves the node bounds to the new boxes of the same primitives, without changing the tree
+    void refit(const std::vector<AABox>& boxes);
+
+    void clear();
+
+    bool isEmpty() const { return _nodes.empty(); }
+    size_t getNumNodes() const { return _nodes.size(); }
+    size_t getNumPrimitives() const { return _indices.size(); }
+    AABox getBounds() const;
+
+    // Traces the ray from the nearest node to the farthest, skipping any node farther than the best distance so far.
+    // intersect(index, distance) is called on the primitives of the leaves reached, and returns true only if it found
+    // an intersection closer than distance, which it then lowers to it.
+    // distance is the farthest to look on entry, and the closest intersection on return.
+    template <typename F>
+    bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance, F intersect) const;
+
+    // Calls candidate(index) on the primitives of the leaves whose bounds contain the point, which the caller still has
+    // to test against the point itself.
+    template <typename F>
+    void findPointCandidates(const glm::vec3& point, F candidate) const;
+
+private:
+    // internal nodes have a count of 0, their left child follows them and offset is their right child,
+    // leaves have offset and count in _indices
+    struct Node {
+        glm::vec3 minimum;
+        uint32_t offset;
+        glm::vec3 maximum;
+        uint32_t count;
+    };
+
+    // splits are forced to the median below this depth, which bounds the traversal stack
+    static const int MAX_MIDPOINT_DEPTH = 32;
+    static const int MAX_STACK_SIZE = 2 * MAX_MIDPOINT_DEPTH + 2;
+
+    uint32_t buildNode(const std::vector<AABox>& boxes, const std::vector<glm::vec3>& centroids,
+                       uint32_t begin, uint32_t end, int depth);
+
+    static glm::vec3 getInverseDirection(const glm::vec3& direction);
+    static bool findNodeIntersection(const Node& node, const glm::vec3& origin, const glm::vec3& inverseDirection,
+                                     float distance, float& entry);
+
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _indices;
+};
+
+inline glm::vec3 BoundingVolumeHierarchy::getInverseDirection(const glm::vec3& direction) {
+    // keep the slabs finite on rays parallel to an axis
+    const float EPSILON = 1.0e-20f;
+    glm::vec3 inverse;
+    for (int i = 0; i < 3; i++) {
+        float component = direction[i];
+        if (fabsf(component) < EPSILON) {
+            component = component < 0.0f ? -EPSILON : EPSILON;
+        }
+        inverse[i] = 1.0f / component;
+    }
+    return inverse;
+}
+
+inline bool BoundingVolumeHierarchy::findNodeIntersection(const Node& node, const glm::vec3& origin,
+                                                          const glm::vec3& inverseDirection, float distance, float& entry) {
+    glm::vec3 t0 = (node.minimum - origin) * inverseDirection;
+    glm::vec3 t1 = (node.maximum - origin) * inverseDirection;
+    glm::vec3 slabNear = glm::min(t0, t1);
+    glm::vec3 slabFar = glm::max(t0, t1);
+
+    float enter = std::max(std::max(slabNear.x, slabNear.y), std::max(slabNear.z, 0.0f));
+    float exit = std::min(std::min(slabFar.x, slabFar.y), slabFar.z);
+    if (enter > exit || enter >= distance) {
+        return false;
+    }
+    entry = enter;
+    return true;
+}
+
+template <typename F>
+bool BoundingVolumeHierarchy::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
+                                                  float& distance, F intersect) const {
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    glm::vec3 inverseDirection = getInverseDirection(direction);
+    float entry;
+    if (!findNodeIntersection(_nodes[0], origin, inverseDirection, distance, entry)) {
+        return false;
+    }
+
+    struct Visit {
+        uint32_t node;
+        float entry;
+    };
+    Visit stack[MAX_STACK_SIZE];
+    int size = 0;
+    stack[size++] = { 0, entry };
+
+    bool intersects = false;
+    while (size > 0) {
+        Visit visit = stack[--size];
+        // something closer was found since this node was pushed
+        if (visit.entry >= distance) {
+            continue;
+        }
+
+        const Node& node = _nodes[visit.node];
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                if (intersect(_indices[i], distance)) {
+                    intersects = true;
+                }
+            }
+            continue;
+        }
+
+        Visit left { visit.node + 1, 0.0f };
+        Visit right { node.offset, 0.0f };
+        bool hitsLeft = findNodeIntersection(_nodes[left.node], origin, inverseDirection, distance, left.entry);
+        bool hitsRight = findNodeIntersection(_nodes[right.node], origin, inverseDirection, distance, right.entry);
+
+        // push the farther child first, so that the nearer one is visited first
+        if (hitsLeft && hitsRight) {
+            if (left.entry < right.entry) {
+                stack[size++] = right;
+                stack[size++] = left;
+            } else {
+                stack[size++] = left;
+                stack[size++] = right;
+            }
+        } else if (hitsLeft) {
+            stack[size++] = left;
+        } else if (hitsRight) {
+            stack[size++] = right;
+        }
+    }
+    return intersects;
+}
+
+template <typename F>
+void BoundingVolumeHierarchy::findPointCandidates(const glm::vec3& point, F candidate) const {
+    if (_nodes.empty()) {
+        return;
+    }
+
+    uint32_t stack[MAX_STACK_SIZE];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        uint32_t index = stack[--size];
+        const Node& node = _nodes[index];
+        if (glm::any(glm::lessThan(point, node.minimum)) || glm::any(glm::greaterThan(point, node.maximum))) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                candidate(_indices[i]);
+            }
+        } else {
+            stack[size++] = node.offset;
+            stack[size++] = index + 1;
+        }
+    }
+}
+
+#endif // hifi_BoundingVolumeHierarchy_h
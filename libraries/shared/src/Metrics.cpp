@@ -0,0 +1,133 @@
+//
+//  Metrics.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Metrics.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::MetricsRegistry() {
+    _exitedThreadTotals.fill(0);
+    for (auto& gauge : _gauges) {
+        gauge.store(0, std::memory_order_relaxed);
+    }
+}
+
+int MetricsRegistry::registerMetric(const QString& name, Kind kind) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (const auto& metric : _metrics) {
+        if (metric.name == name) {
+            if (metric.kind != kind) {
+                qWarning() << "Metric" << name << "is already registered as a different kind of metric";
+                return INVALID_SLOT;
+            }
+            return metric.firstSlot;
+        }
+    }
+
+    int numSlots = kind == Kind::Histogram ? NUM_HISTOGRAM_BUCKETS : 1;
+    if (_numSlots + numSlots > MAX_SLOTS) {
+        qWarning() << "Out of metric slots, not recording" << name;
+        return INVALID_SLOT;
+    }
+
+    _metrics.push_back({ name, kind, _numSlots, numSlots });
+    _numSlots += numSlots;
+    return _metrics.back().firstSlot;
+}
+
+std::vector<MetricsRegistry::Metric> MetricsRegistry::getSchema() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _metrics;
+}
+
+size_t MetricsRegistry::getNumMetrics() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _metrics.size();
+}
+
+size_t MetricsRegistry::getNumThreads() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _threadSlots.size();
+}
+
+std::vector<quint64> MetricsRegistry::collect() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    std::vector<quint64> values(_numSlots, 0);
+    for (const auto& metric : _metrics) {
+        for (int slot = metric.firstSlot; slot < metric.firstSlot + metric.numSlots; ++slot) {
+            if (metric.kind == Kind::Gauge) {
+                values[slot] = _gauges[slot].load(std::memory_order_relaxed);
+            } else {
+                values[slot] = _exitedThreadTotals[slot];
+                for (const auto& threadSlots : _threadSlots) {
+                    values[slot] += (*threadSlots)[slot].load(std::memory_order_relaxed);
+                }
+            }
+        }
+    }
+    return values;
+}
+
+MetricsRegistry::LocalSlots::~LocalSlots() {
+    if (slots) {
+        MetricsRegistry::getInstance().releaseSlots(slots);
+    }
+}
+
+MetricsRegistry::Slots& MetricsRegistry::getLocalSlots() {
+    thread_local LocalSlots localSlots;
+
+    if (!localSlots.slots) {
+        std::unique_ptr<Slots> slots { new Slots() };
+        for (auto& slot : *slots) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        localSlots.slots = slots.get();
+        _threadSlots.push_back(std::move(slots));
+    }
+    return *localSlots.slots;
+}
+
+void MetricsRegistry::releaseSlots(Slots* slots) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // the thread is exiting, nothing writes these slots anymore
+    for (int slot = 0; slot < _numSlots; ++slot) {
+        _exitedThreadTotals[slot] += (*slots)[slot].load(std::memory_order_relaxed);
+    }
+
+    auto it = std::find_if(_threadSlots.begin(), _threadSlots.end(), [&](const std::unique_ptr<Slots>& threadSlots) {
+        return threadSlots.get() == slots;
+    });
+    if (it != _threadSlots.end()) {
+        _threadSlots.erase(it);
+    }
+}
+
+int MetricsRegistry::bucketForValue(quint64 value) {
+    int bucket = 0;
+    while (value > 0 && bucket < NUM_HISTOGRAM_BUCKETS - 1) {
+        value >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
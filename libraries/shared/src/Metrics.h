@@ -0,0 +1,136 @@
+//
+//  Metrics.h
+//  libraries/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_Metrics_h
+#define hifi_Metrics_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QString>
+
+/// Process wide set of named counters, gauges and histograms, cheap enough to update from a mixer's frame loop.
+///
+/// Counters and histograms are kept per thread: a thread only ever writes its own slots, with relaxed loads and
+/// stores rather than locked instructions, and collect() sums the slots of every live thread that wrote one,
+/// plus the counts that exited threads left behind.
+/// Gauges hold a single value for the whole process. Metrics can be registered at any time, but never go away.
+class MetricsRegistry {
+public:
+    enum class Kind : uint8_t {
+        Counter = 0,
+        Gauge,
+        Histogram
+    };
+
+    struct Metric {
+        QString name;
+        Kind kind;
+        int firstSlot;
+        int numSlots;
+    };
+
+    // histogram bucket 0 counts zeros, bucket i counts values in [2^(i-1), 2^i), and the last one everything above
+    static const int NUM_HISTOGRAM_BUCKETS = 32;
+    static const int MAX_SLOTS = 2048;
+    static const int INVALID_SLOT = -1;
+
+    static MetricsRegistry& getInstance();
+
+    /// Returns the first slot of the named metric, registering it the first time it is asked for.
+    /// Returns INVALID_SLOT if it was registered with a different kind, or if the slots ran out.
+    int registerMetric(const QString& name, Kind kind);
+
+    std::vector<Metric> getSchema() const;
+    size_t getNumMetrics() const;
+    size_t getNumThreads() const; // live threads that have their own slots
+
+    /// The current value of every slot: totals for counters and histogram buckets, values for gauges
+    std::vector<quint64> collect() const;
+
+    void add(int slot, quint64 value) {
+        if (slot != INVALID_SLOT) {
+            auto& localSlot = getLocalSlots()[slot];
+            localSlot.store(localSlot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+
+    void set(int slot, quint64 value) {
+        if (slot != INVALID_SLOT) {
+            _gauges[slot].store(value, std::memory_order_relaxed);
+        }
+    }
+
+    static int bucketForValue(quint64 value);
+
+private:
+    using Slots = std::array<std::atomic<quint64>, MAX_SLOTS>;
+
+    // the slots of a thread, handed back to the registry when the thread exits
+    struct LocalSlots {
+        ~LocalSlots();
+        Slots* slots { nullptr };
+    };
+
+    MetricsRegistry();
+    Slots& getLocalSlots();
+    void releaseSlots(Slots* slots);
+
+    mutable std::mutex _mutex;
+    std::vector<Metric> _metrics;
+    int _numSlots { 0 };
+
+    std::vector<std::unique_ptr<Slots>> _threadSlots;
+    std::array<quint64, MAX_SLOTS> _exitedThreadTotals; // folded in as threads exit, so that their counts are not lost
+    Slots _gauges;
+};
+
+class MetricCounter {
+public:
+    MetricCounter(const QString& name) :
+        _slot(MetricsRegistry::getInstance().registerMetric(name, MetricsRegistry::Kind::Counter)) {}
+
+    void add(quint64 value = 1) const { MetricsRegistry::getInstance().add(_slot, value); }
+
+private:
+    const int _slot;
+};
+
+class MetricGauge {
+public:
+    MetricGauge(const QString& name) :
+        _slot(MetricsRegistry::getInstance().registerMetric(name, MetricsRegistry::Kind::Gauge)) {}
+
+    void set(quint64 value) const { MetricsRegistry::getInstance().set(_slot, value); }
+
+private:
+    const int _slot;
+};
+
+class MetricHistogram {
+public:
+    MetricHistogram(const QString& name) :
+        _slot(MetricsRegistry::getInstance().registerMetric(name, MetricsRegistry::Kind::Histogram)) {}
+
+    void record(quint64 value) const {
+        if (_slot != MetricsRegistry::INVALID_SLOT) {
+            MetricsRegistry::getInstance().add(_slot + MetricsRegistry::bucketForValue(value), 1);
+        }
+    }
+
+private:
+    const int _slot;
+};
+
+#endif // hifi_Metrics_h
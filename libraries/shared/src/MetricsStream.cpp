@@ -0,0 +1,150 @@
+//
+//  MetricsStream.cpp
+//  libraries/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsStream.h"
+
+#include <algorithm>
+
+void MetricsStreamWriter::start(QIODevice* device) {
+    _device = device;
+    _stream.setDevice(device);
+    _numMetricsInSchema = 0;
+
+    // the first sample counts from now, rather than from whenever the process started
+    _lastValues = MetricsRegistry::getInstance().collect();
+
+    _stream.writeRawData(METRICS_STREAM_MAGIC.constData(), METRICS_STREAM_MAGIC.size());
+    _stream << METRICS_STREAM_VERSION;
+}
+
+void MetricsStreamWriter::stop() {
+    _stream.setDevice(nullptr);
+    _device = nullptr;
+}
+
+void MetricsStreamWriter::writeSchema() {
+    auto schema = MetricsRegistry::getInstance().getSchema();
+
+    _stream << (quint8)MetricsRecordType::Schema << (quint32)schema.size();
+    for (const auto& metric : schema) {
+        _stream << metric.name << (quint8)metric.kind << (qint32)metric.firstSlot << (qint32)metric.numSlots;
+    }
+    _numMetricsInSchema = schema.size();
+
+    // gauges are written in full after every schema, since the reader only learns of changes otherwise
+    _writeAllGauges = true;
+}
+
+void MetricsStreamWriter::writeSample(quint64 timestampUsecs) {
+    if (!_device) {
+        return;
+    }
+
+    auto& registry = MetricsRegistry::getInstance();
+    if (registry.getNumMetrics() != _numMetricsInSchema) {
+        writeSchema();
+    }
+
+    // metrics registered after the schema was read are left for the next sample
+    auto values = registry.collect();
+    _lastValues.resize(values.size(), 0);
+
+    // only the slots that changed are written, as slot and difference (or value, for gauges)
+    std::vector<std::pair<quint16, quint64>> changes;
+    auto schema = registry.getSchema();
+    for (size_t i = 0; i < _numMetricsInSchema && i < schema.size(); ++i) {
+        const auto& metric = schema[i];
+        for (int slot = metric.firstSlot; slot < metric.firstSlot + metric.numSlots; ++slot) {
+            bool isGauge = metric.kind == MetricsRegistry::Kind::Gauge;
+            if (values[slot] != _lastValues[slot] || (isGauge && _writeAllGauges)) {
+                changes.emplace_back((quint16)slot, isGauge ? values[slot] : values[slot] - _lastValues[slot]);
+                _lastValues[slot] = values[slot];
+            }
+        }
+    }
+
+    _writeAllGauges = false;
+
+    _stream << (quint8)MetricsRecordType::Sample << timestampUsecs << (quint32)changes.size();
+    for (const auto& change : changes) {
+        _stream << change.first << change.second;
+    }
+}
+
+bool MetricsStreamReader::start(QIODevice* device) {
+    _stream.setDevice(device);
+
+    QByteArray magic(METRICS_STREAM_MAGIC.size(), 0);
+    quint32 version = 0;
+    if (_stream.readRawData(magic.data(), magic.size()) != magic.size() || magic != METRICS_STREAM_MAGIC) {
+        return false;
+    }
+    _stream >> version;
+    return _stream.status() == QDataStream::Ok && version == METRICS_STREAM_VERSION;
+}
+
+bool MetricsStreamReader::readSample(Sample& sample) {
+    while (!_stream.atEnd()) {
+        quint8 recordType;
+        _stream >> recordType;
+
+        if (recordType == (quint8)MetricsRecordType::Schema) {
+            quint32 numMetrics;
+            _stream >> numMetrics;
+            _schema.clear();
+            _numSlots = 0;
+            for (quint32 i = 0; i < numMetrics && _stream.status() == QDataStream::Ok; ++i) {
+                MetricsRegistry::Metric metric;
+                quint8 kind;
+                qint32 firstSlot, numSlots;
+                _stream >> metric.name >> kind >> firstSlot >> numSlots;
+                metric.kind = (MetricsRegistry::Kind)kind;
+                metric.firstSlot = firstSlot;
+                metric.numSlots = numSlots;
+                _numSlots = std::max(_numSlots, firstSlot + numSlots);
+                _schema.push_back(metric);
+            }
+            if (_numSlots > MetricsRegistry::MAX_SLOTS) {
+                return false;
+            }
+            _gauges.resize(_numSlots, 0);
+        } else if (recordType == (quint8)MetricsRecordType::Sample) {
+            quint32 numChanges;
+            _stream >> sample.timestampUsecs >> numChanges;
+
+            sample.values.assign(_numSlots, 0);
+            for (const auto& metric : _schema) {
+                if (metric.kind == MetricsRegistry::Kind::Gauge) {
+                    sample.values[metric.firstSlot] = _gauges[metric.firstSlot];
+                }
+            }
+
+            for (quint32 i = 0; i < numChanges && _stream.status() == QDataStream::Ok; ++i) {
+                quint16 slot;
+                quint64 value;
+                _stream >> slot >> value;
+                if (slot >= _numSlots) {
+                    return false;
+                }
+                sample.values[slot] = value;
+                _gauges[slot] = value;
+            }
+            return _stream.status() == QDataStream::Ok;
+        } else {
+            return false;
+        }
+
+        if (_stream.status() != QDataStream::Ok) {
+            return false;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+//
+//  MetricsStream.h
+//  libraries/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MetricsStream_h
+#define hifi_MetricsStream_h
+
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QIODevice>
+
+#include "Metrics.h"
+
+// A metrics stream starts with METRICS_STREAM_MAGIC and the format version, followed by records that each start
+// with their type. A schema record lists every metric and its slots, and is written again whenever metrics
+// were added. A sample record holds a timestamp and the slots that changed since the previous sample: the
+// increase of counters and histogram buckets, or the value of gauges.
+const QByteArray METRICS_STREAM_MAGIC = "HFMETRIC";
+const quint32 METRICS_STREAM_VERSION = 1;
+const QString METRICS_STREAM_EXTENSION = "hfmetrics";
+
+enum class MetricsRecordType : quint8 {
+    Schema = 'S',
+    Sample = 'R'
+};
+
+/// Writes samples of the MetricsRegistry to a device, usually a file
+class MetricsStreamWriter {
+public:
+    /// writes the stream header, the device must already be open for writing
+    void start(QIODevice* device);
+    void stop();
+    bool isStarted() const { return _device != nullptr; }
+
+    void writeSample(quint64 timestampUsecs);
+
+private:
+    void writeSchema();
+
+    QIODevice* _device { nullptr };
+    QDataStream _stream;
+    size_t _numMetricsInSchema { 0 };
+    bool _writeAllGauges { false };
+    std::vector<quint64> _lastValues;
+};
+
+/// Reads back what a MetricsStreamWriter wrote
+class MetricsStreamReader {
+public:
+    struct Sample {
+        quint64 timestampUsecs { 0 };
+        std::vector<quint64> values; // per slot: the increase of counters and buckets, the value of gauges
+    };
+
+    /// reads and checks the stream header
+    bool start(QIODevice* device);
+
+    /// reads up to and including the next sample, returns false at the end of the stream or on a bad record
+    bool readSample(Sample& sample);
+
+    const std::vector<MetricsRegistry::Metric>& getSchema() const { return _schema; }
+
+private:
+    QDataStream _stream;
+    std::vector<MetricsRegistry::Metric> _schema;
+    std::vector<quint64> _gauges; // gauges keep their last value between samples
+    int _numSlots { 0 };
+};
+
+#endif // hifi_MetricsStream_h
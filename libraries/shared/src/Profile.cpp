@@ -38,28 +38,63 @@ static bool tracingEnabled() {
 }
 
 Duration::Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _name(name), _category(category) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
+    if (!category.isDebugEnabled()) {
+        return;
+    }
+
+    auto& traceRing = tracing::TraceRing::getInstance();
+    if (traceRing.isEnabled()) {
+        _traceRingNameId = traceRing.internName(name);
+        traceRing.record(category, _traceRingNameId, tracing::DurationBegin, (int64_t)payload);
+    }
+
+    if (tracingEnabled()) {
+        begin(argbColor, payload, baseArgs);
+    }
+}
+
+Duration::Duration(const QLoggingCategory& category, const char* name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) : _category(category) {
+    if (!category.isDebugEnabled()) {
+        return;
+    }
+
+    auto& traceRing = tracing::TraceRing::getInstance();
+    if (traceRing.isEnabled()) {
+        _traceRingNameId = traceRing.internName(name);
+        traceRing.record(category, _traceRingNameId, tracing::DurationBegin, (int64_t)payload);
+    }
+
+    if (tracingEnabled()) {
+        _name = name;
+        begin(argbColor, payload, baseArgs);
+    }
+}
+
+void Duration::begin(uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) {
+    QVariantMap args = baseArgs;
+    args["nv_payload"] = QVariant::fromValue(payload);
+    tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
 
 #if defined(NSIGHT_TRACING)
-        nvtxEventAttributes_t eventAttrib { 0 };
-        eventAttrib.version = NVTX_VERSION;
-        eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
-        eventAttrib.colorType = NVTX_COLOR_ARGB;
-        eventAttrib.color = argbColor;
-        eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
-        eventAttrib.message.ascii = name.toUtf8().data();
-        eventAttrib.payload.llValue = payload;
-        eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+    nvtxEventAttributes_t eventAttrib { 0 };
+    eventAttrib.version = NVTX_VERSION;
+    eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    eventAttrib.colorType = NVTX_COLOR_ARGB;
+    eventAttrib.color = argbColor;
+    eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    eventAttrib.message.ascii = _name.toUtf8().data();
+    eventAttrib.payload.llValue = payload;
+    eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
 
-        nvtxRangePushEx(&eventAttrib);
+    nvtxRangePushEx(&eventAttrib);
 #endif
-    }
 }
 
 Duration::~Duration() {
+    if (_traceRingNameId != tracing::TraceRing::INVALID_NAME) {
+        tracing::TraceRing::getInstance().record(_category, _traceRingNameId, tracing::DurationEnd);
+    }
+
     if (tracingEnabled() && _category.isDebugEnabled()) {
         tracing::traceEvent(_category, _name, tracing::DurationEnd);
 #ifdef NSIGHT_TRACING
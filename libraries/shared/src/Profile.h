@@ -11,6 +11,7 @@
 #define HIFI_PROFILE_
 
 #include "Trace.h"
+#include "TraceRing.h"
 #include "SharedUtil.h"
 
 // When profiling something that may happen many times per frame, use a xxx_detail category so that they may easily be filtered out of trace results
@@ -33,17 +34,23 @@ Q_DECLARE_LOGGING_CATEGORY(trace_simulation_animation_detail)
 Q_DECLARE_LOGGING_CATEGORY(trace_simulation_physics)
 Q_DECLARE_LOGGING_CATEGORY(trace_simulation_physics_detail)
 
+// Durations are always recorded in the TraceRing when it is enabled, and in the Tracer while it is tracing
 class Duration {
 public:
     Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
+    // literal names are only turned into a QString when the Tracer needs one
+    Duration(const QLoggingCategory& category, const char* name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
     ~Duration();
 
     static uint64_t beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor);
     static void endRange(const QLoggingCategory& category, uint64_t rangeId);
 
 private:
+    void begin(uint32_t argbColor, uint64_t payload, const QVariantMap& args);
+
     QString _name;
     const QLoggingCategory& _category;
+    uint16_t _traceRingNameId { tracing::TraceRing::INVALID_NAME };
 };
 
 
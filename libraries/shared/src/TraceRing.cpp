@@ -0,0 +1,290 @@
+//
+//  Created by agent on 2026/10/19
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraceRing.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRunnable>
+#include <QtCore/QThread>
+
+#include "Gzip.h"
+#include "PathUtils.h"
+#include "PortableHighResolutionClock.h"
+#include "Profile.h"
+#include "SharedUtil.h"
+
+using namespace tracing;
+
+// formats, compresses and writes a stall trace, away from the thread that stalled
+class TraceRing::StallTraceWriter : public QRunnable {
+public:
+    StallTraceWriter(Snapshot snapshot, const QString& path, const QString& reason, quint64 stallUsecs) :
+        _snapshot(std::move(snapshot)), _path(path), _reason(reason), _stallUsecs(stallUsecs) {}
+
+    void run() override {
+        QThread::currentThread()->setPriority(QThread::LowestPriority);
+
+        QDir().mkpath(QFileInfo(_path).absolutePath());
+        if (serialize(_path, _snapshot)) {
+            qWarning() << _reason << "stalled for" << _stallUsecs << "usecs, wrote the trace leading up to it to" << _path;
+        } else {
+            qWarning() << _reason << "stalled for" << _stallUsecs << "usecs, but its trace could not be written to" << _path;
+        }
+    }
+
+private:
+    Snapshot _snapshot;
+    QString _path;
+    QString _reason;
+    quint64 _stallUsecs;
+};
+
+TraceRing& TraceRing::getInstance() {
+    static TraceRing instance;
+    return instance;
+}
+
+TraceRing::TraceRing() {
+    _stallWriter.setMaxThreadCount(1);
+}
+
+quint64 TraceRing::now() {
+    // the same clock as the Tracer, so that both kinds of traces line up
+    return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
+uint16_t TraceRing::internName(const char* name) {
+    // names are usually literals, so the pointer is a good key, but it is checked in case the memory was reused
+    thread_local std::unordered_map<const char*, uint16_t> localNameIDs;
+
+    auto it = localNameIDs.find(name);
+    if (it != localNameIDs.end() && strcmp(_names[it->second].constData(), name) == 0) {
+        return it->second;
+    }
+
+    uint16_t nameID = internName(QString::fromUtf8(name));
+    localNameIDs[name] = nameID;
+    return nameID;
+}
+
+uint16_t TraceRing::internName(const QString& name) {
+    thread_local QHash<QString, uint16_t> localNameIDs;
+
+    auto it = localNameIDs.find(name);
+    if (it != localNameIDs.end()) {
+        return it.value();
+    }
+
+    QByteArray utf8Name = name.toUtf8();
+    uint16_t nameID = OVERFLOW_NAME;
+    {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+        auto existing = _nameIDs.find(utf8Name);
+        if (existing != _nameIDs.end()) {
+            nameID = existing.value();
+        } else if (_numNames < MAX_NAMES) {
+            nameID = _numNames++;
+            _names[nameID] = utf8Name;
+            _nameIDs[utf8Name] = nameID;
+        } else {
+            qWarning() << "Out of trace ring names, recording" << name << "without its name";
+        }
+    }
+
+    localNameIDs[name] = nameID;
+    return nameID;
+}
+
+TraceRing::LocalRing::~LocalRing() {
+    if (ring) {
+        TraceRing::getInstance().releaseRing(ring);
+    }
+}
+
+TraceRing::ThreadRing& TraceRing::getLocalRing() {
+    thread_local LocalRing localRing;
+
+    if (!localRing.ring) {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        if (!_freeRings.empty()) {
+            // the events of the thread that exited are only dropped now
+            localRing.ring = _freeRings.back();
+            _freeRings.pop_back();
+            localRing.ring->head.store(0, std::memory_order_relaxed);
+        } else {
+            _rings.emplace_back(new ThreadRing());
+            localRing.ring = _rings.back().get();
+        }
+        localRing.ring->threadID = int64_t(QThread::currentThreadId());
+        localRing.ring->threadName = QThread::currentThread()->objectName();
+    }
+    return *localRing.ring;
+}
+
+void TraceRing::releaseRing(ThreadRing* ring) {
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+    _freeRings.push_back(ring);
+}
+
+size_t TraceRing::getNumRings() {
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+    return _rings.size();
+}
+
+TraceRing::Snapshot TraceRing::takeSnapshot(quint64 lastUsecs) {
+    Snapshot snapshot;
+    quint64 since = lastUsecs > 0 ? now() - lastUsecs : 0;
+    {
+        std::lock_guard<std::mutex> lock(_ringsMutex);
+        std::vector<Event> ringEvents;
+        for (const auto& ring : _rings) {
+            uint64_t end = ring->head.load(std::memory_order_acquire);
+            uint64_t begin = end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0;
+
+            ringEvents.clear();
+            for (uint64_t i = begin; i < end; ++i) {
+                ringEvents.push_back(ring->events[i & (EVENTS_PER_THREAD - 1)]);
+            }
+
+            // the thread kept recording while its ring was copied, so drop what it may have overwritten meanwhile
+            uint64_t after = ring->head.load(std::memory_order_acquire);
+            uint64_t firstValid = after + 1 > EVENTS_PER_THREAD ? after + 1 - EVENTS_PER_THREAD : 0;
+            for (uint64_t i = std::max(begin, firstValid); i < end; ++i) {
+                const auto& event = ringEvents[i - begin];
+                if (event.timestamp >= since) {
+                    snapshot.events.push_back({ event, ring->threadID });
+                }
+            }
+
+            if (!ring->threadName.isEmpty()) {
+                snapshot.threadNames.emplace_back(ring->threadID, ring->threadName);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_namesMutex);
+        snapshot.names.reserve(_numNames);
+        for (uint16_t i = 0; i < _numNames; ++i) {
+            snapshot.names.push_back(QString::fromUtf8(_names[i]));
+        }
+    }
+    return snapshot;
+}
+
+void TraceRing::writeJson(QTextStream& out, quint64 lastUsecs) {
+    writeJson(out, takeSnapshot(lastUsecs));
+}
+
+bool TraceRing::serialize(const QString& path, quint64 lastUsecs) {
+    return serialize(path, takeSnapshot(lastUsecs));
+}
+
+void TraceRing::writeJson(QTextStream& out, const Snapshot& snapshot) {
+    auto events = snapshot.events;
+    std::stable_sort(events.begin(), events.end(), [](const Snapshot::ThreadEvent& a, const Snapshot::ThreadEvent& b) {
+        return a.event.timestamp < b.event.timestamp;
+    });
+    const auto& names = snapshot.names;
+
+    auto processID = QCoreApplication::applicationPid();
+    bool first = true;
+    auto writeEvent = [&](const TraceEvent& event) {
+        if (first) {
+            first = false;
+        } else {
+            out << ",\n";
+        }
+        event.writeJson(out);
+    };
+
+    out << "[\n";
+    for (const auto& threadName : snapshot.threadNames) {
+        writeEvent({ "", "thread_name", Metadata, 0, processID, threadName.first, trace_metadata(),
+                     { { "name", threadName.second } }, {} });
+    }
+    for (const auto& threadEvent : events) {
+        const auto& event = threadEvent.event;
+        const QString& name = event.nameId < names.size() ? names[event.nameId] : names[OVERFLOW_NAME];
+
+        QVariantMap args;
+        if (event.type == Counter) {
+            args[name] = QVariant::fromValue<qint64>(event.arg);
+        } else if (event.arg != 0) {
+            args["nv_payload"] = QVariant::fromValue<qint64>(event.arg);
+        }
+
+        writeEvent({ "", name, event.type, (qint64)event.timestamp, processID, threadEvent.threadID,
+                     *event.category, args, {} });
+    }
+    out << "\n]";
+}
+
+bool TraceRing::serialize(const QString& path, const Snapshot& snapshot) {
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        writeJson(out, snapshot);
+    }
+
+    if (path.endsWith(".gz")) {
+        QByteArray compressed;
+        gzip(data, compressed);
+        data = compressed;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+
+void TraceRing::setStallTraceOptions(const QString& directory, const QString& prefix, quint64 traceUsecs) {
+    std::lock_guard<std::mutex> lock(_stallMutex);
+    _stallDirectory = directory;
+    _stallPrefix = prefix;
+    _stallTraceUsecs = traceUsecs;
+}
+
+void TraceRing::reportStall(const QString& reason, quint64 stallUsecs) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    // if another thread is already reporting its stall, this one is most likely part of the same
+    std::unique_lock<std::mutex> lock(_stallMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    auto timestamp = usecTimestampNow();
+    if (_lastStallTrace != 0 && timestamp - _lastStallTrace < MIN_USECS_BETWEEN_STALL_TRACES) {
+        return;
+    }
+    _lastStallTrace = timestamp;
+
+    QString directory = _stallDirectory.isEmpty() ? PathUtils::getAppDataFilePath("traces/") : _stallDirectory;
+
+    QString prefix = _stallPrefix.isEmpty() ? QCoreApplication::applicationName() : _stallPrefix;
+    QString fileName = QString("%1-stall-%2.json.gz").arg(prefix)
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"));
+    QString path = QDir(directory).filePath(fileName);
+
+    _stallWriter.start(new StallTraceWriter(takeSnapshot(_stallTraceUsecs), path, reason, stallUsecs));
+}
@@ -0,0 +1,143 @@
+//
+//  Created by agent on 2026/10/19
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TraceRing_h
+#define hifi_TraceRing_h
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QTextStream>
+#include <QtCore/QThreadPool>
+
+#include "Trace.h"
+
+namespace tracing {
+
+// A flight recorder for servers: every thread records into its own fixed size ring of small binary events, with
+// interned names and an integer argument, so that it can be left on in production. Nothing is formatted until
+// the recent past is written out as Chrome trace JSON, typically when a stall was detected.
+class TraceRing {
+public:
+    static const size_t EVENTS_PER_THREAD = 1 << 14; // must be a power of two
+    static const uint16_t MAX_NAMES = 4096;
+    static const uint16_t INVALID_NAME = UINT16_MAX;
+    static const uint16_t OVERFLOW_NAME = 0; // shared by every name after MAX_NAMES
+    static const quint64 DEFAULT_STALL_TRACE_USECS = 5 * 1000 * 1000;
+    static const quint64 MIN_USECS_BETWEEN_STALL_TRACES = 60 * 1000 * 1000;
+
+    static TraceRing& getInstance();
+
+    void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    // names are interned once per thread and call site, later calls are a thread local lookup
+    uint16_t internName(const char* name);
+    uint16_t internName(const QString& name);
+
+    void record(const QLoggingCategory& category, uint16_t nameId, EventType type, int64_t arg = 0) {
+        if (nameId != INVALID_NAME) {
+            auto& ring = getLocalRing();
+            auto head = ring.head.load(std::memory_order_relaxed);
+            ring.events[head & (EVENTS_PER_THREAD - 1)] = { now(), arg, &category, nameId, type };
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+    }
+
+    /// Writes the events of the last lastUsecs (or all of them, for 0) as a Chrome trace JSON array
+    void writeJson(QTextStream& out, quint64 lastUsecs = 0);
+    /// As writeJson, to a file that is gzipped if path ends with .gz
+    bool serialize(const QString& path, quint64 lastUsecs = 0);
+
+    /// Where reportStall writes its traces: <directory>/<prefix>-stall-<date>-<time>.json.gz
+    void setStallTraceOptions(const QString& directory, const QString& prefix, quint64 traceUsecs);
+
+    /// Writes the last few seconds of events when a stall was detected, at most once a minute.
+    /// Only the copy of the events is made on the calling thread, they are written out on a low priority one.
+    void reportStall(const QString& reason, quint64 stallUsecs);
+
+    size_t getNumRings(); // one per live thread that recorded, at least
+
+private:
+    struct Event {
+        quint64 timestamp;
+        int64_t arg;
+        const QLoggingCategory* category;
+        uint16_t nameId;
+        EventType type;
+    };
+
+    struct ThreadRing {
+        std::array<Event, EVENTS_PER_THREAD> events;
+        std::atomic<uint64_t> head { 0 };
+        int64_t threadID;
+        QString threadName;
+    };
+
+    // the ring of a thread, handed back for another thread to reuse when the thread exits
+    struct LocalRing {
+        ~LocalRing();
+        ThreadRing* ring { nullptr };
+    };
+
+    // the events to write out, copied from the rings so that they can be formatted on any thread
+    struct Snapshot {
+        struct ThreadEvent {
+            Event event;
+            int64_t threadID;
+        };
+        std::vector<ThreadEvent> events;
+        std::vector<std::pair<int64_t, QString>> threadNames;
+        std::vector<QString> names;
+    };
+
+    class StallTraceWriter;
+
+    TraceRing();
+    ThreadRing& getLocalRing();
+    void releaseRing(ThreadRing* ring);
+    static quint64 now();
+
+    Snapshot takeSnapshot(quint64 lastUsecs);
+    static void writeJson(QTextStream& out, const Snapshot& snapshot);
+    static bool serialize(const QString& path, const Snapshot& snapshot);
+
+    std::atomic<bool> _enabled { false };
+
+    // names are only ever appended, and an id is only handed out once its name was stored
+    std::mutex _namesMutex;
+    std::array<QByteArray, MAX_NAMES> _names;
+    QHash<QByteArray, uint16_t> _nameIDs;
+    uint16_t _numNames { 1 };
+
+    // Rings of threads that have exited are kept until another thread needs one, since their last events may be
+    // what explains a stall. There are only ever as many rings as there were threads recording at once.
+    std::mutex _ringsMutex;
+    std::vector<std::unique_ptr<ThreadRing>> _rings;
+    std::vector<ThreadRing*> _freeRings;
+
+    std::mutex _stallMutex;
+    QString _stallDirectory;
+    QString _stallPrefix;
+    quint64 _stallTraceUsecs { DEFAULT_STALL_TRACE_USECS };
+    quint64 _lastStallTrace { 0 };
+    QThreadPool _stallWriter; // a single thread, so that stall traces never compete with each other
+};
+
+}
+
+#endif // hifi_TraceRing_h
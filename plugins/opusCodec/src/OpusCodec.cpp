@@ -0,0 +1,190 @@
+//
+//  OpusCodec.cpp
+//  plugins/opusCodec/src
+//
+//  Created by agent on 10/19/2026
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <QtCore/QDebug>
+
+#include <opus/opus.h>
+
+#include <AudioConstants.h>
+
+#include "OpusCodec.h"
+
+const char* OpusCodec::NAME { "opus" };
+
+// until the mixer has heard back from the listener, encode at the top of the range it adapts over
+static const int DEFAULT_BITRATE = 64000;
+static const int MIN_BITRATE = 6000;
+static const int MAX_BITRATE = 510000;
+
+// a single Opus frame never encodes to more than this
+static const int MAX_ENCODED_BYTES = 1275;
+
+void OpusCodec::init() {
+}
+
+void OpusCodec::deinit() {
+}
+
+bool OpusCodec::activate() {
+    CodecPlugin::activate();
+    return true;
+}
+
+void OpusCodec::deactivate() {
+    CodecPlugin::deactivate();
+}
+
+bool OpusCodec::isSupported() const {
+    return true;
+}
+
+class OpusAudioEncoder : public Encoder {
+public:
+    OpusAudioEncoder(int sampleRate, int numChannels) {
+        int error = OPUS_OK;
+        _encoder = opus_encoder_create(sampleRate, numChannels, OPUS_APPLICATION_VOIP, &error);
+        if (error != OPUS_OK) {
+            qWarning() << "Opus encoder could not be created:" << opus_strerror(error);
+            _encoder = nullptr;
+            return;
+        }
+        opus_encoder_ctl(_encoder, OPUS_SET_INBAND_FEC(1));
+        opus_encoder_ctl(_encoder, OPUS_SET_VBR(1));
+        opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(DEFAULT_BITRATE));
+        _appliedBitrate = DEFAULT_BITRATE;
+    }
+
+    virtual ~OpusAudioEncoder() {
+        if (_encoder) {
+            opus_encoder_destroy(_encoder);
+        }
+    }
+
+    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
+        if (!_encoder) {
+            encodedBuffer.clear();
+            return;
+        }
+
+        // retuning is deferred to here, so that it never races an encode
+        int bitrate = _bitrate.load(std::memory_order_relaxed);
+        if (bitrate != _appliedBitrate) {
+            opus_encoder_ctl(_encoder, OPUS_SET_BITRATE(bitrate));
+            _appliedBitrate = bitrate;
+        }
+        int lossPercent = _lossPercent.load(std::memory_order_relaxed);
+        if (lossPercent != _appliedLossPercent) {
+            opus_encoder_ctl(_encoder, OPUS_SET_PACKET_LOSS_PERC(lossPercent));
+            _appliedLossPercent = lossPercent;
+        }
+
+        encodedBuffer.resize(MAX_ENCODED_BYTES);
+        int bytes = opus_encode(_encoder, (const opus_int16*)decodedBuffer.constData(),
+                                AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL,
+                                (unsigned char*)encodedBuffer.data(), MAX_ENCODED_BYTES);
+        encodedBuffer.resize(std::max(bytes, 0));
+    }
+
+    virtual bool supportsBitrateAdaptation() const override { return true; }
+
+    virtual void setBitrate(int bitsPerSecond) override {
+        _bitrate.store(std::min(std::max(bitsPerSecond, MIN_BITRATE), MAX_BITRATE), std::memory_order_relaxed);
+    }
+
+    virtual int getBitrate() const override { return _bitrate.load(std::memory_order_relaxed); }
+
+    virtual void setExpectedPacketLoss(float lossRate) override {
+        int lossPercent = (int)(lossRate * 100.0f + 0.5f);
+        _lossPercent.store(std::min(std::max(lossPercent, 0), 100), std::memory_order_relaxed);
+    }
+
+private:
+    OpusEncoder* _encoder { nullptr };
+
+    std::atomic<int> _bitrate { DEFAULT_BITRATE };
+    std::atomic<int> _lossPercent { 0 };
+    int _appliedBitrate { 0 };
+    int _appliedLossPercent { 0 };
+};
+
+class OpusAudioDecoder : public Decoder {
+public:
+    OpusAudioDecoder(int sampleRate, int numChannels) : _numChannels(numChannels) {
+        _decodedSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * sizeof(int16_t) * numChannels;
+
+        int error = OPUS_OK;
+        _decoder = opus_decoder_create(sampleRate, numChannels, &error);
+        if (error != OPUS_OK) {
+            qWarning() << "Opus decoder could not be created:" << opus_strerror(error);
+            _decoder = nullptr;
+        }
+    }
+
+    virtual ~OpusAudioDecoder() {
+        if (_decoder) {
+            opus_decoder_destroy(_decoder);
+        }
+    }
+
+    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
+        decodeFrame((const unsigned char*)encodedBuffer.constData(), encodedBuffer.size(), decodedBuffer, 0);
+    }
+
+    virtual void lostFrame(QByteArray& decodedBuffer) override {
+        // this performs packet loss concealment
+        decodeFrame(nullptr, 0, decodedBuffer, 0);
+    }
+
+    virtual void recoverLostFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) override {
+        // the next packet carries a low bitrate copy of this frame, if the encoder expected loss
+        decodeFrame((const unsigned char*)nextEncodedBuffer.constData(), nextEncodedBuffer.size(), decodedBuffer, 1);
+    }
+
+private:
+    void decodeFrame(const unsigned char* data, int size, QByteArray& decodedBuffer, int decodeFEC) {
+        decodedBuffer.resize(_decodedSize);
+        int samples = 0;
+        if (_decoder) {
+            samples = opus_decode(_decoder, data, size, (opus_int16*)decodedBuffer.data(),
+                                  AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, decodeFEC);
+        }
+
+        // a corrupt packet, or a frame size we do not use, is heard as silence
+        int decodedBytes = std::max(samples, 0) * _numChannels * (int)sizeof(int16_t);
+        if (decodedBytes < _decodedSize) {
+            memset(decodedBuffer.data() + decodedBytes, 0, _decodedSize - decodedBytes);
+        }
+    }
+
+    OpusDecoder* _decoder { nullptr };
+    int _numChannels;
+    int _decodedSize;
+};
+
+Encoder* OpusCodec::createEncoder(int sampleRate, int numChannels) {
+    return new OpusAudioEncoder(sampleRate, numChannels);
+}
+
+Decoder* OpusCodec::createDecoder(int sampleRate, int numChannels) {
+    return new OpusAudioDecoder(sampleRate, numChannels);
+}
+
+void OpusCodec::releaseEncoder(Encoder* encoder) {
+    delete encoder;
+}
+
+void OpusCodec::releaseDecoder(Decoder* decoder) {
+    delete decoder;
+}
@@ -97,6 +97,30 @@ Item {
             ]
         }
 
+        PlotPerf {
+            title: "Scene Transactions"
+            height: parent.evalEvenHeight()
+            object: stats.config
+            plots: [
+                {
+                    prop: "frameTransactionCount",
+                    label: "Transactions",
+                    color: "#00B4EF"
+                },
+                {
+                    prop: "frameTransactionUpdateCount",
+                    label: "Updates",
+                    color: "#1AC567"
+                },
+                {
+                    prop: "frameTransactionApplyUsecs",
+                    label: "Apply",
+                    color: "#E2334D",
+                    unit: "us"
+                }
+            ]
+        }
+
         property var drawOpaqueConfig: Render.getConfig("RenderMainView.DrawOpaqueDeferred")
         property var drawTransparentConfig: Render.getConfig("RenderMainView.DrawTransparentDeferred")
         property var drawLightConfig: Render.getConfig("RenderMainView.DrawLight")
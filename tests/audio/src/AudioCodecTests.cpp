@@ -0,0 +1,267 @@
+//
+//  AudioCodecTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioCodecTests.h"
+
+#include <cmath>
+#include <vector>
+
+#include <AudioBitrateController.h>
+#include <AudioConstants.h>
+#include <NumericalConstants.h>
+#include <plugins/CodecPlugin.h>
+#include <plugins/PluginManager.h>
+
+QTEST_MAIN(AudioCodecTests)
+
+static const int LOWEST_LEVEL = 0;
+static const int HIGHEST_LEVEL = AudioBitrateController::NUM_LEVELS - 1;
+static const int GOOD_RTT_MSECS = 50;
+
+// one second of mix
+static const int NUM_BENCHMARK_FRAMES = AudioConstants::SAMPLE_RATE / AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+Q_DECLARE_METATYPE(CodecPluginPointer)
+
+// a tone in each channel, so that codecs have something to spend bits on
+static QByteArray createStereoFrame(int frameIndex) {
+    QByteArray frame(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+    int16_t* samples = reinterpret_cast<int16_t*>(frame.data());
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        float t = (frameIndex * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL + i) / (float)AudioConstants::SAMPLE_RATE;
+        samples[2 * i] = (int16_t)(8192.0f * sinf(TWO_PI * 440.0f * t));
+        samples[2 * i + 1] = (int16_t)(8192.0f * sinf(TWO_PI * 660.0f * t));
+    }
+    return frame;
+}
+
+void AudioCodecTests::testBitrateStepsDownOnLoss() {
+    AudioBitrateController controller;
+    QCOMPARE(controller.getLevel(), HIGHEST_LEVEL);
+
+    // heavy loss steps down once per report, to the lowest level and no further
+    for (int i = 0; i < AudioBitrateController::NUM_LEVELS + 2; i++) {
+        controller.update(0.2f, GOOD_RTT_MSECS);
+    }
+    QCOMPARE(controller.getLevel(), LOWEST_LEVEL);
+    QCOMPARE(controller.getBitrate(), AudioBitrateController::BITRATE_LEVELS[LOWEST_LEVEL]);
+    QVERIFY(controller.getExpectedPacketLoss() > 0.1f);
+}
+
+void AudioCodecTests::testBitrateStepsDownOnDelay() {
+    AudioBitrateController controller;
+
+    // a queue building up shows in the delay before any packet is lost
+    QVERIFY(controller.update(0.0f, 600));
+    QCOMPARE(controller.getLevel(), HIGHEST_LEVEL - 1);
+
+    // an unknown ping is not taken as congestion
+    QVERIFY(!controller.update(0.0f, -1));
+}
+
+void AudioCodecTests::testBitrateStepsUpSlowly() {
+    // step down on delay alone, so that no smoothed loss is left to decay
+    AudioBitrateController controller;
+    while (controller.getLevel() > LOWEST_LEVEL) {
+        controller.update(0.0f, 600);
+    }
+
+    // from here each level takes a run of clean reports
+    for (int level = LOWEST_LEVEL + 1; level <= HIGHEST_LEVEL; level++) {
+        for (int i = 1; i < AudioBitrateController::CLEAN_REPORTS_TO_STEP_UP; i++) {
+            QVERIFY(!controller.update(0.0f, GOOD_RTT_MSECS));
+        }
+        QVERIFY(controller.update(0.0f, GOOD_RTT_MSECS));
+        QCOMPARE(controller.getLevel(), level);
+    }
+
+    // and a single lossy report steps back down
+    QVERIFY(controller.update(1.0f, GOOD_RTT_MSECS));
+    QCOMPARE(controller.getLevel(), HIGHEST_LEVEL - 1);
+}
+
+void AudioCodecTests::testBitrateHoldsOnModerateLoss() {
+    AudioBitrateController controller;
+
+    // between clean and congested, the bitrate neither drops nor creeps back up
+    for (int i = 0; i < 50; i++) {
+        QVERIFY(!controller.update(0.03f, GOOD_RTT_MSECS));
+    }
+    QCOMPARE(controller.getLevel(), HIGHEST_LEVEL);
+}
+
+class ConcealingDecoder : public Decoder {
+public:
+    void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override { decodedBuffer = encodedBuffer; }
+    void lostFrame(QByteArray& decodedBuffer) override {
+        decodedBuffer = QByteArray(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+        lostFrames++;
+    }
+
+    int lostFrames { 0 };
+};
+
+// the error of a decoded frame against the one decoded without loss, relative to the level of the latter
+static float relativeError(const QByteArray& decoded, const QByteArray& reference) {
+    const int16_t* samples = reinterpret_cast<const int16_t*>(decoded.constData());
+    const int16_t* referenceSamples = reinterpret_cast<const int16_t*>(reference.constData());
+    int numSamples = reference.size() / (int)sizeof(int16_t);
+    double error = 0.0;
+    double level = 0.0;
+    for (int i = 0; i < numSamples; i++) {
+        double difference = (double)samples[i] - (double)referenceSamples[i];
+        error += difference * difference;
+        level += (double)referenceSamples[i] * referenceSamples[i];
+    }
+    return level > 0.0 ? (float)sqrt(error / level) : 1.0f;
+}
+
+void AudioCodecTests::testLostFrameRecovery() {
+    // codecs without forward error correction conceal a frame they cannot recover
+    ConcealingDecoder concealingDecoder;
+    QByteArray decoded;
+    concealingDecoder.recoverLostFrame(createStereoFrame(0), decoded);
+    QCOMPARE(concealingDecoder.lostFrames, 1);
+    QCOMPARE(decoded.size(), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+
+    // opus is the only one with forward error correction
+    CodecPluginPointer codec;
+    for (auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+        if (plugin->getName() == "opus") {
+            codec = plugin;
+        }
+    }
+    if (!codec) {
+        QSKIP("the opus codec plugin is not deployed beside the test");
+    }
+
+    const int NUM_FRAMES = 10;
+    const int LOST_FRAME = 8;
+    Encoder* encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    encoder->setExpectedPacketLoss(0.2f);
+    std::vector<QByteArray> packets(NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        encoder->encode(createStereoFrame(i), packets[i]);
+    }
+    codec->releaseEncoder(encoder);
+
+    // the frames as decoded without loss, which the codec delays and colors, to compare against
+    Decoder* referenceDecoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    std::vector<QByteArray> reference(NUM_FRAMES);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        referenceDecoder->decode(packets[i], reference[i]);
+    }
+    codec->releaseDecoder(referenceDecoder);
+
+    // the lost frame is rebuilt from the next packet as soon as it arrives, before that packet is decoded itself
+    Decoder* decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    for (int i = 0; i < LOST_FRAME; i++) {
+        decoder->decode(packets[i], decoded);
+    }
+    QByteArray recovered;
+    decoder->recoverLostFrame(packets[LOST_FRAME + 1], recovered);
+    decoder->decode(packets[LOST_FRAME + 1], decoded);
+    codec->releaseDecoder(decoder);
+
+    // the redundant copy is coded at a lower bitrate, so it is close to the frame but not the same
+    const float MAX_RECOVERED_ERROR = 0.5f;
+    QCOMPARE(recovered.size(), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+    float recoveredError = relativeError(recovered, reference[LOST_FRAME]);
+    QVERIFY2(recoveredError < MAX_RECOVERED_ERROR, qPrintable(QString("recovered error %1").arg(recoveredError)));
+
+    // and the decoder carries on from it to the next frame
+    QCOMPARE(decoded.size(), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+    float nextError = relativeError(decoded, reference[LOST_FRAME + 1]);
+    QVERIFY2(nextError < MAX_RECOVERED_ERROR, qPrintable(QString("next frame error %1").arg(nextError)));
+}
+
+void AudioCodecTests::addCodecRows() {
+    QTest::addColumn<CodecPluginPointer>("codec");
+    QTest::addColumn<int>("bitrate");
+
+    for (auto& codec : PluginManager::getInstance()->getCodecPlugins()) {
+        Encoder* encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+        bool adapts = encoder->supportsBitrateAdaptation();
+        codec->releaseEncoder(encoder);
+
+        if (adapts) {
+            for (int bitrate : AudioBitrateController::BITRATE_LEVELS) {
+                QString name = QString("%1 %2kbps").arg(codec->getName()).arg(bitrate / 1000);
+                QTest::newRow(qPrintable(name)) << codec << bitrate;
+            }
+        } else {
+            QTest::newRow(qPrintable(codec->getName())) << codec << 0;
+        }
+    }
+}
+
+void AudioCodecTests::benchmarkEncode_data() {
+    addCodecRows();
+}
+
+void AudioCodecTests::benchmarkEncode() {
+    QFETCH(CodecPluginPointer, codec);
+    QFETCH(int, bitrate);
+
+    Encoder* encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    if (bitrate > 0) {
+        encoder->setBitrate(bitrate);
+    }
+
+    std::vector<QByteArray> frames;
+    for (int i = 0; i < NUM_BENCHMARK_FRAMES; i++) {
+        frames.push_back(createStereoFrame(i));
+    }
+
+    QByteArray encoded;
+    int encodedBytes = 0;
+    QBENCHMARK {
+        encodedBytes = 0;
+        for (auto& frame : frames) {
+            encoder->encode(frame, encoded);
+            encodedBytes += encoded.size();
+        }
+    }
+    qDebug() << codec->getName() << "encodes a second of mix to" << encodedBytes << "bytes";
+
+    codec->releaseEncoder(encoder);
+}
+
+void AudioCodecTests::benchmarkDecode_data() {
+    addCodecRows();
+}
+
+void AudioCodecTests::benchmarkDecode() {
+    QFETCH(CodecPluginPointer, codec);
+    QFETCH(int, bitrate);
+
+    Encoder* encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    Decoder* decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    if (bitrate > 0) {
+        encoder->setBitrate(bitrate);
+    }
+
+    std::vector<QByteArray> packets(NUM_BENCHMARK_FRAMES);
+    for (int i = 0; i < NUM_BENCHMARK_FRAMES; i++) {
+        encoder->encode(createStereoFrame(i), packets[i]);
+    }
+
+    QByteArray decoded;
+    QBENCHMARK {
+        for (auto& packet : packets) {
+            decoder->decode(packet, decoded);
+        }
+    }
+    QCOMPARE(decoded.size(), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+
+    codec->releaseEncoder(encoder);
+    codec->releaseDecoder(decoder);
+}
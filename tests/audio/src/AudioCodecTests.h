@@ -0,0 +1,38 @@
+//
+//  AudioCodecTests.h
+//  tests/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioCodecTests_h
+#define hifi_AudioCodecTests_h
+
+#include <QtTest/QtTest>
+
+// Checks how the mixer adapts a listener's bitrate to its link, and benchmarks encoding and decoding a mix with each
+// codec plugin that can be loaded (codecs are only found if the plugins are deployed beside the test).
+class AudioCodecTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testBitrateStepsDownOnLoss();
+    void testBitrateStepsDownOnDelay();
+    void testBitrateStepsUpSlowly();
+    void testBitrateHoldsOnModerateLoss();
+    void testLostFrameRecovery();
+
+    void benchmarkEncode_data();
+    void benchmarkEncode();
+    void benchmarkDecode_data();
+    void benchmarkDecode();
+
+private:
+    void addCodecRows();
+};
+
+#endif // hifi_AudioCodecTests_h
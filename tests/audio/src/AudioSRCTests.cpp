@@ -0,0 +1,242 @@
+//
+//  AudioSRCTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioSRCTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioSRC.h>
+#include <AudioSRCBatch.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AudioSRCTests)
+
+Q_DECLARE_METATYPE(AudioSRC::Quality)
+
+// about what the mixer has to resample: a stereo stream per injector or client at a different rate
+static const int NUM_STREAMS = 16;
+static const int NUM_BENCHMARK_FRAMES = 48000;
+
+// a tone per channel, at a different phase in each stream
+static std::vector<float> createTone(int sampleRate, float hz, int numFrames, int numChannels, int stream = 0) {
+    std::vector<float> samples(numFrames * numChannels);
+    for (int i = 0; i < numFrames; i++) {
+        for (int ch = 0; ch < numChannels; ch++) {
+            samples[i * numChannels + ch] = 0.5f * sinf(TWO_PI * hz * i / sampleRate + stream + 0.5f * ch);
+        }
+    }
+    return samples;
+}
+
+static std::vector<int16_t> toInt16(const std::vector<float>& samples) {
+    std::vector<int16_t> result(samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+        result[i] = (int16_t)(samples[i] * AudioConstants::MAX_SAMPLE_VALUE);
+    }
+    return result;
+}
+
+// RMS of the output relative to the input, in dB, after the filter has settled
+static float resampledGainDB(int inputSampleRate, float hz, AudioSRC::Quality quality) {
+    auto input = createTone(inputSampleRate, hz, inputSampleRate, 1);
+
+    AudioSRC src(inputSampleRate, AudioConstants::SAMPLE_RATE, 1, quality);
+    std::vector<float> output(src.getMaxOutput(inputSampleRate));
+    int numFrames = src.render(input.data(), output.data(), inputSampleRate);
+
+    double sum = 0.0;
+    int start = numFrames / 4;
+    for (int i = start; i < numFrames; i++) {
+        sum += output[i] * output[i];
+    }
+    float rms = (float)sqrt(sum / (numFrames - start));
+    return 20.0f * log10f(rms / (0.5f / sqrtf(2.0f)) + 1e-9f);
+}
+
+void AudioSRCTests::addRateRows() {
+    QTest::addColumn<int>("inputSampleRate");
+    QTest::newRow("48000") << 48000;
+    QTest::newRow("44100") << 44100;
+    QTest::newRow("22050") << 22050;
+    QTest::newRow("11025") << 11025;
+    QTest::newRow("24001") << 24001;    // irrational
+}
+
+void AudioSRCTests::testQuality_data() {
+    QTest::addColumn<int>("inputSampleRate");
+    QTest::addColumn<AudioSRC::Quality>("quality");
+
+    for (int rate : { 48000, 44100 }) {
+        QTest::newRow(qPrintable(QString("%1 low").arg(rate))) << rate << AudioSRC::LOW_QUALITY;
+        QTest::newRow(qPrintable(QString("%1 medium").arg(rate))) << rate << AudioSRC::MEDIUM_QUALITY;
+        QTest::newRow(qPrintable(QString("%1 high").arg(rate))) << rate << AudioSRC::HIGH_QUALITY;
+    }
+}
+
+void AudioSRCTests::testQuality() {
+    QFETCH(int, inputSampleRate);
+    QFETCH(AudioSRC::Quality, quality);
+
+    // a tone well inside the passband is kept, one above the output Nyquist is filtered out rather than aliased
+    float passbandDB = resampledGainDB(inputSampleRate, 1000.0f, quality);
+    float stopbandDB = resampledGainDB(inputSampleRate, 15000.0f, quality);
+    qDebug() << "passband" << passbandDB << "dB, alias rejection" << -stopbandDB << "dB";
+
+    QVERIFY(std::abs(passbandDB) < 0.1f);
+    QVERIFY(stopbandDB < -50.0f);
+}
+
+void AudioSRCTests::testBatchMatchesSingle_data() {
+    addRateRows();
+}
+
+void AudioSRCTests::testBatchMatchesSingle() {
+    QFETCH(int, inputSampleRate);
+
+    const int NUM_FRAMES = 3000;
+    const int SPLIT = 777;  // not a block size, nor a period of the ratio
+
+    for (int numChannels : { 1, 2 }) {
+        AudioSRCBatch batch(inputSampleRate, AudioConstants::SAMPLE_RATE, NUM_STREAMS, numChannels);
+        int maxFrames = batch.getMaxOutput(NUM_FRAMES);
+
+        std::vector<std::vector<float>> inputs, outputs;
+        for (int s = 0; s < NUM_STREAMS; s++) {
+            inputs.push_back(createTone(inputSampleRate, 440.0f, NUM_FRAMES, numChannels, s));
+            outputs.emplace_back(maxFrames * numChannels);
+        }
+
+        // in two calls, to carry the history and phase across
+        std::vector<const float*> in(NUM_STREAMS);
+        std::vector<float*> out(NUM_STREAMS);
+        for (int s = 0; s < NUM_STREAMS; s++) {
+            in[s] = inputs[s].data();
+            out[s] = outputs[s].data();
+        }
+        int numFrames = batch.render(in.data(), out.data(), SPLIT);
+        for (int s = 0; s < NUM_STREAMS; s++) {
+            in[s] = inputs[s].data() + SPLIT * numChannels;
+            out[s] = outputs[s].data() + numFrames * numChannels;
+        }
+        numFrames += batch.render(in.data(), out.data(), NUM_FRAMES - SPLIT);
+
+        for (int s = 0; s < NUM_STREAMS; s++) {
+            AudioSRC src(inputSampleRate, AudioConstants::SAMPLE_RATE, numChannels);
+            std::vector<float> expected(maxFrames * numChannels);
+            QCOMPARE(src.render(inputs[s].data(), expected.data(), NUM_FRAMES), numFrames);
+
+            for (int i = 0; i < numFrames * numChannels; i++) {
+                QVERIFY(std::abs(outputs[s][i] - expected[i]) < 1e-5f);
+            }
+        }
+    }
+}
+
+void AudioSRCTests::testParallelMatchesSerial() {
+    const int NUM_FRAMES = 10 * 44100;
+    const int NUM_CHANNELS = AudioConstants::STEREO;
+
+    auto input = toInt16(createTone(44100, 440.0f, NUM_FRAMES, NUM_CHANNELS));
+
+    AudioSRC serial(44100, AudioConstants::SAMPLE_RATE, NUM_CHANNELS);
+    AudioSRC parallel(44100, AudioConstants::SAMPLE_RATE, NUM_CHANNELS);
+    std::vector<int16_t> expected(serial.getMaxOutput(NUM_FRAMES) * NUM_CHANNELS);
+    std::vector<int16_t> output(expected.size());
+
+    int numFrames = serial.render(input.data(), expected.data(), NUM_FRAMES);
+    QCOMPARE(parallel.renderParallel(input.data(), output.data(), NUM_FRAMES), numFrames);
+
+    // only the dither differs, including across the chunk boundaries
+    for (int i = 0; i < numFrames * NUM_CHANNELS; i++) {
+        QVERIFY(std::abs(output[i] - expected[i]) <= 2);
+    }
+}
+
+void AudioSRCTests::benchmarkStreams_data() {
+    QTest::addColumn<int>("inputSampleRate");
+    QTest::addColumn<bool>("batched");
+
+    QTest::newRow("44100 single") << 44100 << false;
+    QTest::newRow("44100 batch") << 44100 << true;
+    QTest::newRow("48000 single") << 48000 << false;
+    QTest::newRow("48000 batch") << 48000 << true;
+}
+
+void AudioSRCTests::benchmarkStreams() {
+    QFETCH(int, inputSampleRate);
+    QFETCH(bool, batched);
+
+    const int NUM_CHANNELS = AudioConstants::STEREO;
+    int blockFrames = inputSampleRate / 100;
+
+    std::vector<std::vector<int16_t>> inputs, outputs;
+    std::vector<std::unique_ptr<AudioSRC>> resamplers;
+    for (int s = 0; s < NUM_STREAMS; s++) {
+        inputs.push_back(toInt16(createTone(inputSampleRate, 440.0f, NUM_BENCHMARK_FRAMES, NUM_CHANNELS, s)));
+        resamplers.emplace_back(new AudioSRC(inputSampleRate, AudioConstants::SAMPLE_RATE, NUM_CHANNELS));
+        outputs.emplace_back(resamplers.back()->getMaxOutput(blockFrames) * NUM_CHANNELS);
+    }
+    AudioSRCBatch batch(inputSampleRate, AudioConstants::SAMPLE_RATE, NUM_STREAMS, NUM_CHANNELS);
+
+    std::vector<const int16_t*> in(NUM_STREAMS);
+    std::vector<int16_t*> out(NUM_STREAMS);
+    for (int s = 0; s < NUM_STREAMS; s++) {
+        out[s] = outputs[s].data();
+    }
+
+    // in blocks of 10ms, as streams arrive
+    QBENCHMARK {
+        for (int i = 0; i + blockFrames <= NUM_BENCHMARK_FRAMES; i += blockFrames) {
+            if (batched) {
+                for (int s = 0; s < NUM_STREAMS; s++) {
+                    in[s] = inputs[s].data() + i * NUM_CHANNELS;
+                }
+                batch.render(in.data(), out.data(), blockFrames);
+            } else {
+                for (int s = 0; s < NUM_STREAMS; s++) {
+                    resamplers[s]->render(inputs[s].data() + i * NUM_CHANNELS, out[s], blockFrames);
+                }
+            }
+        }
+    }
+}
+
+void AudioSRCTests::benchmarkFile_data() {
+    QTest::addColumn<bool>("parallel");
+
+    QTest::newRow("serial") << false;
+    QTest::newRow("parallel") << true;
+}
+
+void AudioSRCTests::benchmarkFile() {
+    QFETCH(bool, parallel);
+
+    // a minute of music
+    const int NUM_FRAMES = 60 * 44100;
+    const int NUM_CHANNELS = AudioConstants::STEREO;
+
+    auto input = toInt16(createTone(44100, 440.0f, NUM_FRAMES, NUM_CHANNELS));
+    std::vector<int16_t> output;
+
+    QBENCHMARK {
+        AudioSRC src(44100, AudioConstants::SAMPLE_RATE, NUM_CHANNELS);
+        output.resize(src.getMaxOutput(NUM_FRAMES) * NUM_CHANNELS);
+        if (parallel) {
+            src.renderParallel(input.data(), output.data(), NUM_FRAMES);
+        } else {
+            src.render(input.data(), output.data(), NUM_FRAMES);
+        }
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  AudioSRCTests.h
+//  tests/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioSRCTests_h
+#define hifi_AudioSRCTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that the batch and parallel resamplers match AudioSRC, measures passband gain and alias rejection,
+// and benchmarks resampling many streams one at a time against one batch, and a long file serially against in parallel.
+class AudioSRCTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testQuality_data();
+    void testQuality();
+    void testBatchMatchesSingle_data();
+    void testBatchMatchesSingle();
+    void testParallelMatchesSerial();
+
+    void benchmarkStreams_data();
+    void benchmarkStreams();
+    void benchmarkFile_data();
+    void benchmarkFile();
+
+private:
+    void addRateRows();
+};
+
+#endif // hifi_AudioSRCTests_h
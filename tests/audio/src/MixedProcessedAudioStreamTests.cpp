@@ -0,0 +1,97 @@
+//
+//  MixedProcessedAudioStreamTests.cpp
+//  tests/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MixedProcessedAudioStreamTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioSRC.h>
+#include <AudioTimeStretch.h>
+#include <MixedProcessedAudioStream.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(MixedProcessedAudioStreamTests)
+
+static const float TONE_HZ = 440.0f;
+static const float AMPLITUDE = 0.25f * std::numeric_limits<int16_t>::max();
+
+// a shortened, a regular and a lengthened frame, as accelerate() and expand() make them
+static const int FRAME_LENGTHS[] = {
+    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL - AudioTimeStretch::MAX_LAG,
+    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL,
+    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL + AudioTimeStretch::MAX_LAG
+};
+
+// the next numFrames of a stereo tone, continuing from frame
+static QByteArray createTone(int frame, int numFrames) {
+    QByteArray buffer(numFrames * AudioConstants::STEREO * AudioConstants::SAMPLE_SIZE, 0);
+    auto samples = reinterpret_cast<int16_t*>(buffer.data());
+    for (int i = 0; i < numFrames; i++) {
+        samples[2 * i] = samples[2 * i + 1] =
+            (int16_t)(AMPLITUDE * sinf(TWO_PI * TONE_HZ * (frame + i) / AudioConstants::SAMPLE_RATE));
+    }
+    return buffer;
+}
+
+void MixedProcessedAudioStreamTests::testRenderWithoutResampler() {
+    std::vector<int16_t> scratchBuffer;
+    int frame = 0;
+    for (int numFrames : FRAME_LENGTHS) {
+        QByteArray input = createTone(frame, numFrames);
+        frame += numFrames;
+
+        QByteArray output;
+        MixedProcessedAudioStream::renderToOutput(input, output, nullptr, nullptr, scratchBuffer);
+        QCOMPARE(output, input);
+    }
+}
+
+void MixedProcessedAudioStreamTests::testRenderWithResampler() {
+    const int OUTPUT_SAMPLE_RATE = 48000;
+    const int RATIO = OUTPUT_SAMPLE_RATE / AudioConstants::SAMPLE_RATE;
+    AudioSRC resampler(AudioConstants::SAMPLE_RATE, OUTPUT_SAMPLE_RATE, AudioConstants::STEREO);
+    std::vector<int16_t> scratchBuffer;
+
+    // several times over, so that the resampler is past its start up
+    std::vector<int16_t> output;
+    int frame = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int numFrames : FRAME_LENGTHS) {
+            QByteArray input = createTone(frame, numFrames);
+            frame += numFrames;
+
+            QByteArray outputBuffer;
+            MixedProcessedAudioStream::renderToOutput(input, outputBuffer, nullptr, &resampler, scratchBuffer);
+
+            // every input frame is resampled, whatever its length
+            int numOutputFrames = outputBuffer.size() / (AudioConstants::STEREO * AudioConstants::SAMPLE_SIZE);
+            QVERIFY(numOutputFrames >= resampler.getMinOutput(numFrames));
+            QVERIFY(numOutputFrames <= resampler.getMaxOutput(numFrames));
+
+            auto samples = reinterpret_cast<const int16_t*>(outputBuffer.constData());
+            output.insert(output.end(), samples, samples + numOutputFrames * AudioConstants::STEREO);
+        }
+    }
+
+    // nothing was lost or added between the frames, so the tone is as smooth at the output rate as it was
+    int numOutputFrames = (int)output.size() / AudioConstants::STEREO;
+    QVERIFY(std::abs(numOutputFrames - frame * RATIO) <= RATIO * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    const float MAX_STEP = 1.1f * AMPLITUDE * TWO_PI * TONE_HZ / OUTPUT_SAMPLE_RATE;
+    int settled = RATIO * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    for (int i = settled + 1; i < numOutputFrames; i++) {
+        QVERIFY(std::abs(output[2 * i] - output[2 * (i - 1)]) <= MAX_STEP);
+    }
+}
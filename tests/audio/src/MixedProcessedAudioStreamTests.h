@@ -0,0 +1,26 @@
+//
+//  MixedProcessedAudioStreamTests.h
+//  tests/audio/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MixedProcessedAudioStreamTests_h
+#define hifi_MixedProcessedAudioStreamTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that received frames the jitter buffer shortened or lengthened make it to the output whole.
+class MixedProcessedAudioStreamTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRenderWithoutResampler();
+    void testRenderWithResampler();
+};
+
+#endif // hifi_MixedProcessedAudioStreamTests_h
@@ -0,0 +1,150 @@
+//
+//  FBXGeometrySerializerTests.cpp
+//  tests/fbx/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXGeometrySerializerTests.h"
+
+#include <memory>
+
+#include <FBXGeometrySerializer.h>
+
+QTEST_MAIN(FBXGeometrySerializerTests)
+
+static const QString TEST_URL { "/models/test.fbx" };
+
+static FBXGeometry makeGeometry() {
+    FBXGeometry geometry;
+    geometry.originalURL = TEST_URL;
+    geometry.author = "tester";
+
+    FBXJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.0f;
+    joint.translation = glm::vec3(1.0f, 2.0f, 3.0f);
+    joint.rotation = glm::quat(0.5f, 0.5f, 0.5f, 0.5f);
+    joint.name = "Hips";
+    joint.isSkeletonJoint = true;
+    joint.bindTransformFoundInCluster = false;
+    joint.hasGeometricOffset = false;
+    joint.shapeInfo.points = { glm::vec3(0.1f), glm::vec3(0.2f) };
+    geometry.joints << joint;
+    geometry.jointIndices.insert(joint.name, 1);
+    geometry.hasSkeletonJoints = true;
+
+    FBXMesh mesh;
+    FBXMeshPart part;
+    part.triangleIndices = { 0, 1, 2, 0, 2, 3 };
+    part.materialID = "material";
+    mesh.parts << part;
+    mesh.vertices = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    mesh.normals = QVector<glm::vec3>(4, glm::vec3(0.0f, 0.0f, 1.0f));
+    mesh.texCoords = { glm::vec2(0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f), glm::vec2(0.0f, 1.0f) };
+    mesh.meshExtents = Extents(glm::vec3(0.0f), glm::vec3(1.0f, 1.0f, 0.0f));
+    mesh.meshIndex = 0;
+    geometry.meshes << mesh;
+    geometry.meshIndicesToModelNames.insert(0, "quad");
+
+    FBXMaterial material(glm::vec3(0.8f), glm::vec3(0.1f), glm::vec3(0.0f), 10.0f, 0.5f);
+    material.materialID = "material";
+    material.albedoTexture.filename = "albedo.png";
+    material.albedoTexture.transform.setScale(glm::vec3(2.0f));
+    material._material = std::make_shared<model::Material>();
+    material._material->setAlbedo(material.diffuseColor);
+    material._material->setRoughness(0.25f);
+    material._material->setOpacity(material.opacity);
+    geometry.materials.insert(material.materialID, material);
+
+    geometry.blendshapeChannelNames << "EyeBlink_L";
+    return geometry;
+}
+
+void FBXGeometrySerializerTests::testRoundTrip() {
+    FBXGeometry geometry = makeGeometry();
+    QByteArray data = FBXGeometrySerializer::serialize(geometry);
+
+    std::unique_ptr<FBXGeometry> restored(FBXGeometrySerializer::deserialize(data.constData(), data.size(), TEST_URL));
+    QVERIFY(restored);
+    QCOMPARE(restored->originalURL, geometry.originalURL);
+    QCOMPARE(restored->author, geometry.author);
+
+    QCOMPARE(restored->joints.size(), 1);
+    QCOMPARE(restored->joints[0].name, geometry.joints[0].name);
+    QVERIFY(restored->joints[0].translation == geometry.joints[0].translation);
+    QVERIFY(restored->joints[0].rotation == geometry.joints[0].rotation);
+    QVERIFY(restored->joints[0].shapeInfo.points == geometry.joints[0].shapeInfo.points);
+    QCOMPARE(restored->getJointIndex("Hips"), 0);
+
+    QCOMPARE(restored->meshes.size(), 1);
+    const FBXMesh& mesh = restored->meshes[0];
+    QVERIFY(mesh.vertices == geometry.meshes[0].vertices);
+    QVERIFY(mesh.texCoords == geometry.meshes[0].texCoords);
+    QCOMPARE(mesh.parts.size(), 1);
+    QCOMPARE(mesh.parts[0].triangleIndices, geometry.meshes[0].parts[0].triangleIndices);
+    QVERIFY(mesh.meshExtents.maximum == geometry.meshes[0].meshExtents.maximum);
+    // the gpu mesh is rebuilt on load
+    QVERIFY(mesh._mesh);
+    QCOMPARE((int)mesh._mesh->getNumVertices(), 4);
+    QCOMPARE(restored->getModelNameOfMesh(0), QString("quad"));
+
+    QVERIFY(restored->materials.contains("material"));
+    const FBXMaterial& material = restored->materials["material"];
+    const FBXMaterial& original = geometry.materials["material"];
+    QCOMPARE(material.opacity, original.opacity);
+    QCOMPARE(material.albedoTexture.filename, original.albedoTexture.filename);
+    QVERIFY(material.albedoTexture.transform.getScale() == original.albedoTexture.transform.getScale());
+    QVERIFY(material._material);
+    QCOMPARE(material._material->getRoughness(), original._material->getRoughness());
+    QVERIFY(material._material->getKey()._flags == original._material->getKey()._flags);
+
+    QCOMPARE(restored->blendshapeChannelNames, geometry.blendshapeChannelNames);
+
+    // encoding is stable
+    QCOMPARE(FBXGeometrySerializer::serialize(*restored), data);
+}
+
+void FBXGeometrySerializerTests::testCorruptData() {
+    QByteArray data = FBXGeometrySerializer::serialize(makeGeometry());
+
+    QByteArray truncated = data.left(data.size() - 1);
+    QVERIFY_EXCEPTION_THROWN(FBXGeometrySerializer::deserialize(truncated.constData(), truncated.size(), TEST_URL), QString);
+
+    QByteArray wrongVersion = data;
+    wrongVersion[4] = wrongVersion[4] + 1;
+    QVERIFY_EXCEPTION_THROWN(FBXGeometrySerializer::deserialize(wrongVersion.constData(), wrongVersion.size(), TEST_URL), QString);
+}
+
+// offsets into the encoding of an empty geometry: magic, version, three empty strings, then the joint sections
+static const int EMPTY_JOINT_COUNT_OFFSET = 5 * sizeof(quint32);
+static const int EMPTY_HAS_SKELETON_JOINTS_OFFSET = 7 * sizeof(quint32);
+
+void FBXGeometrySerializerTests::testInvalidBool() {
+    QByteArray data = FBXGeometrySerializer::serialize(FBXGeometry());
+    std::unique_ptr<FBXGeometry> restored(FBXGeometrySerializer::deserialize(data.constData(), data.size(), TEST_URL));
+    QVERIFY(restored);
+
+    QCOMPARE((int)data[EMPTY_HAS_SKELETON_JOINTS_OFFSET], 0);
+    data[EMPTY_HAS_SKELETON_JOINTS_OFFSET] = 2;
+    QVERIFY_EXCEPTION_THROWN(FBXGeometrySerializer::deserialize(data.constData(), data.size(), TEST_URL), QString);
+}
+
+void FBXGeometrySerializerTests::testOversizedSection() {
+    QByteArray data = FBXGeometrySerializer::serialize(FBXGeometry());
+
+    // a header alone, or less, is rejected before anything is read past it
+    QVERIFY_EXCEPTION_THROWN(FBXGeometrySerializer::deserialize(data.constData(), 3, TEST_URL), QString);
+    QVERIFY_EXCEPTION_THROWN(FBXGeometrySerializer::deserialize(data.constData(), 2 * sizeof(quint32), TEST_URL), QString);
+
+    // a joint count that the remaining bytes could hold one byte of each of, but not whole joints
+    quint32 jointCount = data.size() - EMPTY_JOINT_COUNT_OFFSET - sizeof(quint32);
+    QVERIFY(jointCount > 0);
+    memcpy(data.data() + EMPTY_JOINT_COUNT_OFFSET, &jointCount, sizeof(jointCount));
+    QVERIFY_EXCEPTION_THROWN(FBXGeometrySerializer::deserialize(data.constData(), data.size(), TEST_URL), QString);
+}
@@ -0,0 +1,27 @@
+//
+//  FBXGeometrySerializerTests.h
+//  tests/fbx/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXGeometrySerializerTests_h
+#define hifi_FBXGeometrySerializerTests_h
+
+#include <QtTest/QtTest>
+
+class FBXGeometrySerializerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testCorruptData();
+    void testInvalidBool();
+    void testOversizedSection();
+};
+
+#endif // hifi_FBXGeometrySerializerTests_h
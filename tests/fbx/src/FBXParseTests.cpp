@@ -0,0 +1,158 @@
+//
+//  FBXParseTests.cpp
+//  tests/fbx/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXParseTests.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDirIterator>
+
+#include <FBXReader.h>
+#include <FBXWriter.h>
+
+QTEST_MAIN(FBXParseTests)
+
+// builds a document shaped like a model: many geometries with big (compressible) arrays
+static FBXNode makeDocument(int numGeometries, int numVertices) {
+    FBXNode root;
+    FBXNode objects;
+    objects.name = "Objects";
+    for (int i = 0; i < numGeometries; ++i) {
+        FBXNode geometry;
+        geometry.name = "Geometry";
+        geometry.properties << QVariant::fromValue((qint64)i) << QByteArray("Geometry::mesh") << QByteArray("Mesh");
+
+        QVector<double> vertices;
+        QVector<qint32> indices;
+        vertices.reserve(3 * numVertices);
+        indices.reserve(numVertices);
+        for (int j = 0; j < numVertices; ++j) {
+            vertices << (double)(j % 101) << (double)(j % 37) * 0.5 << (double)i;
+            indices << ((j % 3 == 2) ? ~j : j);
+        }
+        FBXNode verticesNode;
+        verticesNode.name = "Vertices";
+        verticesNode.properties << QVariant::fromValue(vertices);
+        FBXNode indicesNode;
+        indicesNode.name = "PolygonVertexIndex";
+        indicesNode.properties << QVariant::fromValue(indices);
+        FBXNode versionNode;
+        versionNode.name = "GeometryVersion";
+        versionNode.properties << QVariant::fromValue((qint32)124);
+        FBXNode smallNode;
+        smallNode.name = "Weights";
+        smallNode.properties << QVariant::fromValue(QVector<float>({ 0.25f, 0.5f, 0.25f }));
+
+        geometry.children << verticesNode << indicesNode << versionNode << smallNode;
+        objects.children << geometry;
+    }
+    root.children << objects;
+    return root;
+}
+
+template<class T>
+static bool compareVectors(const QVariant& property, const QVariant& other) {
+    return property.value<QVector<T>>() == other.value<QVector<T>>();
+}
+
+static bool compareProperties(const QVariant& property, const QVariant& other) {
+    // QVariant can't compare the array types by value
+    int type = property.userType();
+    if (type == qMetaTypeId<QVector<float>>()) {
+        return compareVectors<float>(property, other);
+    } else if (type == qMetaTypeId<QVector<double>>()) {
+        return compareVectors<double>(property, other);
+    } else if (type == qMetaTypeId<QVector<qint32>>()) {
+        return compareVectors<qint32>(property, other);
+    } else if (type == qMetaTypeId<QVector<qint64>>()) {
+        return compareVectors<qint64>(property, other);
+    }
+    return property == other;
+}
+
+static void compareNodes(const FBXNode& node, const FBXNode& other) {
+    QCOMPARE(other.name, node.name);
+    QCOMPARE(other.properties.size(), node.properties.size());
+    for (int i = 0; i < node.properties.size(); ++i) {
+        QCOMPARE(other.properties[i].userType(), node.properties[i].userType());
+        QVERIFY(compareProperties(node.properties[i], other.properties[i]));
+    }
+    QCOMPARE(other.children.size(), node.children.size());
+    for (int i = 0; i < node.children.size(); ++i) {
+        compareNodes(node.children[i], other.children[i]);
+    }
+}
+
+static FBXNode parseBuffer(QByteArray& data) {
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    return FBXReader::parseFBX(&buffer);
+}
+
+void FBXParseTests::testRoundTrip() {
+    // enough data that the arrays are compressed and inflated in parallel
+    FBXNode document = makeDocument(16, 20000);
+    QByteArray data = FBXWriter::encodeFBX(document);
+
+    FBXNode parsed = parseBuffer(data);
+    compareNodes(document, parsed);
+
+    QVector<double> vertices = FBXReader::getDoubleVector(parsed.children[0].children[3].children[0]);
+    QCOMPARE(vertices.size(), 3 * 20000);
+    QCOMPARE(vertices[3 * 102], 1.0);
+}
+
+void FBXParseTests::testCorruptFile() {
+    QByteArray data = FBXWriter::encodeFBX(makeDocument(2, 2000));
+
+    QByteArray truncated = data.left(data.size() / 2);
+    QVERIFY_EXCEPTION_THROWN(parseBuffer(truncated), QString);
+
+    // damage the first compressed array
+    QByteArray damaged = data;
+    int vertices = damaged.indexOf("Vertices");
+    QVERIFY(vertices > 0);
+    for (int i = vertices + 40; i < vertices + 60; ++i) {
+        damaged[i] = (char)0xff;
+    }
+    QVERIFY_EXCEPTION_THROWN(parseBuffer(damaged), QString);
+}
+
+void FBXParseTests::benchmarkParseLargeMesh() {
+    QByteArray data = FBXWriter::encodeFBX(makeDocument(64, 50000));
+    QBENCHMARK {
+        parseBuffer(data);
+    }
+}
+
+void FBXParseTests::benchmarkParseSampleFiles_data() {
+    QTest::addColumn<QString>("path");
+
+    QString samplesDir = QFINDTESTDATA("../../../unpublishedScripts/marketplace");
+    if (samplesDir.isEmpty()) {
+        return;
+    }
+    QDirIterator it(samplesDir, { "*.fbx" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString path = it.next();
+        QTest::newRow(qPrintable(QDir(samplesDir).relativeFilePath(path))) << path;
+    }
+}
+
+void FBXParseTests::benchmarkParseSampleFiles() {
+    QFETCH(QString, path);
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QBENCHMARK {
+        file.seek(0);
+        FBXNode root = FBXReader::parseFBX(&file);
+        QVERIFY(!root.children.isEmpty());
+    }
+}
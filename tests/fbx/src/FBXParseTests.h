@@ -0,0 +1,28 @@
+//
+//  FBXParseTests.h
+//  tests/fbx/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXParseTests_h
+#define hifi_FBXParseTests_h
+
+#include <QtTest/QtTest>
+
+class FBXParseTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testCorruptFile();
+    void benchmarkParseLargeMesh();
+    void benchmarkParseSampleFiles_data();
+    void benchmarkParseSampleFiles();
+};
+
+#endif // hifi_FBXParseTests_h
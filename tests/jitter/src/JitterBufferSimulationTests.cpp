@@ -0,0 +1,297 @@
+//
+//  JitterBufferSimulationTests.cpp
+//  tests/jitter/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JitterBufferSimulationTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include <QtCore/QFile>
+#include <QtCore/QProcessEnvironment>
+#include <QtCore/QTextStream>
+
+#include <AudioConstants.h>
+#include <AudioTimeStretch.h>
+#include <InboundAudioStream.h>
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(JitterBufferSimulationTests)
+
+static const double FRAME_USECS = AudioConstants::NETWORK_FRAME_MSECS * 1000.0;
+static const int FRAME_CAPACITY = 100;
+static const quint64 BASE_DELAY_USECS = 2000;
+static const quint64 WARM_UP_USECS = 10 * 1000 * 1000;
+static const float TONE_HZ = 440.0f;
+
+static int16_t toneSample(qint64 frame) {
+    const float AMPLITUDE = 0.25f * std::numeric_limits<int16_t>::max();
+    return (int16_t)(AMPLITUDE * sinf(TWO_PI * TONE_HZ * frame / AudioConstants::SAMPLE_RATE));
+}
+
+static int maxStep(const int16_t* samples, int numFrames, int numChannels) {
+    int step = 0;
+    for (int i = 1; i < numFrames; i++) {
+        step = std::max(step, std::abs(samples[i * numChannels] - samples[(i - 1) * numChannels]));
+    }
+    return step;
+}
+
+static std::unique_ptr<NLPacket> createAudioPacket(quint16 sequence) {
+    auto packet = NLPacket::create(PacketType::MixedAudio);
+    packet->writePrimitive(sequence);
+    packet->writeString(QString());
+
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        samples[2 * i] = samples[2 * i + 1] = toneSample((qint64)sequence * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL + i);
+    }
+    packet->write(reinterpret_cast<const char*>(samples), sizeof(samples));
+
+    packet->seek(0);
+    return packet;
+}
+
+std::vector<JitterBufferSimulationTests::Arrival> JitterBufferSimulationTests::generateTrace(int numPackets,
+        quint64 jitterUsecs, float lossRate, quint64 stallUsecs, quint64 stallIntervalUsecs) {
+    // seeded, so that every run sees the same trace
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    std::vector<Arrival> trace;
+    for (int i = 0; i < numPackets; i++) {
+        if (unit(generator) < lossRate) {
+            continue;
+        }
+
+        quint64 arrival = (quint64)(i * FRAME_USECS) + BASE_DELAY_USECS + (quint64)(unit(generator) * jitterUsecs);
+
+        // Wi-Fi power saving and scans hold every packet for a while, then deliver them in a burst
+        if (stallUsecs > 0) {
+            quint64 stallStart = (arrival / stallIntervalUsecs) * stallIntervalUsecs + stallIntervalUsecs / 2;
+            if (arrival >= stallStart && arrival < stallStart + stallUsecs) {
+                arrival = stallStart + stallUsecs + (arrival - stallStart) / 100;
+            }
+        }
+
+        trace.push_back({ (quint16)i, arrival });
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const Arrival& a, const Arrival& b) {
+        return a.usecs < b.usecs;
+    });
+    return trace;
+}
+
+std::vector<JitterBufferSimulationTests::Arrival> JitterBufferSimulationTests::loadTrace(const QString& path) {
+    std::vector<Arrival> trace;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return trace;
+    }
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        QStringList fields = line.split(QRegExp("\\s+"));
+        bool sequenceOK = false;
+        bool usecsOK = false;
+        if (fields.size() >= 2) {
+            Arrival arrival { (quint16)fields[0].toUInt(&sequenceOK), fields[1].toULongLong(&usecsOK) };
+            if (sequenceOK && usecsOK) {
+                trace.push_back(arrival);
+            }
+        }
+    }
+
+    std::stable_sort(trace.begin(), trace.end(), [](const Arrival& a, const Arrival& b) {
+        return a.usecs < b.usecs;
+    });
+    return trace;
+}
+
+JitterBufferSimulationTests::Result JitterBufferSimulationTests::simulate(const std::vector<Arrival>& trace,
+        quint64 warmUpUsecs) {
+    Result result;
+    if (trace.empty()) {
+        return result;
+    }
+
+    InboundAudioStream stream(AudioConstants::STEREO, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, FRAME_CAPACITY, -1);
+    int numFrameSamples = stream.getNumFrameSamples();
+
+    // like the mixer, pop a frame on every tick, independently of when packets arrive
+    quint64 start = trace.front().usecs;
+    quint64 end = trace.back().usecs + (quint64)FRAME_USECS;
+    size_t next = 0;
+    double latencyFrames = 0.0;
+
+    for (double tick = start + FRAME_USECS / 2; tick <= end; tick += FRAME_USECS) {
+        while (next < trace.size() && trace[next].usecs <= tick) {
+            auto packet = createAudioPacket(trace[next].sequence);
+            ReceivedMessage message(*packet);
+            stream.parseData(message, trace[next].usecs);
+            ++next;
+        }
+
+        bool hasStarted = stream.hasStarted();
+        float framesBuffered = stream.getSamplesAvailable() / (float)numFrameSamples;
+        int framesPopped = stream.popFrames(1, true);
+
+        if (hasStarted && tick >= start + warmUpUsecs) {
+            result.pops++;
+            if (framesPopped == 0) {
+                result.failedPops++;
+            } else {
+                latencyFrames += framesBuffered;
+            }
+        }
+    }
+
+    result.concealedFrames = stream.getConcealedFrames();
+    result.acceleratedFrames = stream.getAcceleratedFrames();
+    result.expandedFrames = stream.getExpandedFrames();
+    result.desiredFrames = stream.getDesiredJitterBufferFrames();
+
+    int successfulPops = result.pops - result.failedPops;
+    if (successfulPops > 0) {
+        result.averageLatencyMsecs = (float)(latencyFrames / successfulPops) * AudioConstants::NETWORK_FRAME_MSECS;
+    }
+
+    qDebug() << "pops" << result.pops << "failed" << result.failedPops << "concealed" << result.concealedFrames
+        << "accelerated" << result.acceleratedFrames << "expanded" << result.expandedFrames
+        << "desired" << result.desiredFrames << "latency" << result.averageLatencyMsecs << "ms";
+    return result;
+}
+
+void JitterBufferSimulationTests::testTimeStretch() {
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int NUM_CHANNELS = AudioConstants::STEREO;
+
+    int16_t input[NUM_FRAMES * NUM_CHANNELS];
+    int16_t output[(NUM_FRAMES + AudioTimeStretch::MAX_LAG) * NUM_CHANNELS];
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        input[2 * i] = input[2 * i + 1] = toneSample(i);
+    }
+    int inputStep = maxStep(input, NUM_FRAMES, NUM_CHANNELS);
+
+    // a pitch period is removed or repeated, without a discontinuity
+    int accelerated = AudioTimeStretch::accelerate(input, output, NUM_FRAMES, NUM_CHANNELS);
+    QVERIFY(accelerated < NUM_FRAMES && accelerated >= NUM_FRAMES - AudioTimeStretch::MAX_LAG);
+    QVERIFY(maxStep(output, accelerated, NUM_CHANNELS) <= inputStep * 3 / 2);
+
+    int expanded = AudioTimeStretch::expand(input, output, NUM_FRAMES, NUM_CHANNELS);
+    QVERIFY(expanded > NUM_FRAMES && expanded <= NUM_FRAMES + AudioTimeStretch::MAX_LAG);
+    QVERIFY(maxStep(output, expanded, NUM_CHANNELS) <= inputStep * 3 / 2);
+
+    // noise has no period to remove, so it is left alone
+    std::mt19937 generator(17);
+    std::uniform_int_distribution<int> noise(-8192, 8192);
+    for (int i = 0; i < NUM_FRAMES * NUM_CHANNELS; i++) {
+        input[i] = (int16_t)noise(generator);
+    }
+    QCOMPARE(AudioTimeStretch::accelerate(input, output, NUM_FRAMES, NUM_CHANNELS), NUM_FRAMES);
+    QVERIFY(memcmp(input, output, sizeof(input)) == 0);
+
+    // silence can be shortened by as much as possible
+    memset(input, 0, sizeof(input));
+    QCOMPARE(AudioTimeStretch::accelerate(input, output, NUM_FRAMES, NUM_CHANNELS), NUM_FRAMES - AudioTimeStretch::MAX_LAG);
+}
+
+void JitterBufferSimulationTests::testExpandSplice() {
+    const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const int NUM_CHANNELS = AudioConstants::STEREO;
+
+    int16_t input[NUM_FRAMES * NUM_CHANNELS];
+    int16_t output[(NUM_FRAMES + AudioTimeStretch::MAX_LAG) * NUM_CHANNELS];
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        input[2 * i] = input[2 * i + 1] = toneSample(i);
+    }
+    int inputStep = maxStep(input, NUM_FRAMES, NUM_CHANNELS);
+
+    int expanded = AudioTimeStretch::expand(input, output, NUM_FRAMES, NUM_CHANNELS);
+    int lag = expanded - NUM_FRAMES;
+    QVERIFY(lag >= AudioTimeStretch::MIN_LAG && lag <= AudioTimeStretch::MAX_LAG);
+
+    // x[0:2L], a repeated period, then the tail x[2L:N] unchanged
+    QVERIFY(memcmp(output, input, 2 * lag * NUM_CHANNELS * sizeof(int16_t)) == 0);
+    QVERIFY(memcmp(&output[3 * lag * NUM_CHANNELS], &input[2 * lag * NUM_CHANNELS],
+                   (NUM_FRAMES - 2 * lag) * NUM_CHANNELS * sizeof(int16_t)) == 0);
+
+    // no jump where the repeated period starts or where the tail picks up after it
+    for (int splice : { 2 * lag, 3 * lag }) {
+        int step = std::abs(output[splice * NUM_CHANNELS] - output[(splice - 1) * NUM_CHANNELS]);
+        QVERIFY(step <= inputStep * 3 / 2);
+    }
+}
+
+void JitterBufferSimulationTests::testSteadyArrivals() {
+    auto result = simulate(generateTrace(3000, 1000, 0.0f, 0, 0), WARM_UP_USECS);
+
+    QVERIFY(result.pops > 0);
+    QCOMPARE(result.failedPops, 0);
+    QCOMPARE(result.concealedFrames, 0);
+    QVERIFY(result.desiredFrames <= 2);
+    QVERIFY(result.averageLatencyMsecs < 3 * AudioConstants::NETWORK_FRAME_MSECS);
+}
+
+void JitterBufferSimulationTests::testPacketLoss() {
+    const int NUM_PACKETS = 3000;
+    const float LOSS_RATE = 0.02f;
+    auto result = simulate(generateTrace(NUM_PACKETS, 1000, LOSS_RATE, 0, 0), WARM_UP_USECS);
+
+    // lost packets are concealed, without growing the buffer
+    QCOMPARE(result.failedPops, 0);
+    QVERIFY(result.concealedFrames > 0);
+    QVERIFY(result.concealedFrames <= 2 * LOSS_RATE * NUM_PACKETS);
+    QVERIFY(result.desiredFrames <= 2);
+}
+
+void JitterBufferSimulationTests::testWifiBursts() {
+    const int NUM_PACKETS = 6000;
+    const quint64 STALL_USECS = 100 * 1000;
+    const quint64 STALL_INTERVAL_USECS = 1000 * 1000;
+    auto result = simulate(generateTrace(NUM_PACKETS, 2000, 0.005f, STALL_USECS, STALL_INTERVAL_USECS), WARM_UP_USECS);
+
+    // the target covers most of each stall, concealment the rest, and the burst that follows is time-compressed
+    QVERIFY(result.desiredFrames >= 4 && result.desiredFrames <= 12);
+    QVERIFY(result.failedPops <= result.pops / 100);
+    QVERIFY(result.concealedFrames <= NUM_PACKETS / 10);
+    QVERIFY(result.acceleratedFrames > 0);
+    QVERIFY(result.averageLatencyMsecs < 150.0f);
+}
+
+void JitterBufferSimulationTests::testRecordedTraces() {
+    QString traces = QProcessEnvironment::systemEnvironment().value("HIFI_JITTER_TRACES");
+    if (traces.isEmpty()) {
+        QSKIP("set HIFI_JITTER_TRACES to the recorded traces to simulate");
+    }
+
+    for (const auto& path : traces.split(';', QString::SkipEmptyParts)) {
+        auto trace = loadTrace(path);
+        QVERIFY2(!trace.empty(), qPrintable("could not read a trace from " + path));
+
+        qDebug() << path;
+        auto result = simulate(trace, WARM_UP_USECS);
+        QVERIFY(result.pops > 0);
+    }
+}
@@ -0,0 +1,58 @@
+//
+//  JitterBufferSimulationTests.h
+//  tests/jitter/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JitterBufferSimulationTests_h
+#define hifi_JitterBufferSimulationTests_h
+
+#include <vector>
+
+#include <QtTest/QtTest>
+
+// Plays packet arrival traces through an InboundAudioStream on a simulated mixer clock, and checks how often it
+// concealed and how much latency it added.
+//
+// Traces are synthetic, or recorded ones listed in the HIFI_JITTER_TRACES environment variable (separated by ';').
+// A recorded trace is a text file with a line per received packet: its sequence number and arrival time in usecs.
+class JitterBufferSimulationTests : public QObject {
+    Q_OBJECT
+
+public:
+    struct Arrival {
+        quint16 sequence;
+        quint64 usecs;
+    };
+
+    struct Result {
+        int pops { 0 };
+        int failedPops { 0 };       // after the stream started, and after the warm up
+        int concealedFrames { 0 };
+        int acceleratedFrames { 0 };
+        int expandedFrames { 0 };
+        int desiredFrames { 0 };
+        float averageLatencyMsecs { 0.0f };
+    };
+
+private slots:
+    void testTimeStretch();
+    void testExpandSplice();
+    void testSteadyArrivals();
+    void testPacketLoss();
+    void testWifiBursts();
+    void testRecordedTraces();
+
+private:
+    static std::vector<Arrival> generateTrace(int numPackets, quint64 jitterUsecs, float lossRate,
+                                              quint64 stallUsecs, quint64 stallIntervalUsecs);
+    static std::vector<Arrival> loadTrace(const QString& path);
+    static Result simulate(const std::vector<Arrival>& trace, quint64 warmUpUsecs);
+};
+
+#endif // hifi_JitterBufferSimulationTests_h
@@ -0,0 +1,117 @@
+//
+//  CompressedAssetStoreTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "CompressedAssetStoreTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <CompressedAssetStore.h>
+
+QTEST_MAIN(CompressedAssetStoreTests)
+
+using Decision = CompressedAssetStore::Decision;
+
+static const AssetHash TEXT_HASH = QString(SHA256_HASH_HEX_LENGTH, 'a');
+static const AssetHash RANDOM_HASH = QString(SHA256_HASH_HEX_LENGTH, 'b');
+
+static void writeFile(const QString& path, const QByteArray& data) {
+    QFile file { path };
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(data), (qint64)data.size());
+}
+
+static QByteArray textData() {
+    QByteArray data;
+    for (int i = 0; i < 1000; ++i) {
+        data += "{ \"name\": \"entity\", \"position\": [0, 0, 0] },\n";
+    }
+    return data;
+}
+
+static QByteArray randomData() {
+    QByteArray data;
+    qsrand(1);
+    for (int i = 0; i < 16 * 1024; ++i) {
+        data.append((char)(qrand() & 0xff));
+    }
+    return data;
+}
+
+// an assets directory with a text asset and a random one, and an empty directory for the store
+struct Fixture {
+    QTemporaryDir files;
+    QTemporaryDir compressed;
+
+    Fixture() {
+        writeFile(files.filePath(TEXT_HASH), textData());
+        writeFile(files.filePath(RANDOM_HASH), randomData());
+    }
+};
+
+void CompressedAssetStoreTests::compressesWhenWorthIt() {
+    Fixture fixture;
+    CompressedAssetStore store { QDir(fixture.compressed.path()) };
+    QCOMPARE(store.getDecision(TEXT_HASH), Decision::Unknown);
+
+    QCOMPARE(store.compress(TEXT_HASH, fixture.files.filePath(TEXT_HASH)), Decision::Compressed);
+    QCOMPARE(store.getDecision(TEXT_HASH), Decision::Compressed);
+
+    QFile compressedFile { store.getCompressedFilePath(TEXT_HASH) };
+    QVERIFY(compressedFile.open(QIODevice::ReadOnly));
+    QCOMPARE(qUncompress(compressedFile.readAll()), textData());
+}
+
+void CompressedAssetStoreTests::recordsWhenNotWorthIt() {
+    Fixture fixture;
+    CompressedAssetStore store { QDir(fixture.compressed.path()) };
+
+    QCOMPARE(store.compress(RANDOM_HASH, fixture.files.filePath(RANDOM_HASH)), Decision::NotWorthIt);
+    QCOMPARE(store.getDecision(RANDOM_HASH), Decision::NotWorthIt);
+    // nothing that a send task would serve compressed
+    QVERIFY(!QFile::exists(store.getCompressedFilePath(RANDOM_HASH)));
+
+    // an asset that can't be read is left undecided, to be tried again
+    QCOMPARE(store.compress(TEXT_HASH, fixture.files.filePath("missing")), Decision::Unknown);
+    QCOMPARE(store.getDecision(TEXT_HASH), Decision::Unknown);
+}
+
+void CompressedAssetStoreTests::decisionsSurviveRestart() {
+    Fixture fixture;
+    {
+        CompressedAssetStore store { QDir(fixture.compressed.path()) };
+        QCOMPARE(store.compress(TEXT_HASH, fixture.files.filePath(TEXT_HASH)), Decision::Compressed);
+        QCOMPARE(store.compress(RANDOM_HASH, fixture.files.filePath(RANDOM_HASH)), Decision::NotWorthIt);
+    }
+
+    // a new store over the same directory, as after a server restart, knows both decisions without compressing
+    CompressedAssetStore reloaded { QDir(fixture.compressed.path()) };
+    QCOMPARE(reloaded.getDecision(TEXT_HASH), Decision::Compressed);
+    QCOMPARE(reloaded.getDecision(RANDOM_HASH), Decision::NotWorthIt);
+}
+
+void CompressedAssetStoreTests::removeAndOrphans() {
+    Fixture fixture;
+    CompressedAssetStore store { QDir(fixture.compressed.path()) };
+    store.compress(TEXT_HASH, fixture.files.filePath(TEXT_HASH));
+    store.compress(RANDOM_HASH, fixture.files.filePath(RANDOM_HASH));
+
+    store.remove(TEXT_HASH);
+    QCOMPARE(store.getDecision(TEXT_HASH), Decision::Unknown);
+    QVERIFY(!QFile::exists(store.getCompressedFilePath(TEXT_HASH)));
+
+    // the random asset went away while the store wasn't looking
+    store.compress(TEXT_HASH, fixture.files.filePath(TEXT_HASH));
+    QVERIFY(QFile::remove(fixture.files.filePath(RANDOM_HASH)));
+    store.removeOrphans(QDir(fixture.files.path()));
+    QCOMPARE(store.getDecision(RANDOM_HASH), Decision::Unknown);
+    QCOMPARE(store.getDecision(TEXT_HASH), Decision::Compressed);
+    QCOMPARE(QDir(fixture.compressed.path()).entryList(QDir::Files).size(), 1);
+}
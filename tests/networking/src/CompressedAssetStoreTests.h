@@ -0,0 +1,27 @@
+//
+//  CompressedAssetStoreTests.h
+//  tests/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_CompressedAssetStoreTests_h
+#define hifi_CompressedAssetStoreTests_h
+
+#include <QtTest/QtTest>
+
+class CompressedAssetStoreTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void compressesWhenWorthIt();
+    void recordsWhenNotWorthIt();
+    void decisionsSurviveRestart();
+    void removeAndOrphans();
+};
+
+#endif // hifi_CompressedAssetStoreTests_h
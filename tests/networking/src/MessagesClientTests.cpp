@@ -0,0 +1,72 @@
+//
+//  MessagesClientTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MessagesClientTests.h"
+
+#include <MessagesClient.h>
+#include <NLPacketList.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(MessagesClientTests)
+
+static const QString CHANNEL { "com.highfidelity.test" };
+
+// does what the messages mixer does with an encoded message: copies its payload into a new packet list per subscriber
+static QSharedPointer<ReceivedMessage> forward(std::unique_ptr<NLPacketList> encodedPacketList) {
+    const QByteArray payload = encodedPacketList->getMessage();
+
+    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(payload);
+    packetList->closeCurrentPacket();
+
+    return QSharedPointer<ReceivedMessage>::create(*packetList);
+}
+
+void MessagesClientTests::forwardedTextMessageTest() {
+    const QString text { "hello" };
+    const QUuid senderID = QUuid::createUuid();
+
+    auto receivedMessage = forward(MessagesClient::encodeMessagesPacket(CHANNEL, text, senderID));
+
+    QString channel, message;
+    QByteArray data;
+    bool isText { false };
+    QUuid decodedSenderID;
+    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, decodedSenderID);
+
+    QCOMPARE(channel, CHANNEL);
+    QVERIFY(isText);
+    QCOMPARE(message, text);
+    QCOMPARE(decodedSenderID, senderID);
+}
+
+void MessagesClientTests::forwardedDataMessageTest() {
+    QByteArray sent(udt::Packet::maxPayloadSize(true) * 3, 0);
+    for (int i = 0; i < sent.size(); ++i) {
+        sent[i] = (char)(i % 251);
+    }
+    const QUuid senderID = QUuid::createUuid();
+
+    auto encodedPacketList = MessagesClient::encodeMessagesDataPacket(CHANNEL, sent, senderID);
+    QVERIFY(encodedPacketList->getNumPackets() > 1);
+    auto receivedMessage = forward(std::move(encodedPacketList));
+
+    QString channel, message;
+    QByteArray data;
+    bool isText { true };
+    QUuid decodedSenderID;
+    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, decodedSenderID);
+
+    QCOMPARE(channel, CHANNEL);
+    QVERIFY(!isText);
+    QCOMPARE(data, sent);
+    QCOMPARE(decodedSenderID, senderID);
+}
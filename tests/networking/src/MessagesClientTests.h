@@ -0,0 +1,29 @@
+//
+//  MessagesClientTests.h
+//  tests/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MessagesClientTests_h
+#define hifi_MessagesClientTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class MessagesClientTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a text message that fits in one packet decodes the same after the messages mixer forwards it
+    void forwardedTextMessageTest();
+
+    // Test that a data message spanning several packets decodes the same after the messages mixer forwards it
+    void forwardedDataMessageTest();
+};
+
+#endif // hifi_MessagesClientTests_h
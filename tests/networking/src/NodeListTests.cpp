@@ -0,0 +1,101 @@
+//
+//  NodeListTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeListTests.h"
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <NodeList.h>
+#include <SettingInterface.h>
+
+QTEST_MAIN(NodeListTests)
+
+static const QUuid DOMAIN_ID = QUuid::createUuid();
+static const QUuid SESSION_ID = QUuid::createUuid();
+static const HifiSockAddr DOMAIN_SOCKET { QHostAddress::LocalHost, DEFAULT_DOMAIN_SERVER_PORT };
+
+// a domain list as the domain-server sends it, in a single packet
+static QSharedPointer<ReceivedMessage> makeDomainList(DomainListRevision revision, DomainListRevision baseRevision,
+                                                      const QVector<QUuid>& nodeIDs, const QVector<QUuid>& removedNodeIDs) {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << DOMAIN_ID << SESSION_ID << NodePermissions();
+    stream << revision << baseRevision << (quint32)(nodeIDs.size() + removedNodeIDs.size());
+
+    for (const auto& nodeID : nodeIDs) {
+        HifiSockAddr nodeSocket { QHostAddress::LocalHost, 40000 };
+        stream << (quint8)DomainListRecordType::Node;
+        stream << (qint8)NodeType::EntityServer << nodeID << nodeSocket << nodeSocket << NodePermissions() << false;
+        stream << QUuid::createUuid();
+    }
+    for (const auto& nodeID : removedNodeIDs) {
+        stream << (quint8)DomainListRecordType::RemovedNode << nodeID;
+    }
+
+    return QSharedPointer<ReceivedMessage>::create(data, PacketType::DomainList, versionForPacketType(PacketType::DomainList),
+                                                   DOMAIN_SOCKET, QUuid());
+}
+
+void NodeListTests::initTestCase() {
+    Setting::init();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent, 0);
+
+    // as if we had already connected to the domain
+    auto& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+    domainHandler.setSockAddr(DOMAIN_SOCKET, "localhost");
+    domainHandler.setUUID(DOMAIN_ID);
+    domainHandler.setIsConnected(true);
+}
+
+void NodeListTests::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+    DependencyManager::destroy<AccountManager>();
+}
+
+void NodeListTests::removedByDomainListTest() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid nodeID = QUuid::createUuid();
+
+    nodeList->processDomainServerList(makeDomainList(10, NO_DOMAIN_LIST_REVISION, { nodeID }, {}));
+    QVERIFY(nodeList->nodeWithUUID(nodeID));
+    QCOMPARE(nodeList->getDomainListRevision(), (DomainListRevision)10);
+
+    nodeList->processDomainServerList(makeDomainList(11, 10, {}, { nodeID }));
+    QVERIFY(!nodeList->nodeWithUUID(nodeID));
+    QCOMPARE(nodeList->getDomainListRevision(), (DomainListRevision)11);
+}
+
+void NodeListTests::killedNodeComesBackTest() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid nodeID = QUuid::createUuid();
+
+    nodeList->processDomainServerList(makeDomainList(20, NO_DOMAIN_LIST_REVISION, { nodeID }, {}));
+    QVERIFY(nodeList->nodeWithUUID(nodeID));
+    QCOMPARE(nodeList->getDomainListRevision(), (DomainListRevision)20);
+
+    // e.g. it went silent, while the domain-server still has it in the list it thinks we have
+    QVERIFY(nodeList->killNodeWithUUID(nodeID));
+    QCOMPARE(nodeList->getDomainListRevision(), NO_DOMAIN_LIST_REVISION);
+
+    // a delta from that list would never mention the node again, and is not adopted
+    nodeList->processDomainServerList(makeDomainList(21, 20, {}, {}));
+    QCOMPARE(nodeList->getDomainListRevision(), NO_DOMAIN_LIST_REVISION);
+
+    // so the next check in asks for a full list, which has the node again
+    nodeList->processDomainServerList(makeDomainList(22, NO_DOMAIN_LIST_REVISION, { nodeID }, {}));
+    QVERIFY(nodeList->nodeWithUUID(nodeID));
+    QCOMPARE(nodeList->getDomainListRevision(), (DomainListRevision)22);
+}
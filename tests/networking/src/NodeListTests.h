@@ -0,0 +1,32 @@
+//
+//  NodeListTests.h
+//  tests/networking/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeListTests_h
+#define hifi_NodeListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class NodeListTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    // Test that a node removed by a domain list delta keeps the revision the domain-server builds on
+    void removedByDomainListTest();
+
+    // Test that a node killed outside of a domain list makes us ask for a full list, which brings it back
+    void killedNodeComesBackTest();
+};
+
+#endif // hifi_NodeListTests_h
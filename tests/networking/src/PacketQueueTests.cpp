@@ -0,0 +1,205 @@
+//
+//  PacketQueueTests.cpp
+//  tests/networking/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketQueueTests.h"
+
+#include <thread>
+
+#include <QBuffer>
+#include <QSemaphore>
+
+#include <udt/PacketList.h>
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(PacketQueueTests)
+
+using namespace udt;
+
+static const QByteArray HEADER { "header" };
+
+static QByteArray makeData(int size) {
+    QByteArray data(size, 0);
+    for (int i = 0; i < size; ++i) {
+        data[i] = (char)(i % 251);
+    }
+    return data;
+}
+
+// a source whose every read waits to be allowed, to see what the queue does while a read is stuck on the disk
+class BlockingDevice : public QIODevice {
+public:
+    // unbuffered, so that every read of the packet list reaches readData()
+    BlockingDevice(const QByteArray& data) : _data(data) { open(QIODevice::ReadOnly | QIODevice::Unbuffered); }
+
+    QSemaphore readStarted;
+    QSemaphore readAllowed;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override {
+        readStarted.release();
+        readAllowed.acquire();
+        qint64 size = std::min(maxSize, (qint64)_data.size() - _position);
+        memcpy(data, _data.constData() + _position, size);
+        _position += size;
+        return size;
+    }
+    qint64 writeData(const char* data, qint64 maxSize) override { return -1; }
+
+private:
+    QByteArray _data;
+    qint64 _position { 0 };
+};
+
+// takes every packet from the queue, checks that they form one message and returns its payload
+// if source is given, also checks that it was never read more than one packet ahead of what was taken so far
+// (up to the last packet, at which point the packet list is done with the source and deletes it)
+static QByteArray takeMessage(PacketQueue& queue, int expectedNumPackets, const QIODevice* source = nullptr) {
+    QByteArray message;
+    int numPackets = 0;
+    MessageNumber messageNumber = 0;
+
+    while (!queue.isEmpty()) {
+        auto packet = queue.takePacket();
+        if (!packet) {
+            break;
+        }
+
+        if (numPackets == 0) {
+            messageNumber = packet->getMessageNumber();
+        }
+        Packet::PacketPosition expectedPosition;
+        if (expectedNumPackets == 1) {
+            expectedPosition = Packet::PacketPosition::ONLY;
+        } else if (numPackets == 0) {
+            expectedPosition = Packet::PacketPosition::FIRST;
+        } else if (numPackets == expectedNumPackets - 1) {
+            expectedPosition = Packet::PacketPosition::LAST;
+        } else {
+            expectedPosition = Packet::PacketPosition::MIDDLE;
+        }
+
+        if (!packet->isPartOfMessage() || packet->getMessageNumber() != messageNumber ||
+            packet->getPacketPosition() != expectedPosition ||
+            packet->getMessagePartNumber() != (Packet::MessagePartNumber)numPackets) {
+            return QByteArray();
+        }
+
+        message.append(packet->getPayload(), packet->getPayloadSize());
+        ++numPackets;
+
+        if (source && numPackets < expectedNumPackets &&
+            source->pos() > message.size() - HEADER.size() + Packet::maxPayloadSize(true)) {
+            return QByteArray();
+        }
+    }
+
+    return numPackets == expectedNumPackets ? message : QByteArray();
+}
+
+void PacketQueueTests::packetListTest() {
+    QByteArray data = makeData(Packet::maxPayloadSize(true) * 3);
+
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    packetList->write(HEADER);
+    packetList->write(data);
+    packetList->closeCurrentPacket();
+    int numPackets = (int)packetList->getNumPackets();
+    QCOMPARE(numPackets, 4);
+
+    PacketQueue queue;
+    queue.queuePacketList(std::move(packetList));
+    QCOMPARE(takeMessage(queue, numPackets), HEADER + data);
+    QVERIFY(queue.isEmpty());
+}
+
+void PacketQueueTests::streamedPacketListTest() {
+    QByteArray data = makeData(Packet::maxPayloadSize(true) * 3);
+    QBuffer* buffer = new QBuffer();
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    packetList->write(HEADER);
+    packetList->setStreamSource(std::unique_ptr<QIODevice>(buffer), data.size());
+    packetList->closeCurrentPacket();
+    QVERIFY(packetList->isStreamed());
+    int numPackets = (int)packetList->getNumPackets();
+    QCOMPARE(numPackets, 4);
+
+    PacketQueue queue;
+    queue.queuePacketList(std::move(packetList));
+
+    // only the first packet is read until one is taken
+    QCOMPARE(buffer->pos(), (qint64)(Packet::maxPayloadSize(true) - HEADER.size()));
+    QCOMPARE(takeMessage(queue, numPackets, buffer), HEADER + data);
+    QVERIFY(queue.isEmpty());
+}
+
+void PacketQueueTests::streamedSinglePacketTest() {
+    QByteArray data = makeData(100);
+    QBuffer* buffer = new QBuffer();
+    buffer->setData(data);
+    buffer->open(QIODevice::ReadOnly);
+
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    packetList->write(HEADER);
+    packetList->setStreamSource(std::unique_ptr<QIODevice>(buffer), data.size());
+    QCOMPARE((int)packetList->getNumPackets(), 1);
+
+    PacketQueue queue;
+    queue.queuePacketList(std::move(packetList));
+    QCOMPARE(takeMessage(queue, 1), HEADER + data);
+    QVERIFY(queue.isEmpty());
+}
+
+void PacketQueueTests::streamedReadUnlockedTest() {
+    QByteArray data = makeData(Packet::maxPayloadSize(true) * 3);
+    BlockingDevice* device = new BlockingDevice(data);
+
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    packetList->write(HEADER);
+    packetList->setStreamSource(std::unique_ptr<QIODevice>(device), data.size());
+    packetList->closeCurrentPacket();
+    int numPackets = (int)packetList->getNumPackets();
+
+    // the first packet is read as the list is queued
+    device->readAllowed.release();
+    PacketQueue queue;
+    queue.queuePacketList(std::move(packetList));
+    device->readStarted.acquire();
+
+    // taking it reads the next one, which gets stuck
+    bool isTaken = false;
+    std::thread sender([&] {
+        isTaken = (bool)queue.takePacket();
+    });
+    device->readStarted.acquire();
+
+    // meanwhile the queue can still be locked by others
+    bool isLocked = queue.getLock().try_lock();
+    if (isLocked) {
+        queue.queuePacket(Packet::create());
+        queue.getLock().unlock();
+    }
+
+    device->readAllowed.release(numPackets);
+    sender.join();
+    QVERIFY(isTaken);
+    QVERIFY(isLocked);
+
+    // the rest of the message, and the packet queued in the middle of it
+    int numTaken = 0;
+    while (!queue.isEmpty() && queue.takePacket()) {
+        ++numTaken;
+    }
+    QCOMPARE(numTaken, numPackets);
+    QVERIFY(queue.isEmpty());
+}
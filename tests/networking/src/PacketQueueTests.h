@@ -0,0 +1,35 @@
+//
+//  PacketQueueTests.h
+//  tests/networking/src
+//
+//  Created by agent on 10/18/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketQueueTests_h
+#define hifi_PacketQueueTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a packet list comes out of the queue numbered as one message
+    void packetListTest();
+
+    // Test that a streamed packet list reads its source no more than one packet ahead
+    void streamedPacketListTest();
+
+    // Test a streamed packet list that fits in a single packet
+    void streamedSinglePacketTest();
+
+    // Test that the queue is not locked while a streamed packet list reads its source
+    void streamedReadUnlockedTest();
+};
+
+#endif // hifi_PacketQueueTests_h
@@ -0,0 +1,143 @@
+//
+//  EntityContainmentIndexTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityContainmentIndexTests.h"
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <SettingInterface.h>
+
+QTEST_MAIN(EntityContainmentIndexTests)
+
+static const QString SCRIPT_URL = "file:///containment.js";
+static const glm::vec3 ENTITY_DIMENSIONS { 2.0f };
+static const glm::vec3 FIRST_POSITION { 10.0f, 10.0f, 10.0f };
+static const glm::vec3 SECOND_POSITION { 20.0f, 10.0f, 10.0f };
+
+static EntityTreePointer createTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    return tree;
+}
+
+// a box with or without a script, which does not need the domain's permission to rez
+static EntityItemPointer addBox(const EntityTreePointer& tree, const glm::vec3& position, const QString& script) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setDimensions(ENTITY_DIMENSIONS);
+    properties.setScript(script);
+    properties.setClientOnly(true);
+
+    EntityItemPointer entity;
+    tree->withWriteLock([&] {
+        entity = tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    });
+    return entity;
+}
+
+void EntityContainmentIndexTests::initTestCase() {
+    // EntityTree::addEntity() asks the node list for rez permissions
+    Setting::init();
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Agent, 0);
+}
+
+void EntityContainmentIndexTests::cleanupTestCase() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+    DependencyManager::destroy<AccountManager>();
+}
+
+void EntityContainmentIndexTests::testAddedEntities() {
+    auto tree = createTree();
+    auto scripted = addBox(tree, FIRST_POSITION, SCRIPT_URL);
+    auto plain = addBox(tree, FIRST_POSITION, QString());
+    QVERIFY(scripted && plain);
+
+    // only the entity with a script can be entered and left
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)1);
+    auto found = tree->findEntitiesContainingPoint(FIRST_POSITION);
+    QCOMPARE(found.size(), 1);
+    QVERIFY(found.contains(scripted));
+
+    QVERIFY(tree->findEntitiesContainingPoint(SECOND_POSITION).isEmpty());
+}
+
+void EntityContainmentIndexTests::testMovedEntity() {
+    auto tree = createTree();
+    auto entity = addBox(tree, FIRST_POSITION, SCRIPT_URL);
+    QVERIFY(entity);
+    QVERIFY(tree->findEntitiesContainingPoint(FIRST_POSITION).contains(entity));
+
+    // the index only hears of the move, and catches up on the next query
+    tree->withWriteLock([&] {
+        entity->setPosition(SECOND_POSITION);
+    });
+    QVERIFY(tree->findEntitiesContainingPoint(FIRST_POSITION).isEmpty());
+    QVERIFY(tree->findEntitiesContainingPoint(SECOND_POSITION).contains(entity));
+}
+
+void EntityContainmentIndexTests::testScriptChange() {
+    auto tree = createTree();
+    auto entity = addBox(tree, FIRST_POSITION, QString());
+    QVERIFY(entity);
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)0);
+
+    entity->setScript(SCRIPT_URL);
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)1);
+    QVERIFY(tree->findEntitiesContainingPoint(FIRST_POSITION).contains(entity));
+
+    entity->setScript(QString());
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)0);
+    QVERIFY(tree->findEntitiesContainingPoint(FIRST_POSITION).isEmpty());
+}
+
+void EntityContainmentIndexTests::testDeletedEntity() {
+    auto tree = createTree();
+    auto entity = addBox(tree, FIRST_POSITION, SCRIPT_URL);
+    auto other = addBox(tree, FIRST_POSITION, SCRIPT_URL);
+    QVERIFY(entity && other);
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)2);
+
+    // moved, then deleted before the next query
+    tree->withWriteLock([&] {
+        entity->setPosition(SECOND_POSITION);
+        tree->deleteEntity(entity->getEntityItemID(), true);
+    });
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)1);
+    QVERIFY(tree->findEntitiesContainingPoint(SECOND_POSITION).isEmpty());
+    auto found = tree->findEntitiesContainingPoint(FIRST_POSITION);
+    QCOMPARE(found.size(), 1);
+    QVERIFY(found.contains(other));
+
+    // as a script change racing with the deletion would, after it
+    tree->updateContainmentIndex(entity);
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)1);
+    QVERIFY(!entity->isContainmentIndexed());
+}
+
+void EntityContainmentIndexTests::testServerTree() {
+    auto tree = createTree();
+    tree->setIsServer(true);
+    auto entity = addBox(tree, FIRST_POSITION, SCRIPT_URL);
+    QVERIFY(entity);
+
+    QCOMPARE(tree->getContainmentIndex().size(), (size_t)0);
+    QVERIFY(!entity->isContainmentIndexed());
+}
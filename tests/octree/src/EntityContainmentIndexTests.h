@@ -0,0 +1,32 @@
+//
+//  EntityContainmentIndexTests.h
+//  tests/octree/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityContainmentIndexTests_h
+#define hifi_EntityContainmentIndexTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that a tree's containment index follows its entities as they are added, moved, change script and are deleted.
+class EntityContainmentIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testAddedEntities();
+    void testMovedEntity();
+    void testScriptChange();
+    void testDeletedEntity();
+    void testServerTree();
+};
+
+#endif // hifi_EntityContainmentIndexTests_h
@@ -0,0 +1,164 @@
+//
+//  EntityPhysicsUpdateTests.cpp
+//  tests/octree/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsUpdateTests.h"
+
+#include <vector>
+
+#include <EntityItemProperties.h>
+#include <EntityPhysicsUpdate.h>
+#include <EntityTree.h>
+#include <GLMHelpers.h>
+#include <Node.h>
+#include <OctalCode.h>
+#include <ReceivedMessage.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(EntityPhysicsUpdateTests)
+
+static const int MESSAGE_SIZE = 1024;
+static const quint64 NOW = 1000000000;
+static const float EPSILON = 0.001f;
+
+static EntityPhysicsUpdate createUpdate(int i) {
+    EntityPhysicsUpdate update;
+    update.id = EntityItemID(QUuid::createUuid());
+    update.position = glm::vec3(1.0f + i, 2.0f, 3.0f);
+    update.rotation = glm::angleAxis(0.1f * i, Vectors::UNIT_Y);
+    update.velocity = glm::vec3(0.0f, -1.0f * i, 0.0f);
+    update.angularVelocity = (i % 2) ? glm::vec3(0.0f, 0.5f, 0.0f) : Vectors::ZERO;
+    update.hasQueryAACube = (i % 3) == 0;
+    if (update.hasQueryAACube) {
+        update.queryAACube = AACube(update.position - glm::vec3(0.5f), 1.0f);
+    }
+    update.lastEdited = NOW - i * 1000;
+    return update;
+}
+
+static QByteArray encode(const std::vector<EntityPhysicsUpdate>& updates, int& numPacked) {
+    QByteArray buffer(MESSAGE_SIZE, 0);
+    numPacked = EntityPhysicsUpdate::encodeBulkMessage(updates.data(), (int)updates.size(), buffer);
+    return buffer;
+}
+
+void EntityPhysicsUpdateTests::testRoundTrip() {
+    std::vector<EntityPhysicsUpdate> updates;
+    for (int i = 0; i < 6; i++) {
+        updates.push_back(createUpdate(i));
+    }
+    int numPacked;
+    QByteArray message = encode(updates, numPacked);
+    QCOMPARE(numPacked, (int)updates.size());
+
+    quint64 lastEdited;
+    std::vector<EntityPhysicsUpdate> decoded;
+    int bytesRead = EntityPhysicsUpdate::decodeBulkMessage(reinterpret_cast<const unsigned char*>(message.constData()),
+                                                           message.size(), lastEdited, decoded);
+    QCOMPARE(bytesRead, message.size());
+    QCOMPARE(decoded.size(), updates.size());
+    QCOMPARE(lastEdited, NOW);
+
+    for (size_t i = 0; i < updates.size(); i++) {
+        QCOMPARE(decoded[i].id, updates[i].id);
+        QCOMPARE_WITH_ABS_ERROR(decoded[i].position, updates[i].position, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(decoded[i].rotation, updates[i].rotation, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(decoded[i].velocity, updates[i].velocity, EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(decoded[i].angularVelocity, updates[i].angularVelocity, EPSILON);
+        QCOMPARE(decoded[i].hasQueryAACube, updates[i].hasQueryAACube);
+        if (updates[i].hasQueryAACube) {
+            QCOMPARE(decoded[i].queryAACube, updates[i].queryAACube);
+        }
+    }
+}
+
+void EntityPhysicsUpdateTests::testPerEntityTimestamps() {
+    // an older update packed with a newer one keeps its own time, so that it cannot win over edits made in between
+    std::vector<EntityPhysicsUpdate> updates { createUpdate(1), createUpdate(5), createUpdate(0) };
+    int numPacked;
+    QByteArray message = encode(updates, numPacked);
+    QCOMPARE(numPacked, 3);
+
+    quint64 lastEdited;
+    std::vector<EntityPhysicsUpdate> decoded;
+    EntityPhysicsUpdate::decodeBulkMessage(reinterpret_cast<const unsigned char*>(message.constData()),
+                                           message.size(), lastEdited, decoded);
+    QCOMPARE(decoded.size(), (size_t)3);
+    for (size_t i = 0; i < updates.size(); i++) {
+        QCOMPARE(decoded[i].lastEdited, updates[i].lastEdited);
+
+        EntityItemProperties properties;
+        decoded[i].copyToProperties(properties);
+        QCOMPARE(properties.getLastEdited(), updates[i].lastEdited);
+    }
+}
+
+void EntityPhysicsUpdateTests::testTruncatedMessage() {
+    std::vector<EntityPhysicsUpdate> updates { createUpdate(0), createUpdate(1), createUpdate(2) };
+    int numPacked;
+    QByteArray message = encode(updates, numPacked);
+
+    // every cut short of the whole message is malformed
+    for (int length = 0; length < message.size(); length++) {
+        quint64 lastEdited;
+        std::vector<EntityPhysicsUpdate> decoded;
+        int bytesRead = EntityPhysicsUpdate::decodeBulkMessage(reinterpret_cast<const unsigned char*>(message.constData()),
+                                                               length, lastEdited, decoded);
+        QCOMPARE(bytesRead, 0);
+    }
+}
+
+void EntityPhysicsUpdateTests::testServerSkipsMalformedMessage_data() {
+    QTest::addColumn<QByteArray>("message");
+
+    std::vector<EntityPhysicsUpdate> updates { createUpdate(0), createUpdate(1) };
+    int numPacked;
+    QByteArray message = encode(updates, numPacked);
+
+    QTest::newRow("truncated") << message.left(message.size() - 5);
+
+    // claims far more updates than follow
+    QByteArray tooManyUpdates = message;
+    quint16 numUpdates = 1000;
+    const unsigned char* octcode = reinterpret_cast<const unsigned char*>(message.constData());
+    int countOffset = (int)bytesRequiredForCodeLength(numberOfThreeBitSectionsInCode(octcode)) + sizeof(quint64);
+    memcpy(tooManyUpdates.data() + countOffset, &numUpdates, sizeof(numUpdates));
+    QTest::newRow("too many updates") << tooManyUpdates;
+
+    QTest::newRow("garbage") << QByteArray(64, (char)0xff);
+}
+
+void EntityPhysicsUpdateTests::testServerSkipsMalformedMessage() {
+    QFETCH(QByteArray, message);
+
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    auto sender = SharedNodePointer::create(QUuid::createUuid(), NodeType::Agent, HifiSockAddr(), HifiSockAddr());
+    ReceivedMessage received(message, PacketType::EntityPhysicsBulk, 0, HifiSockAddr());
+
+    // as OctreeInboundPacketProcessor::processPacket() does, which would spin forever if nothing were read
+    int numEdits = 0;
+    while (received.getBytesLeftToRead() > 0 && numEdits < message.size()) {
+        const unsigned char* editData =
+            reinterpret_cast<const unsigned char*>(received.getRawMessage() + received.getPosition());
+        int maxSize = received.getBytesLeftToRead();
+        int bytesRead = 0;
+        tree->withWriteLock([&] {
+            bytesRead = tree->processEditPacketData(received, editData, maxSize, sender);
+        });
+        QVERIFY(bytesRead > 0);
+        received.seek(received.getPosition() + bytesRead);
+        numEdits++;
+    }
+    QCOMPARE(received.getBytesLeftToRead(), (qint64)0);
+}
@@ -0,0 +1,29 @@
+//
+//  EntityPhysicsUpdateTests.h
+//  tests/octree/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsUpdateTests_h
+#define hifi_EntityPhysicsUpdateTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that EntityPhysicsBulk messages decode to what was encoded, and that malformed ones are skipped whole.
+class EntityPhysicsUpdateTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testPerEntityTimestamps();
+    void testTruncatedMessage();
+    void testServerSkipsMalformedMessage_data();
+    void testServerSkipsMalformedMessage();
+};
+
+#endif // hifi_EntityPhysicsUpdateTests_h
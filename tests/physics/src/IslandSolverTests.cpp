@@ -0,0 +1,139 @@
+//
+//  IslandSolverTests.cpp
+//  tests/physics/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IslandSolverTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <PhysicsHelpers.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(IslandSolverTests)
+
+// Many stacks of boxes on a static floor: each stack is its own simulation island.
+// A few stacks stand on a shared kinematic platform to force their islands into one batch.
+const int NUM_STACKS_PER_SIDE = 16;
+const int NUM_BOXES_PER_STACK = 8;
+const float BOX_HALF_EXTENT = 0.25f;
+const float STACK_SPACING = 2.0f;
+const int NUM_SUBSTEPS_PER_TEST = 90;
+
+class StackedBoxesWorld {
+public:
+    StackedBoxesWorld(int numSolverThreads) {
+        _world.reset(new ThreadSafeDynamicsWorld(&_dispatcher, &_broadphase, &_solver, &_collisionConfig));
+        _world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
+        _world->setNumSolverThreads(numSolverThreads);
+
+        addBody(&_floorShape, 0.0f, btVector3(0.0f, 0.0f, 0.0f));
+
+        // kinematic platform under the first row of stacks
+        btRigidBody* platform = addBody(&_platformShape, 0.0f, btVector3(0.5f * STACK_SPACING * NUM_STACKS_PER_SIDE, 0.1f, 0.0f),
+                                        btCollisionObject::CF_KINEMATIC_OBJECT);
+        platform->setActivationState(DISABLE_DEACTIVATION);
+
+        for (int i = 0; i < NUM_STACKS_PER_SIDE; ++i) {
+            for (int j = 0; j < NUM_STACKS_PER_SIDE; ++j) {
+                float base = (j == 0) ? 0.2f : 0.0f;
+                for (int k = 0; k < NUM_BOXES_PER_STACK; ++k) {
+                    btVector3 position((float)i * STACK_SPACING, base + (2.0f * (float)k + 1.0f) * BOX_HALF_EXTENT, (float)j * STACK_SPACING);
+                    addBody(&_boxShape, 1.0f, position);
+                }
+            }
+        }
+    }
+
+    ~StackedBoxesWorld() {
+        for (auto& body : _bodies) {
+            _world->removeRigidBody(body.get());
+        }
+        _bodies.clear();
+        _world.reset();
+    }
+
+    void step(int numSubsteps) {
+        for (int i = 0; i < numSubsteps; ++i) {
+            _world->stepSimulationWithSubstepCallback(PHYSICS_ENGINE_FIXED_SUBSTEP, 1, PHYSICS_ENGINE_FIXED_SUBSTEP);
+        }
+    }
+
+    const std::vector<std::unique_ptr<btRigidBody>>& getBodies() const { return _bodies; }
+    int getNumSolverThreads() const { return _world->getNumSolverThreads(); }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btVector3& position, int collisionFlags = 0) {
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody* body = new btRigidBody(mass, nullptr, shape, inertia);
+        body->setWorldTransform(btTransform(btQuaternion::getIdentity(), position));
+        body->setCollisionFlags(body->getCollisionFlags() | collisionFlags);
+        _world->addRigidBody(body);
+        _bodies.emplace_back(body);
+        return body;
+    }
+
+    btDefaultCollisionConfiguration _collisionConfig;
+    btCollisionDispatcher _dispatcher { &_collisionConfig };
+    btDbvtBroadphase _broadphase;
+    btSequentialImpulseConstraintSolver _solver;
+    btStaticPlaneShape _floorShape { btVector3(0.0f, 1.0f, 0.0f), 0.0f };
+    btBoxShape _platformShape { btVector3(0.5f * STACK_SPACING * NUM_STACKS_PER_SIDE, 0.1f, 0.5f) };
+    btBoxShape _boxShape { btVector3(BOX_HALF_EXTENT, BOX_HALF_EXTENT, BOX_HALF_EXTENT) };
+    std::unique_ptr<ThreadSafeDynamicsWorld> _world;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+};
+
+void IslandSolverTests::testDeterminism() {
+    // serial Bullet solver, batched islands on one thread, batched islands on worker threads
+    StackedBoxesWorld serialWorld(-1);
+    StackedBoxesWorld batchedWorld(0);
+    StackedBoxesWorld parallelWorld(3);
+
+    serialWorld.step(NUM_SUBSTEPS_PER_TEST);
+    batchedWorld.step(NUM_SUBSTEPS_PER_TEST);
+    parallelWorld.step(NUM_SUBSTEPS_PER_TEST);
+
+    const auto& serialBodies = serialWorld.getBodies();
+    const auto& batchedBodies = batchedWorld.getBodies();
+    const auto& parallelBodies = parallelWorld.getBodies();
+    QCOMPARE(batchedBodies.size(), serialBodies.size());
+    QCOMPARE(parallelBodies.size(), serialBodies.size());
+
+    // islands are independent so every path should produce bit-identical results
+    for (size_t i = 0; i < serialBodies.size(); ++i) {
+        const btTransform& expected = serialBodies[i]->getWorldTransform();
+        QCOMPARE(batchedBodies[i]->getWorldTransform() == expected, true);
+        QCOMPARE(parallelBodies[i]->getWorldTransform() == expected, true);
+        QCOMPARE(parallelBodies[i]->getLinearVelocity() == serialBodies[i]->getLinearVelocity(), true);
+    }
+}
+
+void IslandSolverTests::benchmarkSerialStep() {
+    StackedBoxesWorld world(-1);
+    QBENCHMARK {
+        world.step(NUM_SUBSTEPS_PER_TEST);
+    }
+}
+
+void IslandSolverTests::benchmarkParallelStep() {
+    const int MAX_SOLVER_THREADS = 3;
+    int numThreads = std::max(0, std::min(QThread::idealThreadCount() - 1, MAX_SOLVER_THREADS));
+    StackedBoxesWorld world(numThreads);
+    qDebug() << "solver threads:" << world.getNumSolverThreads();
+    QBENCHMARK {
+        world.step(NUM_SUBSTEPS_PER_TEST);
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  IslandSolverTests.h
+//  tests/physics/src
+//
+//  Created by agent on 2026.10.18
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IslandSolverTests_h
+#define hifi_IslandSolverTests_h
+
+#include <QtTest/QtTest>
+
+class IslandSolverTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDeterminism();
+    void benchmarkSerialStep();
+    void benchmarkParallelStep();
+};
+
+#endif // hifi_IslandSolverTests_h
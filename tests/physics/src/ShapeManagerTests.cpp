@@ -10,6 +10,11 @@
 //
 
 #include <iostream>
+
+#include <QtCore/QDirIterator>
+#include <QtCore/QTemporaryDir>
+
+#include <ShapeFactory.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -243,3 +248,234 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+static ShapeInfo makeCompoundInfo() {
+    QVector<glm::vec3> tetrahedron;
+    tetrahedron.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    tetrahedron.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+
+    ShapeInfo::PointCollection pointCollection;
+    const int NUM_HULLS = 3;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList pointList;
+        for (auto& point : tetrahedron) {
+            pointList.push_back((float)(i + 1) * point + glm::vec3((float)i, 0.0f, 0.0f));
+        }
+        pointCollection.push_back(pointList);
+    }
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(3.0f));
+    info.setPointCollection(pointCollection);
+    info.setOffset(glm::vec3(0.0f, 1.0f, 0.0f));
+    return info;
+}
+
+static ShapeInfo makeStaticMeshInfo() {
+    // a flat grid of quads
+    const int NUM_CELLS = 16;
+    ShapeInfo::PointList points;
+    for (int i = 0; i <= NUM_CELLS; ++i) {
+        for (int j = 0; j <= NUM_CELLS; ++j) {
+            points.push_back(glm::vec3((float)i, 0.1f * (float)(i * j % 3), (float)j));
+        }
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * (float)NUM_CELLS));
+    ShapeInfo::TriangleIndices& indices = info.getTriangleIndices();
+    const int ROW = NUM_CELLS + 1;
+    for (int i = 0; i < NUM_CELLS; ++i) {
+        for (int j = 0; j < NUM_CELLS; ++j) {
+            int32_t corner = i * ROW + j;
+            indices << corner << corner + 1 << corner + ROW;
+            indices << corner + 1 << corner + ROW + 1 << corner + ROW;
+        }
+    }
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(points);
+    info.setPointCollection(pointCollection);
+    return info;
+}
+
+static void compareAabbs(const btCollisionShape* shape, const btCollisionShape* otherShape) {
+    btTransform identity;
+    identity.setIdentity();
+    btVector3 minCorner, maxCorner, otherMinCorner, otherMaxCorner;
+    shape->getAabb(identity, minCorner, maxCorner);
+    otherShape->getAabb(identity, otherMinCorner, otherMaxCorner);
+    QCOMPARE(otherMinCorner, minCorner);
+    QCOMPARE(otherMaxCorner, maxCorner);
+}
+
+void ShapeManagerTests::cacheCompoundShape() {
+    QTemporaryDir cacheDir;
+    ShapeInfo info = makeCompoundInfo();
+
+    // the first manager builds the shape and saves it
+    const btCollisionShape* builtShape = ShapeFactory::createShapeFromInfo(info);
+    {
+        auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+        shapeCache->initialize();
+        ShapeManager shapeManager;
+        shapeManager.setShapeCache(shapeCache);
+        const btCollisionShape* shape = shapeManager.getShape(info);
+        QVERIFY(shape != nullptr);
+        QCOMPARE(shapeCache->getNumMisses(), 1);
+        QCOMPARE(shapeCache->getNumTotalFiles(), (size_t)1);
+        shapeManager.releaseShape(shape);
+    }
+
+    // a later manager restores it from disk
+    auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+    shapeCache->initialize();
+    ShapeManager shapeManager;
+    shapeManager.setShapeCache(shapeCache);
+    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeCache->getNumHits(), 1);
+
+    QCOMPARE(shape->getShapeType(), builtShape->getShapeType());
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    const btCompoundShape* builtCompound = static_cast<const btCompoundShape*>(builtShape);
+    QCOMPARE(compound->getNumChildShapes(), builtCompound->getNumChildShapes());
+    for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+        QCOMPARE(compound->getChildTransform(i).getOrigin(), builtCompound->getChildTransform(i).getOrigin());
+        auto hull = static_cast<const btConvexHullShape*>(compound->getChildShape(i));
+        auto builtHull = static_cast<const btConvexHullShape*>(builtCompound->getChildShape(i));
+        QCOMPARE(hull->getNumPoints(), builtHull->getNumPoints());
+        QCOMPARE(hull->getMargin(), builtHull->getMargin());
+    }
+    compareAabbs(shape, builtShape);
+
+    shapeManager.releaseShape(shape);
+    ShapeFactory::deleteShape(builtShape);
+}
+
+void ShapeManagerTests::cacheStaticMeshShape() {
+    ShapeInfo info = makeStaticMeshInfo();
+    const btCollisionShape* builtShape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(builtShape != nullptr);
+
+    QByteArray data;
+    QVERIFY(ShapeFactory::serializeShape(builtShape, data));
+    const btCollisionShape* shape = ShapeFactory::deserializeShape(data);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    compareAabbs(shape, builtShape);
+
+    // the restored BVH should find the same triangle under a ray as the one that was built
+    auto meshShape = static_cast<ShapeFactory::StaticMeshShape*>(const_cast<btCollisionShape*>(shape));
+    auto builtMeshShape = static_cast<ShapeFactory::StaticMeshShape*>(const_cast<btCollisionShape*>(builtShape));
+    QVERIFY(meshShape->getOptimizedBvh() != nullptr);
+    class CountTriangles : public btTriangleCallback {
+    public:
+        void processTriangle(btVector3* triangle, int partId, int triangleIndex) override { indices.push_back(triangleIndex); }
+        std::vector<int> indices;
+    };
+    btVector3 from(3.3f, 10.0f, 7.6f);
+    btVector3 to(3.3f, -10.0f, 7.6f);
+    CountTriangles hits, builtHits;
+    meshShape->performRaycast(&hits, from, to);
+    builtMeshShape->performRaycast(&builtHits, from, to);
+    QVERIFY(hits.indices.size() > 0);
+    QCOMPARE(hits.indices, builtHits.indices);
+
+    // corrupt data is rejected
+    data.truncate(data.size() / 2);
+    QVERIFY(ShapeFactory::deserializeShape(data) == nullptr);
+
+    ShapeFactory::deleteShape(shape);
+    ShapeFactory::deleteShape(builtShape);
+}
+
+static void setInt32(QByteArray& data, int offset, int32_t value) {
+    memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+static int32_t getInt32(const QByteArray& data, int offset) {
+    int32_t value;
+    memcpy(&value, data.constData() + offset, sizeof(value));
+    return value;
+}
+
+void ShapeManagerTests::rejectCorruptShapeData() {
+    // the offsets below follow the layout written by ShapeFactory::serializeShape()
+    const int NUM_CHILDREN_OFFSET = sizeof(int32_t);
+    const int NUM_TRIANGLES_OFFSET = 2 * sizeof(int32_t);
+    const int NUM_VERTICES_OFFSET = 3 * sizeof(int32_t);
+    const int VERTICES_OFFSET = 4 * sizeof(int32_t);
+    const int32_t HUGE_COUNT = 0x7fffffff;
+
+    for (ShapeInfo info : { makeCompoundInfo(), makeStaticMeshInfo() }) {
+        const btCollisionShape* builtShape = ShapeFactory::createShapeFromInfo(info);
+        QByteArray data;
+        QVERIFY(ShapeFactory::serializeShape(builtShape, data));
+        ShapeFactory::deleteShape(builtShape);
+
+        // a file cut short anywhere
+        int step = std::max(1, data.size() / 256);
+        for (int length = 0; length < data.size(); length += step) {
+            QVERIFY(ShapeFactory::deserializeShape(data.left(length)) == nullptr);
+        }
+
+        if (info.getType() == SHAPE_TYPE_COMPOUND) {
+            QByteArray corrupt = data;
+            setInt32(corrupt, NUM_CHILDREN_OFFSET, HUGE_COUNT);
+            QVERIFY(ShapeFactory::deserializeShape(corrupt) == nullptr);
+        } else {
+            // counts larger than the data that follows them
+            QByteArray corrupt = data;
+            setInt32(corrupt, NUM_VERTICES_OFFSET, HUGE_COUNT);
+            QVERIFY(ShapeFactory::deserializeShape(corrupt) == nullptr);
+            corrupt = data;
+            setInt32(corrupt, NUM_TRIANGLES_OFFSET, HUGE_COUNT);
+            QVERIFY(ShapeFactory::deserializeShape(corrupt) == nullptr);
+
+            // an index past the last vertex
+            corrupt = data;
+            int32_t numVertices = getInt32(data, NUM_VERTICES_OFFSET);
+            int indicesOffset = VERTICES_OFFSET + numVertices * 3 * (int)sizeof(float);
+            setInt32(corrupt, indicesOffset, numVertices);
+            QVERIFY(ShapeFactory::deserializeShape(corrupt) == nullptr);
+        }
+    }
+}
+
+void ShapeManagerTests::rebuildCorruptCacheEntry() {
+    QTemporaryDir cacheDir;
+    ShapeInfo info = makeCompoundInfo();
+    {
+        auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+        shapeCache->initialize();
+        ShapeManager shapeManager;
+        shapeManager.setShapeCache(shapeCache);
+        shapeManager.releaseShape(shapeManager.getShape(info));
+    }
+
+    // scribble over the saved entry
+    QDirIterator files(cacheDir.path(), QDir::Files, QDirIterator::Subdirectories);
+    while (files.hasNext()) {
+        QFile file(files.next());
+        QVERIFY(file.open(QFile::ReadWrite));
+        QByteArray data = file.readAll();
+        if (data.size() > (int)(2 * sizeof(int32_t))) {
+            setInt32(data, sizeof(int32_t), 0x7fffffff);
+            file.seek(0);
+            file.write(data);
+        }
+    }
+
+    // it is rejected, and the shape is built again
+    auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+    shapeCache->initialize();
+    ShapeManager shapeManager;
+    shapeManager.setShapeCache(shapeCache);
+    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeCache->getNumHits(), 0);
+    QCOMPARE(shapeCache->getNumMisses(), 1);
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    shapeManager.releaseShape(shape);
+}
@@ -25,6 +25,10 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void cacheCompoundShape();
+    void cacheStaticMeshShape();
+    void rejectCorruptShapeData();
+    void rebuildCorruptCacheEntry();
 };
 
 #endif // hifi_ShapeManagerTests_h
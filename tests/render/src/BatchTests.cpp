@@ -0,0 +1,254 @@
+//
+//  BatchTests.cpp
+//  tests/render/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchTests.h"
+
+#include <string.h>
+
+#include <gpu/Context.h>
+#include <gpu/null/NullBackend.h>
+#include <render/DrawTask.h>
+#include <render/Scene.h>
+
+QTEST_MAIN(BatchTests)
+
+static const std::string INSTANCE_NAME { "BatchTests::instance" };
+static const int NUM_SHAPES = 2000;
+
+// records about what a model mesh part or an instanced shape does, some of them through a named call
+static void recordShape(gpu::Batch& batch, int index, const gpu::BufferPointer& buffer) {
+    Transform model;
+    model.setTranslation(glm::vec3((float)index, 0.0f, 0.0f));
+    batch.setModelTransform(model);
+
+    batch.setUniformBuffer(0, buffer, 0, 16);
+    batch.setInputBuffer(0, buffer, 16 * index, 12);
+    glm::vec4 color((float)index, 0.5f, 0.25f, 1.0f);
+    batch._glUniform4fv(1, 1, &color.x);
+
+    if (index % 3 == 0) {
+        batch.setupNamedCalls(INSTANCE_NAME, [](gpu::Batch&, gpu::Batch::NamedBatchData&) {});
+        batch.getNamedBuffer(INSTANCE_NAME)->append(color);
+    } else {
+        batch.setStateScissorRect(glm::ivec4(0, 0, index, index));
+        batch.draw(gpu::TRIANGLES, 3 * index);
+    }
+}
+
+static void recordPrefix(gpu::Batch& batch) {
+    batch.setViewportTransform(glm::ivec4(0, 0, 1920, 1080));
+    batch.setProjectionTransform(glm::mat4(2.0f));
+    batch.setViewTransform(Transform());
+}
+
+static bool isSameBatch(const gpu::Batch& a, const gpu::Batch& b) {
+    if (a.getCommands() != b.getCommands() || a.getCommandOffsets() != b.getCommandOffsets()) {
+        return false;
+    }
+    if (a.getParams().size() != b.getParams().size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.getParams().size(); i++) {
+        if (a.getParams()[i]._uint != b.getParams()[i]._uint) {
+            return false;
+        }
+    }
+    if (a._data != b._data || a._objects.size() != b._objects.size() ||
+        memcmp(a._objects.data(), b._objects.data(), a._objects.size() * sizeof(gpu::Batch::TransformObject)) != 0) {
+        return false;
+    }
+    if (a._drawCallInfos.size() != b._drawCallInfos.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a._drawCallInfos.size(); i++) {
+        if (a._drawCallInfos[i].index != b._drawCallInfos[i].index) {
+            return false;
+        }
+    }
+    if (a._buffers.size() != b._buffers.size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < (uint32_t)a._buffers.size(); i++) {
+        if (a._buffers.get(i) != b._buffers.get(i)) {
+            return false;
+        }
+    }
+    if (a._namedData.size() != b._namedData.size()) {
+        return false;
+    }
+    for (const auto& item : a._namedData) {
+        auto it = b._namedData.find(item.first);
+        if (it == b._namedData.end() || item.second.count() != it->second.count()) {
+            return false;
+        }
+        for (size_t i = 0; i < item.second.count(); i++) {
+            if (item.second.drawCallInfos[i].index != it->second.drawCallInfos[i].index) {
+                return false;
+            }
+        }
+        const auto& bufferA = item.second.buffers[0];
+        const auto& bufferB = it->second.buffers[0];
+        if (bufferA->getSize() != bufferB->getSize() || memcmp(bufferA->getData(), bufferB->getData(), bufferA->getSize()) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// a shape in the scene that records itself as above
+struct Shape {
+    int index;
+    gpu::BufferPointer buffer;
+};
+using ShapePointer = std::shared_ptr<Shape>;
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const ShapePointer& shape) {
+        return ItemKey::Builder::opaqueShape().build();
+    }
+    template <> const Item::Bound payloadGetBound(const ShapePointer& shape) {
+        return Item::Bound(glm::vec3((float)shape->index, 0.0f, 0.0f), 1.0f);
+    }
+    template <> void payloadRender(const ShapePointer& shape, RenderArgs* args) {
+        recordShape(*args->_batch, shape->index, shape->buffer);
+    }
+}
+
+static render::ItemBounds addShapes(const render::ScenePointer& scene, const gpu::BufferPointer& buffer) {
+    render::ItemBounds items;
+    render::Transaction transaction;
+    for (int i = 0; i < NUM_SHAPES; i++) {
+        auto id = scene->allocateID();
+        auto shape = std::make_shared<Shape>(Shape { i, buffer });
+        transaction.resetItem(id, std::make_shared<render::Payload<Shape>>(shape));
+        items.emplace_back(id);
+    }
+    scene->enqueueTransaction(std::move(transaction));
+    scene->processTransactionQueue();
+    return items;
+}
+
+void BatchTests::initTestCase() {
+    gpu::Context::init<gpu::null::Backend>();
+}
+
+void BatchTests::testAppend() {
+    const int CHUNK_SIZE = 100;
+    auto buffer = std::make_shared<gpu::Buffer>();
+
+    gpu::Batch serial;
+    recordPrefix(serial);
+    for (int i = 0; i < NUM_SHAPES; i++) {
+        recordShape(serial, i, buffer);
+    }
+
+    gpu::Batch merged;
+    recordPrefix(merged);
+    for (int begin = 0; begin < NUM_SHAPES; begin += CHUNK_SIZE) {
+        auto chunk = gpu::Batch::acquire();
+        for (int i = begin; i < begin + CHUNK_SIZE; i++) {
+            recordShape(*chunk, i, buffer);
+        }
+        merged.append(std::move(*chunk));
+        QVERIFY(chunk->getCommands().empty());
+        QVERIFY(chunk->_namedData.empty());
+    }
+
+    QVERIFY(isSameBatch(serial, merged));
+
+    // draws that follow the appended batch keep its model transform
+    serial.draw(gpu::TRIANGLES, 3);
+    merged.draw(gpu::TRIANGLES, 3);
+    QVERIFY(isSameBatch(serial, merged));
+}
+
+void BatchTests::testPool() {
+    gpu::Batch* recycled = nullptr;
+    {
+        auto batch = gpu::Batch::acquire();
+        recordPrefix(*batch);
+        batch->enableStereo(false);
+        recycled = batch.get();
+    }
+
+    // the batch comes back cleared
+    auto batch = gpu::Batch::acquire();
+    QCOMPARE(batch.get(), recycled);
+    QVERIFY(batch->getCommands().empty());
+    QVERIFY(batch->getParams().empty());
+    QVERIFY(batch->_data.empty());
+    QVERIFY(batch->isStereoEnabled());
+}
+
+void BatchTests::testParallelRecording() {
+    auto scene = std::make_shared<render::Scene>(glm::vec3(0.0f), 1024.0f);
+    auto items = addShapes(scene, std::make_shared<gpu::Buffer>());
+
+    auto context = std::make_shared<gpu::Context>();
+    RenderArgs args(context);
+    auto renderContext = std::make_shared<render::RenderContext>();
+    renderContext->args = &args;
+    renderContext->_scene = scene;
+
+    gpu::Batch serial;
+    recordPrefix(serial);
+    args._batch = &serial;
+    render::renderItems(renderContext, items);
+
+    auto parallel = gpu::Batch::acquire();
+    recordPrefix(*parallel);
+    args._batch = parallel.get();
+    render::renderItemsInParallel(renderContext, items);
+    args._batch = nullptr;
+
+    QVERIFY(isSameBatch(serial, *parallel));
+
+    // and the merged batch goes through a frame like any other
+    context->beginFrame();
+    context->appendFrameBatch(std::move(parallel));
+    auto frame = context->endFrame();
+    QCOMPARE((int)frame->batches.size(), 1);
+    context->executeFrame(frame);
+}
+
+void BatchTests::benchmarkRecording_data() {
+    QTest::addColumn<bool>("parallel");
+    QTest::newRow("serial") << false;
+    QTest::newRow("parallel") << true;
+}
+
+void BatchTests::benchmarkRecording() {
+    QFETCH(bool, parallel);
+
+    auto scene = std::make_shared<render::Scene>(glm::vec3(0.0f), 1024.0f);
+    auto items = addShapes(scene, std::make_shared<gpu::Buffer>());
+
+    auto context = std::make_shared<gpu::Context>();
+    RenderArgs args(context);
+    auto renderContext = std::make_shared<render::RenderContext>();
+    renderContext->args = &args;
+    renderContext->_scene = scene;
+
+    QBENCHMARK {
+        context->beginFrame();
+        gpu::doInBatch(context, [&](gpu::Batch& batch) {
+            recordPrefix(batch);
+            args._batch = &batch;
+            if (parallel) {
+                render::renderItemsInParallel(renderContext, items);
+            } else {
+                render::renderItems(renderContext, items);
+            }
+            args._batch = nullptr;
+        });
+        context->executeFrame(context->endFrame());
+    }
+}
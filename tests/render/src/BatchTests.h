@@ -0,0 +1,33 @@
+//
+//  BatchTests.h
+//  tests/render/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BatchTests_h
+#define hifi_BatchTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that batches recorded in pieces, on one thread or on the job pool, and appended together are the same as
+// one batch recorded in order, and benchmarks recording a frame both ways. Frames go to the null backend, no GPU needed.
+class BatchTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testAppend();
+    void testPool();
+    void testParallelRecording();
+
+    void benchmarkRecording_data();
+    void benchmarkRecording();
+};
+
+#endif // hifi_BatchTests_h
@@ -0,0 +1,150 @@
+//
+//  FrustumCullerTests.cpp
+//  tests/render/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrustumCullerTests.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <TBBHelpers.h>
+#include <ViewFrustum.h>
+#include <render/FrustumCuller.h>
+
+QTEST_MAIN(FrustumCullerTests)
+
+// about as many render items as a dense domain
+static const int NUM_BOUNDS = 50000;
+
+static ViewFrustum createFrustum() {
+    ViewFrustum frustum;
+    frustum.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    frustum.setOrientation(glm::angleAxis(0.5f, glm::normalize(glm::vec3(0.2f, 1.0f, 0.1f))));
+    frustum.setProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f));
+    frustum.calculate();
+    return frustum;
+}
+
+// scattered around the camera, from pebbles to buildings, some flat
+static std::vector<AABox> createBounds(int numBounds) {
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> position(-250.0f, 250.0f);
+    std::exponential_distribution<float> size(0.5f);
+
+    std::vector<AABox> bounds;
+    for (int i = 0; i < numBounds; i++) {
+        glm::vec3 scale(size(generator), size(generator), size(generator));
+        if (i % 16 == 0) {
+            scale.y = 0.0f;
+        }
+        bounds.emplace_back(glm::vec3(position(generator), position(generator), position(generator)), scale);
+    }
+    return bounds;
+}
+
+void FrustumCullerTests::testMatchesViewFrustum() {
+    auto frustum = createFrustum();
+    auto bounds = createBounds(NUM_BOUNDS);
+
+    render::FrustumCuller culler;
+    culler.setFrustum(frustum);
+    culler.resize(bounds.size());
+    for (size_t i = 0; i < bounds.size(); i++) {
+        culler.setBound(i, bounds[i]);
+    }
+
+    std::vector<uint8_t> inView(bounds.size());
+    std::vector<uint8_t> reference(bounds.size());
+    culler.test(0, bounds.size(), inView.data());
+    culler.test_ref(0, bounds.size(), reference.data());
+
+    int numInView = 0;
+    for (size_t i = 0; i < bounds.size(); i++) {
+        bool expected = frustum.boxIntersectsFrustum(bounds[i]);
+        QCOMPARE((bool)inView[i], expected);
+        QCOMPARE((bool)reference[i], expected);
+        numInView += expected ? 1 : 0;
+    }
+
+    // both outcomes are exercised
+    QVERIFY(numInView > 0 && numInView < NUM_BOUNDS);
+}
+
+void FrustumCullerTests::testRanges() {
+    auto frustum = createFrustum();
+    auto bounds = createBounds(21);
+
+    render::FrustumCuller culler;
+    culler.setFrustum(frustum);
+    culler.resize(bounds.size());
+    for (size_t i = 0; i < bounds.size(); i++) {
+        culler.setBound(i, bounds[i]);
+    }
+
+    // only [begin, end) is written, even when it ends inside a SIMD group
+    const uint8_t UNTOUCHED = 0xff;
+    std::vector<uint8_t> inView(bounds.size() + 1, UNTOUCHED);
+    culler.test(8, 13, inView.data());
+
+    for (size_t i = 0; i < inView.size(); i++) {
+        if (i >= 8 && i < 13) {
+            QCOMPARE((bool)inView[i], frustum.boxIntersectsFrustum(bounds[i]));
+        } else {
+            QCOMPARE(inView[i], UNTOUCHED);
+        }
+    }
+}
+
+void FrustumCullerTests::benchmarkCull_data() {
+    QTest::addColumn<QString>("method");
+
+    QTest::newRow("serial") << "serial";
+    QTest::newRow("simd") << "simd";
+    QTest::newRow("simd parallel") << "parallel";
+}
+
+void FrustumCullerTests::benchmarkCull() {
+    QFETCH(QString, method);
+
+    const size_t BATCH_SIZE = 1024;
+
+    auto frustum = createFrustum();
+    auto bounds = createBounds(NUM_BOUNDS);
+    std::vector<uint8_t> inView(bounds.size());
+    render::FrustumCuller culler;
+
+    // the bounds are copied into the culler each frame, as CullSpatialSelection does
+    QBENCHMARK {
+        if (method == "serial") {
+            for (size_t i = 0; i < bounds.size(); i++) {
+                inView[i] = frustum.boxIntersectsFrustum(bounds[i]) ? 1 : 0;
+            }
+        } else {
+            culler.setFrustum(frustum);
+            culler.resize(bounds.size());
+            for (size_t i = 0; i < bounds.size(); i++) {
+                culler.setBound(i, bounds[i]);
+            }
+
+            if (method == "simd") {
+                culler.test(0, bounds.size(), inView.data());
+            } else {
+                size_t numBatches = (bounds.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+                tbb::parallel_for(tbb::blocked_range<size_t>(0, numBatches), [&](const tbb::blocked_range<size_t>& batches) {
+                    size_t end = std::min(batches.end() * BATCH_SIZE, bounds.size());
+                    culler.test(batches.begin() * BATCH_SIZE, end, inView.data());
+                });
+            }
+        }
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  FrustumCullerTests.h
+//  tests/render/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrustumCullerTests_h
+#define hifi_FrustumCullerTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that FrustumCuller agrees exactly with ViewFrustum::boxIntersectsFrustum(), and benchmarks culling the bounds
+// of a dense domain one box at a time, 8 at a time, and 8 at a time across the job pool. Needs no GPU.
+class FrustumCullerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testMatchesViewFrustum();
+    void testRanges();
+
+    void benchmarkCull_data();
+    void benchmarkCull();
+};
+
+#endif // hifi_FrustumCullerTests_h
@@ -0,0 +1,160 @@
+//
+//  SceneTests.cpp
+//  tests/render/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <render/Scene.h>
+
+QTEST_MAIN(SceneTests)
+
+// a minimal payload, moved around by its updates
+struct Box {
+    glm::vec3 corner;
+    float size { 1.0f };
+};
+using BoxPointer = std::shared_ptr<Box>;
+using BoxPayload = render::Payload<Box>;
+
+namespace render {
+    template <> const ItemKey payloadGetKey(const BoxPointer& box) {
+        return ItemKey::Builder::opaqueShape().build();
+    }
+    template <> const Item::Bound payloadGetBound(const BoxPointer& box) {
+        return Item::Bound(box->corner, box->size);
+    }
+}
+
+static const glm::vec3 SCENE_ORIGIN(0.0f);
+static const float SCENE_SIZE = 1024.0f;
+
+static std::vector<render::ItemID> addBoxes(render::Scene& scene, int numBoxes) {
+    std::vector<render::ItemID> ids;
+    render::Transaction transaction;
+    for (int i = 0; i < numBoxes; i++) {
+        auto box = std::make_shared<Box>();
+        box->corner = glm::vec3((float)(i % 100), (float)(i / 100 % 100), (float)(i / 10000));
+        auto id = scene.allocateID();
+        transaction.resetItem(id, std::make_shared<BoxPayload>(box));
+        ids.push_back(id);
+    }
+    scene.enqueueTransaction(std::move(transaction));
+    scene.processTransactionQueue();
+    return ids;
+}
+
+// every item is updated twice, once by each of two transactions, so that the order they apply in matters
+static void updateBoxes(render::Scene& scene, const std::vector<render::ItemID>& ids, int frame) {
+    render::Transaction first;
+    render::Transaction second;
+    for (size_t i = 0; i < ids.size(); i++) {
+        float offset = (float)((i * 7 + frame) % 50);
+        first.updateItem<Box>(ids[i], [offset](Box& box) {
+            box.corner += glm::vec3(offset, 0.0f, offset);
+        });
+        second.updateItem<Box>(ids[i], [](Box& box) {
+            box.corner *= 2.0f;
+            box.size += 1.0f;
+        });
+    }
+    scene.enqueueTransaction(std::move(first));
+    scene.enqueueTransaction(std::move(second));
+    scene.processTransactionQueue();
+}
+
+void SceneTests::testConcurrentTransactions() {
+    const int NUM_THREADS = 8;
+    const int NUM_TRANSACTIONS = 100;
+    const int NUM_ITEMS = 10;
+
+    render::Scene scene(SCENE_ORIGIN, SCENE_SIZE);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        producers.emplace_back([&scene] {
+            for (int i = 0; i < NUM_TRANSACTIONS; i++) {
+                render::Transaction transaction;
+                for (int j = 0; j < NUM_ITEMS; j++) {
+                    transaction.resetItem(scene.allocateID(), std::make_shared<BoxPayload>(std::make_shared<Box>()));
+                }
+                scene.enqueueTransaction(std::move(transaction));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    scene.processTransactionQueue();
+
+    const auto& stats = scene.getTransactionStats();
+    QCOMPARE((int)stats.numTransactions, NUM_THREADS * NUM_TRANSACTIONS);
+    QCOMPARE((int)stats.numResets, NUM_THREADS * NUM_TRANSACTIONS * NUM_ITEMS);
+    QCOMPARE((int)stats.numUpdates, 0);
+
+    for (render::ItemID id = 1; id <= (render::ItemID)(NUM_THREADS * NUM_TRANSACTIONS * NUM_ITEMS); id++) {
+        QVERIFY(scene.getItem(id).exist());
+    }
+
+    // nothing left over for the next frame
+    scene.processTransactionQueue();
+    QCOMPARE((int)scene.getTransactionStats().numTransactions, 0);
+}
+
+void SceneTests::testParallelUpdates() {
+    const int NUM_BOXES = 5000;
+    const int NUM_FRAMES = 4;
+
+    render::Scene serialScene(SCENE_ORIGIN, SCENE_SIZE);
+    render::Scene parallelScene(SCENE_ORIGIN, SCENE_SIZE);
+    parallelScene.setParallelUpdates(true);
+
+    auto serialIDs = addBoxes(serialScene, NUM_BOXES);
+    auto parallelIDs = addBoxes(parallelScene, NUM_BOXES);
+    QVERIFY(serialIDs == parallelIDs);
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        updateBoxes(serialScene, serialIDs, frame);
+        updateBoxes(parallelScene, parallelIDs, frame);
+        QCOMPARE((int)parallelScene.getTransactionStats().numUpdates, 2 * NUM_BOXES);
+    }
+
+    for (auto id : serialIDs) {
+        const auto& serialItem = serialScene.getItem(id);
+        const auto& parallelItem = parallelScene.getItem(id);
+        QVERIFY(serialItem.getKey() == parallelItem.getKey());
+        QVERIFY(serialItem.getBound() == parallelItem.getBound());
+        QVERIFY(serialScene.getSpatialTree().getCellLocation(serialItem.getCell()) ==
+            parallelScene.getSpatialTree().getCellLocation(parallelItem.getCell()));
+    }
+}
+
+void SceneTests::benchmarkUpdates_data() {
+    QTest::addColumn<bool>("parallel");
+    QTest::newRow("serial") << false;
+    QTest::newRow("parallel") << true;
+}
+
+void SceneTests::benchmarkUpdates() {
+    QFETCH(bool, parallel);
+    const int NUM_BOXES = 50000;
+
+    render::Scene scene(SCENE_ORIGIN, SCENE_SIZE);
+    scene.setParallelUpdates(parallel);
+    auto ids = addBoxes(scene, NUM_BOXES);
+
+    int frame = 0;
+    QBENCHMARK {
+        updateBoxes(scene, ids, frame++);
+    }
+}
@@ -0,0 +1,30 @@
+//
+//  SceneTests.h
+//  tests/render/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SceneTests_h
+#define hifi_SceneTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that transactions enqueued from many threads all get applied, and that applying a large batch of updates
+// across the job pool leaves the scene as applying them in order does. Needs no GPU.
+class SceneTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testConcurrentTransactions();
+    void testParallelUpdates();
+
+    void benchmarkUpdates_data();
+    void benchmarkUpdates();
+};
+
+#endif // hifi_SceneTests_h
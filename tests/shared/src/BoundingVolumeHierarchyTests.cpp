@@ -0,0 +1,267 @@
+//
+//  BoundingVolumeHierarchyTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BoundingVolumeHierarchyTests.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+#include <vector>
+
+#include <BoundingVolumeHierarchy.h>
+#include <GeometryUtil.h>
+#include <RegisteredMetaTypes.h>
+#include <TriangleSet.h>
+
+QTEST_MAIN(BoundingVolumeHierarchyTests)
+
+static const float WORLD_SIZE = 100.0f;
+static const float MAX_BOX_SIZE = 2.0f;
+
+static std::vector<AABox> randomBoxes(size_t count, std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(0.0f, WORLD_SIZE);
+    std::uniform_real_distribution<float> size(0.01f, MAX_BOX_SIZE);
+    std::vector<AABox> boxes;
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 corner(position(generator), position(generator), position(generator));
+        boxes.emplace_back(corner, glm::vec3(size(generator), size(generator), size(generator)));
+    }
+    return boxes;
+}
+
+static std::vector<PickRay> randomRays(size_t count, std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(-0.1f * WORLD_SIZE, 1.1f * WORLD_SIZE);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<PickRay> rays;
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 direction(unit(generator), unit(generator), unit(generator));
+        if (i % 8 == 0) {
+            // some rays parallel to an axis
+            direction = glm::vec3(0.0f);
+            direction[i % 3] = 1.0f;
+        }
+        rays.emplace_back(glm::vec3(position(generator), position(generator), position(generator)), glm::normalize(direction));
+    }
+    return rays;
+}
+
+static bool findBoxIntersection(const AABox& box, const PickRay& ray, float& distance) {
+    float boxDistance;
+    BoxFace face;
+    glm::vec3 normal;
+    if (box.findRayIntersection(ray.origin, ray.direction, boxDistance, face, normal) && boxDistance < distance) {
+        distance = boxDistance;
+        return true;
+    }
+    return false;
+}
+
+static int findClosestBox(const std::vector<AABox>& boxes, const PickRay& ray, float& distance) {
+    int closest = -1;
+    distance = FLT_MAX;
+    for (size_t i = 0; i < boxes.size(); i++) {
+        if (findBoxIntersection(boxes[i], ray, distance)) {
+            closest = (int)i;
+        }
+    }
+    return closest;
+}
+
+static int findClosestBox(const BoundingVolumeHierarchy& hierarchy, const std::vector<AABox>& boxes,
+                          const PickRay& ray, float& distance) {
+    int closest = -1;
+    distance = FLT_MAX;
+    hierarchy.findRayIntersection(ray.origin, ray.direction, distance, [&](uint32_t index, float& bestDistance) {
+        if (findBoxIntersection(boxes[index], ray, bestDistance)) {
+            closest = (int)index;
+            return true;
+        }
+        return false;
+    });
+    return closest;
+}
+
+static void compareWithBruteForce(const BoundingVolumeHierarchy& hierarchy, const std::vector<AABox>& boxes,
+                                  const std::vector<PickRay>& rays) {
+    int hits = 0;
+    for (const auto& ray : rays) {
+        float expectedDistance;
+        int expected = findClosestBox(boxes, ray, expectedDistance);
+        float distance;
+        int closest = findClosestBox(hierarchy, boxes, ray, distance);
+
+        // boxes can overlap, so only the distance is sure to be the same
+        QCOMPARE(closest < 0, expected < 0);
+        if (expected >= 0) {
+            QCOMPARE(distance, expectedDistance);
+            hits++;
+        }
+    }
+    QVERIFY(hits > 0);
+}
+
+void BoundingVolumeHierarchyTests::testEmpty() {
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(std::vector<AABox>());
+    QVERIFY(hierarchy.isEmpty());
+
+    float distance = FLT_MAX;
+    QVERIFY(!hierarchy.findRayIntersection(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), distance,
+        [](uint32_t, float&) { return true; }));
+}
+
+void BoundingVolumeHierarchyTests::testRayIntersection() {
+    std::mt19937 generator(17);
+    auto rays = randomRays(1000, generator);
+
+    for (size_t count : { 1, 3, 4, 5, 100, 5000 }) {
+        auto boxes = randomBoxes(count, generator);
+        BoundingVolumeHierarchy hierarchy;
+        hierarchy.build(boxes);
+        QCOMPARE(hierarchy.getNumPrimitives(), count);
+        compareWithBruteForce(hierarchy, boxes, rays);
+    }
+
+    // boxes all in one place split in halves rather than by their centroids
+    std::vector<AABox> stacked(1000, AABox(glm::vec3(1.0f), 1.0f));
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(stacked);
+    PickRay ray(glm::vec3(0.0f), glm::normalize(glm::vec3(1.0f)));
+    float distance;
+    QVERIFY(findClosestBox(hierarchy, stacked, ray, distance) >= 0);
+    QVERIFY(fabsf(distance - sqrtf(3.0f)) < 0.001f);
+}
+
+void BoundingVolumeHierarchyTests::testRefit() {
+    std::mt19937 generator(17);
+    auto boxes = randomBoxes(2000, generator);
+    auto rays = randomRays(1000, generator);
+
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(boxes);
+
+    // move everything around, the tree is only looser but still finds the same intersections
+    auto moved = randomBoxes(boxes.size(), generator);
+    hierarchy.refit(moved);
+    compareWithBruteForce(hierarchy, moved, rays);
+
+    AABox bounds;
+    for (const auto& box : moved) {
+        bounds += box;
+    }
+    QVERIFY(hierarchy.getBounds().getMinimumPoint() == bounds.getMinimumPoint());
+    QVERIFY(glm::distance(hierarchy.getBounds().getMaximumPoint(), bounds.getMaximumPoint()) < 0.001f);
+}
+
+void BoundingVolumeHierarchyTests::testPointCandidates() {
+    std::mt19937 generator(17);
+    auto boxes = randomBoxes(2000, generator);
+    std::uniform_real_distribution<float> position(0.0f, WORLD_SIZE);
+
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(boxes);
+
+    int found = 0;
+    for (int i = 0; i < 1000; i++) {
+        // half of the points in a box, the other half anywhere
+        glm::vec3 point = (i % 2) ? boxes[i].calcCenter() : glm::vec3(position(generator), position(generator), position(generator));
+
+        std::vector<uint32_t> expected;
+        for (uint32_t j = 0; j < boxes.size(); j++) {
+            if (boxes[j].contains(point)) {
+                expected.push_back(j);
+            }
+        }
+
+        std::vector<uint32_t> containing;
+        hierarchy.findPointCandidates(point, [&](uint32_t index) {
+            if (boxes[index].contains(point)) {
+                containing.push_back(index);
+            }
+        });
+        std::sort(containing.begin(), containing.end());
+
+        QVERIFY(containing == expected);
+        found += (int)containing.size();
+    }
+    QVERIFY(found >= 500);
+}
+
+void BoundingVolumeHierarchyTests::testTriangleSet() {
+    std::mt19937 generator(17);
+    std::uniform_real_distribution<float> position(0.0f, WORLD_SIZE);
+    std::uniform_real_distribution<float> offset(-MAX_BOX_SIZE, MAX_BOX_SIZE);
+
+    TriangleSet triangleSet;
+    std::vector<Triangle> triangles;
+    for (int i = 0; i < 5000; i++) {
+        glm::vec3 v0(position(generator), position(generator), position(generator));
+        glm::vec3 v1 = v0 + glm::vec3(offset(generator), offset(generator), offset(generator));
+        glm::vec3 v2 = v0 + glm::vec3(offset(generator), offset(generator), offset(generator));
+        Triangle triangle { v0, v1, v2 };
+        triangles.push_back(triangle);
+        triangleSet.insert(triangle);
+    }
+
+    int hits = 0;
+    for (const auto& ray : randomRays(1000, generator)) {
+        for (bool allowBackface : { false, true }) {
+            float expectedDistance = FLT_MAX;
+            for (const auto& triangle : triangles) {
+                float triangleDistance;
+                if (findRayTriangleIntersection(ray.origin, ray.direction, triangle, triangleDistance, allowBackface)) {
+                    expectedDistance = std::min(expectedDistance, triangleDistance);
+                }
+            }
+
+            float distance;
+            BoxFace face;
+            glm::vec3 normal;
+            bool intersects = triangleSet.findRayIntersection(ray.origin, ray.direction, distance, face, normal, true, allowBackface);
+            QCOMPARE(intersects, expectedDistance < FLT_MAX);
+            if (intersects) {
+                QCOMPARE(distance, expectedDistance);
+                hits++;
+            }
+        }
+    }
+    QVERIFY(hits > 0);
+
+    // copies have their own hierarchy
+    TriangleSet copy = triangleSet;
+    triangleSet.clear();
+    PickRay ray(triangles[0].v0 - glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    float distance;
+    BoxFace face;
+    glm::vec3 normal;
+    QVERIFY(!triangleSet.findRayIntersection(ray.origin, ray.direction, distance, face, normal, true));
+    QVERIFY(copy.findRayIntersection(ray.origin, ray.direction, distance, face, normal, false));
+}
+
+void BoundingVolumeHierarchyTests::benchmarkRayIntersection() {
+    std::mt19937 generator(17);
+    auto boxes = randomBoxes(10000, generator);
+    auto rays = randomRays(1000, generator);
+
+    BoundingVolumeHierarchy hierarchy;
+    hierarchy.build(boxes);
+
+    int hits = 0;
+    QBENCHMARK {
+        for (const auto& ray : rays) {
+            float distance;
+            if (findClosestBox(hierarchy, boxes, ray, distance) >= 0) {
+                hits++;
+            }
+        }
+    }
+    QVERIFY(hits > 0);
+}
@@ -0,0 +1,29 @@
+//
+//  BoundingVolumeHierarchyTests.h
+//  tests/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BoundingVolumeHierarchyTests_h
+#define hifi_BoundingVolumeHierarchyTests_h
+
+#include <QtTest/QtTest>
+#include <glm/glm.hpp>
+
+class BoundingVolumeHierarchyTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testEmpty();
+    void testRayIntersection();
+    void testRefit();
+    void testPointCandidates();
+    void testTriangleSet();
+    void benchmarkRayIntersection();
+};
+
+#endif // hifi_BoundingVolumeHierarchyTests_h
@@ -0,0 +1,124 @@
+//
+//  MetricsTests.cpp
+//  tests/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsTests.h"
+
+#include <thread>
+
+#include <QtCore/QBuffer>
+
+#include <MetricsStream.h>
+
+QTEST_MAIN(MetricsTests)
+
+static quint64 valueOf(const QString& name) {
+    auto& registry = MetricsRegistry::getInstance();
+    auto values = registry.collect();
+    for (const auto& metric : registry.getSchema()) {
+        if (metric.name == name) {
+            return values[metric.firstSlot];
+        }
+    }
+    return 0;
+}
+
+void MetricsTests::testCountersAcrossThreads() {
+    const MetricCounter counter { "tests.threaded_counter" };
+    size_t numThreads = MetricsRegistry::getInstance().getNumThreads();
+
+    static const int NUM_THREADS = 4;
+    static const int NUM_ADDS = 10000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < NUM_ADDS; ++j) {
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // the exited threads gave their slots back, but their counts are still there
+    QCOMPARE(MetricsRegistry::getInstance().getNumThreads(), numThreads);
+    QCOMPARE(valueOf("tests.threaded_counter"), (quint64)(NUM_THREADS * NUM_ADDS));
+
+    // the same name is the same metric, but not as a different kind
+    MetricCounter("tests.threaded_counter").add(5);
+    QCOMPARE(valueOf("tests.threaded_counter"), (quint64)(NUM_THREADS * NUM_ADDS + 5));
+    QCOMPARE(MetricsRegistry::getInstance().registerMetric("tests.threaded_counter", MetricsRegistry::Kind::Gauge),
+             MetricsRegistry::INVALID_SLOT);
+}
+
+void MetricsTests::testHistogramBuckets() {
+    QCOMPARE(MetricsRegistry::bucketForValue(0), 0);
+    QCOMPARE(MetricsRegistry::bucketForValue(1), 1);
+    QCOMPARE(MetricsRegistry::bucketForValue(2), 2);
+    QCOMPARE(MetricsRegistry::bucketForValue(3), 2);
+    QCOMPARE(MetricsRegistry::bucketForValue(4), 3);
+    QCOMPARE(MetricsRegistry::bucketForValue(1000), 10);
+    QCOMPARE(MetricsRegistry::bucketForValue(std::numeric_limits<quint64>::max()),
+             MetricsRegistry::NUM_HISTOGRAM_BUCKETS - 1);
+}
+
+void MetricsTests::testStreamRoundTrip() {
+    const MetricCounter counter { "tests.stream_counter" };
+    const MetricGauge gauge { "tests.stream_gauge" };
+    counter.add(100); // before the stream starts, so it is not part of the first sample
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    MetricsStreamWriter writer;
+    writer.start(&buffer);
+
+    counter.add(3);
+    gauge.set(42);
+    writer.writeSample(1000);
+
+    // a metric added in the middle of the stream comes with a new schema
+    const MetricHistogram histogram { "tests.stream_histogram" };
+    counter.add(2);
+    histogram.record(5);
+    writer.writeSample(2000);
+    writer.stop();
+    buffer.close();
+
+    buffer.open(QIODevice::ReadOnly);
+    MetricsStreamReader reader;
+    QVERIFY(reader.start(&buffer));
+
+    auto slotOf = [&](const QString& name) {
+        for (const auto& metric : reader.getSchema()) {
+            if (metric.name == name) {
+                return metric.firstSlot;
+            }
+        }
+        return (int)MetricsRegistry::INVALID_SLOT;
+    };
+
+    MetricsStreamReader::Sample sample;
+    QVERIFY(reader.readSample(sample));
+    QCOMPARE(sample.timestampUsecs, (quint64)1000);
+    QCOMPARE(sample.values[slotOf("tests.stream_counter")], (quint64)3);
+    QCOMPARE(sample.values[slotOf("tests.stream_gauge")], (quint64)42);
+    QCOMPARE(slotOf("tests.stream_histogram"), (int)MetricsRegistry::INVALID_SLOT);
+
+    QVERIFY(reader.readSample(sample));
+    QCOMPARE(sample.timestampUsecs, (quint64)2000);
+    QCOMPARE(sample.values[slotOf("tests.stream_counter")], (quint64)2);
+    QCOMPARE(sample.values[slotOf("tests.stream_gauge")], (quint64)42); // unchanged gauges keep their value
+    int histogramSlot = slotOf("tests.stream_histogram");
+    QVERIFY(histogramSlot != MetricsRegistry::INVALID_SLOT);
+    QCOMPARE(sample.values[histogramSlot + MetricsRegistry::bucketForValue(5)], (quint64)1);
+
+    QVERIFY(!reader.readSample(sample));
+}
@@ -0,0 +1,25 @@
+//
+//  MetricsTests.h
+//  tests/shared/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MetricsTests_h
+#define hifi_MetricsTests_h
+
+#include <QtTest/QtTest>
+
+class MetricsTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testCountersAcrossThreads();
+    void testHistogramBuckets();
+    void testStreamRoundTrip();
+};
+
+#endif // hifi_MetricsTests_h
@@ -8,10 +8,14 @@
 
 #include "TraceTests.h"
 
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
 
+#include <Gzip.h>
 #include <Profile.h>
+#include <TraceRing.h>
 
 #include <NumericalConstants.h>
 #include <../QTestExtensions.h>
@@ -45,3 +49,113 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+static int countEvents(const QJsonArray& events, const QString& name, const QString& type) {
+    int count = 0;
+    for (const auto& event : events) {
+        auto object = event.toObject();
+        if (object["name"].toString() == name && object["ph"].toString() == type) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void TraceTests::testTraceRing() {
+    auto& traceRing = tracing::TraceRing::getInstance();
+    traceRing.setEnabled(true);
+    {
+        PROFILE_RANGE(test, "RingRange")
+        PROFILE_RANGE_EX(test, "RingRangeWithPayload", 0xff00ff00, 42)
+    }
+
+    // a thread that records more than its ring holds keeps only the most recent events
+    std::thread([&] {
+        auto nameId = traceRing.internName("RingOverflow");
+        for (size_t i = 0; i < tracing::TraceRing::EVENTS_PER_THREAD + 10; ++i) {
+            traceRing.record(trace_test(), nameId, tracing::Instant, i);
+        }
+    }).join();
+    traceRing.setEnabled(false);
+
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        traceRing.writeJson(out);
+    }
+    auto document = QJsonDocument::fromJson(data);
+    QVERIFY(document.isArray());
+    auto events = document.array();
+
+    QCOMPARE(countEvents(events, "RingRange", "B"), 1);
+    QCOMPARE(countEvents(events, "RingRange", "E"), 1);
+    QCOMPARE(countEvents(events, "RingRangeWithPayload", "B"), 1);
+    QCOMPARE(countEvents(events, "RingOverflow", "i"), (int)tracing::TraceRing::EVENTS_PER_THREAD);
+
+    // disabled, nothing more is recorded
+    {
+        PROFILE_RANGE(test, "RingRange")
+    }
+    data.clear();
+    {
+        QTextStream out(&data);
+        traceRing.writeJson(out);
+    }
+    QCOMPARE(countEvents(QJsonDocument::fromJson(data).array(), "RingRange", "B"), 1);
+}
+
+void TraceTests::testTraceRingReuse() {
+    auto& traceRing = tracing::TraceRing::getInstance();
+    traceRing.setEnabled(true);
+
+    // threads that come and go one after the other all record into the same ring
+    size_t numRings = 0;
+    for (int i = 0; i < 8; ++i) {
+        std::thread([&] {
+            traceRing.record(trace_test(), traceRing.internName("RingReuse"), tracing::Instant);
+        }).join();
+
+        if (i == 0) {
+            numRings = traceRing.getNumRings();
+        }
+        QCOMPARE(traceRing.getNumRings(), numRings);
+    }
+    traceRing.setEnabled(false);
+
+    // the events of the last of them are still there, until another thread needs its ring
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        traceRing.writeJson(out);
+    }
+    QCOMPARE(countEvents(QJsonDocument::fromJson(data).array(), "RingReuse", "i"), 1);
+}
+
+void TraceTests::testStallTrace() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    auto& traceRing = tracing::TraceRing::getInstance();
+    traceRing.setStallTraceOptions(directory.path(), "test", tracing::TraceRing::DEFAULT_STALL_TRACE_USECS);
+    traceRing.setEnabled(true);
+    {
+        PROFILE_RANGE(test, "StallRange")
+    }
+    traceRing.reportStall("Test", USECS_PER_SECOND);
+    traceRing.setEnabled(false);
+
+    // the trace is written in the background
+    auto readTrace = [&] {
+        auto files = QDir(directory.path()).entryInfoList({ "test-stall-*.json.gz" }, QDir::Files);
+        if (files.size() != 1) {
+            return QJsonArray();
+        }
+        QFile file(files.front().absoluteFilePath());
+        QByteArray data;
+        if (!file.open(QIODevice::ReadOnly) || !gunzip(file.readAll(), data)) {
+            return QJsonArray();
+        }
+        return QJsonDocument::fromJson(data).array();
+    };
+    QTRY_COMPARE_WITH_TIMEOUT(countEvents(readTrace(), "StallRange", "B"), 1, 5000);
+}
@@ -15,6 +15,9 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testTraceRing();
+    void testTraceRingReuse();
+    void testStallTrace();
 };
 
 #endif // hifi_TraceTests_h
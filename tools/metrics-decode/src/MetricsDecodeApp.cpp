@@ -0,0 +1,185 @@
+//
+//  MetricsDecodeApp.cpp
+//  tools/metrics-decode/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsDecodeApp.h"
+
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+
+#include <NumericalConstants.h>
+
+// the upper bound of the histogram bucket that holds the given fraction of the samples
+static quint64 histogramPercentile(const std::vector<quint64>& values, int firstSlot, float fraction) {
+    quint64 count = 0;
+    for (int i = 0; i < MetricsRegistry::NUM_HISTOGRAM_BUCKETS; ++i) {
+        count += values[firstSlot + i];
+    }
+
+    quint64 target = (quint64)(fraction * count);
+    quint64 seen = 0;
+    for (int i = 0; i < MetricsRegistry::NUM_HISTOGRAM_BUCKETS; ++i) {
+        seen += values[firstSlot + i];
+        if (seen > target) {
+            return i == 0 ? 0 : (1ULL << i) - 1;
+        }
+    }
+    return 0;
+}
+
+static quint64 histogramCount(const std::vector<quint64>& values, int firstSlot) {
+    quint64 count = 0;
+    for (int i = 0; i < MetricsRegistry::NUM_HISTOGRAM_BUCKETS; ++i) {
+        count += values[firstSlot + i];
+    }
+    return count;
+}
+
+MetricsDecodeApp::MetricsDecodeApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Metrics Decoder");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "filename." + METRICS_STREAM_EXTENSION);
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption csvOption("csv", "print every sample as CSV, rather than a summary");
+    parser.addOption(csvOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QFile file(inputFilename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Failed to open file" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    MetricsStreamReader reader;
+    if (!reader.start(&file)) {
+        qCritical() << inputFilename << "is not a metrics file, or is from a different version";
+        _returnCode = 3;
+        return;
+    }
+
+    QTextStream out(stdout);
+    if (parser.isSet(csvOption)) {
+        printCSV(reader, out);
+    } else {
+        printSummary(reader, out);
+    }
+}
+
+void MetricsDecodeApp::printSummary(MetricsStreamReader& reader, QTextStream& out) {
+    std::vector<quint64> totals;
+    std::vector<quint64> maximums;
+    std::vector<quint64> lasts;
+    quint64 firstTimestamp = 0;
+    quint64 lastTimestamp = 0;
+    int numSamples = 0;
+
+    MetricsStreamReader::Sample sample;
+    while (reader.readSample(sample)) {
+        if (numSamples == 0) {
+            firstTimestamp = sample.timestampUsecs;
+        }
+        lastTimestamp = sample.timestampUsecs;
+        ++numSamples;
+
+        // slots are never reused, so a later schema only ever adds to them
+        totals.resize(std::max(totals.size(), sample.values.size()), 0);
+        maximums.resize(totals.size(), 0);
+        lasts.resize(totals.size(), 0);
+        for (size_t slot = 0; slot < sample.values.size(); ++slot) {
+            totals[slot] += sample.values[slot];
+            maximums[slot] = std::max(maximums[slot], sample.values[slot]);
+            lasts[slot] = sample.values[slot];
+        }
+    }
+
+    float seconds = (float)(lastTimestamp - firstTimestamp) / USECS_PER_SECOND;
+    out << numSamples << " samples over " << seconds << "s" << endl;
+
+    for (const auto& metric : reader.getSchema()) {
+        if (metric.firstSlot + metric.numSlots > (int)totals.size()) {
+            continue;
+        }
+
+        switch (metric.kind) {
+            case MetricsRegistry::Kind::Counter: {
+                quint64 total = totals[metric.firstSlot];
+                out << metric.name << ": total " << total;
+                if (seconds > 0.0f) {
+                    out << ", " << (total / seconds) << "/s";
+                }
+                out << endl;
+                break;
+            }
+            case MetricsRegistry::Kind::Gauge:
+                out << metric.name << ": last " << lasts[metric.firstSlot]
+                    << ", max " << maximums[metric.firstSlot] << endl;
+                break;
+            case MetricsRegistry::Kind::Histogram:
+                out << metric.name << ": count " << histogramCount(totals, metric.firstSlot)
+                    << ", p50 <= " << histogramPercentile(totals, metric.firstSlot, 0.5f)
+                    << ", p90 <= " << histogramPercentile(totals, metric.firstSlot, 0.9f)
+                    << ", p99 <= " << histogramPercentile(totals, metric.firstSlot, 0.99f) << endl;
+                break;
+        }
+    }
+}
+
+void MetricsDecodeApp::printCSV(MetricsStreamReader& reader, QTextStream& out) {
+    size_t numMetricsInHeader = 0;
+
+    MetricsStreamReader::Sample sample;
+    while (reader.readSample(sample)) {
+        const auto& schema = reader.getSchema();
+
+        // print the header again whenever metrics were added
+        if (schema.size() != numMetricsInHeader) {
+            out << "timestamp_usecs";
+            for (const auto& metric : schema) {
+                if (metric.kind == MetricsRegistry::Kind::Histogram) {
+                    out << "," << metric.name << ".count," << metric.name << ".p50";
+                } else {
+                    out << "," << metric.name;
+                }
+            }
+            out << endl;
+            numMetricsInHeader = schema.size();
+        }
+
+        out << sample.timestampUsecs;
+        for (const auto& metric : schema) {
+            if (metric.kind == MetricsRegistry::Kind::Histogram) {
+                out << "," << histogramCount(sample.values, metric.firstSlot)
+                    << "," << histogramPercentile(sample.values, metric.firstSlot, 0.5f);
+            } else {
+                out << "," << sample.values[metric.firstSlot];
+            }
+        }
+        out << endl;
+    }
+}
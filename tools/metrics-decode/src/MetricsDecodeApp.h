@@ -0,0 +1,35 @@
+//
+//  MetricsDecodeApp.h
+//  tools/metrics-decode/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MetricsDecodeApp_h
+#define hifi_MetricsDecodeApp_h
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QTextStream>
+
+#include <MetricsStream.h>
+
+/// Prints the metrics file written by an assignment client, either as a summary of every metric or as CSV rows
+class MetricsDecodeApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    MetricsDecodeApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    void printSummary(MetricsStreamReader& reader, QTextStream& out);
+    void printCSV(MetricsStreamReader& reader, QTextStream& out);
+
+    int _returnCode { 0 };
+};
+
+#endif // hifi_MetricsDecodeApp_h
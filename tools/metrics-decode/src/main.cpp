@@ -0,0 +1,17 @@
+//
+//  main.cpp
+//  tools/metrics-decode/src
+//
+//  Created by agent on 10/19/2026.
+//  Copyright 2026 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MetricsDecodeApp.h"
+
+int main(int argc, char* argv[]) {
+    MetricsDecodeApp app(argc, argv);
+    return app.getReturnCode();
+}